@@ -0,0 +1,75 @@
+# Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+# 
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License, version 2.0,
+# as published by the Free Software Foundation.
+#
+# This program is also distributed with certain software (including
+# but not limited to OpenSSL) that is licensed under separate terms,
+# as designated in a particular file or component or in included license
+# documentation.  The authors of MySQL hereby grant you an additional
+# permission to link the program and your derivative works with the
+# separately licensed software that they have included with MySQL.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License, version 2.0, for more details.
+#
+# You should have received a copy of the GNU General Public License
+
+# Optional compression libraries, used by util.importTable to read compressed
+# input files.
+#
+# cmake -DWITH_ZLIB=system|none -DWITH_ZSTD=system|none
+# system is the default, if library is not found support is disabled
+
+MACRO (MYSQL_CHECK_ZLIB)
+  IF (NOT WITH_ZLIB)
+    SET(WITH_ZLIB "system" CACHE STRING "By default use system zlib library")
+  ENDIF()
+
+  IF (WITH_ZLIB STREQUAL "system")
+    FIND_PACKAGE(ZLIB)
+    IF (ZLIB_FOUND)
+      SET(HAVE_ZLIB 1)
+      ADD_DEFINITIONS(-DHAVE_ZLIB)
+      INCLUDE_DIRECTORIES(SYSTEM ${ZLIB_INCLUDE_DIRS})
+      LIST(APPEND COMPRESSION_LIBRARIES ${ZLIB_LIBRARIES})
+      MESSAGE(STATUS "ZLIB_LIBRARIES ${ZLIB_LIBRARIES}")
+    ELSE()
+      MESSAGE(STATUS "zlib not found, importing gzip files is disabled")
+    ENDIF()
+  ELSEIF (NOT WITH_ZLIB STREQUAL "none")
+    MESSAGE(FATAL_ERROR "WITH_ZLIB must be system or none")
+  ENDIF()
+ENDMACRO()
+
+MACRO (MYSQL_CHECK_ZSTD)
+  IF (NOT WITH_ZSTD)
+    SET(WITH_ZSTD "system" CACHE STRING "By default use system zstd library")
+  ENDIF()
+
+  IF (WITH_ZSTD STREQUAL "system")
+    FIND_PATH(PATH_TO_ZSTD NAMES zstd.h)
+    FIND_LIBRARY(ZSTD_SYSTEM_LIBRARY NAMES zstd)
+    IF (PATH_TO_ZSTD AND ZSTD_SYSTEM_LIBRARY)
+      SET(HAVE_ZSTD 1)
+      ADD_DEFINITIONS(-DHAVE_ZSTD)
+      INCLUDE_DIRECTORIES(SYSTEM ${PATH_TO_ZSTD})
+      LIST(APPEND COMPRESSION_LIBRARIES ${ZSTD_SYSTEM_LIBRARY})
+      MESSAGE(STATUS "PATH_TO_ZSTD ${PATH_TO_ZSTD}")
+      MESSAGE(STATUS "ZSTD_LIBRARY ${ZSTD_SYSTEM_LIBRARY}")
+    ELSE()
+      MESSAGE(STATUS "zstd not found, importing zstd files is disabled")
+    ENDIF()
+  ELSEIF (NOT WITH_ZSTD STREQUAL "none")
+    MESSAGE(FATAL_ERROR "WITH_ZSTD must be system or none")
+  ENDIF()
+ENDMACRO()
+
+MACRO (MYSQL_CHECK_COMPRESSION)
+  SET(COMPRESSION_LIBRARIES "")
+  MYSQL_CHECK_ZLIB()
+  MYSQL_CHECK_ZSTD()
+ENDMACRO()
@@ -27,15 +27,31 @@
 #include "modules/adminapi/common/common.h"
 #include "modules/adminapi/common/metadata_storage.h"
 #include "modules/adminapi/common/sql.h"
+#include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/replay/setup.h"
 #include "mysqlshdk/libs/mysql/clone.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
 #include "mysqlshdk/libs/mysql/replication.h"
+#include "mysqlshdk/libs/utils/threads.h"
 
 namespace mysqlsh {
 namespace dba {
 
 namespace {
+// members are probed concurrently, so that an unreachable or distant member
+// delays the status only by its own connect timeout/latency
+constexpr size_t k_max_member_probe_threads = 8;
+
+size_t member_probe_threads() {
+  // sessions which are recorded or replayed are numbered in the order in
+  // which they are created, and their traces need to be deterministic
+  return mysqlshdk::db::replay::g_replay_mode ==
+                 mysqlshdk::db::replay::Mode::Direct
+             ? k_max_member_probe_threads
+             : 1;
+}
+
 template <typename R>
 inline bool set_uint(shcore::Dictionary_t dict, const std::string &prop,
                      const R &row, const std::string &field) {
@@ -124,19 +140,41 @@ void Replicaset_status::connect_to_members() {
   mysqlshdk::db::Connection_options group_session_copts(
       group_session->get_connection_options());
 
-  for (const auto &inst : m_instances) {
-    mysqlshdk::db::Connection_options opts(inst.endpoint);
-    if (opts.uri_endpoint() == group_session_copts.uri_endpoint()) {
-      m_member_sessions[inst.endpoint] = group_session;
-    } else {
-      opts.set_login_options_from(group_session_copts);
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions(
+      m_instances.size());
+  std::vector<std::string> errors(m_instances.size());
 
-      try {
-        m_member_sessions[inst.endpoint] =
-            mysqlshdk::db::mysql::open_session(opts);
-      } catch (const mysqlshdk::db::Error &e) {
-        m_member_connect_errors[inst.endpoint] = e.format();
-      }
+  mysqlshdk::utils::parallel_for<mysqlsh::Mysql_thread>(
+      m_instances.size(), member_probe_threads(), [&](size_t i) {
+        const auto &inst = m_instances[i];
+        mysqlshdk::db::Connection_options opts(inst.endpoint);
+
+        if (opts.uri_endpoint() == group_session_copts.uri_endpoint()) {
+          sessions[i] = group_session;
+        } else {
+          opts.set_login_options_from(group_session_copts);
+
+          // connect timeout is the deadline for each member, use the one
+          // given by the user when connecting to the cluster
+          if (group_session_copts.has(mysqlshdk::db::kConnectTimeout) &&
+              !opts.has(mysqlshdk::db::kConnectTimeout)) {
+            opts.set(mysqlshdk::db::kConnectTimeout,
+                     group_session_copts.get(mysqlshdk::db::kConnectTimeout));
+          }
+
+          try {
+            sessions[i] = mysqlshdk::db::mysql::open_session(opts);
+          } catch (const mysqlshdk::db::Error &e) {
+            errors[i] = e.format();
+          }
+        }
+      });
+
+  for (size_t i = 0; i < m_instances.size(); ++i) {
+    if (sessions[i]) {
+      m_member_sessions[m_instances[i].endpoint] = sessions[i];
+    } else {
+      m_member_connect_errors[m_instances[i].endpoint] = errors[i];
     }
   }
 }
@@ -739,6 +777,49 @@ std::pair<std::string, shcore::Value> recovery_status(
 }
 }  // namespace
 
+Replicaset_status::Member_probe Replicaset_status::probe_member(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const mysqlshdk::gr::Member &minfo, const shcore::Value &join_time) {
+  Member_probe probe;
+  mysqlsh::dba::Instance instance(session);
+
+  // Get super_read_only value of each instance to set the mode accurately.
+  probe.super_read_only = instance.get_sysvar_bool("super_read_only");
+
+  // Check if auto-rejoin is running.
+  probe.auto_rejoin = mysqlshdk::gr::is_running_gr_auto_rejoin(instance);
+
+  if (!m_extended.is_null()) {
+    if (*m_extended >= 1) {
+      probe.fence_sysvars = instance.get_fence_sysvars();
+    }
+
+    if (*m_extended >= 3) {
+      collect_local_status(
+          probe.member, instance,
+          minfo.state == mysqlshdk::gr::Member_state::RECOVERING);
+    } else {
+      if (minfo.state == mysqlshdk::gr::Member_state::ONLINE)
+        collect_basic_local_status(probe.member, instance);
+    }
+
+    if (minfo.state == mysqlshdk::gr::Member_state::RECOVERING) {
+      std::string status;
+      shcore::Value info;
+
+      std::tie(status, info) = recovery_status(
+          instance,
+          join_time.type == shcore::String ? join_time.as_string() : "");
+      if (!status.empty()) {
+        (*probe.member)["recoveryStatusText"] = shcore::Value(status);
+      }
+      if (info) (*probe.member)["recovery"] = info;
+    }
+  }
+
+  return probe;
+}
+
 shcore::Dictionary_t Replicaset_status::get_topology(
     const std::vector<mysqlshdk::gr::Member> &member_info,
     const mysqlsh::dba::Instance *primary_instance) {
@@ -753,62 +834,52 @@ shcore::Dictionary_t Replicaset_status::get_topology(
     return mysqlshdk::gr::Member();
   };
 
-  for (const auto &inst : m_instances) {
-    shcore::Dictionary_t member = shcore::make_dict();
-    mysqlshdk::gr::Member minfo(get_member(inst.uuid));
+  const auto count = m_instances.size();
+  std::vector<mysqlshdk::gr::Member> members;
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions;
+  std::vector<shcore::Value> join_times(count);
 
-    mysqlsh::dba::Instance instance(m_member_sessions[inst.endpoint]);
+  for (size_t i = 0; i < count; ++i) {
+    const auto &inst = m_instances[i];
 
-    mysqlshdk::utils::nullable<bool> super_read_only;
-    std::vector<std::string> fence_sysvars;
-    bool auto_rejoin = false;
+    members.emplace_back(get_member(inst.uuid));
 
-    if (instance.get_session()) {
-      // Get super_read_only value of each instance to set the mode accurately.
-      super_read_only = instance.get_sysvar_bool("super_read_only");
+    const auto session = m_member_sessions.find(inst.endpoint);
+    sessions.emplace_back(session == m_member_sessions.end() ? nullptr
+                                                             : session->second);
 
-      // Check if auto-rejoin is running.
-      auto_rejoin = mysqlshdk::gr::is_running_gr_auto_rejoin(instance);
+    // metadata session is not used by the probes, join timestamp is read here
+    if (sessions.back() && !m_extended.is_null() &&
+        members.back().state == mysqlshdk::gr::Member_state::RECOVERING) {
+      m_cluster->get_metadata_storage()->query_instance_attribute(
+          inst.uuid, k_instance_attribute_join_time, &join_times[i]);
+    }
+  }
 
-      if (!m_extended.is_null()) {
-        if (*m_extended >= 1) {
-          fence_sysvars = instance.get_fence_sysvars();
-        }
+  // each session is used by just one probe
+  std::vector<Member_probe> probes(count);
 
-        if (*m_extended >= 3) {
-          collect_local_status(
-              member, instance,
-              minfo.state == mysqlshdk::gr::Member_state::RECOVERING);
-        } else {
-          if (minfo.state == mysqlshdk::gr::Member_state::ONLINE)
-            collect_basic_local_status(member, instance);
+  mysqlshdk::utils::parallel_for<mysqlsh::Mysql_thread>(
+      count, member_probe_threads(), [&](size_t i) {
+        if (sessions[i]) {
+          probes[i] = probe_member(sessions[i], members[i], join_times[i]);
         }
+      });
 
-        if (minfo.state == mysqlshdk::gr::Member_state::RECOVERING) {
-          std::string status;
-          shcore::Value info;
-          // Get the join timestamp from the Metadata
-          shcore::Value join_time;
-          m_cluster->get_metadata_storage()->query_instance_attribute(
-              instance.get_uuid(), k_instance_attribute_join_time, &join_time);
-
-          std::tie(status, info) = recovery_status(
-              instance,
-              join_time.type == shcore::String ? join_time.as_string() : "");
-          if (!status.empty()) {
-            (*member)["recoveryStatusText"] = shcore::Value(status);
-          }
-          if (info) (*member)["recovery"] = info;
-        }
-      }
-    } else {
+  for (size_t i = 0; i < count; ++i) {
+    const auto &inst = m_instances[i];
+    const auto &minfo = members[i];
+    auto &probe = probes[i];
+    shcore::Dictionary_t member = probe.member;
+
+    if (!sessions[i]) {
       (*member)["shellConnectError"] =
           shcore::Value(m_member_connect_errors[inst.endpoint]);
     }
 
     feed_metadata_info(member, inst);
-    feed_member_info(member, minfo, super_read_only, fence_sysvars,
-                     auto_rejoin);
+    feed_member_info(member, minfo, probe.super_read_only,
+                     probe.fence_sysvars, probe.auto_rejoin);
 
     if ((!m_extended.is_null() && *m_extended >= 2) &&
         member_stats.find(inst.uuid) != member_stats.end()) {
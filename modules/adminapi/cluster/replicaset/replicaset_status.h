@@ -25,6 +25,7 @@
 #define MODULES_ADMINAPI_REPLICASET_REPLICASET_STATUS_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -142,6 +143,24 @@ class Replicaset_status : public Command_interface {
   void feed_member_stats(shcore::Dictionary_t dict,
                          const mysqlshdk::db::Row_by_name &stats);
 
+  /**
+   * Information about a member which needs to be queried from that member.
+   */
+  struct Member_probe {
+    shcore::Dictionary_t member = shcore::make_dict();
+    mysqlshdk::utils::nullable<bool> super_read_only;
+    std::vector<std::string> fence_sysvars;
+    bool auto_rejoin = false;
+  };
+
+  /**
+   * Queries the member using the given session. Called concurrently for all
+   * the members, must not use any other session.
+   */
+  Member_probe probe_member(
+      const std::shared_ptr<mysqlshdk::db::ISession> &session,
+      const mysqlshdk::gr::Member &minfo, const shcore::Value &join_time);
+
   shcore::Dictionary_t get_topology(
       const std::vector<mysqlshdk::gr::Member> &member_info,
       const mysqlsh::dba::Instance *primary_instance);
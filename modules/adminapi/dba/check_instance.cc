@@ -180,6 +180,9 @@ void Check_instance::prepare() {
     session = mysqlshdk::db::mysql::Session::create();
     session->connect(m_instance_cnx_opts);
     m_target_instance = new mysqlsh::dba::Instance(session);
+
+    // the check reads lots of variables, fetch them all at once
+    m_target_instance->set_sysvar_snapshot(true);
   }
 
   std::string target = m_target_instance->descr();
@@ -283,6 +286,12 @@ void Check_instance::rollback() {
 void Check_instance::finish() {
   // Close the instance session at the end if available.
   if (m_target_instance) {
+    if (m_target_instance->is_sysvar_snapshot_enabled()) {
+      const auto saved = m_target_instance->get_sysvar_queries_saved();
+      log_debug("System variable queries saved: %s",
+                std::to_string(saved).c_str());
+    }
+
     m_target_instance->close_session();
   }
 }
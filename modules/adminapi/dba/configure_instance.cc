@@ -478,6 +478,7 @@ void Configure_instance::prepare() {
     session = mysqlshdk::db::mysql::Session::create();
     session->connect(m_instance_cnx_opts);
     m_target_instance = new mysqlsh::dba::Instance(session);
+    m_target_instance->set_sysvar_snapshot(true);
 
     m_local_target = mysqlshdk::utils::Net::is_local_address(
         m_target_instance->get_connection_options().get_host());
@@ -693,6 +694,12 @@ void Configure_instance::rollback() {}
 void Configure_instance::finish() {
   // Close the instance session at the end if available.
   if (m_target_instance) {
+    if (m_target_instance->is_sysvar_snapshot_enabled()) {
+      const auto saved = m_target_instance->get_sysvar_queries_saved();
+      log_debug("System variable queries saved: %s",
+                std::to_string(saved).c_str());
+    }
+
     m_target_instance->close_session();
   }
 }
@@ -64,6 +64,7 @@ void Configure_local_instance::prepare() {
     session = mysqlshdk::db::mysql::Session::create();
     session->connect(m_instance_cnx_opts);
     m_target_instance = new mysqlsh::dba::Instance(session);
+    m_target_instance->set_sysvar_snapshot(true);
 
     m_local_target = mysqlshdk::utils::Net::is_local_address(
         m_target_instance->get_connection_options().get_host());
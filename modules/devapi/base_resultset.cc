@@ -23,9 +23,11 @@
 
 #include "modules/devapi/base_resultset.h"
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "modules/mod_utils.h"
 #include "mysqlshdk/include/shellcore/utils_help.h"
@@ -54,7 +56,11 @@ std::unique_ptr<mysqlsh::Row> ShellBaseResult::fetch_one_row() const {
   if (result && columns) {
     const mysqlshdk::db::IRow *row = result->fetch_one();
     if (row) {
-      ret_val = shcore::make_unique<mysqlsh::Row>(columns, *row);
+      if (!_row_members || _row_members->names() != columns) {
+        _row_members = std::make_shared<const Row_members>(columns);
+      }
+
+      ret_val = shcore::make_unique<mysqlsh::Row>(_row_members, *row);
     }
   }
 
@@ -212,32 +218,155 @@ REGISTER_HELP(ROW_DETAIL3,
               "retrieved through "
               "<b>@<Row@>.<<<getField>>>(@<fieldName@>)</b>.");
 
-Row::Row() {
-  add_property("length", "getLength");
-  add_method("getField", std::bind(&Row::get_field, this, _1), "field",
-             shcore::String);
-  names.reset(new std::vector<std::string>());
+namespace {
+
+// names of the members of the Row object, in the LowerCamelCase style
+const char *const k_row_members[] = {"length", "getLength", "getField",
+                                     "help"};
+
+}  // namespace
+
+constexpr const size_t Row_members::npos;
+
+Row_members::Row_members(std::shared_ptr<std::vector<std::string>> names)
+    : _names(std::move(names)) {
+  const auto &columns = *_names;
+  std::vector<std::pair<std::string, uint32_t>> entries;
+
+  entries.reserve(columns.size());
+
+  for (uint32_t i = 0, c = columns.size(); i < c; ++i) {
+    entries.emplace_back(columns[i], i);
+  }
+
+  _columns.build(std::move(entries));
+
+  const auto reserved = [](const std::string &name, shcore::NamingStyle style) {
+    for (const auto member : k_row_members) {
+      if (shcore::get_member_name(member, style) == name) return true;
+    }
+
+    return false;
+  };
+
+  // Values are available as properties if they are valid identifiers and not
+  // base members like length and getField, otherwise they are available
+  // through getField()
+  for (uint32_t i = 0, c = columns.size(); i < c; ++i) {
+    const auto &key = columns[i];
+
+    if (shcore::is_valid_identifier(key) &&
+        !reserved(key, shcore::LowerCamelCase) && _columns.find(key) == i) {
+      _properties.emplace_back(shcore::Cpp_property_name(key), i);
+    }
+  }
+
+  for (const auto style :
+       {shcore::LowerCamelCase, shcore::LowerCaseUnderscores}) {
+    entries.clear();
+
+    for (const auto &p : _properties) {
+      auto name = p.first.name(style);
+
+      // members take precedence over the properties
+      if (!reserved(name, style)) {
+        entries.emplace_back(std::move(name), p.second);
+      }
+    }
+
+    _property_index[style].build(std::move(entries));
+  }
 }
 
-Row::Row(std::shared_ptr<std::vector<std::string>> names_,
-         const mysqlshdk::db::IRow &row)
-    : names(names_) {
-  add_property("length", "getLength");
-  add_method("getField", std::bind(&Row::get_field, this, _1), "field",
-             shcore::String);
-
-  for (uint32_t i = 0, c = row.num_fields(); i < c; i++) {
-    const std::string &key = (*names_)[i];
-    // Values would be available as properties if they are valid identifier
-    // and not base members like length and getField
-    // O on this case the values would be available as
-    // row.property
-    if (shcore::is_valid_identifier(key) && !has_member(key)) add_property(key);
+size_t Row_members::property(const std::string &name,
+                             shcore::NamingStyle style) const {
+  if (style != shcore::LowerCamelCase &&
+      style != shcore::LowerCaseUnderscores) {
+    return npos;
+  }
+
+  return _property_index[style].find(name);
+}
+
+void Row_members::append_properties(shcore::NamingStyle style,
+                                    std::vector<std::string> *out) const {
+  for (const auto &p : _properties) {
+    out->emplace_back(p.first.name(style));
+  }
+}
+
+void Row_members::Index::build(
+    std::vector<std::pair<std::string, uint32_t>> &&entries) {
+  _entries = std::move(entries);
+  _slots.clear();
+
+  if (_entries.empty()) {
+    return;
+  }
+
+  // power of two, at least twice the number of entries
+  size_t size = 2;
+
+  while (size < 2 * _entries.size()) {
+    size *= 2;
   }
 
+  _slots.resize(size, 0);
+
+  for (uint32_t i = 0, c = _entries.size(); i < c; ++i) {
+    auto &s = _slots[slot(_entries[i].first)];
+
+    // first entry wins
+    if (0 == s) {
+      s = i + 1;
+    }
+  }
+}
+
+size_t Row_members::Index::find(const std::string &name) const {
+  if (_slots.empty()) {
+    return npos;
+  }
+
+  const auto s = _slots[slot(name)];
+  return 0 == s ? npos : _entries[s - 1].second;
+}
+
+size_t Row_members::Index::slot(const std::string &name) const {
+  const auto mask = _slots.size() - 1;
+  auto i = std::hash<std::string>()(name) & mask;
+
+  // table is never full, empty slot is always found
+  while (0 != _slots[i] && _entries[_slots[i] - 1].first != name) {
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+Row::Row()
+    : names(std::make_shared<std::vector<std::string>>()),
+      _members(std::make_shared<const Row_members>(names)) {}
+
+Row::Row(std::shared_ptr<const Row_members> members,
+         const mysqlshdk::db::IRow &row)
+    : names(members->names()), _members(std::move(members)) {
   value_array = get_row_values(row);
 }
 
+void Row::add_methods() const {
+  if (_methods_added) return;
+
+  _methods_added = true;
+
+  // rows are created in bulk, members which are not columns are added only
+  // when they are needed
+  const auto self = const_cast<Row *>(this);
+  self->add_property("length", "getLength");
+  self->add_method("getField", std::bind(&Row::get_field, self, _1), "field",
+                   shcore::String);
+}
+
 shcore::Dictionary_t Row::as_object() {
   auto ret_val = shcore::make_dict();
 
@@ -313,9 +442,9 @@ shcore::Value Row::get_field(const shcore::Argument_list &args) {
 }
 
 shcore::Value Row::get_field_(const std::string &field) const {
-  auto iter = std::find(names->begin(), names->end(), field);
-  if (iter != names->end())
-    return value_array[iter - names->begin()];
+  const auto index = _members->column(field);
+  if (index != Row_members::npos)
+    return value_array[index];
   else
     throw shcore::Exception::argument_error("Row.getField: Field " + field +
                                             " does not exist");
@@ -337,13 +466,96 @@ shcore::Value Row::get_member(const std::string &prop) const {
   if (prop == "length") {
     return shcore::Value((int)value_array.size());
   } else {
-    auto it = std::find(names->begin(), names->end(), prop);
-    if (it != names->end()) return value_array[it - names->begin()];
+    const auto index = _members->column(prop);
+    if (index != Row_members::npos) return value_array[index];
   }
 
+  add_methods();
   return shcore::Cpp_object_bridge::get_member(prop);
 }
 
+std::vector<std::string> Row::get_members() const {
+  add_methods();
+
+  auto members = shcore::Cpp_object_bridge::get_members();
+  // properties are listed first, columns follow the base ones
+  std::vector<std::string> columns;
+  _members->append_properties(shcore::current_naming_style(), &columns);
+  members.insert(members.begin() + _properties.size(), columns.begin(),
+                 columns.end());
+
+  return members;
+}
+
+bool Row::has_member(const std::string &prop) const {
+  if (_members->property(prop, shcore::LowerCamelCase) != Row_members::npos) {
+    return true;
+  }
+
+  add_methods();
+  return shcore::Cpp_object_bridge::has_member(prop);
+}
+
+bool Row::has_method(const std::string &name) const {
+  if (_members->property(name, shcore::LowerCamelCase) != Row_members::npos) {
+    return false;
+  }
+
+  add_methods();
+  return shcore::Cpp_object_bridge::has_method(name);
+}
+
+shcore::Value Row::call(const std::string &name,
+                        const shcore::Argument_list &args) {
+  add_methods();
+  return shcore::Cpp_object_bridge::call(name, args);
+}
+
+shcore::Value Row::get_member_advanced(const std::string &prop) const {
+  const auto index = _members->property(prop, shcore::current_naming_style());
+  if (index != Row_members::npos) return value_array[index];
+
+  add_methods();
+  return shcore::Cpp_object_bridge::get_member_advanced(prop);
+}
+
+bool Row::has_member_advanced(const std::string &prop) const {
+  if (_members->property(prop, shcore::current_naming_style()) !=
+      Row_members::npos) {
+    return true;
+  }
+
+  add_methods();
+  return shcore::Cpp_object_bridge::has_member_advanced(prop);
+}
+
+void Row::set_member_advanced(const std::string &prop, shcore::Value value) {
+  const auto index = _members->property(prop, shcore::current_naming_style());
+  if (index != Row_members::npos) {
+    // throws, values cannot be modified
+    set_member(names->at(index), value);
+  }
+
+  add_methods();
+  shcore::Cpp_object_bridge::set_member_advanced(prop, value);
+}
+
+bool Row::has_method_advanced(const std::string &name) const {
+  if (_members->property(name, shcore::current_naming_style()) !=
+      Row_members::npos) {
+    return false;
+  }
+
+  add_methods();
+  return shcore::Cpp_object_bridge::has_method_advanced(name);
+}
+
+shcore::Value Row::call_advanced(const std::string &name,
+                                 const shcore::Argument_list &args) {
+  add_methods();
+  return shcore::Cpp_object_bridge::call_advanced(name, args);
+}
+
 #if DOXYGEN_CPP
 /**
  * Returns the value of a field on the Row based on the field position.
@@ -359,11 +571,10 @@ shcore::Value Row::get_member(size_t index) const {
 void Row::add_item(const std::string &key, shcore::Value value) {
   // All the values are available through index
   value_array.push_back(value);
-  names->push_back(key);
 
-  // Values would be available as properties if they are valid identifier
-  // and not base members like lenght and getField
-  // O on this case the values would be available as
-  // row.property
-  if (shcore::is_valid_identifier(key) && !has_member(key)) add_property(key);
+  // members are immutable, they are rebuilt using the new list of names
+  auto new_names = std::make_shared<std::vector<std::string>>(*names);
+  new_names->push_back(key);
+  names = new_names;
+  _members = std::make_shared<const Row_members>(names);
 }
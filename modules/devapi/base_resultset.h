@@ -27,9 +27,11 @@
 #ifndef MODULES_DEVAPI_BASE_RESULTSET_H_
 #define MODULES_DEVAPI_BASE_RESULTSET_H_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "db/column.h"
 #include "db/row.h"
@@ -40,6 +42,7 @@
 
 namespace mysqlsh {
 class Row;
+class Row_members;
 // This is the Shell Common Base Class for all the resultset classes
 class ShellBaseResult : public shcore::Cpp_object_bridge {
  public:
@@ -55,6 +58,10 @@ class ShellBaseResult : public shcore::Cpp_object_bridge {
   std::unique_ptr<mysqlsh::Row> fetch_one_row() const;
 
   shcore::Dictionary_t fetch_one_object() const;
+
+ private:
+  // members shared by the rows fetched from this result
+  mutable std::shared_ptr<const Row_members> _row_members;
 };
 
 /**
@@ -245,6 +252,73 @@ class SHCORE_PUBLIC Column : public shcore::Cpp_object_bridge {
   shcore::Value _type;
 };
 
+/**
+ * Members of the rows which belong to the same result: names of the columns
+ * and the properties they are exposed as. Computed once and shared by all the
+ * rows, names are looked up using flat hash tables.
+ */
+class SHCORE_PUBLIC Row_members final {
+ public:
+  static constexpr const size_t npos = static_cast<size_t>(-1);
+
+  explicit Row_members(std::shared_ptr<std::vector<std::string>> names);
+
+  Row_members(const Row_members &) = delete;
+  Row_members(Row_members &&) = delete;
+
+  Row_members &operator=(const Row_members &) = delete;
+  Row_members &operator=(Row_members &&) = delete;
+
+  ~Row_members() = default;
+
+  const std::shared_ptr<std::vector<std::string>> &names() const {
+    return _names;
+  }
+
+  /**
+   * Returns index of the first column with the given name, or npos.
+   */
+  size_t column(const std::string &name) const { return _columns.find(name); }
+
+  /**
+   * Returns index of the column exposed as a property with the given name, or
+   * npos. Properties whose names clash with the members of the Row object in
+   * the given naming style are not returned.
+   */
+  size_t property(const std::string &name, shcore::NamingStyle style) const;
+
+  /**
+   * Appends names of all the properties, in the given naming style.
+   */
+  void append_properties(shcore::NamingStyle style,
+                         std::vector<std::string> *out) const;
+
+ private:
+  /**
+   * Open addressing hash table, maps names to indexes. If a name is added
+   * multiple times, the first index is used.
+   */
+  class Index final {
+   public:
+    void build(std::vector<std::pair<std::string, uint32_t>> &&entries);
+
+    size_t find(const std::string &name) const;
+
+   private:
+    size_t slot(const std::string &name) const;
+
+    std::vector<std::pair<std::string, uint32_t>> _entries;
+    // positions of the entries + 1, 0 marks an empty slot
+    std::vector<uint32_t> _slots;
+  };
+
+  std::shared_ptr<std::vector<std::string>> _names;
+  Index _columns;
+  // properties and indexes of their columns
+  std::vector<std::pair<shcore::Cpp_property_name, uint32_t>> _properties;
+  Index _property_index[2];
+};
+
 /**
  * \ingroup ShellAPI
  *
@@ -281,7 +355,7 @@ class SHCORE_PUBLIC Row : public shcore::Cpp_object_bridge {
 #endif
 
   Row();
-  Row(std::shared_ptr<std::vector<std::string>> names,
+  Row(std::shared_ptr<const Row_members> members,
       const mysqlshdk::db::IRow &row);
 
   virtual std::string class_name() const { return "Row"; }
@@ -299,15 +373,37 @@ class SHCORE_PUBLIC Row : public shcore::Cpp_object_bridge {
 
   virtual bool operator==(const Object_bridge &other) const;
 
+  virtual std::vector<std::string> get_members() const;
   virtual shcore::Value get_member(const std::string &prop) const;
   shcore::Value get_member(size_t index) const;
 
+  virtual bool has_member(const std::string &prop) const;
+  virtual bool has_method(const std::string &name) const;
+  virtual shcore::Value call(const std::string &name,
+                             const shcore::Argument_list &args);
+
+  virtual shcore::Value get_member_advanced(const std::string &prop) const;
+  virtual bool has_member_advanced(const std::string &prop) const;
+  virtual void set_member_advanced(const std::string &prop,
+                                   shcore::Value value);
+  virtual bool has_method_advanced(const std::string &name) const;
+  virtual shcore::Value call_advanced(const std::string &name,
+                                      const shcore::Argument_list &args);
+
   size_t get_length() { return value_array.size(); }
   virtual bool is_indexed() const { return true; }
 
   void add_item(const std::string &key, shcore::Value value);
 
   shcore::Dictionary_t as_object();
+
+ private:
+  // Methods are registered when they are used for the first time, columns are
+  // handled using the shared members.
+  void add_methods() const;
+
+  std::shared_ptr<const Row_members> _members;
+  mutable bool _methods_added = false;
 };
 }  // namespace mysqlsh
 
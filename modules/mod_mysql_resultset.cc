@@ -23,10 +23,14 @@
 
 #include "mod_mysql_resultset.h"
 #include <iomanip>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "modules/devapi/base_constants.h"
 #include "modules/mod_utils.h"
 #include "modules/mysqlxtest_utils.h"
+#include "mysqlshdk/include/scripting/obj_typed_array.h"
 #include "mysqlshdk/include/shellcore/base_shell.h"
 #include "mysqlshdk/libs/db/charset.h"
 #include "mysqlshdk/libs/utils/strformat.h"
@@ -72,6 +76,7 @@ ClassicResult::ClassicResult(
                                        const shcore::Argument_list &) const) &
                                        ClassicResult::fetch_all,
                                    this, _1));
+  expose("fetchAllColumnar", &ClassicResult::fetch_all_columnar);
   add_method("nextDataSet", std::bind(&ClassicResult::next_data_set, this, _1));
   add_method("nextResult", std::bind(&ClassicResult::next_result, this, _1));
   add_method("hasData", std::bind(&ClassicResult::has_data, this, _1));
@@ -279,6 +284,223 @@ shcore::Value ClassicResult::fetch_all(
   return shcore::Value(array);
 }
 
+namespace {
+
+/**
+ * Values of a single column, stored contiguously.
+ */
+class Column_values final {
+ public:
+  explicit Column_values(const mysqlshdk::db::Column &column)
+      : m_name(column.get_column_label()),
+        m_type(column.get_type()),
+        m_nulls(std::make_shared<Typed_array>(Typed_array::Type::Uint8)) {
+    using mysqlshdk::db::Type;
+
+    switch (m_type) {
+      case Type::Integer:
+        m_kind = Kind::Int64;
+        m_values = std::make_shared<Typed_array>(Typed_array::Type::Int64);
+        break;
+
+      case Type::UInteger:
+      case Type::Bit:
+        m_kind = Kind::Uint64;
+        m_values = std::make_shared<Typed_array>(Typed_array::Type::Uint64);
+        break;
+
+      case Type::Float:
+      case Type::Double:
+        m_kind = Kind::Double;
+        m_values = std::make_shared<Typed_array>(Typed_array::Type::Double);
+        break;
+
+      case Type::Bytes:
+      case Type::Geometry:
+        m_kind = Kind::Bytes;
+        m_values = std::make_shared<Typed_array>(Typed_array::Type::Uint64);
+        m_values->push_back<uint64_t>(0);
+        break;
+
+      default:
+        m_kind = Kind::String;
+        m_values =
+            std::make_shared<Typed_array>(Typed_array::Type::Text_offset);
+        break;
+    }
+  }
+
+  void append(const mysqlshdk::db::IRow &row, uint32_t index) {
+    using mysqlshdk::db::Type;
+
+    const bool null = row.is_null(index);
+    m_nulls->push_back<uint8_t>(null ? 1 : 0);
+
+    switch (m_kind) {
+      case Kind::Int64:
+        m_values->push_back<int64_t>(null ? 0 : row.get_int(index));
+        break;
+
+      case Kind::Uint64:
+        m_values->push_back<uint64_t>(
+            null ? 0
+                 : (Type::Bit == m_type ? row.get_bit(index)
+                                        : row.get_uint(index)));
+        break;
+
+      case Kind::Double:
+        m_values->push_back<double>(
+            null ? 0.0
+                 : (Type::Float == m_type ? row.get_float(index)
+                                          : row.get_double(index)));
+        break;
+
+      case Kind::String:
+      case Kind::Bytes: {
+        const auto start = m_data.size();
+
+        if (!null) {
+          if (mysqlshdk::db::is_string_type(m_type)) {
+            const auto data = row.get_string_data(index);
+            m_data.append(data.first, data.second);
+          } else {
+            m_data.append(row.get_as_string(index));
+          }
+        }
+
+        if (Kind::String == m_kind) {
+          m_values->push_back_text(m_data.data() + start,
+                                   m_data.size() - start);
+        } else {
+          m_values->push_back<uint64_t>(m_data.size());
+        }
+        break;
+      }
+    }
+  }
+
+  /**
+   * Moves the values into a dictionary.
+   */
+  shcore::Dictionary_t release() {
+    auto column = shcore::make_dict();
+
+    (*column)["name"] = shcore::Value(m_name);
+    (*column)["nulls"] = shcore::Value(m_nulls);
+
+    switch (m_kind) {
+      case Kind::Int64:
+        (*column)["type"] = shcore::Value("int64");
+        (*column)["values"] = shcore::Value(m_values);
+        break;
+
+      case Kind::Uint64:
+        (*column)["type"] = shcore::Value("uint64");
+        (*column)["values"] = shcore::Value(m_values);
+        break;
+
+      case Kind::Double:
+        (*column)["type"] = shcore::Value("double");
+        (*column)["values"] = shcore::Value(m_values);
+        break;
+
+      case Kind::String:
+        (*column)["type"] = shcore::Value("string");
+        (*column)["data"] = shcore::Value(std::move(m_data));
+        (*column)["offsets"] = shcore::Value(m_values);
+        break;
+
+      case Kind::Bytes:
+        (*column)["type"] = shcore::Value("bytes");
+        (*column)["data"] = shcore::Value(std::make_shared<Typed_array>(
+            Typed_array::Type::Uint8, std::move(m_data)));
+        (*column)["offsets"] = shcore::Value(m_values);
+        break;
+    }
+
+    return column;
+  }
+
+ private:
+  enum class Kind { Int64, Uint64, Double, String, Bytes };
+
+  std::string m_name;
+  mysqlshdk::db::Type m_type;
+  Kind m_kind;
+  std::shared_ptr<Typed_array> m_nulls;
+  // numeric values or offsets of the string/binary values in m_data
+  std::shared_ptr<Typed_array> m_values;
+  std::string m_data;
+};
+
+}  // namespace
+
+// Documentation of the fetchAllColumnar function
+REGISTER_HELP_FUNCTION(fetchAllColumnar, ClassicResult);
+REGISTER_HELP_FUNCTION_TEXT(CLASSICRESULT_FETCHALLCOLUMNAR, R"*(
+Returns the records left on the result, stored column by column.
+
+@returns A list with a dictionary for each column.
+
+Values of each column are stored contiguously, which is much faster than
+creating a Row object for every record when processing large results. The
+dictionary describing a column has the following keys:
+
+@li name: the column label.
+@li type: one of int64, uint64, double, string or bytes.
+@li nulls: typed array which holds 1 for each NULL value, 0 otherwise.
+@li values: typed array with the numeric values, NULL is stored as 0.
+@li data: string and binary values concatenated, binary values are returned
+as a typed array of bytes.
+@li offsets: typed array with the offsets of string and binary values in
+data, value i spans from offsets[i] to offsets[i + 1].
+
+Typed arrays are returned as Float64Array or Uint8Array objects in
+JavaScript and as array.array objects in Python. Offsets of string values
+are expressed in the units used to index strings in the given language.
+Decimal, date and time values are returned as strings.
+
+If <<<fetchOne>>> is called before this function, only the remaining records
+are returned.
+)*");
+
+/**
+ * $(CLASSICRESULT_FETCHALLCOLUMNAR_BRIEF)
+ *
+ * $(CLASSICRESULT_FETCHALLCOLUMNAR_RETURNS)
+ *
+ * $(CLASSICRESULT_FETCHALLCOLUMNAR_DETAIL)
+ */
+#if DOXYGEN_JS
+List ClassicResult::fetchAllColumnar() {}
+#elif DOXYGEN_PY
+list ClassicResult::fetch_all_columnar() {}
+#endif
+shcore::Array_t ClassicResult::fetch_all_columnar() {
+  std::vector<Column_values> columns;
+
+  for (const auto &column : _result->get_metadata()) {
+    columns.emplace_back(column);
+  }
+
+  try {
+    while (const auto row = _result->fetch_one()) {
+      for (uint32_t i = 0, size = columns.size(); i < size; ++i) {
+        columns[i].append(*row, i);
+      }
+    }
+  }
+  CATCH_AND_TRANSLATE_FUNCTION_EXCEPTION(get_function_name("fetchAllColumnar"));
+
+  auto result = shcore::make_array();
+
+  for (auto &column : columns) {
+    result->emplace_back(column.release());
+  }
+
+  return result;
+}
+
 // Documentation of getAffectedRowCount function
 REGISTER_HELP_PROPERTY(affectedRowCount, ClassicResult);
 REGISTER_HELP(CLASSICRESULT_AFFECTEDROWCOUNT_BRIEF,
@@ -75,6 +75,7 @@ class SHCORE_PUBLIC ClassicResult : public ShellBaseResult {
   Row fetchOne();
   Dictionary fetchOneObject();
   List fetchAll();
+  List fetchAllColumnar();
   Integer getAffectedItemsCount();
   Integer getAffectedRowCount();
   Integer getColumnCount();
@@ -117,6 +118,7 @@ class SHCORE_PUBLIC ClassicResult : public ShellBaseResult {
   Row fetch_one();
   dict fetch_one_object();
   list fetch_all();
+  list fetch_all_columnar();
   int get_affected_items_count();
   int get_affected_row_count();
   int get_column_count();
@@ -148,6 +150,7 @@ class SHCORE_PUBLIC ClassicResult : public ShellBaseResult {
   virtual shcore::Value fetch_one(const shcore::Argument_list &args) const;
   shcore::Dictionary_t _fetch_one_object();
   virtual shcore::Value fetch_all(const shcore::Argument_list &args) const;
+  shcore::Array_t fetch_all_columnar();
   virtual shcore::Value next_data_set(const shcore::Argument_list &args);
   virtual shcore::Value next_result(const shcore::Argument_list &args);
 
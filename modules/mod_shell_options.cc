@@ -108,6 +108,20 @@ connect to the server, e.g. DbType field is approximated when using X protocol.
 @li showWarnings: boolean value to indicate whether warnings shall be
 included when printing a SQL result
 
+@li sqlBatchSize: maximum number of consecutive INSERT, REPLACE, UPDATE and
+DELETE statements sent to the server in a single packet when executing a SQL
+script using a classic session, values lower than 2 disable batching. Not used
+when results are printed in JSON format or when warnings are displayed.
+
+@li tableFormat.maxSampleSize: maximum size in bytes of the rows used to
+compute column widths when printing results in table format, 0 means no limit.
+Rows which follow the sample are printed without being buffered.
+
+@li tableFormat.sampleRows: number of rows used to compute column widths when
+printing results in table format, 0 means all rows. Rows which follow the
+sample are printed without being buffered, the header is printed again if a
+value does not fit into its column.
+
 @li useWizards: read-only, boolean value to indicate if interactive prompting
 and wizards are enabled by default in AdminAPI and others. Use --no-wizard
 to disable.
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/export_table/dialect_writer.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+Dialect_writer::Dialect_writer(const Dialect &dialect)
+    : m_dialect(dialect),
+      m_enclose_all(!dialect.fields_optionally_enclosed) {
+  m_escaped.fill(false);
+
+  if (m_dialect.fields_escaped_by.empty()) {
+    // nothing is escaped if the escape character is empty
+    return;
+  }
+
+  const auto mark = [this](const std::string &s) {
+    if (!s.empty()) {
+      m_escaped[static_cast<unsigned char>(s[0])] = true;
+    }
+  };
+
+  mark(m_dialect.fields_escaped_by);
+  m_escaped[0] = true;
+
+  if (m_dialect.fields_enclosed_by.empty()) {
+    // without enclosing, terminators within data are escaped instead
+    mark(m_dialect.fields_terminated_by);
+    mark(m_dialect.lines_terminated_by);
+  } else {
+    mark(m_dialect.fields_enclosed_by);
+  }
+}
+
+void Dialect_writer::write_row(const std::vector<Field> &fields,
+                               std::string *out) const {
+  out->append(m_dialect.lines_starting_by);
+
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (i > 0) {
+      out->append(m_dialect.fields_terminated_by);
+    }
+
+    write_field(fields[i], out);
+  }
+
+  out->append(m_dialect.lines_terminated_by);
+}
+
+void Dialect_writer::write_field(const Field &field, std::string *out) const {
+  if (nullptr == field.data) {
+    if (m_dialect.fields_escaped_by.empty()) {
+      out->append("NULL");
+    } else {
+      out->append(m_dialect.fields_escaped_by);
+      out->push_back('N');
+    }
+
+    return;
+  }
+
+  const bool enclose = !m_dialect.fields_enclosed_by.empty() &&
+                       (m_enclose_all || field.quoted);
+
+  if (enclose) {
+    out->append(m_dialect.fields_enclosed_by);
+  }
+
+  write_escaped(field.data, field.length, out);
+
+  if (enclose) {
+    out->append(m_dialect.fields_enclosed_by);
+  }
+}
+
+void Dialect_writer::write_escaped(const char *data, size_t length,
+                                   std::string *out) const {
+  const char *begin = data;
+  const char *const end = data + length;
+
+  // copy runs of characters which do not need to be escaped at once
+  for (const char *p = data; p < end; ++p) {
+    if (m_escaped[static_cast<unsigned char>(*p)]) {
+      out->append(begin, p - begin);
+      out->push_back(m_dialect.fields_escaped_by[0]);
+      out->push_back('\0' == *p ? '0' : *p);
+      begin = p + 1;
+    }
+  }
+
+  out->append(begin, end - begin);
+}
+
+}  // namespace export_table
+}  // namespace mysqlsh
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_EXPORT_TABLE_DIALECT_WRITER_H_
+#define MODULES_UTIL_EXPORT_TABLE_DIALECT_WRITER_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "modules/util/import_table/dialect.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+using import_table::Dialect;
+
+/**
+ * Formats rows the same way SELECT ... INTO OUTFILE does, so that they can be
+ * read back by LOAD DATA INFILE using the same dialect.
+ */
+class Dialect_writer final {
+ public:
+  /**
+   * Value of a single field.
+   */
+  struct Field {
+    const char *data;  //< Field data, nullptr if value is NULL
+    size_t length;     //< Length of the data
+    bool quoted;  //< Value of a string type, enclosed if enclosing is optional
+  };
+
+  Dialect_writer() = delete;
+  explicit Dialect_writer(const Dialect &dialect);
+
+  Dialect_writer(const Dialect_writer &other) = default;
+  Dialect_writer(Dialect_writer &&other) = default;
+
+  Dialect_writer &operator=(const Dialect_writer &other) = default;
+  Dialect_writer &operator=(Dialect_writer &&other) = default;
+
+  ~Dialect_writer() = default;
+
+  /**
+   * Appends a complete line holding the given fields to the buffer.
+   */
+  void write_row(const std::vector<Field> &fields, std::string *out) const;
+
+ private:
+  void write_field(const Field &field, std::string *out) const;
+
+  void write_escaped(const char *data, size_t length, std::string *out) const;
+
+  Dialect m_dialect;
+  bool m_enclose_all;
+  // characters which need to be prefixed with the escape character
+  std::array<bool, 256> m_escaped;
+};
+
+}  // namespace export_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_EXPORT_TABLE_DIALECT_WRITER_H_
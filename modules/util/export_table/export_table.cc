@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/export_table/export_table.h"
+
+#include <errno.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include "modules/util/export_table/dialect_writer.h"
+#include "mysqlshdk/include/shellcore/shell_init.h"
+#include "mysqlshdk/include/shellcore/shell_options.h"
+#include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/rate_limit.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+namespace {
+
+bool is_integer_type(const std::string &data_type) {
+  static constexpr const char *k_integer_types[] = {
+      "tinyint", "smallint", "mediumint", "int", "bigint"};
+
+  for (const auto type : k_integer_types) {
+    if (shcore::str_caseeq(data_type, type)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool to_int64(const std::string &value, int64_t *out) {
+  char *end = nullptr;
+  errno = 0;
+  *out = std::strtoll(value.c_str(), &end, 10);
+  return 0 == errno && end != value.c_str() && '\0' == *end;
+}
+
+/**
+ * Values of these types are enclosed if enclosing is optional, the same as
+ * in case of SELECT ... INTO OUTFILE.
+ */
+bool is_quoted_type(mysqlshdk::db::Type type) {
+  using mysqlshdk::db::Type;
+
+  return type == Type::String || type == Type::Bytes || type == Type::Enum ||
+         type == Type::Set || type == Type::Json || type == Type::Geometry;
+}
+
+/**
+ * Formatted rows are written out in blocks of this size, memory used by each
+ * worker does not depend on the size of the chunks.
+ */
+constexpr size_t k_block_size = 1024 * 1024;
+
+/**
+ * Temporary file which holds the data of a chunk while the preceding chunks
+ * are not written to the output yet. Reused by all the chunks of a worker.
+ */
+class Spill_file final {
+ public:
+  explicit Spill_file(const std::string &path) : m_path(path) {}
+
+  Spill_file(const Spill_file &other) = delete;
+  Spill_file(Spill_file &&other) = delete;
+
+  Spill_file &operator=(const Spill_file &other) = delete;
+  Spill_file &operator=(Spill_file &&other) = delete;
+
+  ~Spill_file() {
+    if (m_file) {
+      fclose(m_file);
+      shcore::delete_file(m_path);
+    }
+  }
+
+  void append(const std::string &data) {
+    if (!m_file) {
+      m_file = fopen(m_path.c_str(), "w+b");
+
+      if (!m_file) {
+        throw std::runtime_error("Cannot open file '" + m_path +
+                                 "' for writing: " +
+                                 shcore::errno_to_string(errno));
+      }
+    }
+
+    // previous chunk was read back, start from the beginning
+    if (0 == m_size && 0 != fseek(m_file, 0, SEEK_SET)) {
+      throw error("seek in");
+    }
+
+    if (fwrite(data.data(), 1, data.size(), m_file) != data.size()) {
+      throw error("write to");
+    }
+
+    m_size += data.size();
+  }
+
+  /**
+   * Reads back all the data in blocks, file is empty afterwards.
+   */
+  template <typename F>
+  void drain(std::string *buffer, F &&write) {
+    if (0 == m_size) {
+      return;
+    }
+
+    if (0 != fseek(m_file, 0, SEEK_SET)) {
+      throw error("seek in");
+    }
+
+    buffer->resize(k_block_size);
+
+    while (m_size > 0) {
+      const auto bytes =
+          fread(&(*buffer)[0], 1, std::min<uint64_t>(m_size, k_block_size),
+                m_file);
+
+      if (0 == bytes) {
+        throw error("read from");
+      }
+
+      write(buffer->data(), bytes);
+      m_size -= bytes;
+    }
+  }
+
+ private:
+  std::runtime_error error(const char *operation) const {
+    return std::runtime_error("Failed to " + std::string{operation} +
+                              " file '" + m_path +
+                              "': " + shcore::errno_to_string(errno));
+  }
+
+  std::string m_path;
+  FILE *m_file = nullptr;
+  uint64_t m_size = 0;
+};
+
+}  // namespace
+
+Export_table::Export_table(const Export_table_options &options)
+    : m_opt(options) {
+  if (m_opt.show_progress()) {
+    if (mysqlsh::current_shell_options()->get().wrap_json != "off") {
+      m_progress = shcore::make_unique<mysqlshdk::textui::Json_progress>();
+    } else {
+      m_progress = shcore::make_unique<mysqlshdk::textui::Text_progress>();
+    }
+  } else {
+    m_progress = shcore::make_unique<mysqlshdk::textui::IProgress>();
+  }
+}
+
+Export_table::~Export_table() {
+  if (m_file) {
+    fclose(m_file);
+  }
+}
+
+void Export_table::create_chunks() {
+  using shcore::sqlstring;
+  const auto session = m_opt.base_session()->get_core_session();
+
+  {
+    const auto result = session->query(
+        (sqlstring("SELECT DATA_LENGTH FROM information_schema.TABLES WHERE "
+                   "TABLE_SCHEMA = ? AND TABLE_NAME = ?",
+                   0)
+         << m_opt.schema() << m_opt.table())
+            .str());
+    const auto row = result->fetch_one();
+
+    if (!row) {
+      throw std::runtime_error("Table `" + m_opt.schema() + "`.`" +
+                               m_opt.table() + "` does not exist.");
+    }
+
+    m_data_length = row->is_null(0) ? 0 : row->get_uint(0);
+  }
+
+  // single chunk is used if table cannot be split
+  m_chunks.assign(1, std::string{});
+
+  {
+    const auto result = session->query(
+        (sqlstring("SELECT s.COLUMN_NAME, c.DATA_TYPE FROM "
+                   "information_schema.STATISTICS s JOIN "
+                   "information_schema.COLUMNS c ON s.TABLE_SCHEMA = "
+                   "c.TABLE_SCHEMA AND s.TABLE_NAME = c.TABLE_NAME AND "
+                   "s.COLUMN_NAME = c.COLUMN_NAME WHERE s.TABLE_SCHEMA = ? AND "
+                   "s.TABLE_NAME = ? AND s.INDEX_NAME = 'PRIMARY' AND "
+                   "s.SEQ_IN_INDEX = 1",
+                   0)
+         << m_opt.schema() << m_opt.table())
+            .str());
+    const auto row = result->fetch_one();
+
+    if (!row) {
+      return;
+    }
+
+    m_key_column = row->get_string(0);
+
+    if (!is_integer_type(row->get_string(1))) {
+      return;
+    }
+  }
+
+  int64_t min = 0;
+  int64_t max = 0;
+
+  {
+    const auto result = session->query(
+        (sqlstring("SELECT MIN(!), MAX(!) FROM !.!", 0)
+         << m_key_column << m_key_column << m_opt.schema() << m_opt.table())
+            .str());
+    const auto row = result->fetch_one();
+
+    // empty table, or unsigned values which do not fit
+    if (!row || row->is_null(0) || !to_int64(row->get_as_string(0), &min) ||
+        !to_int64(row->get_as_string(1), &max)) {
+      return;
+    }
+  }
+
+  // use unsigned arithmetic, difference between int64_t values may not fit
+  const uint64_t span =
+      static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  uint64_t count = std::max<uint64_t>(
+      m_opt.threads_size(),
+      (m_data_length + m_opt.bytes_per_chunk() - 1) / m_opt.bytes_per_chunk());
+
+  if (span < std::numeric_limits<uint64_t>::max()) {
+    count = std::min(count, span + 1);
+  }
+
+  const uint64_t step = span / count + 1;
+  int64_t begin = min;
+
+  m_chunks.clear();
+
+  while (true) {
+    const int64_t end =
+        static_cast<uint64_t>(max) - static_cast<uint64_t>(begin) < step
+            ? max
+            : static_cast<int64_t>(static_cast<uint64_t>(begin) + step - 1);
+
+    m_chunks.emplace_back((sqlstring("! BETWEEN ? AND ?", 0)
+                           << m_key_column << begin << end)
+                              .str());
+
+    if (end == max) {
+      break;
+    }
+
+    begin = end + 1;
+  }
+}
+
+std::string Export_table::chunk_query(size_t index) const {
+  std::string query =
+      (shcore::sqlstring("SELECT * FROM !.!", 0)
+       << m_opt.schema() << m_opt.table())
+          .str();
+
+  if (!m_chunks[index].empty()) {
+    query += " WHERE " + m_chunks[index];
+  }
+
+  if (!m_key_column.empty()) {
+    query += (shcore::sqlstring(" ORDER BY !", 0) << m_key_column).str();
+  }
+
+  return query;
+}
+
+bool Export_table::stop() { return *m_interrupt || any_exception(); }
+
+void Export_table::join_workers() {
+  for (auto &t : m_threads) {
+    t.join();
+  }
+}
+
+void Export_table::rethrow_exceptions() {
+  for (const auto &exc : m_thread_exception) {
+    if (exc) {
+      std::rethrow_exception(exc);
+    }
+  }
+}
+
+bool Export_table::any_exception() {
+  return std::any_of(m_thread_exception.begin(), m_thread_exception.end(),
+                     [](std::exception_ptr p) -> bool { return p != nullptr; });
+}
+
+void Export_table::progress_shutdown() {
+  m_progress->current(m_bytes_written);
+  m_progress->total(m_bytes_written);
+  m_progress->show_status(true);
+  m_progress->shutdown();
+}
+
+void Export_table::spawn_workers() {
+  const auto threads = std::min(static_cast<size_t>(m_opt.threads_size()),
+                                m_chunks.size());
+
+  m_thread_exception.resize(threads, nullptr);
+
+  for (size_t i = 0; i < threads; ++i) {
+    m_threads.emplace_back(&Export_table::dump_chunks, this, i);
+  }
+}
+
+void Export_table::dump_chunks(size_t worker_id) {
+  try {
+    mysqlsh::Mysql_thread t;
+    const auto session = mysqlshdk::db::mysql::Session::create();
+    session->connect(m_opt.connection_options());
+
+    mysqlshdk::utils::Rate_limit rate_limit(m_opt.max_rate());
+    const Dialect_writer writer(m_opt.dialect());
+    std::vector<Dialect_writer::Field> fields;
+    std::vector<std::string> values;
+    std::string buffer;
+    std::string spill_buffer;
+    Spill_file spill{m_opt.output_file() + ".part" +
+                     std::to_string(worker_id)};
+
+    const auto write = [this](const char *data, size_t length) {
+      write_data(data, length);
+    };
+
+    // streams the block straight to the output if all preceding chunks are
+    // written, otherwise keeps it aside until they are
+    const auto flush = [&](size_t index) {
+      if (rate_limit.enabled()) {
+        rate_limit.throttle(buffer.size());
+      }
+
+      if (m_next_write == index) {
+        spill.drain(&spill_buffer, write);
+        write_data(buffer.data(), buffer.size());
+      } else {
+        spill.append(buffer);
+      }
+
+      buffer.clear();
+    };
+
+    while (!stop()) {
+      const size_t index = m_next_chunk++;
+
+      if (index >= m_chunks.size()) {
+        break;
+      }
+
+      // buffer keeps its capacity, blocks are formatted without reallocations
+      buffer.clear();
+      uint64_t rows = 0;
+
+      const auto result = session->query(chunk_query(index), false);
+      const auto &metadata = result->get_metadata();
+
+      fields.resize(metadata.size());
+      values.resize(metadata.size());
+
+      for (size_t i = 0; i < metadata.size(); ++i) {
+        fields[i].quoted = is_quoted_type(metadata[i].get_type());
+      }
+
+      while (const auto row = result->fetch_one()) {
+        if (*m_interrupt) {
+          return;
+        }
+
+        for (uint32_t i = 0; i < fields.size(); ++i) {
+          auto &field = fields[i];
+
+          if (row->is_null(i)) {
+            field.data = nullptr;
+            field.length = 0;
+            continue;
+          }
+
+          const auto type = row->get_type(i);
+
+          if (mysqlshdk::db::is_string_type(type)) {
+            const auto data = row->get_string_data(i);
+            field.data = data.first;
+            field.length = data.second;
+          } else {
+            auto &value = values[i];
+
+            if (mysqlshdk::db::Type::Bit == type) {
+              // LOAD DATA expects bit values as big-endian binary strings
+              const auto bits = row->get_bit(i);
+              value.resize((metadata[i].get_length() + 7) / 8);
+
+              for (size_t b = 0; b < value.size(); ++b) {
+                value[value.size() - b - 1] =
+                    static_cast<char>((bits >> (8 * b)) & 0xFF);
+              }
+            } else {
+              value = row->get_as_string(i);
+            }
+
+            field.data = value.data();
+            field.length = value.length();
+          }
+        }
+
+        writer.write_row(fields, &buffer);
+        ++rows;
+
+        if (buffer.size() >= k_block_size) {
+          flush(index);
+        }
+      }
+
+      if (rate_limit.enabled()) {
+        rate_limit.throttle(buffer.size());
+      }
+
+      if (!wait_for_turn(index)) {
+        return;
+      }
+
+      spill.drain(&spill_buffer, write);
+      write_data(buffer.data(), buffer.size());
+      chunk_written(rows);
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    m_thread_exception[worker_id] = std::current_exception();
+    m_write_cv.notify_all();
+  }
+}
+
+bool Export_table::wait_for_turn(size_t index) {
+  std::unique_lock<std::mutex> lock(m_write_mutex);
+
+  // chunks are written in the order of the key
+  while (m_next_write != index) {
+    if (stop()) {
+      return false;
+    }
+
+    m_write_cv.wait_for(lock, std::chrono::milliseconds(100));
+  }
+
+  return true;
+}
+
+void Export_table::write_data(const char *data, size_t length) {
+  if (0 == length) {
+    return;
+  }
+
+  // only the worker which writes the current chunk gets here, file is not
+  // shared
+  if (fwrite(data, 1, length, m_file) != length) {
+    throw std::runtime_error("Failed to write to file '" +
+                             m_opt.output_file() +
+                             "': " + shcore::errno_to_string(errno));
+  }
+
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+  m_bytes_written += length;
+
+  // size of the table is just an estimate
+  if (m_bytes_written > m_data_length) {
+    m_data_length = m_bytes_written;
+    m_progress->total(m_data_length);
+  }
+
+  m_progress->current(m_bytes_written);
+  m_progress->show_status();
+}
+
+void Export_table::chunk_written(uint64_t rows) {
+  {
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    ++m_next_write;
+    m_rows_written += rows;
+  }
+
+  m_write_cv.notify_all();
+}
+
+void Export_table::export_data() {
+  create_chunks();
+
+  m_file = fopen(m_opt.output_file().c_str(), "wb");
+
+  if (!m_file) {
+    throw std::runtime_error("Cannot open file '" + m_opt.output_file() +
+                             "' for writing: " +
+                             shcore::errno_to_string(errno));
+  }
+
+  m_progress->total(m_data_length);
+
+  m_timer.stage_begin("Parallel export data");
+  spawn_workers();
+  join_workers();
+  m_timer.stage_end();
+  progress_shutdown();
+
+  const bool failed = 0 != fclose(m_file);
+  const int error = errno;
+  m_file = nullptr;
+
+  if (*m_interrupt || any_exception()) {
+    // output is incomplete, do not leave it behind
+    shcore::delete_file(m_opt.output_file());
+  } else if (failed) {
+    throw std::runtime_error("Failed to write to file '" +
+                             m_opt.output_file() +
+                             "': " + shcore::errno_to_string(error));
+  }
+}
+
+std::string Export_table::export_summary() const {
+  using mysqlshdk::utils::format_bytes;
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_bytes;
+  return "Table `" + m_opt.schema() + "`.`" + m_opt.table() + "` (" +
+         format_bytes(m_bytes_written) + ") was exported to file '" +
+         m_opt.output_file() + "' in " +
+         format_seconds(m_timer.total_seconds_ellapsed()) + " at " +
+         format_throughput_bytes(m_bytes_written,
+                                 m_timer.total_seconds_ellapsed());
+}
+
+std::string Export_table::rows_written_info() const {
+  return "Total rows exported from " + m_opt.schema() + "." + m_opt.table() +
+         ": " + std::to_string(m_rows_written);
+}
+
+}  // namespace export_table
+}  // namespace mysqlsh
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_EXPORT_TABLE_EXPORT_TABLE_H_
+#define MODULES_UTIL_EXPORT_TABLE_EXPORT_TABLE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/util/export_table/export_table_options.h"
+#include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+/**
+ * Exports a table to a single file in parallel connections. Table is split
+ * into ranges of the first column of its primary key, each range is read by
+ * one of the workers and written to the file in the order of the key, so that
+ * util.importTable() with the same dialect options loads it back.
+ */
+class Export_table final {
+ public:
+  Export_table() = delete;
+  explicit Export_table(const Export_table_options &options);
+  Export_table(const Export_table &other) = delete;
+  Export_table(Export_table &&other) = delete;
+
+  Export_table &operator=(const Export_table &other) = delete;
+  Export_table &operator=(Export_table &&other) = delete;
+
+  ~Export_table();
+
+  void interrupt(volatile bool *interrupt) { m_interrupt = interrupt; }
+
+  void export_data();
+  bool any_exception();
+  void rethrow_exceptions();
+
+  std::string export_summary() const;
+  std::string rows_written_info() const;
+
+ private:
+  void create_chunks();
+  void spawn_workers();
+  void join_workers();
+  void progress_shutdown();
+  bool stop();
+
+  /**
+   * Reads the chunks from the server and writes them to the output file, run
+   * by each of the workers.
+   */
+  void dump_chunks(size_t worker_id);
+
+  /**
+   * Waits until all preceding chunks are written.
+   *
+   * @returns false if export was stopped.
+   */
+  bool wait_for_turn(size_t index);
+
+  /**
+   * Appends data to the output file, can be called only by the worker which
+   * writes the chunk m_next_write.
+   */
+  void write_data(const char *data, size_t length);
+
+  /**
+   * Marks the chunk m_next_write as written, lets the next one to be written.
+   */
+  void chunk_written(uint64_t rows);
+
+  std::string chunk_query(size_t index) const;
+
+  const Export_table_options &m_opt;
+
+  std::string m_key_column;
+  // WHERE conditions selecting the chunks, empty if table is not split
+  std::vector<std::string> m_chunks;
+  std::atomic<size_t> m_next_chunk{0};
+
+  FILE *m_file = nullptr;
+  std::mutex m_write_mutex;
+  std::condition_variable m_write_cv;
+  std::atomic<size_t> m_next_write{0};
+  uint64_t m_bytes_written = 0;
+  uint64_t m_rows_written = 0;
+  uint64_t m_data_length = 0;
+
+  std::unique_ptr<mysqlshdk::textui::IProgress> m_progress = nullptr;
+
+  volatile bool *m_interrupt;
+  mysqlshdk::utils::Profile_timer m_timer;
+  std::vector<std::thread> m_threads;
+  std::vector<std::exception_ptr> m_thread_exception;
+};
+
+}  // namespace export_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_EXPORT_TABLE_EXPORT_TABLE_H_
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/export_table/export_table_options.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "modules/mod_utils.h"
+#include "mysqlshdk/include/scripting/types.h"
+#include "mysqlshdk/include/shellcore/base_session.h"
+#include "mysqlshdk/libs/db/connection_options.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+Export_table_options::Export_table_options(const std::string &table,
+                                           const std::string &output_url,
+                                           const shcore::Dictionary_t &options)
+    : m_table(table) {
+  static constexpr const char k_file_scheme[] = "file://";
+
+  if (m_table.empty()) {
+    throw shcore::Exception::argument_error(
+        "The name of the table to export cannot be empty.");
+  }
+
+  if (shcore::str_beginswith(output_url, k_file_scheme)) {
+    m_output_file = output_url.substr(shcore::array_size(k_file_scheme) - 1);
+  } else if (std::string::npos != output_url.find("://")) {
+    throw shcore::Exception::argument_error(
+        "Only local files are supported as the output of the export "
+        "operation.");
+  } else {
+    m_output_file = output_url;
+  }
+
+  if (m_output_file.empty()) {
+    throw shcore::Exception::argument_error(
+        "The output file name cannot be empty.");
+  }
+
+  m_output_file = shcore::path::expand_user(m_output_file);
+  unpack(options);
+}
+
+void Export_table_options::validate() {
+  m_dialect.validate();
+
+  if (!m_base_session || !m_base_session->is_open() ||
+      m_base_session->get_node_type().compare("mysql") != 0) {
+    throw shcore::Exception::runtime_error(
+        "A classic protocol session is required to perform this operation.");
+  }
+
+  if (m_schema.empty()) {
+    m_schema = m_base_session->get_current_schema();
+    if (m_schema.empty()) {
+      throw std::runtime_error(
+          "There is no active schema on the current session, the schema of "
+          "the exported table must be provided in the options.");
+    }
+  }
+
+  if (m_threads_size < 1) {
+    throw shcore::Exception::argument_error(
+        "The value of the 'threads' option must be greater than 0.");
+  }
+}
+
+size_t Export_table_options::max_rate() const {
+  if (!m_max_rate.empty()) {
+    return mysqlshdk::utils::expand_to_bytes(m_max_rate);
+  }
+  return 0;
+}
+
+Connection_options Export_table_options::connection_options() const {
+  return m_base_session->get_connection_options();
+}
+
+size_t Export_table_options::bytes_per_chunk() const {
+  // rows are written in whole chunks, small chunks would make the workers
+  // wait for each other
+  constexpr const size_t min_bytes_per_chunk = 131072;
+  return std::max(mysqlshdk::utils::expand_to_bytes(m_bytes_per_chunk),
+                  min_bytes_per_chunk);
+}
+
+std::string Export_table_options::target_export_info() const {
+  auto connection_options = m_base_session->get_connection_options();
+  std::string info_msg =
+      "Exporting table `" + schema() + "`.`" + table() +
+      "` from MySQL Server at " +
+      connection_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
+      " to file '" + output_file() + "' using " +
+      std::to_string(threads_size());
+  info_msg += threads_size() == 1 ? " thread" : " threads";
+  return info_msg;
+}
+
+void Export_table_options::unpack(const shcore::Dictionary_t &options) {
+  auto unpack_options = Unpack_options(options);
+  unpack_options.optional("dialect", &m_base_dialect_name);
+
+  try {
+    m_dialect = Dialect::from_name(m_base_dialect_name);
+  } catch (const std::invalid_argument &e) {
+    throw shcore::Exception::argument_error(e.what());
+  }
+
+  unpack_options.optional("schema", &m_schema)
+      .optional("threads", &m_threads_size)
+      .optional("bytesPerChunk", &m_bytes_per_chunk)
+      .optional("fieldsTerminatedBy", &m_dialect.fields_terminated_by)
+      .optional("fieldsEnclosedBy", &m_dialect.fields_enclosed_by)
+      .optional("fieldsOptionallyEnclosed",
+                &m_dialect.fields_optionally_enclosed)
+      .optional("fieldsEscapedBy", &m_dialect.fields_escaped_by)
+      .optional("linesTerminatedBy", &m_dialect.lines_terminated_by)
+      .optional("maxRate", &m_max_rate)
+      .optional("showProgress", &m_show_progress)
+      .end();
+}
+
+}  // namespace export_table
+}  // namespace mysqlsh
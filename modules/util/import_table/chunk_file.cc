@@ -25,17 +25,49 @@
 
 #include <algorithm>
 #include <cassert>
-
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+
+#include "modules/util/import_table/file_backends/compressed_file.h"
+#include "modules/util/import_table/scanner.h"
+#include "mysqlshdk/libs/utils/logger.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+/**
+ * Maximum number of ranges discovered in a region which wait to be merged
+ * into the output queue.
+ */
+constexpr const size_t k_region_queue_size = 1024;
+
+constexpr const size_t k_min_chunk_size = 2 * BUFFER_SIZE;
+
+/**
+ * If chunk size is adaptive, this many row boundaries are searched for within
+ * each chunk of maximum size.
+ */
+constexpr const size_t k_grains_per_chunk = 32;
+
+/**
+ * Slowest worker should be able to load its chunk in 1/k of the estimated
+ * remaining time.
+ */
+constexpr const double k_tail_fraction = 2.0;
+
+}  // namespace
+
 File_iterator::File_iterator(
     IFile *file_descriptor, size_t file_size, size_t start_from_offset,
     Buffer *current_buffer, Buffer *next_buffer, Async_read_task *aio,
     size_t needle_size,
-    shcore::Synchronized_queue<Async_read_task *> *task_queue)
+    shcore::Bounded_queue<Async_read_task *> *task_queue)
     : m_current(current_buffer),
       m_next(next_buffer),
       m_offset(start_from_offset),
@@ -58,7 +90,8 @@ File_iterator::File_iterator(
     m_next->reserved = needle_size;
   }
 
-  if (start_from_offset < file_size) {
+  // end iterators do not own buffers
+  if (m_current && start_from_offset < file_size) {
     m_aio->fh = m_fh;
     m_aio->length = BUFFER_SIZE;
 
@@ -69,11 +102,19 @@ File_iterator::File_iterator(
   }
 }
 
+File_iterator::File_iterator(const uint8_t *mapping, size_t file_size,
+                             size_t start_from_offset)
+    : m_mapping(mapping),
+      m_ptr(mapping + std::min(start_from_offset, file_size)),
+      m_ptr_end(mapping + file_size),
+      m_offset(std::min(start_from_offset, file_size)),
+      m_file_size(file_size) {}
+
 File_iterator &File_iterator::operator++() {
   ++m_offset;
   ++m_ptr;
 
-  if (!(m_ptr < m_ptr_end)) {
+  if (!(m_ptr < m_ptr_end) && !m_mapping) {
     await_next();
     swap();
     if (!m_eof) {
@@ -87,14 +128,14 @@ File_iterator &File_iterator::operator++() {
 File_iterator &File_iterator::operator++(int) {
   ++m_offset;
   ++m_ptr;
-  assert(m_ptr <= (m_ptr_end + m_current->reserved));
+  assert(m_mapping || m_ptr <= (m_ptr_end + m_current->reserved));
   return *this;
 }
 
 File_iterator &File_iterator::operator--(int) {
   --m_offset;
   --m_ptr;
-  assert(m_ptr >= m_current->buffer);
+  assert(m_ptr >= (m_mapping ? m_mapping : m_current->buffer));
   return *this;
 }
 
@@ -128,6 +169,11 @@ void File_iterator::await_next() {
 void File_iterator::force_offset(size_t start_from_offset) {
   m_offset = std::min(start_from_offset, m_file_size);
 
+  if (m_mapping) {
+    m_ptr = m_mapping + m_offset;
+    return;
+  }
+
   // todo(kg): We can try to cancel current m_aio task. This require cancel
   // functionality implementation for generic aio which isn't currently
   // supported.
@@ -141,11 +187,78 @@ void File_iterator::force_offset(size_t start_from_offset) {
   }
 }
 
+File_iterator find(File_iterator first, File_iterator last,
+                   std::string::const_iterator needle_first,
+                   std::string::const_iterator needle_last,
+                   Find_context<File_iterator::value_type> *context) {
+  assert(context);
+  if (needle_first == needle_last) {
+    if (first != last) {
+      context->last_element = *first;
+    }
+    context->needle_found = true;
+    return first;
+  }
+
+  const auto head = static_cast<uint8_t>(*needle_first);
+
+  while (first != last) {
+    const size_t window =
+        std::min(first.available(), last.offset() - first.offset());
+
+    if (window > 0) {
+      const uint8_t *block = first.data();
+      const uint8_t *hit = find_byte(block, block + window, head);
+
+      if (hit != block) {
+        // no needle can start in [block, hit)
+        const size_t count = hit - block;
+        context->preceding_element_set = true;
+        context->preceding_element = block[count - 1];
+        context->last_element = block[count - 1];
+        first.skip(count - 1);
+        ++first;  // crosses buffer boundary if needed
+        continue;
+      }
+    }
+
+    // first points to a needle candidate
+    context->last_element = *first;
+    File_iterator it = first;
+    for (auto needle_it = needle_first;; it++, ++needle_it) {
+      if (needle_it == needle_last) {
+        context->needle_found = true;
+        return it;
+      }
+      if (it == last) {
+        context->needle_found = false;
+        return last;
+      }
+      if (*it != static_cast<uint8_t>(*needle_it)) {
+        break;
+      }
+    }
+    context->preceding_element_set = true;
+    context->preceding_element = *first;
+    ++first;
+  }
+
+  context->needle_found = false;
+  return last;
+}
+
 File_handler::File_handler(const std::string &pathname) {
   m_fh = make_file_handler(pathname);
   m_fh->open();
   // todo(kg): check if m_fh->is_open() and throw?
   m_file_size = m_fh->file_size();
+  m_mapping = m_fh->mapping();
+
+  if (m_mapping) {
+    // file is scanned directly from memory
+    return;
+  }
+
   m_aio_worker = std::thread([this]() -> void {
     while (true) {
       Async_read_task *r = m_task_queue.pop();
@@ -173,51 +286,409 @@ File_handler::File_handler(const std::string &pathname) {
 }
 
 File_handler::~File_handler() {
-  m_task_queue.shutdown(1);
-  m_aio_worker.join();
+  if (m_aio_worker.joinable()) {
+    m_task_queue.shutdown(1);
+    m_aio_worker.join();
+  }
   m_fh->close();
 }
 
 File_iterator File_handler::begin(size_t needle_size) const {
-  return File_iterator(m_fh.get(), size(), 0, &m_buffer[0], &m_buffer[1],
-                       &m_aio, needle_size, &m_task_queue);
+  return begin(needle_size, 0);
 }
+
 File_iterator File_handler::end(size_t needle_size) const {
-  return File_iterator(m_fh.get(), size(), size(), nullptr, nullptr, nullptr,
-                       needle_size, &m_task_queue);
+  return end(needle_size, size());
+}
+
+File_iterator File_handler::begin(size_t needle_size, size_t offset) const {
+  if (m_mapping) {
+    return File_iterator(m_mapping, size(), offset);
+  }
+  return File_iterator(m_fh.get(), size(), std::min(offset, size()),
+                       &m_buffer[0], &m_buffer[1], &m_aio, needle_size,
+                       &m_task_queue);
+}
+
+File_iterator File_handler::end(size_t needle_size, size_t offset) const {
+  if (m_mapping) {
+    return File_iterator(m_mapping, size(), offset);
+  }
+  return File_iterator(m_fh.get(), size(), std::min(offset, size()), nullptr,
+                       nullptr, nullptr, needle_size, &m_task_queue);
+}
+
+size_t adaptive_chunk_size(const std::vector<double> &rates,
+                           size_t bytes_left) {
+  double total = 0.0;
+  double slowest = 0.0;
+  size_t known = 0;
+
+  for (const auto rate : rates) {
+    if (rate > 0.0) {
+      total += rate;
+      slowest = known > 0 ? std::min(slowest, rate) : rate;
+      ++known;
+    }
+  }
+
+  if (0 == known) {
+    return std::numeric_limits<size_t>::max();
+  }
+
+  // workers which did not report yet are assumed to be average
+  total += (rates.size() - known) * (total / known);
+
+  const double size = bytes_left * slowest / (total * k_tail_fraction);
+
+  return size < static_cast<double>(std::numeric_limits<size_t>::max())
+             ? static_cast<size_t>(size)
+             : std::numeric_limits<size_t>::max();
 }
 
 void Chunk_file::set_chunk_size(const size_t bytes) {
-  constexpr const size_t min_bytes_per_chunk = 2 * BUFFER_SIZE;
-  m_chunk_size = std::max(bytes, min_bytes_per_chunk);
+  m_chunk_size = std::max(bytes, k_min_chunk_size);
 }
 
-void Chunk_file::start() {
+size_t Chunk_file::grain_size() const {
+  return std::max(m_chunk_size / k_grains_per_chunk, k_min_chunk_size);
+}
+
+size_t Chunk_file::next_chunk_size(size_t bytes_left) const {
+  if (!m_chunk_size_policy) {
+    return m_chunk_size;
+  }
+
+  return std::min(std::max(m_chunk_size_policy(bytes_left), k_min_chunk_size),
+                  m_chunk_size);
+}
+
+void Chunk_file::Output_queue::push(Range &&r) {
+  r.file = file;
+
+  if (!merged_size || r.data) {
+    push_range(std::move(r));
+    return;
+  }
+
+  if (pending.begin == pending.end) {
+    pending = std::move(r);
+  } else {
+    assert(pending.end == r.begin);
+    pending.end = r.end;
+  }
+
+  if (pending.end - pending.begin >= merged_size(pending.begin)) {
+    flush();
+  }
+}
+
+void Chunk_file::Output_queue::flush() {
+  if (pending.begin != pending.end) {
+    push_range(std::move(pending));
+    pending = Range{0, 0, nullptr, 0};
+  }
+}
+
+std::vector<size_t> Chunk_file::split_regions(size_t start) const {
   File_handler fh{m_file_path};
 
   if (!fh.is_open()) {
     throw std::runtime_error("Cannot open file '" + m_file_path + "'");
   }
 
+  const size_t file_size = fh.size();
+  std::vector<size_t> regions{start};
+
+  // each region should hold at least couple of chunks, otherwise it is not
+  // worth to spawn a thread for it
+  const size_t min_region_size = 4 * m_chunk_size;
+  const size_t bytes = file_size - std::min(start, file_size);
+  const auto count = static_cast<int64_t>(
+      std::min(static_cast<size_t>(std::max(m_threads, int64_t{1})),
+               std::max(bytes / min_region_size, size_t{1})));
+
+  if (count > 1) {
+    const size_t needle_size = m_dialect.lines_terminated_by.size();
+    auto it = fh.begin(needle_size, start);
+    const auto last = fh.end(needle_size);
+
+    for (int64_t i = 1; i < count; i++) {
+      const size_t split = start + i * (bytes / count);
+      if (split <= regions.back()) {
+        continue;
+      }
+
+      // resync on next unescaped line terminator
+      it.force_offset(split);
+      it = row_boundary(it, last);
+
+      if (it.offset() > regions.back() && it.offset() < file_size) {
+        regions.emplace_back(it.offset());
+      }
+    }
+  }
+
+  regions.emplace_back(file_size);
+  return regions;
+}
+
+void Chunk_file::chunk_in_parallel(const std::vector<size_t> &regions) {
+  const size_t count = regions.size() - 1;
   const size_t needle_size = m_dialect.lines_terminated_by.size();
-  auto first = fh.begin(needle_size);
-  auto last = fh.end(needle_size);
 
-  if (m_dialect.fields_escaped_by.empty()) {
-    if (m_skip_rows_count > 0) {
-      first = skip_rows(first, last, m_dialect.lines_terminated_by,
-                        m_skip_rows_count);
+  // ranges of the subsequent regions are discovered while the preceding ones
+  // are consumed, bounded queues keep only a few of them in memory
+  std::vector<std::unique_ptr<shcore::Bounded_queue<Range>>> queues;
+  std::vector<std::exception_ptr> exceptions(count, nullptr);
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < count; i++) {
+    queues.emplace_back(
+        shcore::make_unique<shcore::Bounded_queue<Range>>(k_region_queue_size));
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    threads.emplace_back([&, i]() {
+      try {
+        File_handler fh{m_file_path};
+
+        if (!fh.is_open()) {
+          throw std::runtime_error("Cannot open file '" + m_file_path + "'");
+        }
+
+        chunk(fh.begin(needle_size, regions[i]),
+              fh.end(needle_size, regions[i + 1]), queues[i].get());
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+      }
+      queues[i]->shutdown(1);
+    });
+  }
+
+  // merge ranges in file order, first region is streamed as soon as ranges
+  // are discovered
+  for (size_t i = 0; i < count; i++) {
+    while (true) {
+      auto r = queues[i]->pop();
+
+      if (r.begin == 0 && r.end == 0) {
+        break;
+      }
+
+      m_queue.push(std::move(r));
     }
-    chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by, m_chunk_size,
-                       m_queue);
-  } else {
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  for (const auto &exc : exceptions) {
+    if (exc) {
+      std::rethrow_exception(exc);
+    }
+  }
+}
+
+void Chunk_file::chunk_stream() {
+  auto fh = make_file_handler(m_file_path, m_read_ahead);
+  fh->open();
+
+  if (!fh->is_open()) {
+    throw std::runtime_error("Cannot open file '" + m_file_path + "'");
+  }
+
+  const auto compressed = dynamic_cast<Compressed_file *>(fh.get());
+  const std::string &needle = m_dialect.lines_terminated_by;
+
+  // number of chunks which were not released by the workers yet
+  struct Pending_chunks {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t count = 0;
+  };
+  const auto pending = std::make_shared<Pending_chunks>();
+
+  std::string data;
+  size_t offset = 0;    // stream offset of data
+  size_t reported = 0;  // compressed bytes already added to the progress
+  bool eof = false;
+
+  const auto read_more = [&]() {
+    const size_t size = data.size();
+    data.resize(size + BUFFER_SIZE);
+    const auto bytes = fh->read(&data[size], BUFFER_SIZE);
+
+    if (bytes < 0) {
+      throw std::runtime_error("Read error");
+    }
+
+    data.resize(size + bytes);
+    eof = bytes == 0;
+
+    if (m_progress && compressed) {
+      // counter can be shared with the other files which are imported
+      const size_t consumed = compressed->compressed_offset();
+      *m_progress += consumed - reported;
+      reported = consumed;
+    }
+  };
+
+  if (m_skip_rows_count > 0) {
+    // skipped rows have to be searched from the beginning of the stream, so
+    // that escape state of the line terminators is known
+    while (true) {
+      const auto it =
+          m_dialect.fields_escaped_by.empty()
+              ? skip_rows(data.begin(), data.end(), needle, m_skip_rows_count)
+              : skip_rows(data.begin(), data.end(), needle, m_skip_rows_count,
+                          m_dialect.fields_escaped_by[0]);
+
+      if (it == data.end() && !eof) {
+        read_more();
+      } else {
+        offset = it - data.begin();
+        data.erase(data.begin(), it);
+        break;
+      }
+    }
+  }
+
+  // size of the decompressed data is not known, number of bytes left is
+  // estimated using the compression ratio observed so far
+  const size_t compressed_size = compressed ? fh->file_size() : 0;
+  const auto bytes_left = [&]() -> size_t {
+    const size_t consumed = compressed ? compressed->compressed_offset() : 0;
+
+    if (0 == consumed) {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    const double ratio = static_cast<double>(offset + data.size()) / consumed;
+    return data.size() +
+           static_cast<size_t>(
+               (compressed_size - std::min(consumed, compressed_size)) * ratio);
+  };
+
+  while (true) {
+    const size_t chunk_size = next_chunk_size(bytes_left());
+
+    while (data.size() < chunk_size && !eof) {
+      read_more();
+    }
+
+    if (data.empty()) {
+      break;
+    }
+
+    size_t cut = data.size();
+
+    if (data.size() >= chunk_size) {
+      size_t search_from = chunk_size;
+
+      while (true) {
+        const auto it = row_boundary(data.begin() + search_from, data.end());
+
+        if (it != data.end() || eof) {
+          cut = it - data.begin();
+          break;
+        }
+
+        // row does not fit, continue search in the new data
+        search_from = std::max(search_from, data.size() - needle.size());
+        read_more();
+      }
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(pending->mutex);
+
+      while (!pending->cv.wait_for(
+          lock, std::chrono::milliseconds(100),
+          [&]() { return pending->count < m_max_pending_chunks; })) {
+        if (m_stop && m_stop()) {
+          return;
+        }
+      }
+
+      ++pending->count;
+    }
+
+    // move data to the chunk, remainder goes back to the buffer
+    std::unique_ptr<std::string> chunk_data{new std::string()};
+    chunk_data->swap(data);
+    data.assign(*chunk_data, cut, std::string::npos);
+    chunk_data->resize(cut);
+
+    std::shared_ptr<const std::string> chunk{
+        chunk_data.release(), [pending](const std::string *p) {
+          delete p;
+          {
+            std::lock_guard<std::mutex> lock(pending->mutex);
+            --pending->count;
+          }
+          pending->cv.notify_one();
+        }};
+
+    m_queue.push(Range{offset, offset + cut, std::move(chunk)});
+    offset += cut;
+  }
+}
+
+void Chunk_file::start() {
+  if (compression_from_path(m_file_path) != Compression::None) {
+    chunk_stream();
+    return;
+  }
+
+  std::vector<size_t> regions;
+
+  {
+    File_handler fh{m_file_path};
+
+    if (!fh.is_open()) {
+      throw std::runtime_error("Cannot open file '" + m_file_path + "'");
+    }
+
+    const size_t needle_size = m_dialect.lines_terminated_by.size();
+    auto first = fh.begin(needle_size);
+    auto last = fh.end(needle_size);
+
     if (m_skip_rows_count > 0) {
-      first = skip_rows(first, last, m_dialect.lines_terminated_by,
-                        m_skip_rows_count, m_dialect.fields_escaped_by[0]);
+      if (m_dialect.fields_escaped_by.empty()) {
+        first = skip_rows(first, last, m_dialect.lines_terminated_by,
+                          m_skip_rows_count);
+      } else {
+        first = skip_rows(first, last, m_dialect.lines_terminated_by,
+                          m_skip_rows_count, m_dialect.fields_escaped_by[0]);
+      }
+    }
+
+    if (m_chunk_size_policy) {
+      const size_t file_size = fh.size();
+      m_queue.merged_size = [this, file_size](size_t offset) {
+        return next_chunk_size(file_size - std::min(offset, file_size));
+      };
+    }
+
+    if (m_threads > 1) {
+      regions = split_regions(first.offset());
+    }
+
+    if (regions.size() <= 2) {
+      chunk(first, last, &m_queue);
     }
-    chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by,
-                       m_dialect.fields_escaped_by[0], m_chunk_size, m_queue);
   }
+
+  if (regions.size() > 2) {
+    log_debug("Chunking file '%s' in %zu regions", m_file_path.c_str(),
+              regions.size() - 1);
+    chunk_in_parallel(regions);
+  }
+
+  m_queue.flush();
+  m_queue.merged_size = nullptr;
 }
 
 }  // namespace import_table
@@ -24,17 +24,21 @@
 #ifndef MODULES_UTIL_IMPORT_TABLE_CHUNK_FILE_H_
 #define MODULES_UTIL_IMPORT_TABLE_CHUNK_FILE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "modules/util/import_table/dialect.h"
 #include "modules/util/import_table/file_backends/ifile.h"
 #include "modules/util/import_table/helpers.h"
+#include "mysqlshdk/libs/utils/bounded_queue.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 
 namespace mysqlsh {
@@ -108,7 +112,14 @@ class File_iterator final {
   File_iterator(IFile *file_descriptor, size_t file_size,
                 size_t start_from_offset, Buffer *current_buffer,
                 Buffer *next_buffer, Async_read_task *aio, size_t needle_size,
-                shcore::Synchronized_queue<Async_read_task *> *task_queue);
+                shcore::Bounded_queue<Async_read_task *> *task_queue);
+
+
+  /**
+   * Creates iterator over file mapped into memory. No buffers are used.
+   */
+  File_iterator(const uint8_t *mapping, size_t file_size,
+                size_t start_from_offset);
 
   File_iterator(const File_iterator &other) = default;
   File_iterator(File_iterator &&other) = default;
@@ -158,7 +169,32 @@ class File_iterator final {
    *
    * @return File offset.
    */
-  size_t offset() { return m_offset; }
+  size_t offset() const { return m_offset; }
+
+  /**
+   * Pointer to the byte iterator points to.
+   */
+  const uint8_t *data() const { return m_ptr; }
+
+  /**
+   * Number of bytes that can be accessed through data() without crossing
+   * current buffer boundary.
+   */
+  size_t available() const {
+    return m_ptr < m_ptr_end ? static_cast<size_t>(m_ptr_end - m_ptr) : 0;
+  }
+
+  /**
+   * Advance iterator by count bytes within current buffer. Buffer boundaries
+   * are not crossed, count must be lower than available().
+   *
+   * @param count Number of bytes to skip.
+   */
+  void skip(size_t count) {
+    assert(count < available());
+    m_ptr += count;
+    m_offset += count;
+  }
 
   /**
    * Set iterator to file offset.
@@ -172,14 +208,15 @@ class File_iterator final {
  private:
   Buffer *m_current = nullptr;
   Buffer *m_next = nullptr;
-  uint8_t *m_ptr = nullptr;
-  uint8_t *m_ptr_end = nullptr;
+  const uint8_t *m_mapping = nullptr;  //< Whole file, if it is mapped
+  const uint8_t *m_ptr = nullptr;
+  const uint8_t *m_ptr_end = nullptr;
   size_t m_offset = 0;  //< Global file offset where m_ptr points
   IFile *m_fh = nullptr;
   size_t m_file_size = 0;
   Async_read_task *m_aio{};
   bool m_eof = false;
-  shcore::Synchronized_queue<Async_read_task *> *m_task_queue = nullptr;
+  shcore::Bounded_queue<Async_read_task *> *m_task_queue = nullptr;
 
   /**
    * Enqueue task that reads data from file offset to next buffer.
@@ -209,7 +246,8 @@ class File_iterator final {
 };
 
 /**
- * Asynchronous double buffered file reader.
+ * Asynchronous double buffered file reader. Files which are mapped into memory
+ * are accessed directly, without buffering.
  */
 class File_handler final {
  public:
@@ -231,11 +269,23 @@ class File_handler final {
   File_iterator begin(size_t needle_size) const;
   File_iterator end(size_t needle_size) const;
 
+  /**
+   * Iterator pointing to the given file offset.
+   */
+  File_iterator begin(size_t needle_size, size_t offset) const;
+
+  /**
+   * End iterator of the range which ends at the given file offset.
+   */
+  File_iterator end(size_t needle_size, size_t offset) const;
+
  private:
+  const uint8_t *m_mapping = nullptr;
   mutable Buffer m_buffer[2];  //< Double buffer
   mutable Async_read_task m_aio{};
   mutable std::thread m_aio_worker;
-  mutable shcore::Synchronized_queue<Async_read_task *> m_task_queue;
+  // at most one read request is in flight
+  mutable shcore::Bounded_queue<Async_read_task *> m_task_queue{2};
   std::unique_ptr<IFile> m_fh;
   size_t m_file_size = 0;
 };
@@ -243,6 +293,15 @@ class File_handler final {
 struct Range {
   size_t begin;
   size_t end;
+  /**
+   * Contents of the range, set only if workers cannot access the file
+   * randomly (i.e. it is compressed).
+   */
+  std::shared_ptr<const std::string> data;
+  /**
+   * Index of the file the range belongs to, if multiple files are imported.
+   */
+  size_t file;
 };
 
 /**
@@ -327,6 +386,25 @@ ForwardIt find(ForwardIt first, ForwardIt last, ForwardIt2 needle_first,
   }
 }
 
+/**
+ * Searches for the first occurrence of the sequence of elements [needle_first,
+ * needle_last) in the range [first, last). Specialization for File_iterator
+ * which scans whole buffer blocks for the first needle byte with vectorized
+ * find_byte() instead of visiting each byte separately.
+ *
+ * @param first Iterator to the first element of range to examine.
+ * @param last Iterator to the last element of range to examine.
+ * @param needle_first Iterator to first element of range to search for.
+ * @param needle_last Iterator to last element of range to search for.
+ * @return Returns one past first element from range [first, last) that
+ * satisfies search criteria, with character before matching needle and boolean
+ * flag indicating if needle was found.
+ */
+File_iterator find(File_iterator first, File_iterator last,
+                   std::string::const_iterator needle_first,
+                   std::string::const_iterator needle_last,
+                   Find_context<File_iterator::value_type> *context);
+
 /**
  * Skip count lines/rows delimited by needle.
  *
@@ -393,6 +471,70 @@ Iter skip_rows(Iter first, Iter last, const std::string &needle,
   return first;
 }
 
+/**
+ * Searches for the first line terminator in [first, last) which is not escaped
+ * and whose escape state is known, i.e. first position where a new row can
+ * start.
+ *
+ * @tparam Iter Forward iterator.
+ * @param first Iterator to first element in range.
+ * @param last Iterator to last element in range.
+ * @param needle Line terminator string.
+ * @param escape_char Escape character.
+ * @return Returns iterator to the element following line terminator or last.
+ */
+template <typename Iter>
+Iter find_row_boundary(Iter first, Iter last, const std::string &needle,
+                       char escape_char) {
+  Find_context<typename Iter::value_type> context{};
+
+  first = find(first, last, needle.begin(), needle.end(), &context);
+
+  // needle found, but is escaped or escape state is unknown
+  auto escaped = [&]() -> bool {
+    return context.needle_found &&
+           ((context.preceding_element_set &&
+             context.preceding_element == escape_char) ||
+            (!context.preceding_element_set));
+  };
+
+  while (escaped()) {
+    context.preceding_element_set = true;
+    context.preceding_element = context.last_element;
+    first = find(first, last, needle.begin(), needle.end(), &context);
+  }
+
+  return first;
+}
+
+/**
+ * Searches for the first line terminator in [first, last) whose escape state
+ * is known, i.e. first position where a new row can start.
+ *
+ * @tparam Iter Forward iterator.
+ * @param first Iterator to first element in range.
+ * @param last Iterator to last element in range.
+ * @param needle Line terminator string.
+ * @return Returns iterator to the element following line terminator or last.
+ */
+template <typename Iter>
+Iter find_row_boundary(Iter first, Iter last, const std::string &needle) {
+  Find_context<typename Iter::value_type> context{};
+
+  first = find(first, last, needle.begin(), needle.end(), &context);
+
+  // needle found, but escape state is unknown
+  auto escaped = [&]() -> bool {
+    return context.needle_found && !context.preceding_element_set;
+  };
+
+  while (escaped()) {
+    first = find(first, last, needle.begin(), needle.end(), &context);
+  }
+
+  return first;
+}
+
 /**
  * Fill QueueContainer with file chunks offset that are roughly
  * max_bytes_per_chunk in size.
@@ -418,25 +560,8 @@ void chunk_by_max_bytes(Iter first, Iter last, const std::string &needle,
   while (first != last) {
     const size_t prev_offset = current_offset;
     const size_t next_offset = current_offset + max_bytes_per_chunk;
-    first.force_offset(next_offset);
-    Find_context<typename Iter::value_type> context{};
-
-    first = find(first, last, needle.begin(), needle.end(), &context);
-
-    // needle found, but is escaped or escape state is unknown
-    auto escaped = [&]() -> bool {
-      return context.needle_found &&
-             ((context.preceding_element_set &&
-               context.preceding_element == escape_char) ||
-              (!context.preceding_element_set));
-    };
-
-    while (escaped()) {
-      context.preceding_element_set = true;
-      context.preceding_element = context.last_element;
-      first = find(first, last, needle.begin(), needle.end(), &context);
-    }
-
+    first.force_offset(std::min(next_offset, last.offset()));
+    first = find_row_boundary(first, last, needle, escape_char);
     current_offset = first.offset();
     range_queue->push(Range{prev_offset, current_offset});
   }
@@ -466,25 +591,28 @@ void chunk_by_max_bytes(Iter first, Iter last, const std::string &needle,
   while (first != last) {
     size_t prev_offset = current_offset;
     const size_t next_offset = current_offset + max_bytes_per_chunk;
-    first.force_offset(next_offset);
-    Find_context<typename Iter::value_type> context{};
-
-    first = find(first, last, needle.begin(), needle.end(), &context);
-
-    // needle found, but escape state is unknown
-    auto escaped = [&]() -> bool {
-      return context.needle_found && !context.preceding_element_set;
-    };
-
-    while (escaped()) {
-      first = find(first, last, needle.begin(), needle.end(), &context);
-    }
-
+    first.force_offset(std::min(next_offset, last.offset()));
+    first = find_row_boundary(first, last, needle);
     current_offset = first.offset();
     range_queue->push(Range{prev_offset, current_offset});
   }
 }
 
+/**
+ * Computes size of the next chunk, so that all workers finish loading at
+ * approximately the same time. Chunks shrink as the end of the file
+ * approaches (guided self-scheduling), while the slowest worker should still
+ * be able to load its chunk in half of the estimated remaining time.
+ *
+ * @param rates Load rate of each worker, 0 if it is not known.
+ * @param bytes_left Number of bytes not assigned to any chunk yet.
+ *
+ * @return Size of the next chunk in bytes, maximum value of size_t if none of
+ * the rates is known.
+ */
+size_t adaptive_chunk_size(const std::vector<double> &rates,
+                           size_t bytes_left);
+
 class Chunk_file final {
  public:
   Chunk_file() = default;
@@ -500,17 +628,162 @@ class Chunk_file final {
   void set_file_path(const std::string &path) { m_file_path = path; }
   void set_dialect(const Dialect &dialect) { m_dialect = dialect; }
   void set_rows_to_skip(const size_t rows) { m_skip_rows_count = rows; }
+
+  /**
+   * Index of the chunked file, emitted ranges are marked with it.
+   */
+  void set_file_index(const size_t index) { m_queue.file = index; }
+
   void set_output_queue(shcore::Synchronized_queue<Range> *queue) {
-    m_queue = queue;
+    m_queue.push_range = [queue](Range &&r) { queue->push(std::move(r)); };
+  }
+
+  /**
+   * Bounded output queue, chunking waits while it is full. Consumers must run
+   * concurrently with start().
+   */
+  void set_output_queue(shcore::Bounded_queue<Range> *queue) {
+    m_queue.push_range = [queue](Range &&r) { queue->push(std::move(r)); };
+  }
+
+  /**
+   * Function which receives the ranges, called by the thread which runs
+   * start().
+   */
+  void set_output(const std::function<void(Range &&)> &push) {
+    m_queue.push_range = push;
   }
+
+  /**
+   * Number of threads used to discover chunk boundaries. File is split into
+   * regions which are chunked concurrently, ranges are emitted to the output
+   * queue in file order.
+   */
+  void set_threads(const int64_t threads) { m_threads = threads; }
+
+  /**
+   * Compressed files are decompressed by a single thread into in-memory
+   * chunks, at most this many chunks can wait for the workers.
+   */
+  void set_max_pending_chunks(const size_t chunks) {
+    m_max_pending_chunks = std::max(chunks, size_t{1});
+  }
+
+  /**
+   * Counter updated with number of compressed bytes consumed so far.
+   */
+  void set_progress(std::atomic<size_t> *bytes) { m_progress = bytes; }
+
+  /**
+   * Condition checked while waiting for the workers to consume pending
+   * chunks, chunking stops when it is true.
+   */
+  void set_stop_condition(const std::function<bool()> &stop) { m_stop = stop; }
+
+  /**
+   * Maximum amount of data fetched ahead when a remote file is read as a
+   * stream.
+   */
+  void set_read_ahead(const size_t bytes) { m_read_ahead = bytes; }
+
+  /**
+   * Makes the chunk size adaptive. Function is given the (estimated) number of
+   * bytes which were not assigned to any chunk yet and returns the size of the
+   * next chunk, which is capped by the size set with set_chunk_size().
+   *
+   * Row boundaries are then searched using a finer granularity and the
+   * resulting ranges are merged until they reach the requested size, so that
+   * the size is chosen when the range is emitted, not when it is discovered.
+   */
+  void set_chunk_size_policy(const std::function<size_t(size_t)> &policy) {
+    m_chunk_size_policy = policy;
+  }
+
   void start();
 
  private:
+  /**
+   * Splits [start, file size) into regions starting at row boundaries.
+   *
+   * @return Offsets of region boundaries, first one is start and last one is
+   * file size.
+   */
+  std::vector<size_t> split_regions(size_t start) const;
+
+  template <typename Iter>
+  Iter row_boundary(Iter first, Iter last) const {
+    if (m_dialect.fields_escaped_by.empty()) {
+      return find_row_boundary(first, last, m_dialect.lines_terminated_by);
+    }
+    return find_row_boundary(first, last, m_dialect.lines_terminated_by,
+                             m_dialect.fields_escaped_by[0]);
+  }
+
+  template <typename Iter, class QueueContainer>
+  void chunk(Iter first, Iter last, QueueContainer *queue) const {
+    const size_t size = m_chunk_size_policy ? grain_size() : m_chunk_size;
+
+    if (m_dialect.fields_escaped_by.empty()) {
+      chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by, size,
+                         queue);
+    } else {
+      chunk_by_max_bytes(first, last, m_dialect.lines_terminated_by,
+                         m_dialect.fields_escaped_by[0], size, queue);
+    }
+  }
+
+  void chunk_in_parallel(const std::vector<size_t> &regions);
+
+  /**
+   * Granularity of the row boundary search if chunk size is adaptive.
+   */
+  size_t grain_size() const;
+
+  /**
+   * Size of the next chunk, given number of bytes which were not assigned to
+   * any chunk yet.
+   */
+  size_t next_chunk_size(size_t bytes_left) const;
+
+  /**
+   * Output queue of either supported type.
+   */
+  struct Output_queue {
+    std::function<void(Range &&)> push_range;
+
+    /**
+     * If set, contiguous ranges are merged until they reach the size returned
+     * by this function, which is given the offset of the merged range.
+     */
+    std::function<size_t(size_t)> merged_size;
+
+    size_t file = 0;
+    Range pending{0, 0, nullptr, 0};
+
+    void push(Range &&r);
+
+    /**
+     * Emits the range which is being merged.
+     */
+    void flush();
+  };
+
+  /**
+   * Reads file sequentially and emits ranges holding their data.
+   */
+  void chunk_stream();
+
   size_t m_chunk_size = 2 * BUFFER_SIZE;
+  int64_t m_threads = 1;
+  size_t m_max_pending_chunks = 1;
+  std::atomic<size_t> *m_progress = nullptr;
+  std::function<bool()> m_stop;
+  std::function<size_t(size_t)> m_chunk_size_policy;
   std::string m_file_path;
+  size_t m_read_ahead = 0;
   Dialect m_dialect;
   uint64_t m_skip_rows_count = 0;
-  shcore::Synchronized_queue<Range> *m_queue = nullptr;
+  Output_queue m_queue;
 };
 
 }  // namespace import_table
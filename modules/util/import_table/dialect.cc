@@ -108,6 +108,23 @@ Dialect Dialect::csv_unix() {
   return dialect;
 }
 
+Dialect Dialect::from_name(const std::string &name) {
+  if (name.empty() || shcore::str_caseeq(name, "default")) {
+    return default_();
+  } else if (shcore::str_caseeq(name, "csv")) {
+    return csv();
+  } else if (shcore::str_caseeq(name, "tsv")) {
+    return tsv();
+  } else if (shcore::str_caseeq(name, "json")) {
+    return json();
+  } else if (shcore::str_caseeq(name, "csv-unix")) {
+    return csv_unix();
+  }
+
+  throw std::invalid_argument(
+      "dialect value must be csv, tsv, json or csv-unix.");
+}
+
 std::string Dialect::build_sql() {
   using sqlstring = shcore::sqlstring;
   std::string sql =
@@ -80,6 +80,12 @@ struct Dialect {
    * (comma-separated values) file format.
    */
   static Dialect csv_unix();
+
+  /**
+   * Returns dialect with the given name: default, csv, tsv, json or csv-unix.
+   * Empty name selects the default dialect.
+   */
+  static Dialect from_name(const std::string &name);
 };
 
 }  // namespace import_table
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/import_table/file_backends/compressed_file.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "modules/util/import_table/helpers.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+/**
+ * Streaming decompressor.
+ */
+class Compressed_file::Decompressor {
+ public:
+  virtual ~Decompressor() = default;
+
+  /**
+   * Decompresses data from [*in, in_end) to [*out, out_end), advances both
+   * pointers.
+   *
+   * @return true if end of compressed stream was reached.
+   */
+  virtual bool decompress(const char **in, const char *in_end, char **out,
+                          char *out_end) = 0;
+};
+
+namespace {
+
+#ifdef HAVE_ZLIB
+class Gzip_decompressor final : public Compressed_file::Decompressor {
+ public:
+  Gzip_decompressor() {
+    // 32 enables automatic detection of gzip and zlib headers
+    if (inflateInit2(&m_stream, 15 + 32) != Z_OK) {
+      throw std::runtime_error("Failed to initialize gzip decompression");
+    }
+  }
+
+  ~Gzip_decompressor() override { inflateEnd(&m_stream); }
+
+  bool decompress(const char **in, const char *in_end, char **out,
+                  char *out_end) override {
+    m_stream.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(*in));  // NOLINT
+    m_stream.avail_in = static_cast<uInt>(in_end - *in);
+    m_stream.next_out = reinterpret_cast<Bytef *>(*out);
+    m_stream.avail_out = static_cast<uInt>(out_end - *out);
+
+    const int ret = inflate(&m_stream, Z_NO_FLUSH);
+
+    *in = in_end - m_stream.avail_in;
+    *out = out_end - m_stream.avail_out;
+
+    if (ret == Z_STREAM_END) {
+      // concatenated gzip members are allowed
+      inflateReset(&m_stream);
+      return true;
+    }
+
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw std::runtime_error(
+          std::string{"gzip decompression failed: "} +
+          (m_stream.msg ? m_stream.msg : std::to_string(ret)));
+    }
+
+    return false;
+  }
+
+ private:
+  z_stream m_stream{};
+};
+#endif  // HAVE_ZLIB
+
+#ifdef HAVE_ZSTD
+class Zstd_decompressor final : public Compressed_file::Decompressor {
+ public:
+  Zstd_decompressor() : m_stream(ZSTD_createDStream()) {
+    if (!m_stream || ZSTD_isError(ZSTD_initDStream(m_stream))) {
+      ZSTD_freeDStream(m_stream);
+      throw std::runtime_error("Failed to initialize zstd decompression");
+    }
+  }
+
+  ~Zstd_decompressor() override { ZSTD_freeDStream(m_stream); }
+
+  bool decompress(const char **in, const char *in_end, char **out,
+                  char *out_end) override {
+    ZSTD_inBuffer input{*in, static_cast<size_t>(in_end - *in), 0};
+    ZSTD_outBuffer output{*out, static_cast<size_t>(out_end - *out), 0};
+
+    // multiple frames are decoded one after another
+    const size_t ret = ZSTD_decompressStream(m_stream, &output, &input);
+
+    if (ZSTD_isError(ret)) {
+      throw std::runtime_error(std::string{"zstd decompression failed: "} +
+                               ZSTD_getErrorName(ret));
+    }
+
+    *in += input.pos;
+    *out += output.pos;
+    return ret == 0;
+  }
+
+ private:
+  ZSTD_DStream *m_stream;
+};
+#endif  // HAVE_ZSTD
+
+std::unique_ptr<Compressed_file::Decompressor> make_decompressor(
+    Compression compression, const std::string &filename) {
+  switch (compression) {
+    case Compression::Gzip:
+#ifdef HAVE_ZLIB
+      return shcore::make_unique<Gzip_decompressor>();
+#else
+      throw std::runtime_error("Cannot read '" + filename +
+                               "', gzip compression is not supported.");
+#endif
+
+    case Compression::Zstd:
+#ifdef HAVE_ZSTD
+      return shcore::make_unique<Zstd_decompressor>();
+#else
+      throw std::runtime_error("Cannot read '" + filename +
+                               "', zstd compression is not supported.");
+#endif
+
+    case Compression::None:
+      break;
+  }
+
+  throw std::logic_error("Unknown compression");
+}
+
+}  // namespace
+
+Compression compression_from_path(const std::string &filepath) {
+  if (shcore::str_iendswith(filepath, ".gz")) {
+    return Compression::Gzip;
+  } else if (shcore::str_iendswith(filepath, ".zst")) {
+    return Compression::Zstd;
+  }
+  return Compression::None;
+}
+
+std::string strip_compression_extension(const std::string &filepath) {
+  switch (compression_from_path(filepath)) {
+    case Compression::Gzip:
+      return filepath.substr(0, filepath.length() - 3);
+    case Compression::Zstd:
+      return filepath.substr(0, filepath.length() - 4);
+    case Compression::None:
+      break;
+  }
+  return filepath;
+}
+
+Compressed_file::Compressed_file(std::unique_ptr<IFile> file,
+                                 Compression compression)
+    : m_file(std::move(file)), m_compression(compression) {
+  assert(m_file);
+}
+
+Compressed_file::~Compressed_file() = default;
+
+void Compressed_file::open() {
+  m_file->open();
+
+  if (m_file->is_open()) {
+    m_decompressor = make_decompressor(m_compression, m_file->file_name());
+    m_input.resize(BUFFER_SIZE);
+    m_input_begin = m_input_end = 0;
+    m_input_eof = false;
+    m_stream_end = false;
+    m_position = 0;
+    m_compressed_offset = 0;
+  }
+}
+
+bool Compressed_file::is_open() { return m_file->is_open(); }
+
+void Compressed_file::close() {
+  m_decompressor.reset();
+  m_file->close();
+}
+
+size_t Compressed_file::file_size() { return m_file->file_size(); }
+
+std::string Compressed_file::file_name() { return m_file->file_name(); }
+
+off64_t Compressed_file::seek(off64_t offset) {
+  if (offset < 0) {
+    return static_cast<off64_t>(-1);
+  }
+
+  const auto target = static_cast<size_t>(offset);
+
+  if (target < m_position) {
+    close();
+    open();
+
+    if (!is_open()) {
+      return static_cast<off64_t>(-1);
+    }
+  }
+
+  char discard[BUFFER_SIZE];
+
+  while (m_position < target) {
+    const auto bytes =
+        read(discard, std::min(sizeof(discard), target - m_position));
+
+    if (bytes <= 0) {
+      return static_cast<off64_t>(-1);
+    }
+  }
+
+  return offset;
+}
+
+ssize_t Compressed_file::read(void *buffer, size_t length) {
+  assert(m_decompressor);
+  char *out = static_cast<char *>(buffer);
+  char *const out_end = out + length;
+
+  while (out == static_cast<char *>(buffer) && length > 0) {
+    if (m_input_begin == m_input_end && !m_input_eof) {
+      const auto bytes = m_file->read(m_input.data(), m_input.size());
+
+      if (bytes < 0) {
+        return bytes;
+      }
+
+      m_input_begin = 0;
+      m_input_end = static_cast<size_t>(bytes);
+      m_input_eof = bytes == 0;
+    }
+
+    if (m_input_begin == m_input_end && m_input_eof) {
+      if (!m_stream_end) {
+        throw std::runtime_error("Unexpected end of compressed file '" +
+                                 m_file->file_name() + "'");
+      }
+      break;
+    }
+
+    const char *in = m_input.data() + m_input_begin;
+    m_stream_end = m_decompressor->decompress(
+        &in, m_input.data() + m_input_end, &out, out_end);
+    const auto consumed = static_cast<size_t>(in - m_input.data());
+    m_compressed_offset += consumed - m_input_begin;
+    m_input_begin = consumed;
+  }
+
+  const auto bytes = static_cast<size_t>(out - static_cast<char *>(buffer));
+  m_position += bytes;
+  return static_cast<ssize_t>(bytes);
+}
+
+}  // namespace import_table
+}  // namespace mysqlsh
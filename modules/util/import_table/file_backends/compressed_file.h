@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_COMPRESSED_FILE_H_
+#define MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_COMPRESSED_FILE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/util/import_table/file_backends/ifile.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+enum class Compression { None, Gzip, Zstd };
+
+/**
+ * Detects compression of the file using its extension.
+ */
+Compression compression_from_path(const std::string &filepath);
+
+/**
+ * Removes compression extension from the file path, if there is one.
+ */
+std::string strip_compression_extension(const std::string &filepath);
+
+/**
+ * Decompressing decorator of IFile. Data can be only read sequentially,
+ * seeking is emulated by decompressing and discarding data, seeking backwards
+ * restarts decompression from the beginning of the file.
+ */
+class Compressed_file : public IFile {
+ public:
+  Compressed_file() = delete;
+  Compressed_file(std::unique_ptr<IFile> file, Compression compression);
+  Compressed_file(const Compressed_file &other) = delete;
+  Compressed_file(Compressed_file &&other) = delete;
+
+  Compressed_file &operator=(const Compressed_file &other) = delete;
+  Compressed_file &operator=(Compressed_file &&other) = delete;
+
+  ~Compressed_file() override;
+
+  void open() override;
+  bool is_open() override;
+  void close() override;
+
+  /**
+   * Size of the compressed file, size of decompressed data is not known until
+   * the whole file is read.
+   */
+  size_t file_size() override;
+  std::string file_name() override;
+  off64_t seek(off64_t offset) override;
+  ssize_t read(void *buffer, size_t length) override;
+
+  /**
+   * Number of compressed bytes consumed so far.
+   */
+  size_t compressed_offset() const { return m_compressed_offset; }
+
+  class Decompressor;
+
+ private:
+  std::unique_ptr<IFile> m_file;
+  Compression m_compression;
+  std::unique_ptr<Decompressor> m_decompressor;
+  std::vector<char> m_input;
+  size_t m_input_begin = 0;
+  size_t m_input_end = 0;
+  bool m_input_eof = false;
+  bool m_stream_end = false;  //< Last decompressed byte ended the stream
+  size_t m_position = 0;
+  size_t m_compressed_offset = 0;
+};
+
+}  // namespace import_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_COMPRESSED_FILE_H_
@@ -53,6 +53,9 @@ class File : public IFile {
   off64_t seek(off64_t offset) override;
   ssize_t read(void *buffer, size_t length) override;
 
+ protected:
+  int fd() const { return m_fd; }
+
  private:
   int m_fd = -1;
   std::string m_filepath;
@@ -37,10 +37,21 @@ using Response = mysqlshdk::rest::Response;
 namespace mysqlsh {
 namespace import_table {
 
-Http_get::Http_get(const std::string &uri) : m_uri(uri) {
-  m_rest = shcore::make_unique<Rest_service>(m_uri, true);
-  m_rest->set_timeout(30000);  // todo(kg): default 2s was not enough, 30s is
-                               // ok? maybe we could make it configurable
+namespace {
+
+std::unique_ptr<Rest_service> make_rest_service(const std::string &uri) {
+  auto rest = shcore::make_unique<Rest_service>(uri, true);
+  rest->set_timeout(30000);  // todo(kg): default 2s was not enough, 30s is
+                             // ok? maybe we could make it configurable
+  // read ahead threads and the reader share the connections
+  rest->set_connection_pool(Range_reader::k_read_ahead_threads + 1);
+  return rest;
+}
+
+}  // namespace
+
+Http_get::Http_get(const std::string &uri, size_t read_ahead) : m_uri(uri) {
+  m_rest = make_rest_service(m_uri);
   auto response = m_rest->head(std::string{});
   if (response.status == Response::Status_code::OK) {
     m_file_size = std::stoul(response.headers["content-length"]);
@@ -52,54 +63,35 @@ Http_get::Http_get(const std::string &uri) : m_uri(uri) {
   } else {
     throw std::runtime_error(Response::status_code(response.status));
   }
+
+  const auto rest = m_rest.get();
+  m_reader = shcore::make_unique<Range_reader>(
+      m_file_size,
+      [rest](size_t begin, size_t end) {
+        return http_get_range(rest, std::string{}, {}, begin, end);
+      },
+      read_ahead);
 }
 
-void Http_get::open() { m_offset = 0; }
+void Http_get::open() { m_reader->seek(0); }
 
 bool Http_get::is_open() {
   return m_open_status_code == Response::Status_code::OK;
 }
 
-void Http_get::close() {}
+void Http_get::close() { m_reader->reset(); }
 
 size_t Http_get::file_size() { return m_file_size; }
 
 std::string Http_get::file_name() { return m_uri; }
 
-off64_t Http_get::seek(off64_t offset) {
-  const off64_t fsize = file_size();
-  m_offset = std::min(offset, fsize);
-  return m_offset;
-}
+off64_t Http_get::seek(off64_t offset) { return m_reader->seek(offset); }
 
 ssize_t Http_get::read(void *buffer, size_t length) {
-  if (!(length > 0)) return 0;
-  const off64_t fsize = file_size();
-  if (m_offset >= fsize) return 0;
-
-  const size_t first = m_offset;
-  const size_t last_unbounded = m_offset + length - 1;
-  // http range request is both sides inclusive
-  const size_t last = std::min(file_size() - 1, last_unbounded);
-  const std::string range =
-      "bytes=" + std::to_string(first) + "-" + std::to_string(last);
-  Headers h{{"range", range}};
-
-  auto response = m_rest->get(std::string{}, h);
-  if (Response::Status_code::PARTIAL_CONTENT == response.status) {
-    const auto &content = response.body.get_string();
-    std::copy(content.data(), content.data() + content.size(),
-              reinterpret_cast<uint8_t *>(buffer));
-    m_offset += content.size();
-    return content.size();
-  } else if (Response::Status_code::OK == response.status) {
-    throw std::runtime_error("Range requests are not supported.");
-  } else if (Response::Status_code::RANGE_NOT_SATISFIABLE == response.status) {
-    throw std::runtime_error("Range request " + std::to_string(first) + "-" +
-                             std::to_string(last) + " is out of bounds.");
-  }
-  return 0;
+  return m_reader->read(buffer, length);
 }
 
+void Http_get::advise_read_end(off64_t end) { m_reader->advise_read_end(end); }
+
 }  // namespace import_table
 }  // namespace mysqlsh
@@ -28,6 +28,7 @@
 #include <string>
 
 #include "modules/util/import_table/file_backends/ifile.h"
+#include "modules/util/import_table/file_backends/range_reader.h"
 #include "mysqlshdk/libs/rest/rest_service.h"
 
 namespace mysqlsh {
@@ -36,7 +37,12 @@ namespace import_table {
 class Http_get : public IFile {
  public:
   Http_get() = delete;
-  explicit Http_get(const std::string &uri);
+  /**
+   * @param uri URI of the file.
+   * @param read_ahead Maximum amount of data fetched ahead of the reader, 0
+   *        disables read ahead.
+   */
+  explicit Http_get(const std::string &uri, size_t read_ahead = 0);
   Http_get(const Http_get &other) = delete;
   Http_get(Http_get &&other) = default;
 
@@ -53,10 +59,11 @@ class Http_get : public IFile {
   std::string file_name() override;
   off64_t seek(off64_t offset) override;
   ssize_t read(void *buffer, size_t length) override;
+  void advise_read_end(off64_t end) override;
 
  private:
   std::unique_ptr<mysqlshdk::rest::Rest_service> m_rest;
-  off64_t m_offset = 0;
+  std::unique_ptr<Range_reader> m_reader;
   mysqlshdk::rest::Response::Status_code m_open_status_code;
   size_t m_file_size = 0;
   std::string m_uri;
@@ -23,8 +23,10 @@
 
 #include "modules/util/import_table/file_backends/ifile.h"
 
+#include "modules/util/import_table/file_backends/compressed_file.h"
 #include "modules/util/import_table/file_backends/file.h"
 #include "modules/util/import_table/file_backends/http.h"
+#include "modules/util/import_table/file_backends/mmap_file.h"
 #include "modules/util/import_table/file_backends/oci_object_storage.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
@@ -33,15 +35,38 @@
 namespace mysqlsh {
 namespace import_table {
 
-std::unique_ptr<IFile> make_file_handler(const std::string &filepath) {
+namespace {
+
+std::unique_ptr<IFile> make_raw_file_handler(const std::string &filepath,
+                                             size_t read_ahead) {
   if (shcore::str_beginswith(filepath, "oci+os://")) {
-    return shcore::make_unique<Oci_object_storage>(filepath);
+    return shcore::make_unique<Oci_object_storage>(filepath, read_ahead);
   } else if (shcore::str_beginswith(filepath, "http://") ||
              shcore::str_beginswith(filepath, "https://")) {
-    return shcore::make_unique<Http_get>(filepath);
+    return shcore::make_unique<Http_get>(filepath, read_ahead);
   }
   // implicit file://
-  return shcore::make_unique<File>(filepath);
+  return shcore::make_unique<Mmap_file>(filepath);
+}
+
+}  // namespace
+
+std::unique_ptr<IFile> make_file_handler(const std::string &filepath,
+                                         size_t read_ahead) {
+  const auto compression = compression_from_path(filepath);
+
+  if (compression != Compression::None) {
+    return shcore::make_unique<Compressed_file>(
+        make_raw_file_handler(filepath, read_ahead), compression);
+  }
+
+  return make_raw_file_handler(filepath, read_ahead);
+}
+
+bool is_local_file(const std::string &filepath) {
+  return !shcore::str_beginswith(filepath, "oci+os://") &&
+         !shcore::str_beginswith(filepath, "http://") &&
+         !shcore::str_beginswith(filepath, "https://");
 }
 
 }  // namespace import_table
@@ -24,6 +24,7 @@
 #ifndef MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_IFILE_H_
 #define MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_IFILE_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -56,9 +57,34 @@ class IFile {
   virtual std::string file_name() = 0;
   virtual off64_t seek(off64_t offset) = 0;
   virtual ssize_t read(void *buffer, size_t length) = 0;
+
+  /**
+   * Returns pointer to the file contents if whole file is mapped into memory,
+   * nullptr otherwise. Valid between open() and close().
+   */
+  virtual const uint8_t *mapping() const { return nullptr; }
+
+  /**
+   * Hints that data up to the given offset is going to be read sequentially
+   * after the last seek().
+   */
+  virtual void advise_read_end(off64_t /* end */) {}
 };
 
-std::unique_ptr<IFile> make_file_handler(const std::string &filepath);
+/**
+ * Creates handler of the given file.
+ *
+ * @param filepath Path to the file.
+ * @param read_ahead Maximum amount of data fetched ahead of the reader in case
+ *        of remote files, 0 disables read ahead.
+ */
+std::unique_ptr<IFile> make_file_handler(const std::string &filepath,
+                                         size_t read_ahead = 0);
+
+/**
+ * Checks if filepath refers to a file in local filesystem.
+ */
+bool is_local_file(const std::string &filepath);
 
 }  // namespace import_table
 }  // namespace mysqlsh
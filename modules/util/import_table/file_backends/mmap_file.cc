@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/import_table/file_backends/mmap_file.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mysqlsh {
+namespace import_table {
+
+namespace {
+
+// read-ahead window requested from the kernel in front of the reader
+constexpr size_t k_read_ahead = 8 * 1024 * 1024;
+
+}  // namespace
+
+Mmap_file::Mmap_file(const std::string &filename) : File(filename) {}
+
+Mmap_file::~Mmap_file() { unmap(); }
+
+void Mmap_file::open() {
+  File::open();
+
+  if (is_open()) {
+    map();
+  }
+}
+
+void Mmap_file::close() {
+  unmap();
+  File::close();
+}
+
+void Mmap_file::map() {
+  assert(!m_mapping);
+  const size_t size = file_size();
+
+  // cannot map an empty file, or a file which does not fit in address space
+  if (size == 0 || size != static_cast<size_t>(static_cast<off64_t>(size))) {
+    return;
+  }
+
+#ifdef _WIN32
+  const auto file = reinterpret_cast<HANDLE>(_get_osfhandle(fd()));
+  m_map_handle =
+      CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (m_map_handle) {
+    m_mapping = static_cast<const uint8_t *>(
+        MapViewOfFile(m_map_handle, FILE_MAP_READ, 0, 0, 0));
+
+    if (!m_mapping) {
+      CloseHandle(m_map_handle);
+      m_map_handle = nullptr;
+    }
+  }
+#else
+  void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd(), 0);
+
+  if (mapping != MAP_FAILED) {
+    m_mapping = static_cast<const uint8_t *>(mapping);
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+  }
+#endif
+
+  if (m_mapping) {
+    m_size = size;
+    m_position = 0;
+    m_advised = 0;
+  }
+}
+
+void Mmap_file::unmap() {
+  if (!m_mapping) {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapping);
+  CloseHandle(m_map_handle);
+  m_map_handle = nullptr;
+#else
+  ::munmap(const_cast<uint8_t *>(m_mapping), m_size);
+#endif
+
+  m_mapping = nullptr;
+  m_size = 0;
+}
+
+void Mmap_file::will_need(size_t offset, size_t length) {
+#ifndef _WIN32
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t begin = offset - offset % page_size;
+  const size_t end = std::min(offset + length, m_size);
+
+  if (begin < end) {
+    ::madvise(const_cast<uint8_t *>(m_mapping) + begin, end - begin,
+              MADV_WILLNEED);
+  }
+#endif
+  m_advised = offset + length;
+}
+
+off64_t Mmap_file::seek(off64_t offset) {
+  if (!m_mapping) {
+    return File::seek(offset);
+  }
+
+  if (offset < 0) {
+    return static_cast<off64_t>(-1);
+  }
+
+  m_position = std::min(static_cast<size_t>(offset), m_size);
+  will_need(m_position, k_read_ahead);
+  return offset;
+}
+
+ssize_t Mmap_file::read(void *buffer, size_t length) {
+  if (!m_mapping) {
+    return File::read(buffer, length);
+  }
+
+  const size_t bytes = std::min(length, m_size - m_position);
+  ::memcpy(buffer, m_mapping + m_position, bytes);
+  m_position += bytes;
+
+  // keep the kernel ahead of the reader
+  if (m_position + k_read_ahead / 2 > m_advised && m_advised < m_size) {
+    will_need(m_advised, k_read_ahead);
+  }
+
+  return bytes;
+}
+
+}  // namespace import_table
+}  // namespace mysqlsh
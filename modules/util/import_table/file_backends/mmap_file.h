@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_MMAP_FILE_H_
+#define MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_MMAP_FILE_H_
+
+#include <string>
+
+#include "modules/util/import_table/file_backends/file.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+/**
+ * Local file mapped into memory. read() copies data straight from the mapping,
+ * without a system call. If file cannot be mapped (i.e. it is empty, or there
+ * is not enough address space) regular reads are used.
+ */
+class Mmap_file : public File {
+ public:
+  Mmap_file() = delete;
+  explicit Mmap_file(const std::string &filename);
+  Mmap_file(const Mmap_file &other) = delete;
+  Mmap_file(Mmap_file &&other) = delete;
+
+  Mmap_file &operator=(const Mmap_file &other) = delete;
+  Mmap_file &operator=(Mmap_file &&other) = delete;
+
+  ~Mmap_file() override;
+
+  void open() override;
+  void close() override;
+
+  off64_t seek(off64_t offset) override;
+  ssize_t read(void *buffer, size_t length) override;
+
+  const uint8_t *mapping() const override { return m_mapping; }
+
+ private:
+  void map();
+  void unmap();
+
+  /**
+   * Hints the kernel that [offset, offset + length) is going to be read soon.
+   */
+  void will_need(size_t offset, size_t length);
+
+  const uint8_t *m_mapping = nullptr;
+  size_t m_size = 0;       //< Size of the mapping
+  size_t m_position = 0;   //< Current read position
+  size_t m_advised = 0;    //< End of range passed to will_need()
+#ifdef _WIN32
+  void *m_map_handle = nullptr;
+#endif
+};
+
+}  // namespace import_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_MMAP_FILE_H_
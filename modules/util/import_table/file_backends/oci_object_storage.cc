@@ -104,12 +104,24 @@ void Oci_object_storage::parse_uri(const std::string &uri) {
       "/n/" + m_uri.tenancy + "/b/" + m_uri.bucket + "/o/" + m_uri.object;
 }
 
-Oci_object_storage::Oci_object_storage(const std::string &uri)
+namespace {
+
+std::unique_ptr<Rest_service> make_rest_service(const std::string &hostname) {
+  auto rest = shcore::make_unique<Rest_service>("https://" + hostname, true);
+  rest->set_timeout(30000);  // todo(kg): default 2s was not enough, 30s is
+                             // ok? maybe we could make it configurable
+  // read ahead threads and the reader share the connections
+  rest->set_connection_pool(Range_reader::k_read_ahead_threads + 1);
+  return rest;
+}
+
+}  // namespace
+
+Oci_object_storage::Oci_object_storage(const std::string &uri,
+                                       size_t read_ahead)
     : m_oci_uri(uri) {
   parse_uri(uri);
-  m_rest = shcore::make_unique<Rest_service>("https://" + m_uri.hostname, true);
-  m_rest->set_timeout(30000);  // todo(kg): default 2s was not enough, 30s is
-                               // ok? maybe we could make it configurable
+  m_rest = make_rest_service(m_uri.hostname);
 
   const auto oci_config_path =
       mysqlsh::current_shell_options()->get().oci_config_file;
@@ -205,62 +217,49 @@ Oci_object_storage::Oci_object_storage(const std::string &uri)
       throw std::runtime_error(error_msg);
     }
   }
+
+  m_reader = shcore::make_unique<Range_reader>(
+      m_file_size,
+      [this](size_t begin, size_t end) {
+        return http_get_range(m_rest.get(), m_uri.path, make_header(), begin,
+                              end);
+      },
+      read_ahead);
 }
 
-Oci_object_storage::~Oci_object_storage() { shcore::clear_buffer(&m_key_file); }
+Oci_object_storage::~Oci_object_storage() {
+  // read ahead threads use the members of this object
+  m_reader.reset();
+  shcore::clear_buffer(&m_key_file);
+}
 
-void Oci_object_storage::open() { m_offset = 0; }
+void Oci_object_storage::open() { m_reader->seek(0); }
 
 bool Oci_object_storage::is_open() {
   return m_open_status_code == Response::Status_code::OK;
 }
 
-void Oci_object_storage::close() {}
+void Oci_object_storage::close() { m_reader->reset(); }
 
 size_t Oci_object_storage::file_size() { return m_file_size; }
 
 std::string Oci_object_storage::file_name() { return m_oci_uri; }
 
 off64_t Oci_object_storage::seek(off64_t offset) {
-  const off64_t fsize = file_size();
-  m_offset = std::min(offset, fsize);
-  return m_offset;
+  return m_reader->seek(offset);
 }
 
 ssize_t Oci_object_storage::read(void *buffer, size_t length) {
-  if (!(length > 0)) return 0;
-  const off64_t fsize = file_size();
-  if (m_offset >= fsize) return 0;
-
-  const size_t first = m_offset;
-  const size_t last_unbounded = m_offset + length - 1;
-  // http range request is both sides inclusive
-  const size_t last = std::min(file_size() - 1, last_unbounded);
-  const std::string range =
-      "bytes=" + std::to_string(first) + "-" + std::to_string(last);
-
-  Headers h = make_header();
-  h["range"] = range;
-
-  auto response = m_rest->get(m_uri.path, h);
-
-  if (Response::Status_code::PARTIAL_CONTENT == response.status) {
-    const auto &content = response.body.get_string();
-    std::copy(content.data(), content.data() + content.size(),
-              reinterpret_cast<uint8_t *>(buffer));
-    m_offset += content.size();
-    return content.size();
-  } else if (Response::Status_code::OK == response.status) {
-    throw std::runtime_error("Range requests are not supported.");
-  } else if (Response::Status_code::RANGE_NOT_SATISFIABLE == response.status) {
-    throw std::runtime_error("Range request " + std::to_string(first) + "-" +
-                             std::to_string(last) + " is out of bounds.");
-  }
-  return 0;
+  return m_reader->read(buffer, length);
+}
+
+void Oci_object_storage::advise_read_end(off64_t end) {
+  m_reader->advise_read_end(end);
 }
 
 mysqlshdk::rest::Headers Oci_object_storage::make_signed_header(
     bool is_get_request) {
+  std::lock_guard<std::mutex> lock(m_header_mutex);
   time_t now = time(nullptr);
   const auto idx = is_get_request ? 1 : 0;
 
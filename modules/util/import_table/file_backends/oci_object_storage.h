@@ -26,8 +26,10 @@
 
 #include <openssl/evp.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "modules/util/import_table/file_backends/ifile.h"
+#include "modules/util/import_table/file_backends/range_reader.h"
 #include "mysqlshdk/libs/config/config_file.h"
 #include "mysqlshdk/libs/rest/rest_service.h"
 
@@ -37,7 +39,12 @@ namespace import_table {
 class Oci_object_storage : public IFile {
  public:
   Oci_object_storage() = delete;
-  explicit Oci_object_storage(const std::string &uri);
+  /**
+   * @param uri URI of the object.
+   * @param read_ahead Maximum amount of data fetched ahead of the reader, 0
+   *        disables read ahead.
+   */
+  explicit Oci_object_storage(const std::string &uri, size_t read_ahead = 0);
   Oci_object_storage(const Oci_object_storage &other) = delete;
   Oci_object_storage(Oci_object_storage &&other) = delete;
 
@@ -54,6 +61,7 @@ class Oci_object_storage : public IFile {
   std::string file_name() override;
   off64_t seek(off64_t offset) override;
   ssize_t read(void *buffer, size_t length) override;
+  void advise_read_end(off64_t end) override;
 
  private:
   void parse_uri(const std::string &uri);
@@ -74,11 +82,13 @@ class Oci_object_storage : public IFile {
    * @return Headers object
    */
   mysqlshdk::rest::Headers make_header(bool is_get_request = true);
+  // headers are created by the read ahead threads as well
+  std::mutex m_header_mutex;
   time_t m_signed_header_cache_time[2] = {0, 0};
   mysqlshdk::rest::Headers m_cached_header[2];
 
   std::unique_ptr<mysqlshdk::rest::Rest_service> m_rest;
-  off64_t m_offset = 0;
+  std::unique_ptr<Range_reader> m_reader;
   mysqlshdk::rest::Response::Status_code m_open_status_code;
   size_t m_file_size = 0;
   std::string m_oci_uri;
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/import_table/file_backends/range_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "modules/util/import_table/helpers.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+std::string http_get_range(mysqlshdk::rest::Rest_service *rest,
+                           const std::string &path,
+                           mysqlshdk::rest::Headers headers, size_t begin,
+                           size_t end) {
+  using Response = mysqlshdk::rest::Response;
+
+  // http range request is both sides inclusive
+  const std::string first = std::to_string(begin);
+  const std::string last = std::to_string(end - 1);
+  headers["range"] = "bytes=" + first + "-" + last;
+
+  // body is received directly into the result
+  std::string data;
+  mysqlshdk::rest::String_buffer buffer{&data, end - begin};
+  const auto response = rest->get(path, headers, &buffer);
+
+  if (Response::Status_code::PARTIAL_CONTENT == response.status) {
+    return data;
+  } else if (Response::Status_code::OK == response.status) {
+    throw std::runtime_error("Range requests are not supported.");
+  } else if (Response::Status_code::RANGE_NOT_SATISFIABLE == response.status) {
+    throw std::runtime_error("Range request " + first + "-" + last +
+                             " is out of bounds.");
+  }
+
+  return {};
+}
+
+constexpr const size_t Range_reader::k_read_ahead_threads;
+
+Range_reader::Range_reader(size_t file_size, const Fetch &fetch,
+                           size_t read_ahead)
+    : m_file_size(file_size),
+      m_fetch(fetch),
+      m_read_ahead(read_ahead),
+      m_read_end(file_size) {
+  // each thread fetches one block at a time
+  m_block_size = std::max(m_read_ahead / k_read_ahead_threads,
+                          static_cast<size_t>(BUFFER_SIZE));
+}
+
+Range_reader::~Range_reader() { reset(); }
+
+off64_t Range_reader::seek(off64_t offset) {
+  const size_t new_offset = std::min(static_cast<size_t>(offset), m_file_size);
+
+  if (new_offset != m_offset) {
+    reset();
+    m_offset = new_offset;
+  }
+
+  m_read_end = m_file_size;
+  m_advised = false;
+
+  return m_offset;
+}
+
+void Range_reader::advise_read_end(off64_t end) {
+  const size_t new_end = std::min(static_cast<size_t>(end), m_file_size);
+
+  if (m_active && new_end != m_read_end) {
+    reset();
+  }
+
+  m_read_end = new_end;
+  m_advised = true;
+}
+
+ssize_t Range_reader::read(void *buffer, size_t length) {
+  if (0 == length || m_offset >= m_file_size) {
+    return 0;
+  }
+
+  // read ahead if reads are sequential or the caller asked for it
+  if (!m_active && m_read_ahead > 0 && m_offset < m_read_end &&
+      (m_advised || m_offset == m_last_read_end)) {
+    start_read_ahead();
+  }
+
+  if (m_active) {
+    const auto bytes = read_ahead(buffer, length);
+
+    if (bytes >= 0) {
+      return bytes;
+    }
+
+    // all of the data was read ahead, continue without it
+    reset();
+  }
+
+  const auto data = m_fetch(m_offset, std::min(m_offset + length, m_file_size));
+  std::memcpy(buffer, data.data(), data.size());
+  m_offset += data.size();
+  m_last_read_end = m_offset;
+
+  return data.size();
+}
+
+void Range_reader::reset() {
+  if (!m_active) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_cv.notify_all();
+
+  // threads finish the requests which are already sent
+  for (auto &t : m_threads) {
+    t.join();
+  }
+
+  m_threads.clear();
+  m_blocks.clear();
+  m_buffered = 0;
+  m_active = false;
+}
+
+void Range_reader::start_read_ahead() {
+  m_stop = false;
+  m_next_fetch = m_offset;
+  m_fetch_end = m_read_end;
+  m_active = true;
+
+  const size_t blocks =
+      (m_fetch_end - m_next_fetch + m_block_size - 1) / m_block_size;
+  const size_t threads = std::min(blocks, k_read_ahead_threads);
+
+  for (size_t i = 0; i < threads; ++i) {
+    m_threads.emplace_back(&Range_reader::fetch_blocks, this);
+  }
+}
+
+void Range_reader::fetch_blocks() {
+  while (true) {
+    std::shared_ptr<Block> block;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      // memory is reserved for the whole block before it is fetched
+      m_cv.wait(lock, [this]() {
+        return m_stop || m_next_fetch >= m_fetch_end ||
+               m_buffered + m_block_size <= m_read_ahead ||
+               m_buffered == 0;
+      });
+
+      if (m_stop || m_next_fetch >= m_fetch_end) {
+        return;
+      }
+
+      block = std::make_shared<Block>();
+      block->begin = m_next_fetch;
+      block->end = std::min(m_next_fetch + m_block_size, m_fetch_end);
+      m_next_fetch = block->end;
+      m_buffered += block->end - block->begin;
+      m_blocks.emplace_back(block);
+    }
+
+    std::string data;
+    std::exception_ptr error;
+
+    try {
+      data = m_fetch(block->begin, block->end);
+
+      if (data.size() != block->end - block->begin) {
+        throw std::runtime_error("Range request " +
+                                 std::to_string(block->begin) + "-" +
+                                 std::to_string(block->end - 1) +
+                                 " returned unexpected number of bytes.");
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      block->data = std::move(data);
+      block->error = error;
+      block->ready = true;
+    }
+
+    m_cv.notify_all();
+  }
+}
+
+ssize_t Range_reader::read_ahead(void *buffer, size_t length) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (m_blocks.empty() && m_next_fetch >= m_fetch_end) {
+    return -1;
+  }
+
+  m_cv.wait(lock,
+            [this]() { return !m_blocks.empty() && m_blocks.front()->ready; });
+
+  const auto &block = *m_blocks.front();
+
+  if (block.error) {
+    std::rethrow_exception(block.error);
+  }
+
+  const size_t bytes = std::min(length, block.end - m_offset);
+  std::memcpy(buffer, block.data.data() + (m_offset - block.begin), bytes);
+  m_offset += bytes;
+  m_last_read_end = m_offset;
+
+  if (m_offset == block.end) {
+    m_buffered -= block.end - block.begin;
+    m_blocks.pop_front();
+    lock.unlock();
+    m_cv.notify_all();
+  }
+
+  return bytes;
+}
+
+}  // namespace import_table
+}  // namespace mysqlsh
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_RANGE_READER_H_
+#define MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_RANGE_READER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/util/import_table/file_backends/ifile.h"
+#include "mysqlshdk/libs/rest/rest_service.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+/**
+ * Fetches bytes [begin, end) of a remote file using HTTP range request.
+ *
+ * @param rest Service used to send the request.
+ * @param path Path to the file.
+ * @param headers Request headers, range header is added.
+ * @param begin First byte to fetch.
+ * @param end Byte after the last one to fetch.
+ *
+ * @return Fetched data.
+ */
+std::string http_get_range(mysqlshdk::rest::Rest_service *rest,
+                           const std::string &path,
+                           mysqlshdk::rest::Headers headers, size_t begin,
+                           size_t end);
+
+/**
+ * Serves reads of a remote file. Once the file is read sequentially, large
+ * ranges ahead of the reader are fetched concurrently by several threads and
+ * reads are served from memory.
+ */
+class Range_reader final {
+ public:
+  /**
+   * Fetches bytes [begin, end) of the file. Called concurrently by the reader
+   * and the read ahead threads.
+   */
+  using Fetch = std::function<std::string(size_t begin, size_t end)>;
+
+  /**
+   * Maximum number of concurrent range requests issued by the read ahead
+   * threads.
+   */
+  static constexpr const size_t k_read_ahead_threads = 4;
+
+  Range_reader() = delete;
+
+  /**
+   * @param file_size Size of the file.
+   * @param fetch Fetches the data.
+   * @param read_ahead Maximum amount of data fetched ahead of the reader, 0
+   *        disables read ahead.
+   */
+  Range_reader(size_t file_size, const Fetch &fetch, size_t read_ahead);
+
+  Range_reader(const Range_reader &other) = delete;
+  Range_reader(Range_reader &&other) = delete;
+
+  Range_reader &operator=(const Range_reader &other) = delete;
+  Range_reader &operator=(Range_reader &&other) = delete;
+
+  ~Range_reader();
+
+  off64_t seek(off64_t offset);
+
+  /**
+   * Data up to the given offset is going to be read sequentially, it is read
+   * ahead right away and nothing past it is fetched.
+   */
+  void advise_read_end(off64_t end);
+
+  ssize_t read(void *buffer, size_t length);
+
+  /**
+   * Stops reading ahead and releases the memory.
+   */
+  void reset();
+
+ private:
+  struct Block {
+    size_t begin = 0;
+    size_t end = 0;
+    std::string data;
+    bool ready = false;
+    std::exception_ptr error;
+  };
+
+  void start_read_ahead();
+
+  void fetch_blocks();
+
+  ssize_t read_ahead(void *buffer, size_t length);
+
+  const size_t m_file_size;
+  const Fetch m_fetch;
+  const size_t m_read_ahead;
+  size_t m_block_size;
+
+  // members used only by the reader
+  size_t m_offset = 0;
+  size_t m_read_end;
+  bool m_advised = false;
+  size_t m_last_read_end = static_cast<size_t>(-1);
+  bool m_active = false;
+  std::vector<std::thread> m_threads;
+
+  // members shared with the read ahead threads
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::shared_ptr<Block>> m_blocks;
+  size_t m_buffered = 0;
+  size_t m_next_fetch = 0;
+  size_t m_fetch_end = 0;
+  bool m_stop = false;
+};
+
+}  // namespace import_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_TABLE_FILE_BACKENDS_RANGE_READER_H_
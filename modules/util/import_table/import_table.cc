@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,10 +24,13 @@
 #include "modules/util/import_table/import_table.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <limits>
 #include <utility>
 
 #include "modules/util/import_table/chunk_file.h"
+#include "modules/util/import_table/file_backends/compressed_file.h"
 #include "modules/util/import_table/load_data.h"
 #include "mysqlshdk/include/shellcore/shell_options.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
@@ -38,8 +41,26 @@
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+/**
+ * Number of discovered ranges per worker which can wait in the queue, chunking
+ * is suspended when workers fall behind.
+ */
+constexpr const size_t k_ranges_per_worker = 4;
+
+}  // namespace
+
+double Worker_stats::rate() const {
+  const uint64_t time = busy_time;
+  return time > 0 ? bytes * 1000000.0 / time : 0.0;
+}
+
 Import_table::Import_table(const Import_table_options &options)
-    : m_opt(options) {
+    : m_range_queue(k_ranges_per_worker *
+                    static_cast<size_t>(options.threads_size())),
+      m_opt(options),
+      m_worker_stats(options.threads_size()) {
   m_thread_exception.resize(options.threads_size(), nullptr);
 
   m_use_json = (mysqlsh::current_shell_options()->get().wrap_json != "off");
@@ -55,6 +76,30 @@ Import_table::Import_table(const Import_table_options &options)
   }
 
   m_progress->total(m_opt.file_size());
+
+  if (!m_opt.journal().empty()) {
+    m_journal = shcore::make_unique<Import_journal>(m_opt.journal());
+    m_journal->set_target(m_opt.schema(), m_opt.table(), m_opt.columns());
+    m_journal->set_dialect(m_opt.dialect());
+    m_journal->set_rows_to_skip(m_opt.skip_rows_count());
+
+    for (const auto &file : m_opt.files()) {
+      m_journal->add_file(
+          file.full_path, file.size,
+          Compression::None != compression_from_path(file.full_path));
+    }
+
+    if (m_opt.resume()) {
+      m_journal->load();
+    } else if (shcore::is_file(m_journal->path())) {
+      throw std::runtime_error(
+          "Journal file '" + m_journal->path() +
+          "' already exists, set the 'resume' option to continue the import "
+          "or remove the file.");
+    }
+
+    m_journal->save();
+  }
 }
 
 void Import_table::join_workers() {
@@ -86,31 +131,128 @@ void Import_table::spawn_workers() {
   for (int64_t i = 0; i < m_opt.threads_size(); i++) {
     Load_data_worker worker(m_opt, i, m_progress.get(), &m_prog_sent_bytes,
                             &m_output_mutex, m_interrupt, &m_range_queue,
-                            &m_thread_exception, m_use_json, &m_stats);
+                            &m_thread_exception, m_use_json, &m_stats,
+                            &m_worker_stats[i], m_journal.get());
     std::thread t(&Load_data_worker::operator(), std::move(worker));
     m_threads.emplace_back(std::move(t));
   }
 }
 
 void Import_table::chunk_file() {
+  const auto &files = m_opt.files();
+  const auto stop = [this]() { return *m_interrupt || any_exception(); };
+  // bytes in the files which were not chunked yet
+  size_t bytes_left = m_opt.file_size();
+
+  for (size_t i = 0; i < files.size() && !stop(); ++i) {
+    const auto &file = files[i];
+    bytes_left -= file.size;
+
+    if (0 == file.size) {
+      continue;
+    }
+
+    // small files are loaded whole, there is nothing to gain from chunking
+    // them, all files share the same worker pool
+    if (file.size <= m_opt.bytes_per_chunk() &&
+        0 == m_opt.skip_rows_count() &&
+        Compression::None == compression_from_path(file.full_path)) {
+      push_range(Range{0, file.size, nullptr, i});
+      continue;
+    }
+
+    chunk_file(file.full_path, i, bytes_left);
+  }
+
+  m_range_queue.shutdown(m_opt.threads_size());
+}
+
+void Import_table::chunk_file(const std::string &path, size_t index,
+                              size_t bytes_after) {
   Chunk_file chunk;
   chunk.set_chunk_size(m_opt.bytes_per_chunk());
-  chunk.set_file_path(m_opt.full_path());
+  chunk.set_file_path(path);
+  chunk.set_file_index(index);
   chunk.set_dialect(m_opt.dialect());
   chunk.set_rows_to_skip(m_opt.skip_rows_count());
-  chunk.set_output_queue(&m_range_queue);
+  chunk.set_output([this](Range &&r) { push_range(std::move(r)); });
+  // seeking in remote files is expensive, their boundaries are discovered by
+  // single thread
+  chunk.set_threads(is_local_file(path) ? m_opt.threads_size() : 1);
+  // compressed files are decompressed by one thread, keep each worker busy
+  // with one chunk in flight and one waiting
+  chunk.set_max_pending_chunks(2 * m_opt.threads_size());
+  chunk.set_read_ahead(m_opt.read_ahead());
+  chunk.set_progress(&m_prog_sent_bytes);
+  chunk.set_stop_condition(
+      [this]() { return *m_interrupt || any_exception(); });
+  // start with large chunks and shrink them as the end of the last file
+  // approaches, so that workers finish together
+  chunk.set_chunk_size_policy([this, bytes_after](size_t bytes_left) {
+    return next_chunk_size(bytes_left + bytes_after);
+  });
   chunk.start();
+}
 
-  m_range_queue.shutdown(m_opt.threads_size());
+size_t Import_table::next_chunk_size(size_t bytes_left) const {
+  std::vector<double> rates;
+  rates.reserve(m_worker_stats.size());
+
+  for (const auto &stats : m_worker_stats) {
+    rates.emplace_back(stats.rate());
+  }
+
+  return adaptive_chunk_size(rates, bytes_left);
+}
+
+void Import_table::push_range(Range &&range) {
+  if (!m_journal) {
+    m_range_queue.push(std::move(range));
+    return;
+  }
+
+  auto parts = m_journal->pending(range);
+
+  // progress of the in-memory chunks is reported by the chunker
+  if (!range.data) {
+    size_t skipped = range.end - range.begin;
+
+    for (const auto &part : parts) {
+      skipped -= part.end - part.begin;
+    }
+
+    m_prog_sent_bytes += skipped;
+  }
+
+  for (auto &part : parts) {
+    m_range_queue.push(std::move(part));
+  }
 }
 
 void Import_table::import() {
   m_timer.stage_begin("Parallel load data");
   spawn_workers();
-  chunk_file();
+
+  try {
+    chunk_file();
+  } catch (...) {
+    // workers wait for more ranges, they have to be released and joined
+    // before the exception leaves, destroying a joinable thread terminates
+    m_range_queue.shutdown(m_opt.threads_size());
+    join_workers();
+    m_timer.stage_end();
+    progress_shutdown();
+    throw;
+  }
+
   join_workers();
   m_timer.stage_end();
   progress_shutdown();
+
+  if (m_journal && !*m_interrupt && !any_exception()) {
+    // all data was loaded, there is nothing to resume
+    m_journal->remove();
+  }
 }
 
 std::string Import_table::import_summary() const {
@@ -118,13 +260,43 @@ std::string Import_table::import_summary() const {
   using mysqlshdk::utils::format_seconds;
   using mysqlshdk::utils::format_throughput_bytes;
   const auto filesize = m_opt.file_size();
+  auto files = m_opt.files_info();
+  files[0] = static_cast<char>(std::toupper(files[0]));
   return std::string{
-      "File '" + m_opt.full_path() + "' (" + format_bytes(filesize) +
-      ") was imported in " + format_seconds(m_timer.total_seconds_ellapsed()) +
-      " at " +
+      files + " (" + format_bytes(filesize) + ") " +
+      (m_opt.files().size() == 1 ? "was" : "were") + " imported in " +
+      format_seconds(m_timer.total_seconds_ellapsed()) + " at " +
       format_throughput_bytes(filesize, m_timer.total_seconds_ellapsed())};
 }
 
+std::string Import_table::workers_summary() const {
+  using mysqlshdk::utils::format_bytes;
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_bytes;
+
+  std::string summary;
+  char worker_name[64];
+
+  for (size_t i = 0; i < m_worker_stats.size(); ++i) {
+    const auto &stats = m_worker_stats[i];
+    const uint64_t bytes = stats.bytes;
+    const double busy = stats.busy_time / 1000000.0;
+
+    snprintf(worker_name, sizeof(worker_name), "[Worker%03u] ",
+             static_cast<unsigned int>(i));
+
+    if (!summary.empty()) {
+      summary += "\n";
+    }
+
+    summary += worker_name + format_bytes(bytes) + " loaded at " +
+               format_throughput_bytes(bytes, busy > 0 ? busy : 1.0) +
+               ", idle for " + format_seconds(stats.idle_time / 1000000.0);
+  }
+
+  return summary;
+}
+
 std::string Import_table::rows_affected_info() {
   return "Total rows affected in " + m_opt.schema() + "." + m_opt.table() +
          ": " + m_stats.to_string();
@@ -25,6 +25,7 @@
 #define MODULES_UTIL_IMPORT_TABLE_IMPORT_TABLE_H_
 
 #include <atomic>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <string>
@@ -33,9 +34,10 @@
 
 #include "modules/util/import_table/chunk_file.h"
 #include "modules/util/import_table/import_table_options.h"
+#include "modules/util/import_table/journal.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/bounded_queue.h"
 #include "mysqlshdk/libs/utils/profiling.h"
-#include "mysqlshdk/libs/utils/synchronized_queue.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -54,6 +56,20 @@ struct Stats {
   }
 };
 
+/**
+ * Statistics of a single worker, updated only by the worker thread.
+ */
+struct Worker_stats {
+  std::atomic<uint64_t> bytes{0};      //< Bytes sent to the server
+  std::atomic<uint64_t> busy_time{0};  //< Microseconds spent loading data
+  std::atomic<uint64_t> idle_time{0};  //< Microseconds spent waiting for chunks
+
+  /**
+   * Measured load rate in bytes per second, 0 if it is not known yet.
+   */
+  double rate() const;
+};
+
 class Import_table final {
  public:
   Import_table() = delete;
@@ -75,19 +91,42 @@ class Import_table final {
   std::string import_summary() const;
   std::string rows_affected_info();
 
+  /**
+   * Load rate and idle time of each worker.
+   */
+  std::string workers_summary() const;
+
  private:
   void spawn_workers();
   void join_workers();
   void chunk_file();
+
+  /**
+   * Chunks a single file.
+   *
+   * @param path Path to the file.
+   * @param index Index of the file in the list of imported files.
+   * @param bytes_after Total size of the files which are chunked later.
+   */
+  void chunk_file(const std::string &path, size_t index, size_t bytes_after);
   void progress_shutdown();
+  size_t next_chunk_size(size_t bytes_left) const;
+
+  /**
+   * Sends range to the workers, parts which were already loaded according to
+   * the journal are skipped.
+   */
+  void push_range(Range &&range);
 
   std::atomic<size_t> m_prog_sent_bytes{0};
   std::mutex m_output_mutex;
   std::unique_ptr<mysqlshdk::textui::IProgress> m_progress = nullptr;
-  shcore::Synchronized_queue<Range> m_range_queue;
+  shcore::Bounded_queue<Range> m_range_queue;
 
   const Import_table_options &m_opt;
   Stats m_stats;
+  std::vector<Worker_stats> m_worker_stats;
+  std::unique_ptr<Import_journal> m_journal;
 
   bool m_use_json = false;
   volatile bool *m_interrupt;
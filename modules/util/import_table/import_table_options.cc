@@ -26,8 +26,10 @@
 #include <errno.h>
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "modules/mod_utils.h"
+#include "modules/util/import_table/file_backends/compressed_file.h"
 #include "modules/util/import_table/file_backends/ifile.h"
 #include "modules/util/import_table/helpers.h"
 #include "mysqlshdk/include/scripting/types.h"
@@ -37,16 +39,85 @@
 #include "mysqlshdk/libs/db/connection_options.h"
 #include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+bool has_wildcards(const std::string &s) {
+  return std::string::npos != s.find_first_of("*?");
+}
+
+/**
+ * Expands wildcards in the file name part of a local path. Matching files are
+ * sorted by name, remote paths are returned unchanged.
+ */
+std::vector<std::string> expand_wildcards(const std::string &pattern) {
+  static constexpr const char k_file_scheme[] = "file://";
+
+  if (!is_local_file(pattern)) {
+    return {pattern};
+  }
+
+  std::string scheme;
+  std::string path = pattern;
+
+  if (shcore::str_beginswith(path, k_file_scheme)) {
+    scheme = k_file_scheme;
+    path = path.substr(scheme.length());
+  }
+
+  const auto name = shcore::path::basename(path);
+
+  if (!has_wildcards(name)) {
+    return {pattern};
+  }
+
+  const bool has_dir = name.length() != path.length();
+  const auto dir = has_dir ? shcore::path::dirname(path) : std::string{"."};
+  std::vector<std::string> files;
+
+  for (const auto &entry : shcore::listdir(dir)) {
+    const auto file = has_dir ? shcore::path::join_path(dir, entry) : entry;
+
+    if (shcore::match_glob(name, entry, true) && shcore::is_file(file)) {
+      files.emplace_back(scheme + file);
+    }
+  }
+
+  if (files.empty()) {
+    throw std::runtime_error("No files match the pattern '" + pattern + "'");
+  }
+
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+}  // namespace
+
 Import_table_options::Import_table_options(const std::string &filename,
                                            const shcore::Dictionary_t &options)
-    : m_filename(filename) {
-  m_table = std::get<0>(
-      shcore::path::split_extension(shcore::path::basename(filename)));
+    : Import_table_options(std::vector<std::string>{filename}, options) {}
+
+Import_table_options::Import_table_options(
+    const std::vector<std::string> &filenames,
+    const shcore::Dictionary_t &options) {
+  for (const auto &filename : filenames) {
+    const auto files = expand_wildcards(filename);
+    m_filenames.insert(m_filenames.end(), files.begin(), files.end());
+  }
+
+  if (m_filenames.empty()) {
+    throw shcore::Exception::argument_error(
+        "At least one file to import must be given.");
+  }
+
+  m_table = std::get<0>(shcore::path::split_extension(shcore::path::basename(
+      strip_compression_extension(m_filenames.front()))));
   unpack(options);
 }
 
@@ -82,14 +153,24 @@ void Import_table_options::validate() {
     }
   }
 
-  auto fh = make_file_handler(m_filename);
-  fh->open();
-  if (!fh->is_open()) {
-    throw std::runtime_error("Cannot open file '" + fh->file_name() + "'");
+  m_files.clear();
+  m_file_size = 0;
+
+  for (const auto &filename : m_filenames) {
+    auto fh = make_file_handler(filename);
+    fh->open();
+    if (!fh->is_open()) {
+      throw std::runtime_error("Cannot open file '" + fh->file_name() + "'");
+    }
+    Import_file file;
+    file.full_path = fh->file_name();
+    file.size = fh->file_size();
+    fh->close();
+
+    m_file_size += file.size;
+    m_files.emplace_back(std::move(file));
   }
-  m_full_path = fh->file_name();
-  m_file_size = fh->file_size();
-  fh->close();
+
   m_threads_size = calc_thread_size();
 }
 
@@ -98,7 +179,10 @@ size_t Import_table_options::calc_thread_size() {
   int64_t threads_size = std::max(static_cast<int64_t>(1), m_threads_size);
 
   // We do not need to spawn more threads than file chunks
-  const size_t calculated_threads = (m_file_size / bytes_per_chunk()) + 1;
+  size_t calculated_threads = 0;
+  for (const auto &file : m_files) {
+    calculated_threads += (file.size / bytes_per_chunk()) + 1;
+  }
   if (calculated_threads <
       static_cast<size_t>(std::numeric_limits<int64_t>::max())) {
     threads_size =
@@ -126,16 +210,28 @@ Connection_options Import_table_options::connection_options() const {
   return connection_options;
 }
 
+size_t Import_table_options::read_ahead() const {
+  return mysqlshdk::utils::expand_to_bytes(m_read_ahead);
+}
+
 size_t Import_table_options::bytes_per_chunk() const {
   constexpr const size_t min_bytes_per_chunk = 2 * BUFFER_SIZE;
   return std::max(mysqlshdk::utils::expand_to_bytes(m_bytes_per_chunk),
                   min_bytes_per_chunk);
 }
 
+std::string Import_table_options::files_info() const {
+  if (m_files.size() == 1) {
+    return "file '" + m_files.front().full_path + "'";
+  }
+
+  return std::to_string(m_files.size()) + " files";
+}
+
 std::string Import_table_options::target_import_info() const {
   auto connection_options = m_base_session->get_connection_options();
   std::string info_msg =
-      "Importing from file '" + full_path() + "' to table `" + schema() +
+      "Importing from " + files_info() + " to table `" + schema() +
       "`.`" + table() + "` in MySQL Server at " +
       connection_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
       " using " + std::to_string(threads_size());
@@ -146,21 +242,11 @@ std::string Import_table_options::target_import_info() const {
 void Import_table_options::unpack(const shcore::Dictionary_t &options) {
   auto unpack_options = Unpack_options(options);
   unpack_options.optional("dialect", &m_base_dialect_name);
-  if (m_base_dialect_name.empty()) {
-    // nop
-  } else if (shcore::str_casecmp(m_base_dialect_name, "default") == 0) {
-    // nop
-  } else if (shcore::str_casecmp(m_base_dialect_name, "csv") == 0) {
-    m_dialect = Dialect::csv();
-  } else if (shcore::str_casecmp(m_base_dialect_name, "tsv") == 0) {
-    m_dialect = Dialect::tsv();
-  } else if (shcore::str_casecmp(m_base_dialect_name, "json") == 0) {
-    m_dialect = Dialect::json();
-  } else if (shcore::str_casecmp(m_base_dialect_name, "csv-unix") == 0) {
-    m_dialect = Dialect::csv_unix();
-  } else {
-    throw shcore::Exception::argument_error(
-        "dialect value must be csv, tsv, json or csv-unix.");
+
+  try {
+    m_dialect = Dialect::from_name(m_base_dialect_name);
+  } catch (const std::invalid_argument &e) {
+    throw shcore::Exception::argument_error(e.what());
   }
 
   unpack_options.optional("table", &m_table)
@@ -177,9 +263,20 @@ void Import_table_options::unpack(const shcore::Dictionary_t &options) {
       .optional("replaceDuplicates", &m_replace_duplicates)
       .optional("maxRate", &m_max_rate)
       .optional("showProgress", &m_show_progress)
-      .optional("skipRows", &m_skip_rows_count);
+      .optional("skipRows", &m_skip_rows_count)
+      .optional("journal", &m_journal)
+      .optional("resume", &m_resume)
+      .optional("readAhead", &m_read_ahead);
+
+  if (m_resume && m_journal.empty()) {
+    throw shcore::Exception::argument_error(
+        "The 'resume' option requires the 'journal' option to be set.");
+  }
 
-  if (shcore::str_beginswith(m_filename, "oci+os://")) {
+  if (std::any_of(m_filenames.begin(), m_filenames.end(),
+                  [](const std::string &filename) {
+                    return shcore::str_beginswith(filename, "oci+os://");
+                  })) {
     unpack_options.optional("ociProfile", &m_oci.profile)
         .optional("ociConfigFile", &m_oci.config_file);
 
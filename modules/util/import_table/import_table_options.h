@@ -42,6 +42,14 @@ namespace import_table {
 
 using Connection_options = mysqlshdk::db::Connection_options;
 
+/**
+ * File which is imported.
+ */
+struct Import_file {
+  std::string full_path;
+  size_t size = 0;
+};
+
 class Import_table_options {
  public:
   Import_table_options() = default;
@@ -49,6 +57,13 @@ class Import_table_options {
   explicit Import_table_options(const std::string &filename,
                                 const shcore::Dictionary_t &options);
 
+  /**
+   * Imports multiple files to the same table. Wildcards (* and ?) in the file
+   * name part of a local path are expanded to the matching files.
+   */
+  Import_table_options(const std::vector<std::string> &filenames,
+                       const shcore::Dictionary_t &options);
+
   Import_table_options(const Import_table_options &other) = default;
   Import_table_options(Import_table_options &&other) = default;
 
@@ -67,7 +82,10 @@ class Import_table_options {
 
   Connection_options connection_options() const;
 
-  const std::string &full_path() const { return m_full_path; }
+  /**
+   * Files to be imported, available after validate().
+   */
+  const std::vector<Import_file> &files() const { return m_files; }
 
   size_t max_rate() const;
 
@@ -79,14 +97,31 @@ class Import_table_options {
 
   uint64_t skip_rows_count() const { return m_skip_rows_count; }
 
+  const std::string &journal() const { return m_journal; }
+
+  bool resume() const { return m_resume; }
+
+  /**
+   * Maximum amount of data fetched ahead by each reader of a remote file.
+   */
+  size_t read_ahead() const;
+
   int64_t threads_size() const { return m_threads_size; }
 
   const std::string &table() const { return m_table; }
 
   const std::string &schema() const { return m_schema; }
 
+  /**
+   * Total size of all files.
+   */
   size_t file_size() const { return m_file_size; }
 
+  /**
+   * Either "file '<path>'" or "<n> files".
+   */
+  std::string files_info() const;
+
   size_t bytes_per_chunk() const;
 
   std::string target_import_info() const;
@@ -96,9 +131,9 @@ class Import_table_options {
 
   size_t calc_thread_size();
 
-  std::string m_filename;
-  std::string m_full_path;
-  size_t m_file_size;
+  std::vector<std::string> m_filenames;
+  std::vector<Import_file> m_files;
+  size_t m_file_size = 0;
   std::string m_table;
   std::string m_schema;
   int64_t m_threads_size = 8;
@@ -108,6 +143,9 @@ class Import_table_options {
   std::string m_max_rate;
   bool m_show_progress = isatty(fileno(stdout)) ? true : false;
   uint64_t m_skip_rows_count = 0;
+  std::string m_journal;
+  bool m_resume = false;
+  std::string m_read_ahead{"32M"};
   std::string m_base_dialect_name;
   Dialect m_dialect;
 
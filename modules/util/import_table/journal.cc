@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/import_table/journal.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <stdexcept>
+
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+namespace {
+
+/**
+ * Thrown if contents of the journal file are malformed.
+ */
+class Invalid_journal : public std::runtime_error {
+ public:
+  explicit Invalid_journal(const std::string &msg) : std::runtime_error(msg) {}
+};
+
+const rapidjson::Value &get_member(const rapidjson::Value &object,
+                                   const char *name) {
+  const auto member = object.FindMember(name);
+
+  if (member == object.MemberEnd()) {
+    throw Invalid_journal(std::string{"missing member '"} + name + "'");
+  }
+
+  return member->value;
+}
+
+std::string get_string(const rapidjson::Value &object, const char *name) {
+  const auto &value = get_member(object, name);
+
+  if (!value.IsString()) {
+    throw Invalid_journal(std::string{"member '"} + name +
+                          "' is expected to be a string");
+  }
+
+  return std::string(value.GetString(), value.GetStringLength());
+}
+
+uint64_t get_uint(const rapidjson::Value &object, const char *name) {
+  const auto &value = get_member(object, name);
+
+  if (!value.IsUint64()) {
+    throw Invalid_journal(std::string{"member '"} + name +
+                          "' is expected to be an unsigned integer");
+  }
+
+  return value.GetUint64();
+}
+
+bool get_bool(const rapidjson::Value &object, const char *name) {
+  const auto &value = get_member(object, name);
+
+  if (!value.IsBool()) {
+    throw Invalid_journal(std::string{"member '"} + name +
+                          "' is expected to be a boolean");
+  }
+
+  return value.GetBool();
+}
+
+const rapidjson::Value &get_object(const rapidjson::Value &object,
+                                   const char *name) {
+  const auto &value = get_member(object, name);
+
+  if (!value.IsObject()) {
+    throw Invalid_journal(std::string{"member '"} + name +
+                          "' is expected to be an object");
+  }
+
+  return value;
+}
+
+const rapidjson::Value &get_array(const rapidjson::Value &object,
+                                  const char *name) {
+  const auto &value = get_member(object, name);
+
+  if (!value.IsArray()) {
+    throw Invalid_journal(std::string{"member '"} + name +
+                          "' is expected to be an array");
+  }
+
+  return value;
+}
+
+std::vector<std::string> get_strings(const rapidjson::Value &object,
+                                     const char *name) {
+  const auto &value = get_array(object, name);
+  std::vector<std::string> result;
+
+  for (const auto &s : value.GetArray()) {
+    if (!s.IsString()) {
+      throw Invalid_journal(std::string{"member '"} + name +
+                            "' is expected to be an array of strings");
+    }
+
+    result.emplace_back(s.GetString(), s.GetStringLength());
+  }
+
+  return result;
+}
+
+#ifndef _WIN32
+void sync_file(int fd, const std::string &path) {
+  if (::fsync(fd) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    throw std::runtime_error("Error '" + shcore::errno_to_string(error) +
+                             "' while syncing journal file '" + path + "'");
+  }
+
+  ::close(fd);
+}
+#endif  // !_WIN32
+
+}  // namespace
+
+Import_journal::Import_journal(const std::string &path) : m_path(path) {}
+
+void Import_journal::set_target(const std::string &schema,
+                                const std::string &table,
+                                const std::vector<std::string> &columns) {
+  m_schema = schema;
+  m_table = table;
+  m_columns = columns;
+}
+
+void Import_journal::add_file(const std::string &path, size_t size,
+                              bool compressed) {
+  File file;
+  file.path = path;
+  file.size = size;
+  file.compressed = compressed;
+  m_files.emplace_back(std::move(file));
+}
+
+bool Import_journal::load() {
+  std::string contents;
+
+  if (!shcore::is_file(m_path) || !shcore::load_text_file(m_path, contents)) {
+    return false;
+  }
+
+  const auto mismatch = [this](const std::string &msg) {
+    return std::runtime_error("Journal file '" + m_path + "' " + msg +
+                              ", it cannot be used to resume this import.");
+  };
+
+  std::vector<std::vector<std::pair<size_t, size_t>>> completed;
+
+  try {
+    rapidjson::Document doc;
+    doc.Parse(contents.c_str());
+
+    if (doc.HasParseError()) {
+      throw Invalid_journal(rapidjson::GetParseError_En(doc.GetParseError()));
+    }
+
+    if (!doc.IsObject()) {
+      throw Invalid_journal("object expected");
+    }
+
+    if (m_schema != get_string(doc, "schema") ||
+        m_table != get_string(doc, "table")) {
+      throw mismatch("was written for a different table");
+    }
+
+    if (m_columns != get_strings(doc, "columns")) {
+      throw mismatch("was written for a different list of columns");
+    }
+
+    const auto &dialect = get_object(doc, "dialect");
+
+    if (m_dialect.lines_terminated_by !=
+            get_string(dialect, "linesTerminatedBy") ||
+        m_dialect.fields_escaped_by != get_string(dialect, "fieldsEscapedBy") ||
+        m_dialect.fields_terminated_by !=
+            get_string(dialect, "fieldsTerminatedBy") ||
+        m_dialect.fields_enclosed_by !=
+            get_string(dialect, "fieldsEnclosedBy") ||
+        m_dialect.fields_optionally_enclosed !=
+            get_bool(dialect, "fieldsOptionallyEnclosed") ||
+        m_dialect.lines_starting_by != get_string(dialect, "linesStartingBy")) {
+      throw mismatch("was written using a different dialect");
+    }
+
+    if (m_skip_rows_count != get_uint(doc, "skipRows")) {
+      throw mismatch("was written using a different value of skipRows");
+    }
+
+    const auto &files = get_array(doc, "files");
+
+    if (files.Size() != m_files.size()) {
+      throw mismatch("was written for a different list of files");
+    }
+
+    for (rapidjson::SizeType i = 0; i < files.Size(); ++i) {
+      const auto &file = files[i];
+
+      if (!file.IsObject()) {
+        throw Invalid_journal("file is expected to be an object");
+      }
+
+      if (m_files[i].path != get_string(file, "path")) {
+        throw mismatch("was written for a different list of files");
+      }
+
+      if (m_files[i].size != get_uint(file, "size")) {
+        throw mismatch("was written for file '" + m_files[i].path +
+                       "' of a different size");
+      }
+
+      if (m_files[i].compressed != get_bool(file, "compressed")) {
+        throw mismatch("was written for a different list of files");
+      }
+
+      const auto &ranges = get_array(file, "completed");
+      completed.emplace_back();
+
+      for (rapidjson::SizeType j = 0; j < ranges.Size(); ++j) {
+        const auto &range = ranges[j];
+
+        if (!range.IsArray() || range.Size() != 2 || !range[0].IsUint64() ||
+            !range[1].IsUint64() ||
+            range[0].GetUint64() >= range[1].GetUint64() ||
+            // offsets in the decompressed stream are not bounded by the size
+            (!m_files[i].compressed &&
+             range[1].GetUint64() > m_files[i].size)) {
+          throw Invalid_journal("invalid completed range of file '" +
+                                m_files[i].path + "'");
+        }
+
+        completed.back().emplace_back(range[0].GetUint64(),
+                                      range[1].GetUint64());
+      }
+    }
+  } catch (const Invalid_journal &e) {
+    throw std::runtime_error("Journal file '" + m_path +
+                             "' is not valid: " + e.what());
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (size_t i = 0; i < m_files.size(); ++i) {
+    m_files[i].completed.clear();
+
+    for (const auto &range : completed[i]) {
+      add_completed(&m_files[i], range.first, range.second);
+    }
+  }
+
+  return true;
+}
+
+void Import_journal::save() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  write(to_json());
+}
+
+void Import_journal::complete(const Range &range) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (range.file < m_files.size() && range.begin < range.end) {
+    add_completed(&m_files[range.file], range.begin, range.end);
+    write(to_json());
+  }
+}
+
+std::vector<Range> Import_journal::pending(const Range &range) const {
+  std::vector<Range> parts;
+
+  const auto add = [&range, &parts](size_t begin, size_t end) {
+    Range part{begin, end, range.data, range.file};
+
+    if (range.data && (begin != range.begin || end != range.end)) {
+      part.data = std::make_shared<const std::string>(
+          range.data->substr(begin - range.begin, end - begin));
+    }
+
+    parts.emplace_back(std::move(part));
+  };
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (range.file >= m_files.size()) {
+    parts.emplace_back(range);
+    return parts;
+  }
+
+  size_t position = range.begin;
+
+  for (const auto &completed : m_files[range.file].completed) {
+    if (completed.second <= position) {
+      continue;
+    }
+
+    if (completed.first >= range.end) {
+      break;
+    }
+
+    if (completed.first > position) {
+      add(position, completed.first);
+    }
+
+    position = completed.second;
+
+    if (position >= range.end) {
+      break;
+    }
+  }
+
+  if (position < range.end) {
+    add(position, range.end);
+  }
+
+  return parts;
+}
+
+void Import_journal::remove() { shcore::delete_file(m_path, true); }
+
+void Import_journal::add_completed(File *file, size_t begin, size_t end) {
+  auto &completed = file->completed;
+
+  // first range which ends at or after the new one begins
+  auto first = std::lower_bound(
+      completed.begin(), completed.end(), begin,
+      [](const std::pair<size_t, size_t> &r, size_t offset) {
+        return r.second < offset;
+      });
+  // first range which begins after the new one ends
+  auto last = std::upper_bound(
+      first, completed.end(), end,
+      [](size_t offset, const std::pair<size_t, size_t> &r) {
+        return offset < r.first;
+      });
+
+  // merge overlapping and adjacent ranges
+  if (first != last) {
+    begin = std::min(begin, first->first);
+    end = std::max(end, (last - 1)->second);
+  }
+
+  completed.insert(completed.erase(first, last), std::make_pair(begin, end));
+}
+
+std::string Import_journal::to_json() const {
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+  const auto string = [&writer](const std::string &s) {
+    writer.String(s.c_str(), static_cast<rapidjson::SizeType>(s.length()));
+  };
+
+  writer.StartObject();
+
+  writer.Key("schema");
+  string(m_schema);
+  writer.Key("table");
+  string(m_table);
+
+  writer.Key("columns");
+  writer.StartArray();
+
+  for (const auto &column : m_columns) {
+    string(column);
+  }
+
+  writer.EndArray();
+
+  writer.Key("dialect");
+  writer.StartObject();
+  writer.Key("linesTerminatedBy");
+  string(m_dialect.lines_terminated_by);
+  writer.Key("fieldsEscapedBy");
+  string(m_dialect.fields_escaped_by);
+  writer.Key("fieldsTerminatedBy");
+  string(m_dialect.fields_terminated_by);
+  writer.Key("fieldsEnclosedBy");
+  string(m_dialect.fields_enclosed_by);
+  writer.Key("fieldsOptionallyEnclosed");
+  writer.Bool(m_dialect.fields_optionally_enclosed);
+  writer.Key("linesStartingBy");
+  string(m_dialect.lines_starting_by);
+  writer.EndObject();
+
+  writer.Key("skipRows");
+  writer.Uint64(m_skip_rows_count);
+
+  writer.Key("files");
+  writer.StartArray();
+
+  for (const auto &file : m_files) {
+    writer.StartObject();
+    writer.Key("path");
+    string(file.path);
+    writer.Key("size");
+    writer.Uint64(file.size);
+    writer.Key("compressed");
+    writer.Bool(file.compressed);
+    writer.Key("completed");
+    writer.StartArray();
+
+    for (const auto &range : file.completed) {
+      writer.StartArray();
+      writer.Uint64(range.first);
+      writer.Uint64(range.second);
+      writer.EndArray();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+  writer.EndObject();
+
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+void Import_journal::write(const std::string &contents) const {
+  const auto tmp_path = m_path + ".tmp";
+
+  // contents have to reach the disk before the rename, otherwise a crash could
+  // leave an empty journal in place of the previous one
+#ifdef _WIN32
+  const HANDLE file =
+      CreateFileA(tmp_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                  FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Unable to open journal file '" + tmp_path +
+                             "' for writing: " +
+                             shcore::last_error_to_string(GetLastError()));
+  }
+
+  DWORD written = 0;
+  const bool ok = WriteFile(file, contents.data(),
+                            static_cast<DWORD>(contents.size()), &written,
+                            nullptr) &&
+                  written == contents.size() && FlushFileBuffers(file);
+  const auto error = GetLastError();
+  CloseHandle(file);
+
+  if (!ok) {
+    throw std::runtime_error("Error '" + shcore::last_error_to_string(error) +
+                             "' while writing journal file '" + tmp_path +
+                             "'");
+  }
+
+  // replace the journal in one step, so that it is never left incomplete
+  if (!MoveFileExA(tmp_path.c_str(), m_path.c_str(),
+                   MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+    throw std::runtime_error("Could not rename '" + tmp_path + "' to '" +
+                             m_path + "'");
+  }
+#else
+  const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+
+  if (fd < 0) {
+    throw std::runtime_error("Unable to open journal file '" + tmp_path +
+                             "' for writing: " +
+                             shcore::errno_to_string(errno));
+  }
+
+  const char *data = contents.data();
+  size_t left = contents.size();
+
+  while (left > 0) {
+    const auto bytes = ::write(fd, data, left);
+
+    if (bytes < 0) {
+      if (errno == EINTR) continue;
+
+      const auto error = errno;
+      ::close(fd);
+      throw std::runtime_error("Error '" + shcore::errno_to_string(error) +
+                               "' while writing journal file '" + tmp_path +
+                               "'");
+    }
+
+    data += bytes;
+    left -= static_cast<size_t>(bytes);
+  }
+
+  sync_file(fd, tmp_path);
+
+  // replace the journal in one step, so that it is never left incomplete
+  shcore::rename_file(tmp_path, m_path);
+
+  // persist the rename
+  const int dir = ::open(shcore::path::dirname(m_path).c_str(), O_RDONLY);
+
+  if (dir >= 0) {
+    ::fsync(dir);
+    ::close(dir);
+  }
+#endif
+}
+
+}  // namespace import_table
+}  // namespace mysqlsh
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_IMPORT_TABLE_JOURNAL_H_
+#define MODULES_UTIL_IMPORT_TABLE_JOURNAL_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "modules/util/import_table/chunk_file.h"
+#include "modules/util/import_table/dialect.h"
+
+namespace mysqlsh {
+namespace import_table {
+
+/**
+ * Persistent record of the ranges loaded by util.importTable, used to resume
+ * an interrupted import.
+ *
+ * Journal describes the import (target table and columns, files, dialect and
+ * number of skipped rows) and holds completed ranges of each file. Completed
+ * ranges end on row boundaries, so parts of the new chunks which are not
+ * covered by them can be loaded even if chunk boundaries differ between the
+ * runs.
+ */
+class Import_journal final {
+ public:
+  Import_journal() = delete;
+  explicit Import_journal(const std::string &path);
+
+  Import_journal(const Import_journal &other) = delete;
+  Import_journal(Import_journal &&other) = delete;
+
+  Import_journal &operator=(const Import_journal &other) = delete;
+  Import_journal &operator=(Import_journal &&other) = delete;
+
+  ~Import_journal() = default;
+
+  const std::string &path() const { return m_path; }
+
+  void set_target(const std::string &schema, const std::string &table,
+                  const std::vector<std::string> &columns);
+  void set_dialect(const Dialect &dialect) { m_dialect = dialect; }
+  void set_rows_to_skip(const uint64_t rows) { m_skip_rows_count = rows; }
+
+  /**
+   * Adds a file to the import.
+   *
+   * @param path Path to the file.
+   * @param size Size of the file.
+   * @param compressed If true, ranges of the file are offsets in the
+   *        decompressed stream, which can exceed the size of the file.
+   */
+  void add_file(const std::string &path, size_t size, bool compressed = false);
+
+  /**
+   * Reads completed ranges from the journal file.
+   *
+   * @return false if journal file does not exist.
+   *
+   * @throws std::runtime_error if journal file is not valid or describes a
+   * different import.
+   */
+  bool load();
+
+  /**
+   * Writes journal file. Temporary file is written and synced first and then
+   * renamed, so that journal file is always complete, even after a crash.
+   */
+  void save();
+
+  /**
+   * Records that the range was loaded and saves the journal. Safe to call from
+   * multiple threads.
+   */
+  void complete(const Range &range);
+
+  /**
+   * Parts of the range which were not loaded yet, in file order. If range
+   * holds data, each part holds its portion of the data.
+   */
+  std::vector<Range> pending(const Range &range) const;
+
+  /**
+   * Deletes journal file.
+   */
+  void remove();
+
+ private:
+  struct File {
+    std::string path;
+    size_t size = 0;
+    bool compressed = false;
+    /// Sorted, non-overlapping and non-adjacent ranges which were loaded
+    std::vector<std::pair<size_t, size_t>> completed;
+  };
+
+  /**
+   * Adds range to the completed ranges of the file, merging it with the
+   * overlapping and adjacent ones. Mutex has to be locked.
+   */
+  static void add_completed(File *file, size_t begin, size_t end);
+
+  std::string to_json() const;
+
+  void write(const std::string &contents) const;
+
+  std::string m_path;
+  std::string m_schema;
+  std::string m_table;
+  std::vector<std::string> m_columns;
+  Dialect m_dialect;
+  uint64_t m_skip_rows_count = 0;
+  std::vector<File> m_files;
+  mutable std::mutex m_mutex;
+};
+
+}  // namespace import_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_TABLE_JOURNAL_H_
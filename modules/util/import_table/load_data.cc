@@ -39,6 +39,8 @@ using off64_t = off_t;
 
 #include <mysql.h>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <memory>
 #include "modules/util/import_table/helpers.h"
 #include "mysqlshdk/include/shellcore/console.h"
@@ -50,8 +52,34 @@ using off64_t = off_t;
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+/**
+ * Adds time elapsed since the last update to the busy time of the worker.
+ */
+void update_busy_time(File_info *file_info) {
+  if (file_info->stats) {
+    const auto now = std::chrono::steady_clock::now();
+    file_info->stats->busy_time +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - file_info->last_update)
+            .count();
+    file_info->last_update = now;
+  }
+}
+
+}  // namespace
+
 int local_infile_init(void **buffer, const char *filename, void *userdata) {
   File_info *file_info = static_cast<File_info *>(userdata);
+
+  if (file_info->chunk_data) {
+    // chunk was already read by the chunker
+    *buffer = file_info;
+    file_info->rate_limit = mysqlshdk::utils::Rate_limit(file_info->max_rate);
+    return 0;
+  }
+
   // todo(kg): we can get rid of file open and close (in local_infile_end()).
   //           We can open it when constructing File_info object.
   file_info->filehandler->open();
@@ -67,6 +95,10 @@ int local_infile_init(void **buffer, const char *filename, void *userdata) {
     return 1;
   }
 
+  // whole chunk is read sequentially, remote files fetch it ahead of the reads
+  file_info->filehandler->advise_read_end(file_info->chunk_start +
+                                          file_info->bytes_left);
+
   *buffer = file_info;
 
   file_info->rate_limit = mysqlshdk::utils::Rate_limit(file_info->max_rate);
@@ -78,16 +110,32 @@ int local_infile_read(void *userdata, char *buffer, unsigned int length) {
 
   size_t len = std::min({static_cast<size_t>(length), file_info->bytes_left});
 
-  auto bytes = file_info->filehandler->read(buffer, len);
-  if (bytes == -1) return bytes;
+  ssize_t bytes = 0;
+
+  if (file_info->chunk_data) {
+    const auto &data = *file_info->chunk_data;
+    memcpy(buffer, data.data() + data.size() - file_info->bytes_left, len);
+    bytes = len;
+    // progress of compressed files is reported by the chunker
+  } else {
+    bytes = file_info->filehandler->read(buffer, len);
+    if (bytes == -1) return bytes;
+    *(file_info->prog_bytes) += bytes;
+  }
 
   file_info->bytes_left -= bytes;
-  *(file_info->prog_bytes) += bytes;
 
   if (file_info->rate_limit.enabled()) {
     file_info->rate_limit.throttle(bytes);
   }
 
+  // time between reads is spent by the server processing the data, rate is
+  // updated while chunk is loaded, so that stragglers are noticed early
+  if (file_info->stats) {
+    file_info->stats->bytes += bytes;
+    update_busy_time(file_info);
+  }
+
   if (*file_info->user_interrupt) {
     return -1;
   }
@@ -116,7 +164,12 @@ void local_infile_end(void *userdata) {
     }
   }
 
-  file_info->filehandler->close();
+  if (file_info->chunk_data) {
+    // let the chunker reuse the memory
+    file_info->chunk_data.reset();
+  } else {
+    file_info->filehandler->close();
+  }
 }
 
 int local_infile_error(void *userdata, char *error_msg,
@@ -134,9 +187,9 @@ Load_data_worker::Load_data_worker(
     const Import_table_options &options, int64_t thread_id,
     mysqlshdk::textui::IProgress *progress,
     std::atomic<size_t> *prog_sent_bytes, std::mutex *output_mutex,
-    volatile bool *interrupt, shcore::Synchronized_queue<Range> *range_queue,
+    volatile bool *interrupt, shcore::Bounded_queue<Range> *range_queue,
     std::vector<std::exception_ptr> *thread_exception, bool use_json,
-    Stats *stats)
+    Stats *stats, Worker_stats *worker_stats, Import_journal *journal)
     : m_opt(options),
       m_thread_id(thread_id),
       m_progress(progress),
@@ -146,7 +199,9 @@ Load_data_worker::Load_data_worker(
       m_range_queue(*range_queue),
       m_thread_exception(*thread_exception),
       m_use_json(use_json),
-      m_stats(*stats) {}
+      m_stats(*stats),
+      m_worker_stats(worker_stats),
+      m_journal(journal) {}
 
 void Load_data_worker::operator()() {
   try {
@@ -157,14 +212,13 @@ void Load_data_worker::operator()() {
     auto const conn_opts = m_opt.connection_options();
 
     File_info fi;
-    fi.filename = m_opt.full_path();
-    fi.filehandler = make_file_handler(m_opt.full_path());
     fi.worker_id = m_thread_id;
     fi.prog = m_opt.show_progress() ? m_progress : nullptr;
     fi.prog_bytes = &m_prog_sent_bytes;
     fi.prog_mutex = &m_output_mutex;
     fi.user_interrupt = &m_interrupt;
     fi.max_rate = m_opt.max_rate();
+    fi.stats = m_worker_stats;
 
     session->set_local_infile_userdata(static_cast<void *>(&fi));
     session->set_local_infile_init(local_infile_init);
@@ -194,26 +248,53 @@ void Load_data_worker::operator()() {
       query_template += " (" + placeholders + ")";
     }
 
-    shcore::sqlstring sql(query_template, 0);
-    sql << fi.filename << m_opt.schema() << m_opt.table();
-    for (const auto &col : columns) {
-      sql << col;
-    }
-    sql.done();
+    const auto &files = m_opt.files();
+    // index of the file currently opened by the worker
+    size_t current_file = files.size();
+    shcore::sqlstring sql;
 
     char worker_name[64];
     snprintf(worker_name, sizeof(worker_name), "[Worker%03u] ",
              static_cast<unsigned int>(m_thread_id));
 
     while (true) {
+      const auto wait_start = std::chrono::steady_clock::now();
       const auto r = m_range_queue.pop();
+      fi.last_update = std::chrono::steady_clock::now();
+
+      if (m_worker_stats) {
+        m_worker_stats->idle_time +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                fi.last_update - wait_start)
+                .count();
+      }
 
       if (r.begin == 0 && r.end == 0) {
         break;
       }
 
+      if (r.file != current_file) {
+        current_file = r.file;
+        fi.filename = files[current_file].full_path;
+        fi.filehandler = make_file_handler(fi.filename, m_opt.read_ahead());
+
+        sql = shcore::sqlstring(query_template, 0);
+        sql << fi.filename << m_opt.schema() << m_opt.table();
+        for (const auto &col : columns) {
+          sql << col;
+        }
+        sql.done();
+      }
+
       fi.chunk_start = r.begin;
       fi.bytes_left = r.end - r.begin;
+      fi.chunk_data = r.data;
+
+      // files are identified by name only if there are more of them
+      const std::string range_info =
+          (files.size() > 1 ? " @ file '" + fi.filename + "'" : " @ file") +
+          " bytes range [" + std::to_string(r.begin) + ", " +
+          std::to_string(r.end) + ")";
 
       std::shared_ptr<mysqlshdk::db::IResult> load_result = nullptr;
 
@@ -225,8 +306,7 @@ void Load_data_worker::operator()() {
         m_progress->clear_status();
         const std::string error_msg{
             worker_name + m_opt.schema() + "." + m_opt.table() + ": " +
-            e.format() + " @ file bytes range [" + std::to_string(r.begin) +
-            ", " + std::to_string(r.end) + ")"};
+            e.format() + range_info};
         mysqlsh::current_console()->print_error(error_msg);
         m_progress->show_status(!m_use_json);
         throw std::runtime_error(error_msg);
@@ -236,8 +316,7 @@ void Load_data_worker::operator()() {
         m_progress->clear_status();
         const std::string error_msg{
             worker_name + m_opt.schema() + "." + m_opt.table() + ": " +
-            e.what() + " @ file bytes range [" + std::to_string(r.begin) +
-            ", " + std::to_string(r.end) + ")"};
+            e.what() + range_info};
         mysqlsh::current_console()->print_error(error_msg);
         m_progress->show_status(!m_use_json);
         throw std::runtime_error(error_msg);
@@ -247,13 +326,19 @@ void Load_data_worker::operator()() {
         m_progress->clear_status();
         const std::string error_msg{
             worker_name + m_opt.schema() + "." + m_opt.table() + ": " +
-            e.what() + " @ file bytes range [" + std::to_string(r.begin) +
-            ", " + std::to_string(r.end) + ")"};
+            e.what() + range_info};
         mysqlsh::current_console()->print_error(error_msg);
         m_progress->show_status(!m_use_json);
         throw std::exception(e);
       }
 
+      // server finished processing the last part of the chunk
+      update_busy_time(&fi);
+
+      if (m_journal) {
+        m_journal->complete(r);
+      }
+
       const auto warnings_num =
           load_result ? load_result->get_warning_count() : 0;
 
@@ -338,6 +423,16 @@ void Load_data_worker::operator()() {
     }
   } catch (...) {
     m_thread_exception[m_thread_id] = std::current_exception();
+
+    // range queue is bounded, keep consuming the ranges so that chunking does
+    // not wait for the failed worker
+    while (true) {
+      const auto r = m_range_queue.pop();
+
+      if (r.begin == 0 && r.end == 0) {
+        break;
+      }
+    }
   }
 }
 
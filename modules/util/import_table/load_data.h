@@ -25,6 +25,7 @@
 #define MODULES_UTIL_IMPORT_TABLE_LOAD_DATA_H_
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -33,9 +34,10 @@
 #include "modules/util/import_table/chunk_file.h"
 #include "modules/util/import_table/import_table.h"
 #include "modules/util/import_table/import_table_options.h"
+#include "modules/util/import_table/journal.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
+#include "mysqlshdk/libs/utils/bounded_queue.h"
 #include "mysqlshdk/libs/utils/rate_limit.h"
-#include "mysqlshdk/libs/utils/synchronized_queue.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -52,6 +54,10 @@ struct File_info {
   std::unique_ptr<IFile> filehandler = nullptr;
   size_t chunk_start = 0;  //< File chunk start offset
   size_t bytes_left = 0;   //< Bytes left to read from file
+  std::shared_ptr<const std::string> chunk_data;  //< In-memory chunk contents
+
+  Worker_stats *stats = nullptr;  //< Load rate of the worker
+  std::chrono::steady_clock::time_point last_update;  //< Last stats update
 
   std::mutex *prog_mutex;  //< Pointer to mutex for progress bar access
   mysqlshdk::textui::IProgress *prog;  //< Pointer to current progress bar
@@ -74,9 +80,10 @@ class Load_data_worker final {
                    mysqlshdk::textui::IProgress *progress,
                    std::atomic<size_t> *prog_sent_bytes,
                    std::mutex *output_mutex, volatile bool *interrupt,
-                   shcore::Synchronized_queue<Range> *range_queue,
+                   shcore::Bounded_queue<Range> *range_queue,
                    std::vector<std::exception_ptr> *thread_exception,
-                   bool use_json, Stats *stats);
+                   bool use_json, Stats *stats, Worker_stats *worker_stats,
+                   Import_journal *journal);
   Load_data_worker(const Load_data_worker &other) = default;
   Load_data_worker(Load_data_worker &&other) = default;
 
@@ -94,10 +101,12 @@ class Load_data_worker final {
   std::atomic<size_t> &m_prog_sent_bytes;
   std::mutex &m_output_mutex;
   volatile bool &m_interrupt;
-  shcore::Synchronized_queue<Range> &m_range_queue;
+  shcore::Bounded_queue<Range> &m_range_queue;
   std::vector<std::exception_ptr> &m_thread_exception;
   bool m_use_json;
   Stats &m_stats;
+  Worker_stats *m_worker_stats;
+  Import_journal *m_journal;
 };
 
 }  // namespace import_table
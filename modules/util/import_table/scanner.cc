@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/import_table/scanner.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define IMPORT_TABLE_SCANNER_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SCANNER_TARGET(arch) __attribute__((target(arch)))
+#else
+#define SCANNER_TARGET(arch)
+#endif
+
+namespace mysqlsh {
+namespace import_table {
+
+namespace {
+
+const uint8_t *find_byte_scalar(const uint8_t *first, const uint8_t *last,
+                                uint8_t needle) {
+  if (first >= last) return last;
+  const void *p = std::memchr(first, needle, last - first);
+  return p ? static_cast<const uint8_t *>(p) : last;
+}
+
+#ifdef IMPORT_TABLE_SCANNER_X86_64
+
+inline int count_trailing_zeros(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+SCANNER_TARGET("sse2")
+const uint8_t *find_byte_sse2(const uint8_t *first, const uint8_t *last,
+                              uint8_t needle) {
+  const __m128i pattern = _mm_set1_epi8(static_cast<char>(needle));
+
+  while (last - first >= 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+    const uint32_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+    if (mask != 0) {
+      return first + count_trailing_zeros(mask);
+    }
+    first += 16;
+  }
+
+  for (; first < last; ++first) {
+    if (*first == needle) return first;
+  }
+  return last;
+}
+
+SCANNER_TARGET("avx2")
+const uint8_t *find_byte_avx2(const uint8_t *first, const uint8_t *last,
+                              uint8_t needle) {
+  const __m256i pattern = _mm256_set1_epi8(static_cast<char>(needle));
+
+  // two vectors per iteration, terminators are usually sparse
+  while (last - first >= 64) {
+    const __m256i lo =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+    const __m256i hi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first + 32));
+    const __m256i eq_lo = _mm256_cmpeq_epi8(lo, pattern);
+    const __m256i eq_hi = _mm256_cmpeq_epi8(hi, pattern);
+
+    if (!_mm256_testz_si256(_mm256_or_si256(eq_lo, eq_hi),
+                            _mm256_set1_epi8(-1))) {
+      const uint32_t mask_lo =
+          static_cast<uint32_t>(_mm256_movemask_epi8(eq_lo));
+      if (mask_lo != 0) {
+        return first + count_trailing_zeros(mask_lo);
+      }
+      const uint32_t mask_hi =
+          static_cast<uint32_t>(_mm256_movemask_epi8(eq_hi));
+      return first + 32 + count_trailing_zeros(mask_hi);
+    }
+    first += 64;
+  }
+
+  while (last - first >= 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+    const uint32_t mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+    if (mask != 0) {
+      return first + count_trailing_zeros(mask);
+    }
+    first += 32;
+  }
+
+  for (; first < last; ++first) {
+    if (*first == needle) return first;
+  }
+  return last;
+}
+
+bool cpu_has_avx2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  // OS has to preserve YMM registers on context switch
+  if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // IMPORT_TABLE_SCANNER_X86_64
+
+}  // namespace
+
+bool scanner_supported(Scanner_impl impl) {
+  switch (impl) {
+    case Scanner_impl::Scalar:
+      return true;
+#ifdef IMPORT_TABLE_SCANNER_X86_64
+    case Scanner_impl::Sse2:
+      // SSE2 is part of x86-64 baseline
+      return true;
+    case Scanner_impl::Avx2: {
+      static const bool avx2 = cpu_has_avx2();
+      return avx2;
+    }
+#else
+    case Scanner_impl::Sse2:
+    case Scanner_impl::Avx2:
+      return false;
+#endif
+  }
+  return false;
+}
+
+Scanner_impl scanner_best_impl() {
+  static const Scanner_impl best = []() {
+    if (scanner_supported(Scanner_impl::Avx2)) return Scanner_impl::Avx2;
+    if (scanner_supported(Scanner_impl::Sse2)) return Scanner_impl::Sse2;
+    return Scanner_impl::Scalar;
+  }();
+  return best;
+}
+
+const char *scanner_name(Scanner_impl impl) {
+  switch (impl) {
+    case Scanner_impl::Scalar:
+      return "scalar";
+    case Scanner_impl::Sse2:
+      return "sse2";
+    case Scanner_impl::Avx2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+Find_byte_function scanner_find_byte(Scanner_impl impl) {
+  if (!scanner_supported(impl)) return nullptr;
+
+  switch (impl) {
+    case Scanner_impl::Scalar:
+      return &find_byte_scalar;
+#ifdef IMPORT_TABLE_SCANNER_X86_64
+    case Scanner_impl::Sse2:
+      return &find_byte_sse2;
+    case Scanner_impl::Avx2:
+      return &find_byte_avx2;
+#else
+    case Scanner_impl::Sse2:
+    case Scanner_impl::Avx2:
+      break;
+#endif
+  }
+  return nullptr;
+}
+
+const uint8_t *find_byte(const uint8_t *first, const uint8_t *last,
+                         uint8_t needle) {
+  static const Find_byte_function impl =
+      scanner_find_byte(scanner_best_impl());
+  return impl(first, last, needle);
+}
+
+}  // namespace import_table
+}  // namespace mysqlsh
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_IMPORT_TABLE_SCANNER_H_
+#define MODULES_UTIL_IMPORT_TABLE_SCANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mysqlsh {
+namespace import_table {
+
+/**
+ * Byte scanner implementations used when looking for line terminators in
+ * file buffers.
+ */
+enum class Scanner_impl { Scalar, Sse2, Avx2 };
+
+using Find_byte_function = const uint8_t *(*)(const uint8_t *first,
+                                              const uint8_t *last,
+                                              uint8_t needle);
+
+/**
+ * Returns the best scanner implementation supported by the CPU the shell is
+ * running on. Detection is done once.
+ */
+Scanner_impl scanner_best_impl();
+
+/**
+ * Checks if given scanner implementation can be used on this CPU.
+ */
+bool scanner_supported(Scanner_impl impl);
+
+/**
+ * Returns human readable name of the scanner implementation.
+ */
+const char *scanner_name(Scanner_impl impl);
+
+/**
+ * Returns find_byte() implementation of the given type, or nullptr if it is
+ * not supported by this CPU.
+ */
+Find_byte_function scanner_find_byte(Scanner_impl impl);
+
+/**
+ * Searches for the first byte equal to needle in range [first, last), using
+ * the best implementation available at runtime.
+ *
+ * @param first Pointer to the first byte of the range.
+ * @param last Pointer one past the last byte of the range.
+ * @param needle Byte to look for.
+ * @return Pointer to the first matching byte, or last if there is no match.
+ */
+const uint8_t *find_byte(const uint8_t *first, const uint8_t *last,
+                         uint8_t needle);
+
+}  // namespace import_table
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_TABLE_SCANNER_H_
@@ -27,11 +27,17 @@
 #else
 #include <sys/select.h>
 #endif
+#include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <istream>
+#include <thread>
 #include <utility>
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/db/mysqlx/util/setter_any.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
 #include "mysqlshdk/libs/utils/utils_buffered_input.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
@@ -180,9 +186,37 @@ Json_importer Prepare_json_import::build() {
  */
 static constexpr const int k_inserts_per_transaction = 8;
 
-Json_importer::Json_importer(
-    const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session)
-    : m_session(session) {
+/*
+ * Parsed documents are handed over to the insert workers in batches of this
+ * size, at most k_batches_per_worker batches per worker are waiting to be
+ * inserted.
+ */
+static constexpr const size_t k_batch_bytes = 1024 * 1024;
+static constexpr const size_t k_batches_per_worker = 4;
+
+namespace {
+
+/**
+ * Parsed documents stored one after another in a single buffer. Batches are
+ * reused once they are inserted.
+ */
+struct Document_batch {
+  std::string data;
+  std::vector<size_t> ends;  //< End offset of each document
+
+  void clear() {
+    data.clear();
+    ends.clear();
+  }
+};
+
+}  // namespace
+
+Json_insert_worker::Json_insert_worker(
+    const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session,
+    const ::Mysqlx::Crud::Insert &insert,
+    const std::function<void(uint64_t)> &on_imported)
+    : m_batch_insert(insert), m_session(session), m_on_imported(on_imported) {
   // Safe bandwidth by disabling gtids tracking
   session->execute("set session session_track_gtids=OFF");
   auto result = session->query("SELECT @@mysqlx_max_allowed_packet");
@@ -192,71 +226,7 @@ Json_importer::Json_importer(
   m_packet_size_tracker.max_packet = row->get_uint(0);
 }
 
-void Json_importer::set_target_table(const std::string &schema,
-                                     const std::string &table,
-                                     const std::string &column) {
-  m_batch_insert.mutable_collection()->set_name(table);
-  m_batch_insert.mutable_collection()->set_schema(schema);
-  m_batch_insert.mutable_projection()->Add()->set_name(column);
-  m_batch_insert.set_data_model(Mysqlx::Crud::TABLE);
-}
-
-void Json_importer::set_target_collection(const std::string &schema,
-                                          const std::string &collection) {
-  m_batch_insert.mutable_collection()->set_name(collection);
-  m_batch_insert.mutable_collection()->set_schema(schema);
-  m_batch_insert.set_data_model(Mysqlx::Crud::DOCUMENT);
-}
-
-void Json_importer::set_print_callback(
-    const std::function<void(const std::string &)> &callback) {
-  m_print = callback;
-}
-
-void Json_importer::print_stats() {
-  using mysqlshdk::utils::format_bytes;
-  using mysqlshdk::utils::format_seconds;
-  using mysqlshdk::utils::format_throughput_items;
-
-  m_stats.timer.stage_end();
-  double import_time_seconds = m_stats.timer.total_seconds_ellapsed();
-
-  if (m_print) {
-    auto human_bytes = format_bytes(m_stats.bytes_processed);
-    auto human_time = format_seconds(import_time_seconds);
-    const std::string msg =
-        "\nProcessed " + human_bytes + " in " +
-        std::to_string(m_stats.items_processed) +
-        (m_stats.items_processed == 1 ? " document" : " documents") + " in " +
-        human_time + " (" +
-        format_throughput_items("document", "documents",
-                                m_stats.items_processed, import_time_seconds) +
-        ")" + "\nTotal successfully imported documents " +
-        std::to_string(m_stats.documents_successfully_imported) + " (" +
-        format_throughput_items("document", "documents",
-                                m_stats.documents_successfully_imported,
-                                import_time_seconds) +
-        ")\n";
-    m_print(msg);
-  }
-}
-
-void Json_importer::load_from(const shcore::Document_reader_options &options) {
-  shcore::Buffered_input input{};
-  m_stats.timer.stage_begin("Importing documents");
-
-  if (!m_file_path.empty()) {
-    auto full_path = shcore::path::expand_user(m_file_path);
-    input.open(full_path);
-  }
-
-  load_from(&input, options);
-}
-
-void Json_importer::load_from(shcore::Buffered_input *input,
-                              const shcore::Document_reader_options &options) {
-  m_stats.items_processed = 0;
-  m_stats.bytes_processed = 0;
+void Json_insert_worker::begin() {
   m_packet_size_tracker.inserts_in_this_transaction = 0;
 
   // schema and collection target are already set here, so we can cache
@@ -264,33 +234,31 @@ void Json_importer::load_from(shcore::Buffered_input *input,
   m_packet_size_tracker.crud_insert_overhead_bytes = m_batch_insert.ByteSize();
 
   m_session->execute("START TRANSACTION");
+}
 
-  bool cancel = false;
-  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
-    cancel = true;
-    return false;
-  });
-
-  shcore::Json_reader reader(input, options);
+void Json_insert_worker::finish() {
+  flush();
+  commit(true);
+}
 
-  while (!reader.eof() && !cancel) {
-    std::string jd = reader.next();
+void Json_insert_worker::rollback() {
+  m_batch_insert.mutable_row()->Clear();
+  m_packet_size_tracker.bytes_in_insert = 0;
+  m_packet_size_tracker.rows_in_insert = 0;
+  m_packet_size_tracker.inserts_in_this_transaction = 0;
 
-    if (!jd.empty()) {
-      // todo(kg): move jd string all the way to protobuf's
-      // Scalar_String::set_value
-      put(std::move(jd));
-    }
+  // errors of the discarded inserts are not relevant anymore
+  while (m_pending_response > 0) {
+    xcl::XError error;
+    m_session->get_driver_obj()->get_protocol().recv_resultset(&error);
+    m_pending_response--;
   }
 
-  flush();
-  commit(true);
-
-  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+  m_session->execute("ROLLBACK");
 }
 
-void Json_importer::put(const std::string &item) {
-  if (m_packet_size_tracker.will_overflow(item.size())) {
+void Json_insert_worker::put(const char *item, size_t size) {
+  if (m_packet_size_tracker.will_overflow(size)) {
     flush();
     if (m_packet_size_tracker.inserts_in_this_transaction >=
         k_inserts_per_transaction) {
@@ -298,25 +266,25 @@ void Json_importer::put(const std::string &item) {
     }
   }
 
-  m_stats.bytes_processed += item.size();
+  m_stats.bytes_processed += size;
   m_stats.items_processed++;
-  add_to_request(item);
+  add_to_request(item, size);
 }
 
-void Json_importer::update_statistics(xcl::XQuery_result *xquery_result) {
+void Json_insert_worker::update_statistics(xcl::XQuery_result *xquery_result) {
   if (xquery_result == nullptr) return;
 
   uint64_t affected_rows = 0;
   bool ret = xquery_result->try_get_affected_rows(&affected_rows);
   if (ret) {
     m_stats.documents_successfully_imported += affected_rows;
-    if (m_print) {
-      m_print(".. " + std::to_string(m_stats.documents_successfully_imported));
+    if (m_on_imported) {
+      m_on_imported(affected_rows);
     }
   }
 }
 
-void Json_importer::recv_response(bool block) {
+void Json_insert_worker::recv_response(bool block) {
   if (m_pending_response > 0) {
     my_socket fd = m_session->get_driver_obj()
                        ->get_protocol()
@@ -334,14 +302,15 @@ void Json_importer::recv_response(bool block) {
       xcl::XError error;
       auto result =
           m_session->get_driver_obj()->get_protocol().recv_resultset(&error);
+      // response is consumed even if it's an error
+      m_pending_response--;
       update_statistics(result.get());
       if (error) throw mysqlshdk::db::Error(error.what(), error.error());
-      m_pending_response--;
     }
   }
 }
 
-void Json_importer::flush() {
+void Json_insert_worker::flush() {
   if (m_packet_size_tracker.rows_in_insert > 0) {
     xcl::XError error;
     if (m_proto_interleaved) {
@@ -361,7 +330,7 @@ void Json_importer::flush() {
   }
 }
 
-void Json_importer::commit(bool final_commit) {
+void Json_insert_worker::commit(bool final_commit) {
   if (m_proto_interleaved) {
     xcl::XError error;
     recv_response(true);
@@ -382,11 +351,312 @@ void Json_importer::commit(bool final_commit) {
   m_packet_size_tracker.inserts_in_this_transaction = 0;
 }
 
-void Json_importer::add_to_request(const std::string &doc) {
-  auto fields = m_batch_insert.mutable_row()->Add()->mutable_field();
-  mysqlshdk::db::mysqlx::util::set_scalar(*fields->Add(), doc);
+void Json_insert_worker::add_to_request(const char *doc, size_t size) {
+  // Rows are cleared after each insert, but not deallocated. Reusing them
+  // together with their nested messages and value buffers, means that in
+  // steady state adding a document does not allocate memory.
+  auto field = m_batch_insert.mutable_row()->Add()->mutable_field()->Add();
+  field->set_type(::Mysqlx::Expr::Expr::LITERAL);
+
+  auto literal = field->mutable_literal();
+  literal->set_type(::Mysqlx::Datatypes::Scalar::V_STRING);
+  literal->mutable_v_string()->mutable_value()->assign(doc, size);
 
-  m_packet_size_tracker.bytes_in_insert += doc.size();
+  m_packet_size_tracker.bytes_in_insert += size;
   m_packet_size_tracker.rows_in_insert++;
 }
+
+Json_importer::Json_importer(
+    const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session)
+    : m_session(session), m_progress(shcore::make_unique<Progress>()) {}
+
+void Json_importer::set_target_table(const std::string &schema,
+                                     const std::string &table,
+                                     const std::string &column) {
+  m_insert.mutable_collection()->set_name(table);
+  m_insert.mutable_collection()->set_schema(schema);
+  m_insert.mutable_projection()->Add()->set_name(column);
+  m_insert.set_data_model(Mysqlx::Crud::TABLE);
+}
+
+void Json_importer::set_target_collection(const std::string &schema,
+                                          const std::string &collection) {
+  m_insert.mutable_collection()->set_name(collection);
+  m_insert.mutable_collection()->set_schema(schema);
+  m_insert.set_data_model(Mysqlx::Crud::DOCUMENT);
+}
+
+void Json_importer::set_print_callback(
+    const std::function<void(const std::string &)> &callback) {
+  m_print = callback;
+}
+
+void Json_importer::print_stats() {
+  using mysqlshdk::utils::format_bytes;
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_items;
+
+  m_timer.stage_end();
+  double import_time_seconds = m_timer.total_seconds_ellapsed();
+
+  uint64_t items_processed = 0;
+  uint64_t bytes_processed = 0;
+  uint64_t documents_successfully_imported = 0;
+
+  for (const auto &worker : m_workers) {
+    items_processed += worker->stats().items_processed;
+    bytes_processed += worker->stats().bytes_processed;
+    documents_successfully_imported +=
+        worker->stats().documents_successfully_imported;
+  }
+
+  if (m_print) {
+    std::string msg;
+
+    if (m_workers.size() > 1) {
+      msg += "\n";
+
+      for (size_t i = 0; i < m_workers.size(); i++) {
+        const auto &stats = m_workers[i]->stats();
+        msg += "Worker " + std::to_string(i + 1) + ": " +
+               std::to_string(stats.documents_successfully_imported) +
+               " imported documents in " +
+               format_seconds(stats.timer.total_seconds_ellapsed()) + " (" +
+               format_throughput_items("document", "documents",
+                                       stats.documents_successfully_imported,
+                                       stats.timer.total_seconds_ellapsed()) +
+               ")\n";
+      }
+    }
+
+    auto human_bytes = format_bytes(bytes_processed);
+    auto human_time = format_seconds(import_time_seconds);
+    msg += "\nProcessed " + human_bytes + " in " +
+           std::to_string(items_processed) +
+           (items_processed == 1 ? " document" : " documents") + " in " +
+           human_time + " (" +
+           format_throughput_items("document", "documents", items_processed,
+                                   import_time_seconds) +
+           ")" + "\nTotal successfully imported documents " +
+           std::to_string(documents_successfully_imported) + " (" +
+           format_throughput_items("document", "documents",
+                                   documents_successfully_imported,
+                                   import_time_seconds) +
+           ")\n";
+    m_print(msg);
+  }
+}
+
+void Json_importer::load_from(const shcore::Document_reader_options &options) {
+  shcore::Buffered_input input{};
+  m_timer.stage_begin("Importing documents");
+
+  if (!m_file_path.empty()) {
+    auto full_path = shcore::path::expand_user(m_file_path);
+    input.open(full_path);
+  }
+
+  load_from(&input, options);
+}
+
+void Json_importer::on_imported(uint64_t documents) {
+  std::lock_guard<std::mutex> lock(m_progress->mutex);
+  m_progress->documents_successfully_imported += documents;
+
+  if (m_print) {
+    m_print(".. " +
+            std::to_string(m_progress->documents_successfully_imported));
+  }
+}
+
+void Json_importer::load_from(shcore::Buffered_input *input,
+                              const shcore::Document_reader_options &options) {
+  m_workers.clear();
+  m_progress->documents_successfully_imported = 0;
+
+  bool cancel = false;
+  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+    cancel = true;
+    return false;
+  });
+
+  shcore::Json_reader reader(input, options);
+
+  if (m_threads > 1) {
+    load_in_parallel(&reader, cancel);
+  } else {
+    m_workers.emplace_back(shcore::make_unique<Json_insert_worker>(
+        m_session, m_insert,
+        [this](uint64_t documents) { on_imported(documents); }));
+    auto &worker = *m_workers.back();
+
+    worker.begin();
+
+    // document buffer is reused, its capacity grows to the largest document
+    std::string jd;
+
+    while (!reader.eof() && !cancel) {
+      jd.clear();
+      reader.next(&jd);
+
+      if (!jd.empty()) {
+        worker.put(jd.data(), jd.size());
+      }
+    }
+
+    worker.finish();
+  }
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+}
+
+void Json_importer::load_in_parallel(shcore::Json_reader *reader,
+                                     const bool &cancel) {
+  using Batch = std::shared_ptr<Document_batch>;
+
+  for (size_t i = 0; i < m_threads; i++) {
+    std::shared_ptr<mysqlshdk::db::mysqlx::Session> session = m_session;
+
+    if (i > 0) {
+      session = mysqlshdk::db::mysqlx::Session::create();
+      session->connect(m_session->get_connection_options());
+    }
+
+    m_workers.emplace_back(shcore::make_unique<Json_insert_worker>(
+        session, m_insert,
+        [this](uint64_t documents) { on_imported(documents); }));
+  }
+
+  shcore::Synchronized_queue<Batch> queue;
+  std::mutex pending_mutex;
+  std::condition_variable pending_cv;
+  size_t pending_batches = 0;
+  std::vector<Batch> free_batches;
+  std::atomic<bool> aborted{false};
+  std::vector<std::exception_ptr> exceptions(m_threads, nullptr);
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < m_threads; i++) {
+    threads.emplace_back([&, i]() {
+      auto &worker = *m_workers[i];
+      worker.stats().timer.stage_begin("Inserting documents");
+
+      bool finished = false;
+
+      try {
+        worker.begin();
+
+        for (auto batch = queue.pop(); batch; batch = queue.pop()) {
+          if (!aborted) {
+            size_t begin = 0;
+
+            for (const auto end : batch->ends) {
+              worker.put(&batch->data[begin], end - begin);
+              begin = end;
+            }
+          }
+
+          {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            --pending_batches;
+            free_batches.emplace_back(std::move(batch));
+          }
+          pending_cv.notify_one();
+        }
+
+        if (!aborted) {
+          worker.finish();
+          finished = true;
+        }
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+        aborted = true;
+        pending_cv.notify_one();
+      }
+
+      if (!finished) {
+        // uncommitted documents are rolled back if any worker failed, first
+        // worker uses the importer's session, it must be left usable
+        try {
+          worker.rollback();
+        } catch (const std::exception &e) {
+          log_warning("Failed to roll back JSON import transaction: %s",
+                      e.what());
+        }
+      }
+
+      worker.stats().timer.stage_end();
+    });
+  }
+
+  std::exception_ptr reader_exception = nullptr;
+
+  try {
+    const size_t max_pending_batches = k_batches_per_worker * m_threads;
+    Batch batch = std::make_shared<Document_batch>();
+
+    const auto push_batch = [&]() {
+      Batch next_batch;
+
+      {
+        std::unique_lock<std::mutex> lock(pending_mutex);
+        pending_cv.wait(lock, [&]() {
+          return pending_batches < max_pending_batches || aborted;
+        });
+        ++pending_batches;
+
+        if (!free_batches.empty()) {
+          next_batch = std::move(free_batches.back());
+          free_batches.pop_back();
+        }
+      }
+
+      queue.push(std::move(batch));
+
+      if (next_batch) {
+        batch = std::move(next_batch);
+        batch->clear();
+      } else {
+        batch = std::make_shared<Document_batch>();
+      }
+    };
+
+    while (!reader->eof() && !cancel && !aborted) {
+      // documents are parsed directly into the batch
+      const size_t size = batch->data.size();
+      reader->next(&batch->data);
+
+      if (batch->data.size() > size) {
+        batch->ends.emplace_back(batch->data.size());
+
+        if (batch->data.size() >= k_batch_bytes) {
+          push_batch();
+        }
+      }
+    }
+
+    if (!batch->ends.empty() && !aborted) {
+      push_batch();
+    }
+  } catch (...) {
+    reader_exception = std::current_exception();
+    aborted = true;
+  }
+
+  queue.shutdown(m_threads);
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  if (reader_exception) {
+    std::rethrow_exception(reader_exception);
+  }
+
+  for (const auto &exc : exceptions) {
+    if (exc) {
+      std::rethrow_exception(exc);
+    }
+  }
+}
 }  // namespace mysqlsh
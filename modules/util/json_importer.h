@@ -24,8 +24,12 @@
 #ifndef MODULES_UTIL_JSON_IMPORTER_H_
 #define MODULES_UTIL_JSON_IMPORTER_H_
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "mysqlshdk/include/scripting/types.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
@@ -183,36 +187,64 @@ class Prepare_json_import {
   bool m_put_to_collection = true;
 };
 
-class Json_importer {
+/**
+ * Sends JSON documents to the server using batched X Protocol Crud::Insert
+ * messages. Each worker uses its own session and transaction.
+ */
+class Json_insert_worker {
  public:
-  explicit Json_importer(
-      const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session);
-  ~Json_importer() {}
+  struct Stats {
+    uint64_t items_processed = 0;
+    uint64_t bytes_processed = 0;
+    uint64_t documents_successfully_imported = 0;
+    mysqlshdk::utils::Profile_timer timer;
+  };
 
-  void set_target_table(const std::string &schema, const std::string &table,
-                        const std::string &column);
-  void set_target_collection(const std::string &schema,
-                             const std::string &collection);
-  void set_print_callback(
-      const std::function<void(const std::string &)> &callback);
+  /**
+   * @param session X session used to insert documents.
+   * @param insert Crud::Insert message with target already set.
+   * @param on_imported Called with number of documents confirmed by the server.
+   */
+  Json_insert_worker(
+      const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session,
+      const ::Mysqlx::Crud::Insert &insert,
+      const std::function<void(uint64_t)> &on_imported);
+  Json_insert_worker(const Json_insert_worker &other) = delete;
+  Json_insert_worker(Json_insert_worker &&other) = delete;
+
+  Json_insert_worker &operator=(const Json_insert_worker &other) = delete;
+  Json_insert_worker &operator=(Json_insert_worker &&other) = delete;
+
+  ~Json_insert_worker() = default;
 
   /**
-   * Set path to JSON document.
-   * @param path Path to JSON document. Empty path enables read from stdin.
+   * Starts the transaction, has to be called before the first put().
    */
-  void set_path(const std::string &path) { m_file_path = path; }
-  void load_from(const shcore::Document_reader_options &options);
+  void begin();
 
-  void print_stats();
+  /**
+   * Adds document to the pending insert, document is copied.
+   */
+  void put(const char *item, size_t size);
+
+  /**
+   * Sends remaining documents and commits the transaction.
+   */
+  void finish();
+
+  /**
+   * Discards the pending documents and responses and rolls back the
+   * transaction, leaving the session ready to be used by other statements.
+   */
+  void rollback();
+
+  Stats &stats() { return m_stats; }
 
  private:
-  void load_from(shcore::Buffered_input *input,
-                 const shcore::Document_reader_options &options);
-  void put(const std::string &item);
   void recv_response(bool block = false);
   void flush();
   void commit(bool final_commit = false);
-  void add_to_request(const std::string &doc);
+  void add_to_request(const char *doc, size_t size);
   void update_statistics(xcl::XQuery_result *xquery_result);
 
   ::Mysqlx::Crud::Insert m_batch_insert;
@@ -286,15 +318,66 @@ class Json_importer {
   const bool m_proto_interleaved = true;
 #endif
   int m_pending_response = 0;
+  std::function<void(uint64_t)> m_on_imported;
+
+  Stats m_stats;
+};
+
+class Json_importer {
+ public:
+  explicit Json_importer(
+      const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session);
+  Json_importer(const Json_importer &other) = delete;
+  Json_importer(Json_importer &&other) = default;
+
+  Json_importer &operator=(const Json_importer &other) = delete;
+  Json_importer &operator=(Json_importer &&other) = delete;
+
+  ~Json_importer() {}
+
+  void set_target_table(const std::string &schema, const std::string &table,
+                        const std::string &column);
+  void set_target_collection(const std::string &schema,
+                             const std::string &collection);
+  void set_print_callback(
+      const std::function<void(const std::string &)> &callback);
+
+  /**
+   * Set path to JSON document.
+   * @param path Path to JSON document. Empty path enables read from stdin.
+   */
+  void set_path(const std::string &path) { m_file_path = path; }
+
+  /**
+   * Set number of insert workers. Documents are parsed by the thread calling
+   * load_from(), each additional worker opens its own X session.
+   */
+  void set_threads(size_t threads) { m_threads = std::max<size_t>(1, threads); }
+
+  void load_from(const shcore::Document_reader_options &options);
+
+  void print_stats();
+
+ private:
+  void load_from(shcore::Buffered_input *input,
+                 const shcore::Document_reader_options &options);
+  void load_in_parallel(shcore::Json_reader *reader, const bool &cancel);
+  void on_imported(uint64_t documents);
+
+  ::Mysqlx::Crud::Insert m_insert;
+  std::shared_ptr<mysqlshdk::db::mysqlx::Session> m_session;
   std::function<void(const std::string &)> m_print = nullptr;
 
-  struct {
-    uint64_t items_processed = 0;
-    uint64_t bytes_processed = 0;
-    uint64_t import_filesize = 0;
+  size_t m_threads = 1;
+  std::vector<std::unique_ptr<Json_insert_worker>> m_workers;
+
+  struct Progress {
+    std::mutex mutex;
     uint64_t documents_successfully_imported = 0;
-    mysqlshdk::utils::Profile_timer timer;
-  } m_stats;
+  };
+  std::unique_ptr<Progress> m_progress;
+
+  mysqlshdk::utils::Profile_timer m_timer;
 
   std::string m_file_path;  //< Path to JSON document
 };
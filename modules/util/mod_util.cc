@@ -23,22 +23,35 @@
 
 #include "modules/util/mod_util.h"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include "modules/mod_utils.h"
 #include "modules/mysqlxtest_utils.h"
+#include "modules/util/export_table/export_table.h"
+#include "modules/util/export_table/export_table_options.h"
 #include "modules/util/import_table/import_table.h"
 #include "modules/util/import_table/import_table_options.h"
 #include "modules/util/json_importer.h"
 #include "modules/util/upgrade_check.h"
 #include "mysqlshdk/include/shellcore/base_session.h"
 #include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/include/shellcore/shell_options.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/mysql/instance.h"
+#include "mysqlshdk/libs/textui/text_progress.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
 #include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/threads.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 #include "rapidjson/document.h"
@@ -75,6 +88,8 @@ Util::Util(shcore::IShell_core *owner) : _shell_core(*owner) {
   expose("configureOci", &Util::configure_oci, "?profile");
 #endif
   expose("importTable", &Util::import_table, "path", "?options");
+  expose("exportTable", &Util::export_table, "table", "outputUrl",
+         "?options");
 }
 
 static std::string format_upgrade_issue(const Upgrade_issue &problem) {
@@ -390,7 +405,12 @@ REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL4,
 REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL5,
               "@li password - password for connection.");
 
-REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL6, "${TOPIC_CONNECTION_DATA}");
+REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL6,
+              "@li threads - number of sessions used to run the checks and "
+              "the 'check table x for upgrade' command concurrently "
+              "(default=1).");
+
+REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL7, "${TOPIC_CONNECTION_DATA}");
 
 /**
  * \ingroup util
@@ -408,6 +428,7 @@ REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL6, "${TOPIC_CONNECTION_DATA}");
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL3)
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL4)
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL5)
+ * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL6)
  *
  * \copydoc connection_options
  *
@@ -458,10 +479,16 @@ shcore::Value Util::check_for_server_upgrade(
             ? "JSON"
             : "TEXT");
 
+    int64_t threads = 1;
+
     if (args.size() > 0 &&
         args[args.size() - 1].type == shcore::Value_type::Map) {
       auto dict = args.map_at(args.size() - 1);
       output_format = dict->get_string("outputFormat", output_format);
+      threads = dict->get_int("threads", threads);
+      if (threads < 1)
+        throw shcore::Exception::argument_error(
+            "The value of 'threads' option must be greater than 0.");
       auto target_version = dict->get_string("targetVersion", MYSH_VERSION);
       if (target_version == "8.0")
         opts.target_version = Version(MYSH_VERSION);
@@ -523,21 +550,126 @@ shcore::Value Util::check_for_server_upgrade(
       }
     };
 
-    for (auto &check : checklist)
+    // checks are executed using a pool of sessions, each used by one thread
+    std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions{session};
+    for (int64_t i = 1; i < threads; ++i) {
+      sessions.emplace_back(
+          establish_session(session->get_connection_options(), false));
+    }
+
+    struct Check_result {
+      std::vector<Upgrade_issue> issues;
+      std::string error;
+      bool failed = false;
+      bool configuration_error = false;
+    };
+
+    std::vector<Check_result> results(checklist.size());
+
+    const auto run_check = [&opts, &checklist, &results](
+                               size_t index,
+                               std::shared_ptr<mysqlshdk::db::ISession> s) {
+      auto &result = results[index];
+
+      try {
+        result.issues = checklist[index]->run(s, opts);
+      } catch (const Upgrade_check::Check_configuration_error &e) {
+        result.failed = true;
+        result.configuration_error = true;
+        result.error = e.what();
+      } catch (const std::exception &e) {
+        result.failed = true;
+        result.error = e.what();
+      }
+    };
+
+    // CHECK TABLE is executed for each table, it's handled separately, using
+    // all the sessions
+    std::vector<size_t> checks;
+    std::vector<size_t> table_checks;
+
+    for (size_t i = 0; i < checklist.size(); ++i) {
+      if (checklist[i]->is_runnable()) {
+        if (dynamic_cast<Check_table_command *>(checklist[i].get()))
+          table_checks.emplace_back(i);
+        else
+          checks.emplace_back(i);
+      }
+    }
+
+    // progress is written to stderr, JSON output is not affected
+    const bool show_progress =
+        output_format == "TEXT" && isatty(fileno(stdout));
+
+    {
+      mysqlshdk::textui::Text_progress text_progress("checks");
+      mysqlshdk::textui::IProgress no_progress;
+      mysqlshdk::textui::IProgress *progress =
+          show_progress ? &text_progress : &no_progress;
+      std::mutex progress_mutex;
+      std::atomic<size_t> next_check{0};
+      size_t done = 0;
+
+      progress->total(checks.size());
+
+      mysqlshdk::utils::parallel_for<mysqlsh::Mysql_thread>(
+          sessions.size(), sessions.size(), [&](size_t s) {
+            for (size_t c = next_check++; c < checks.size();
+                 c = next_check++) {
+              run_check(checks[c], sessions[s]);
+
+              std::lock_guard<std::mutex> lock(progress_mutex);
+              progress->current(++done);
+              progress->show_status();
+            }
+          });
+
+      if (show_progress) {
+        progress->show_status(true);
+        progress->shutdown();
+      }
+    }
+
+    for (const auto index : table_checks) {
+      mysqlshdk::textui::Text_progress progress("tables");
+      auto check = dynamic_cast<Check_table_command *>(checklist[index].get());
+
+      if (sessions.size() > 1) check->set_sessions(sessions);
+
+      if (show_progress) {
+        check->set_progress([&progress](size_t checked, size_t total) {
+          progress.total(total);
+          progress.current(checked);
+          progress.show_status();
+        });
+      }
+
+      run_check(index, session);
+
+      if (show_progress) {
+        progress.show_status(true);
+        progress.shutdown();
+      }
+    }
+
+    // results are reported in the original order of the checks
+    for (size_t i = 0; i < checklist.size(); ++i) {
+      const auto &check = checklist[i];
+      const auto &result = results[i];
+
       if (check->is_runnable()) {
-        try {
-          std::vector<Upgrade_issue> issues = check->run(session, opts);
-          for (const auto &issue : issues) update_counts(issue.level);
-          print->check_results(*check, issues);
-        } catch (const Upgrade_check::Check_configuration_error &e) {
-          print->check_error(*check, e.what(), false);
-        } catch (const std::exception &e) {
-          print->check_error(*check, e.what());
+        if (result.failed) {
+          print->check_error(*check, result.error.c_str(),
+                             !result.configuration_error);
+        } else {
+          for (const auto &issue : result.issues) update_counts(issue.level);
+          print->check_results(*check, result.issues);
         }
       } else {
         update_counts(check->get_level());
         print->manual_check(*check);
       }
+    }
 
     std::string summary;
     if (errors > 0) {
@@ -595,61 +727,66 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL5,
               "@li tableColumn: string (default: \"doc\") - name of column in "
               "target table where the imported JSON documents will be stored.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL6,
+              "@li threads: int (default: 1) - number of threads inserting "
+              "the documents, each one uses its own X Protocol session. When "
+              "greater than 1, documents are not inserted in the order they "
+              "appear in the file.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL7,
               "@li convertBsonTypes: bool (default: false) - enables the BSON "
               "data type conversion.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL7,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL8,
               "@li convertBsonOid: bool (default: the value of "
               "convertBsonTypes) - enables conversion of the BSON ObjectId "
               "values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL8,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL9,
               "@li extractOidTime: string (default: empty) - creates a new "
               "field based on the ObjectID timestamp. Only valid if "
               "convertBsonOid is enabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL9,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
               "The following options are valid only when convertBsonTypes is "
               "enabled. They are all boolean flags. ignoreRegexOptions is "
               "enabled by default, rest are disabled by default.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL11,
               "@li ignoreDate: disables conversion of BSON Date values");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL11,
+    UTIL_IMPORTJSON_DETAIL12,
     "@li ignoreTimestamp: disables conversion of BSON Timestamp values");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL12,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
               "@li ignoreRegex: disables conversion of BSON Regex values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
               "@li ignoreRegexOptions: causes regex options to be ignored when "
               "processing a Regex BSON value. This option is only valid if "
               "ignoreRegex is disabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
-              "@li ignoreBinary: disables conversion of BSON BinData values.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL14,
+              "@li ignoreBinary: disables conversion of BSON BinData values.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
               "@li decimalAsDouble: causes BSON Decimal values to be imported "
               "as double values.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL17,
               "If the schema is not provided, an active schema on the global "
               "session, if set, will be used.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL17,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL18,
               "The collection and the table options cannot be combined. If "
               "they are not provided, the basename of the file without "
               "extension will be used as target collection name.");
 
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL18,
+    UTIL_IMPORTJSON_DETAIL19,
     "If the target collection or table does not exist, they are created, "
     "otherwise the data is inserted into the existing collection or table.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL19,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20,
               "The tableColumn implies the use of the table option and cannot "
               "be combined "
               "with the collection option.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20, "<b>BSON Data Type Processing.</b>");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21, "<b>BSON Data Type Processing.</b>");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "If only convertBsonOid is enabled, no conversion will be done "
               "on the rest of the BSON Data Types.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL23,
               "To use extractOidTime, it should be set to a name which will "
               "be used to insert an additional field into the main document. "
               "The value of the new field will be the timestamp obtained from "
@@ -657,12 +794,12 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "ObjectID value associated to the '_id' field of the main "
               "document.");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL23,
+    UTIL_IMPORTJSON_DETAIL24,
     "NumberLong and NumberInt values will be converted to integer values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL24,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
               "NumberDecimal values are imported as strings, unless "
               "decimalAsDouble is enabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL26,
               "Regex values will be converted to strings containing the "
               "regular expression. The regular expression options are ignored "
               "unless ignoreRegexOptions is disabled. When ignoreRegexOptions "
@@ -710,15 +847,14 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  * $(UTIL_IMPORTJSON_DETAIL6)
  * $(UTIL_IMPORTJSON_DETAIL7)
  * $(UTIL_IMPORTJSON_DETAIL8)
- *
  * $(UTIL_IMPORTJSON_DETAIL9)
+ *
  * $(UTIL_IMPORTJSON_DETAIL10)
  * $(UTIL_IMPORTJSON_DETAIL11)
  * $(UTIL_IMPORTJSON_DETAIL12)
  * $(UTIL_IMPORTJSON_DETAIL13)
  * $(UTIL_IMPORTJSON_DETAIL14)
  * $(UTIL_IMPORTJSON_DETAIL15)
- *
  * $(UTIL_IMPORTJSON_DETAIL16)
  *
  * $(UTIL_IMPORTJSON_DETAIL17)
@@ -739,6 +875,8 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  *
  * $(UTIL_IMPORTJSON_DETAIL25)
  *
+ * $(UTIL_IMPORTJSON_DETAIL26)
+ *
  * $(UTIL_IMPORTJSON_THROWS)
  * $(UTIL_IMPORTJSON_THROWS1)
  * $(UTIL_IMPORTJSON_THROWS2)
@@ -768,12 +906,14 @@ void Util::import_json(const std::string &file,
   std::string collection;
   std::string table;
   std::string table_column;
+  int64_t threads = 1;
 
   shcore::Option_unpacker unpacker(options);
   unpacker.optional("schema", &schema);
   unpacker.optional("collection", &collection);
   unpacker.optional("table", &table);
   unpacker.optional("tableColumn", &table_column);
+  unpacker.optional("threads", &threads);
 
   shcore::Document_reader_options roptions;
   mysqlsh::unpack_json_import_flags(&unpacker, &roptions);
@@ -786,6 +926,11 @@ void Util::import_json(const std::string &file,
         "Option 'extractOidTime' can not be empty.");
   }
 
+  if (threads < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'threads' must be greater than 0.");
+  }
+
   auto shell_session = _shell_core.get_dev_session();
 
   if (!shell_session) {
@@ -852,6 +997,7 @@ void Util::import_json(const std::string &file,
   importer.set_print_callback([](const std::string &msg) -> void {
     mysqlsh::current_console()->print(msg);
   });
+  importer.set_threads(threads);
 
   try {
     importer.load_from(roptions);
@@ -945,7 +1091,7 @@ REGISTER_HELP_FUNCTION_TEXT(UTIL_IMPORTTABLE, R"*(
 Import table dump stored in filename to target table using LOAD DATA LOCAL
 INFILE calls in parallel connections.
 
-@param filename Path to file with user data
+@param filename Path to file with user data, or list of such paths
 @param options Optional dictionary with import options
 
 Scheme part of <b>filename</b> contains infomation about the transport backend.
@@ -965,11 +1111,19 @@ in oci.profile and oci.configFile shell options.
 ociProfile and ociConfigFile options will override, respectively,
 oci.profile and oci.configFile shell options.
 
+Files with .gz (gzip) and .zst (zstd) extensions are decompressed while they
+are imported.
+
+If a list of files is given, all of them are imported to the same table by a
+shared pool of threads. Wildcards (* and ?) in the file name part of a local
+path are expanded to all matching files. Files not larger than
+<b>bytesPerChunk</b> are loaded whole, larger ones are split into chunks.
+
 Options dictionary:
 @li <b>schema</b>: string (default: current shell active schema) - Name of
 target schema
 @li <b>table</b>: string (default: filename without extension) - Name of target
-table
+table, the first file is used if multiple files are given
 @li <b>columns</b>: string array (default: empty array) - This option takes a
 array of column names as its value. The order of the column names indicates how
 to match data file columns with table columns.
@@ -996,17 +1150,30 @@ server.
 bytesPerChunk (+ bytes to end of the row) in single LOAD DATA call. Unit
 suffixes, k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
 bytes), G - for Gigabytes (n * 1'000'000'000 bytes), bytesPerChunk="2k" - ~2
-kilobyte data chunk will send to the MySQL Server.
+kilobyte data chunk will send to the MySQL Server. Chunks become smaller as the
+end of the file approaches, so that all threads finish at the same time.
 @li <b>maxRate</b>: string (default: "0") - Limit data send throughput to
 maxRate in bytes per second per thread.
 maxRate="0" - no limit. Unit suffixes, k - for Kilobytes (n * 1'000 bytes),
 M - for Megabytes (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000
 bytes), maxRate="2k" - limit to 2 kilobytes per second.
+@li <b>readAhead</b>: string (default: "32M") - Maximum amount of data fetched
+ahead of the import by each thread which reads a remote file (http[s]://,
+oci+os://), using up to 4 concurrent range requests. readAhead="0" - fetch only
+the data which is requested. Unit suffixes are the same as in case of
+<b>maxRate</b>.
 @li <b>showProgress</b>: bool (default: true if stdout is a tty, false
 otherwise) - Enable or disable import progress information.
 @li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in the
 file. You can use this option to skip an initial header line containing column
-names.
+names. Rows are skipped in each of the imported files.
+@li <b>journal</b>: string (default: not set) - Path to a file which records the
+data loaded so far, so that an interrupted import can be resumed. The file is
+replaced each time a chunk is loaded and it is removed when the import finishes
+successfully.
+@li <b>resume</b>: bool (default: false) - Skip the data which is recorded as
+loaded in the <b>journal</b> file. The journal has to be written for the same
+files, dialect and skipRows value.
 @li <b>dialect</b>: enum (default: "default") - Setup fields and lines options
 that matches specific data file format. Can be used as base dialect and
 customized with fieldsTerminatedBy, fieldsEnclosedBy, fieldsOptionallyEnclosed,
@@ -1082,7 +1249,7 @@ Each parallel connection sets the following session variables:
  * Import table dump stored in filename to target table using LOAD DATA LOCAL
  * INFILE calls in parallel connections.
  *
- * @param filename Path to file with user data
+ * @param filename Path to file with user data, or list of such paths
  * @param options Optional dictionary with import options
  *
  * Scheme part of <b>filename</b> contains infomation about the transport backend.
@@ -1102,11 +1269,19 @@ Each parallel connection sets the following session variables:
  * ociProfile and ociConfigFile options will override, respectively,
  * oci.profile and oci.configFile shell options.
  *
+ * Files with .gz (gzip) and .zst (zstd) extensions are decompressed while they
+ * are imported.
+ *
+ * If a list of files is given, all of them are imported to the same table by a
+ * shared pool of threads. Wildcards (* and ?) in the file name part of a local
+ * path are expanded to all matching files. Files not larger than
+ * <b>bytesPerChunk</b> are loaded whole, larger ones are split into chunks.
+ *
  * Options dictionary:
  * @li <b>schema</b>: string (default: current shell active schema) - Name of
  * target schema
  * @li <b>table</b>: string (default: filename without extension) - Name of target
- * table
+ * table, the first file is used if multiple files are given
  * @li <b>columns</b>: string array (default: empty array) - This option takes a
  * array of column names as its value. The order of the column names indicates how
  * to match data file columns with table columns.
@@ -1133,17 +1308,30 @@ Each parallel connection sets the following session variables:
  * bytesPerChunk (+ bytes to end of the row) in single LOAD DATA call. Unit
  * suffixes, k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
  * bytes), G - for Gigabytes (n * 1'000'000'000 bytes), bytesPerChunk="2k" - ~2
- * kilobyte data chunk will send to the MySQL Server.
+ * kilobyte data chunk will send to the MySQL Server. Chunks become smaller as
+ * the end of the file approaches, so that all threads finish at the same time.
  * @li <b>maxRate</b>: string (default: "0") - Limit data send throughput to
  * maxRate in bytes per second per thread.
  * maxRate="0" - no limit. Unit suffixes, k - for Kilobytes (n * 1'000 bytes),
  * M - for Megabytes (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000
  * bytes), maxRate="2k" - limit to 2 kilobytes per second.
+ * @li <b>readAhead</b>: string (default: "32M") - Maximum amount of data fetched
+ * ahead of the import by each thread which reads a remote file (http[s]://,
+ * oci+os://), using up to 4 concurrent range requests. readAhead="0" - fetch only
+ * the data which is requested. Unit suffixes are the same as in case of
+ * <b>maxRate</b>.
  * @li <b>showProgress</b>: bool (default: true if stdout is a tty, false
  * otherwise) - Enable or disable import progress information.
  * @li <b>skipRows</b>: int (default: 0) - Skip first n rows of the data in the
  * file. You can use this option to skip an initial header line containing column
- * names.
+ * names. Rows are skipped in each of the imported files.
+ * @li <b>journal</b>: string (default: not set) - Path to a file which records the
+ * data loaded so far, so that an interrupted import can be resumed. The file is
+ * replaced each time a chunk is loaded and it is removed when the import finishes
+ * successfully.
+ * @li <b>resume</b>: bool (default: false) - Skip the data which is recorded as
+ * loaded in the <b>journal</b> file. The journal has to be written for the same
+ * files, dialect and skipRows value.
  * @li <b>dialect</b>: enum (default: "default") - Setup fields and lines options
  * that matches specific data file format. Can be used as base dialect and
  * customized with fieldsTerminatedBy, fieldsEnclosedBy, fieldsOptionallyEnclosed,
@@ -1218,13 +1406,31 @@ Undefined Util::importTable(String filename, Dictionary options);
 #elif DOXYGEN_PY
 None Util::import_table(str filename, dict options);
 #endif
-void Util::import_table(const std::string &filename,
+void Util::import_table(const shcore::Value &filename,
                         const shcore::Dictionary_t &options) {
   using import_table::Import_table;
   using import_table::Import_table_options;
   using mysqlshdk::utils::format_bytes;
 
-  Import_table_options opt(filename, options);
+  std::vector<std::string> filenames;
+
+  if (filename.type == shcore::String) {
+    filenames.emplace_back(filename.get_string());
+  } else if (filename.type == shcore::Array) {
+    for (const auto &f : *filename.as_array()) {
+      if (f.type != shcore::String) {
+        throw shcore::Exception::argument_error(
+            "Argument #1 is expected to be a string or an array of strings");
+      }
+
+      filenames.emplace_back(f.get_string());
+    }
+  } else {
+    throw shcore::Exception::argument_error(
+        "Argument #1 is expected to be a string or an array of strings");
+  }
+
+  Import_table_options opt(filenames, options);
   opt.base_session(_shell_core.get_dev_session());
   opt.validate();
 
@@ -1247,13 +1453,176 @@ void Util::import_table(const std::string &filename,
   const auto filesize = opt.file_size();
   const bool thread_thrown_exception = importer.any_exception();
   if (thread_thrown_exception) {
-    console->print_error("Error occur while importing file '" +
-                         opt.full_path() + "' (" + format_bytes(filesize) +
-                         ")");
+    console->print_error("Error occur while importing " + opt.files_info() +
+                         " (" + format_bytes(filesize) + ")");
+
+    if (!opt.journal().empty()) {
+      console->print_info(
+          "Loaded data was recorded in the journal file '" + opt.journal() +
+          "', use the 'resume' option to continue the import.");
+    }
   } else {
     console->print_info(importer.import_summary());
+    console->print_info(importer.workers_summary());
   }
   console->print_info(importer.rows_affected_info());
   importer.rethrow_exceptions();
 }
+
+REGISTER_HELP_FUNCTION(exportTable, util);
+REGISTER_HELP_FUNCTION_TEXT(UTIL_EXPORTTABLE, R"*(
+Export table to a file using SELECT statements in parallel connections.
+
+@param table Name of the table to be exported
+@param outputUrl Path to the file where the data is written
+@param options Optional dictionary with export options
+
+Scheme part of <b>outputUrl</b> can be omitted or set to file://, only local
+files are supported.
+
+Table is split into ranges of the first column of its primary key, if it is an
+integer column, each range is read by one of the parallel connections. Data is
+written to the file in the order of the primary key. Table which does not have
+such a key is read by a single connection.
+
+The output file uses the same format as SELECT ... INTO OUTFILE with the same
+field and line options, so it can be loaded back by
+<b>util.<<<importTable>>>()</b> called with the same <b>dialect</b>, fields and
+lines options.
+
+Options dictionary:
+@li <b>schema</b>: string (default: current shell active schema) - Name of
+source schema
+@li <b>fieldsTerminatedBy</b>: string (default: "\t"), <b>fieldsEnclosedBy</b>:
+char (default: ''), <b>fieldsEscapedBy</b>: char (default: '\\') - These options
+have the same meaning as the corresponding clauses for SELECT ... INTO OUTFILE.
+@li <b>fieldsOptionallyEnclosed</b>: bool (default: false) - Set to true if only
+values of string columns should be enclosed within quotation marks specified by
+<b>fieldsEnclosedBy</b> option. Set to false if all fields should be quoted.
+@li <b>linesTerminatedBy</b>: string (default: "\n") - This option has the same
+meaning as the corresponding clause for SELECT ... INTO OUTFILE.
+@li <b>threads</b>: int (default: 8) - Use N threads to read the table.
+@li <b>bytesPerChunk</b>: string (minimum: "131072", default: "50M") - Estimated
+size of the data read by a single SELECT statement. Unit suffixes, k - for
+Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000 bytes), G - for
+Gigabytes (n * 1'000'000'000 bytes).
+@li <b>maxRate</b>: string (default: "0") - Limit data read throughput to
+maxRate in bytes per second per thread. maxRate="0" - no limit. Unit suffixes
+are the same as in case of <b>bytesPerChunk</b>.
+@li <b>showProgress</b>: bool (default: true if stdout is a tty, false
+otherwise) - Enable or disable export progress information.
+@li <b>dialect</b>: enum (default: "default") - Setup fields and lines options
+that matches specific data file format. Can be used as base dialect and
+customized with fieldsTerminatedBy, fieldsEnclosedBy, fieldsOptionallyEnclosed,
+fieldsEscapedBy and linesTerminatedBy options. Must be one of the following
+values: csv, tsv, json or csv-unix.
+
+If the <b>schema</b> is not provided, an active schema on the global session, if
+set, will be used.
+
+Connection options set in the global session, such as compression, ssl-mode, etc.
+are used in parallel connections.
+
+Each range is read in a separate transaction, table should not be modified
+while it is exported.
+)*");
+// clang-format off
+/**
+ * \ingroup util
+ *
+ * Export table to a file using SELECT statements in parallel connections.
+ *
+ * @param table Name of the table to be exported
+ * @param outputUrl Path to the file where the data is written
+ * @param options Optional dictionary with export options
+ *
+ * Scheme part of <b>outputUrl</b> can be omitted or set to file://, only local
+ * files are supported.
+ *
+ * Table is split into ranges of the first column of its primary key, if it is an
+ * integer column, each range is read by one of the parallel connections. Data is
+ * written to the file in the order of the primary key. Table which does not have
+ * such a key is read by a single connection.
+ *
+ * The output file uses the same format as SELECT ... INTO OUTFILE with the same
+ * field and line options, so it can be loaded back by
+ * <b>util.<<<importTable>>>()</b> called with the same <b>dialect</b>, fields and
+ * lines options.
+ *
+ * Options dictionary:
+ * @li <b>schema</b>: string (default: current shell active schema) - Name of
+ * source schema
+ * @li <b>fieldsTerminatedBy</b>: string (default: "\t"), <b>fieldsEnclosedBy</b>:
+ * char (default: ''), <b>fieldsEscapedBy</b>: char (default: '\\') - These options
+ * have the same meaning as the corresponding clauses for SELECT ... INTO OUTFILE.
+ * @li <b>fieldsOptionallyEnclosed</b>: bool (default: false) - Set to true if only
+ * values of string columns should be enclosed within quotation marks specified by
+ * <b>fieldsEnclosedBy</b> option. Set to false if all fields should be quoted.
+ * @li <b>linesTerminatedBy</b>: string (default: "\n") - This option has the same
+ * meaning as the corresponding clause for SELECT ... INTO OUTFILE.
+ * @li <b>threads</b>: int (default: 8) - Use N threads to read the table.
+ * @li <b>bytesPerChunk</b>: string (minimum: "131072", default: "50M") - Estimated
+ * size of the data read by a single SELECT statement. Unit suffixes, k - for
+ * Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000 bytes), G - for
+ * Gigabytes (n * 1'000'000'000 bytes).
+ * @li <b>maxRate</b>: string (default: "0") - Limit data read throughput to
+ * maxRate in bytes per second per thread. maxRate="0" - no limit. Unit suffixes
+ * are the same as in case of <b>bytesPerChunk</b>.
+ * @li <b>showProgress</b>: bool (default: true if stdout is a tty, false
+ * otherwise) - Enable or disable export progress information.
+ * @li <b>dialect</b>: enum (default: "default") - Setup fields and lines options
+ * that matches specific data file format. Can be used as base dialect and
+ * customized with fieldsTerminatedBy, fieldsEnclosedBy, fieldsOptionallyEnclosed,
+ * fieldsEscapedBy and linesTerminatedBy options. Must be one of the following
+ * values: csv, tsv, json or csv-unix.
+ *
+ * If the <b>schema</b> is not provided, an active schema on the global session, if
+ * set, will be used.
+ *
+ * Connection options set in the global session, such as compression, ssl-mode, etc.
+ * are used in parallel connections.
+ *
+ * Each range is read in a separate transaction, table should not be modified
+ * while it is exported.
+ */
+// clang-format on
+#if DOXYGEN_JS
+Undefined Util::exportTable(String table, String outputUrl, Dictionary options);
+#elif DOXYGEN_PY
+None Util::export_table(str table, str output_url, dict options);
+#endif
+void Util::export_table(const std::string &table, const std::string &output_url,
+                        const shcore::Dictionary_t &options) {
+  using export_table::Export_table;
+  using export_table::Export_table_options;
+
+  Export_table_options opt(table, output_url, options);
+  opt.base_session(_shell_core.get_dev_session());
+  opt.validate();
+
+  volatile bool interrupt = false;
+  shcore::Interrupt_handler intr_handler([&interrupt]() -> bool {
+    mysqlsh::current_console()->print_warning(
+        "Interrupted by user. Cancelling...");
+    interrupt = true;
+    return false;
+  });
+
+  Export_table exporter(opt);
+  exporter.interrupt(&interrupt);
+
+  auto console = mysqlsh::current_console();
+  console->print_info(opt.target_export_info());
+
+  exporter.export_data();
+
+  if (exporter.any_exception()) {
+    console->print_error("Error occur while exporting table `" + opt.schema() +
+                         "`.`" + opt.table() + "`");
+  } else {
+    console->print_info(exporter.export_summary());
+  }
+  console->print_info(exporter.rows_written_info());
+  exporter.rethrow_exceptions();
+}
 }  // namespace mysqlsh
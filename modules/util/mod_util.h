@@ -76,7 +76,15 @@ class SHCORE_PUBLIC Util : public shcore::Cpp_object_bridge,
 #elif DOXYGEN_PY
   None import_table(str filename, dict options);
 #endif
-  void import_table(const std::string &filename,
+  void import_table(const shcore::Value &filename,
+                    const shcore::Dictionary_t &options);
+
+#if DOXYGEN_JS
+  Undefined exportTable(String table, String outputUrl, Dictionary options);
+#elif DOXYGEN_PY
+  None export_table(str table, str output_url, dict options);
+#endif
+  void export_table(const std::string &table, const std::string &output_url,
                     const shcore::Dictionary_t &options);
 
  private:
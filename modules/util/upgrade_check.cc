@@ -23,13 +23,18 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
 #include "modules/util/upgrade_check.h"
+#include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/libs/config/config_file.h"
 #include "mysqlshdk/libs/db/session.h"
+#include "mysqlshdk/libs/utils/threads.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_lexing.h"
@@ -1266,6 +1271,44 @@ bool UNUSED_VARIABLE(register_fts_tablename_check) =
 Check_table_command::Check_table_command()
     : Upgrade_check("checkTableOutput") {}
 
+namespace {
+
+std::vector<Upgrade_issue> check_table(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const std::pair<std::string, std::string> &table) {
+  std::vector<Upgrade_issue> issues;
+  auto check_result =
+      session->query(shcore::sqlstring("CHECK TABLE !.! FOR UPGRADE;", 0)
+                     << table.first << table.second);
+  const mysqlshdk::db::IRow *row = nullptr;
+  while ((row = check_result->fetch_one()) != nullptr) {
+    if (row->get_string(2) == "status") continue;
+    Upgrade_issue issue;
+    std::string type = row->get_string(2);
+    if (type == "warning")
+      issue.level = Upgrade_issue::WARNING;
+    else if (type == "error")
+      issue.level = Upgrade_issue::ERROR;
+    else
+      issue.level = Upgrade_issue::NOTICE;
+    issue.schema = table.first;
+    issue.table = table.second;
+    issue.description = row->get_string(3);
+
+    // Native partitioning warning has been promoted to error in context of
+    // upgrade to 8.0 and is handled by the separate check
+    if (issue.description.find("use native partitioning instead.") !=
+            std::string::npos &&
+        issue.level == Upgrade_issue::WARNING)
+      continue;
+    issues.push_back(issue);
+  }
+
+  return issues;
+}
+
+}  // namespace
+
 std::vector<Upgrade_issue> Check_table_command::run(
     std::shared_ptr<mysqlshdk::db::ISession> session,
     const Upgrade_check_options &opts) {
@@ -1283,34 +1326,39 @@ std::vector<Upgrade_issue> Check_table_command::run(
     tables.push_back(std::pair<std::string, std::string>(pair->get_string(0),
                                                          pair->get_string(1)));
 
+  const auto sessions =
+      m_sessions.empty()
+          ? std::vector<std::shared_ptr<mysqlshdk::db::ISession>>{session}
+          : m_sessions;
+
+  // tables are handed out one at a time, issues are reported in the table
+  // order regardless of which session checked them
+  std::vector<std::vector<Upgrade_issue>> table_issues(tables.size());
+  std::atomic<size_t> next_table{0};
+  std::mutex progress_mutex;
+  size_t checked = 0;
+
+  mysqlshdk::utils::parallel_for<mysqlsh::Mysql_thread>(
+      sessions.size(), sessions.size(), [&](size_t s) {
+        try {
+          for (size_t t = next_table++; t < tables.size(); t = next_table++) {
+            table_issues[t] = check_table(sessions[s], tables[t]);
+
+            if (m_progress) {
+              std::lock_guard<std::mutex> lock(progress_mutex);
+              m_progress(++checked, tables.size());
+            }
+          }
+        } catch (...) {
+          // stop the remaining threads
+          next_table = tables.size();
+          throw;
+        }
+      });
+
   std::vector<Upgrade_issue> issues;
-  for (const auto &pair : tables) {
-    auto check_result =
-        session->query(shcore::sqlstring("CHECK TABLE !.! FOR UPGRADE;", 0)
-                       << pair.first << pair.second);
-    const mysqlshdk::db::IRow *row = nullptr;
-    while ((row = check_result->fetch_one()) != nullptr) {
-      if (row->get_string(2) == "status") continue;
-      Upgrade_issue issue;
-      std::string type = row->get_string(2);
-      if (type == "warning")
-        issue.level = Upgrade_issue::WARNING;
-      else if (type == "error")
-        issue.level = Upgrade_issue::ERROR;
-      else
-        issue.level = Upgrade_issue::NOTICE;
-      issue.schema = pair.first;
-      issue.table = pair.second;
-      issue.description = row->get_string(3);
-
-      // Native partitioning warning has been promoted to error in context of
-      // upgrade to 8.0 and is handled by the separate check
-      if (issue.description.find("use native partitioning instead.") !=
-              std::string::npos &&
-          issue.level == Upgrade_issue::WARNING)
-        continue;
-      issues.push_back(issue);
-    }
+  for (auto &ti : table_issues) {
+    std::move(ti.begin(), ti.end(), std::back_inserter(issues));
   }
 
   return issues;
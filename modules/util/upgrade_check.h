@@ -239,12 +239,34 @@ class Check_table_command : public Upgrade_check {
     throw std::runtime_error("Unimplemented");
   }
 
+  /**
+   * Sets the sessions used to check the tables, each one is used by its own
+   * thread. If not set, tables are checked using the session given to run().
+   */
+  void set_sessions(
+      const std::vector<std::shared_ptr<mysqlshdk::db::ISession>> &sessions) {
+    m_sessions = sessions;
+  }
+
+  /**
+   * Sets the callback invoked after each table is checked, with the number of
+   * tables checked so far and the total number of tables. Calls are
+   * serialized, but may be made from any of the threads.
+   */
+  void set_progress(const std::function<void(size_t, size_t)> &progress) {
+    m_progress = progress;
+  }
+
  protected:
   const char *get_description_internal() const override { return nullptr; }
 
   const char *get_title_internal() const override {
     return "Issues reported by 'check table x for upgrade' command";
   }
+
+ private:
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> m_sessions;
+  std::function<void(size_t, size_t)> m_progress;
 };
 
 class Manual_check : public Upgrade_check {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2014, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -29,6 +29,7 @@
 
 namespace shcore {
 class JScript_context;
+class Typed_array;
 
 struct JScript_type_bridger {
   JScript_type_bridger(JScript_context *context);
@@ -46,6 +47,7 @@ struct JScript_type_bridger {
 
   v8::Local<v8::Value> native_object_to_js(Object_bridge_ref object);
   Object_bridge_ref js_object_to_native(v8::Local<v8::Object> object);
+  v8::Local<v8::Value> typed_array_to_js(const Typed_array &array);
 
   JScript_context *owner;
 
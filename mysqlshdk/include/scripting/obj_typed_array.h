@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_INCLUDE_SCRIPTING_OBJ_TYPED_ARRAY_H_
+#define MYSQLSHDK_INCLUDE_SCRIPTING_OBJ_TYPED_ARRAY_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "scripting/types_cpp.h"
+
+namespace shcore {
+
+/**
+ * Array of numbers stored in a contiguous buffer. Scripting languages convert
+ * it to their own typed array (Float64Array or Uint8Array in JavaScript,
+ * array.array in Python) without creating an object for each element.
+ */
+class SHCORE_PUBLIC Typed_array : public Cpp_object_bridge {
+ public:
+  enum class Type {
+    Uint8,
+    Int64,
+    Uint64,
+    Double,
+    /**
+     * Offsets of values stored one after another in a UTF-8 encoded string,
+     * converted to units used by the scripting language to index strings.
+     */
+    Text_offset,
+  };
+
+  /**
+   * Units used by scripting languages to index strings.
+   */
+  enum class String_unit { Byte, Code_point, Utf16 };
+
+  explicit Typed_array(Type type);
+
+  /**
+   * Creates an array which holds the given elements.
+   *
+   * @param type type of the elements
+   * @param data elements in native byte order
+   */
+  Typed_array(Type type, std::string &&data);
+
+  std::string class_name() const override { return "TypedArray"; }
+
+  std::string &append_descr(std::string &s_out, int indent = -1,
+                            int quote_strings = 0) const override;
+  std::string &append_repr(std::string &s_out) const override;
+  void append_json(shcore::JSON_dumper &dumper) const override;
+
+  bool operator==(const Object_bridge &other) const override;
+
+  bool is_indexed() const override { return true; }
+  Value get_member(size_t index) const override;
+  using Cpp_object_bridge::get_member;
+
+  Type type() const { return m_type; }
+
+  size_t element_size() const {
+    return Type::Uint8 == m_type ? sizeof(uint8_t) : sizeof(uint64_t);
+  }
+
+  size_t size() const { return m_data.size() / element_size(); }
+
+  bool empty() const { return m_data.empty(); }
+
+  /**
+   * Elements in native byte order.
+   */
+  const char *data() const { return m_data.data(); }
+
+  void reserve(size_t size) { m_data.reserve(size * element_size()); }
+
+  /**
+   * Appends an element, T has to match the type of the array (uint8_t,
+   * int64_t, uint64_t or double).
+   */
+  template <typename T>
+  void push_back(T value) {
+    assert(sizeof(T) == element_size() && Type::Text_offset != m_type);
+    m_data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  T at(size_t index) const {
+    assert(sizeof(T) == element_size());
+    T value;
+    memcpy(&value, m_data.data() + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  /**
+   * Value of an element converted to double.
+   */
+  double at_double(size_t index) const;
+
+  /**
+   * Appends offset of the end of the given value, values are stored one after
+   * another. Array of type Text_offset initially holds a single 0 offset.
+   *
+   * @param value UTF-8 encoded value
+   * @param length length of the value in bytes
+   */
+  void push_back_text(const char *value, size_t length);
+
+  /**
+   * Offsets expressed in the given units. Type of array has to be
+   * Text_offset.
+   */
+  std::vector<uint64_t> offsets(String_unit unit) const;
+
+ private:
+  Type m_type;
+  std::string m_data;
+
+  // offsets of a Text_offset array, m_data holds the byte offsets
+  std::vector<uint64_t> m_code_point_offsets;
+  std::vector<uint64_t> m_utf16_offsets;
+};
+
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_INCLUDE_SCRIPTING_OBJ_TYPED_ARRAY_H_
@@ -132,7 +132,7 @@ class IConsole {
 
   virtual void remove_print_handler(shcore::Interpreter_print_handler *) = 0;
 
-  void set_verbose(int level) { m_verbose = level; }
+  virtual void set_verbose(int level) { m_verbose = level; }
 
   int get_verbose() const { return m_verbose; }
 
@@ -31,6 +31,9 @@
 #define SHCORE_SHOW_WARNINGS "showWarnings"
 #define SHCORE_BATCH_CONTINUE_ON_ERROR "batchContinueOnError"
 #define SHCORE_USE_WIZARDS "useWizards"
+#define SHCORE_SQL_BATCH_SIZE "sqlBatchSize"
+#define SHCORE_TABLE_SAMPLE_ROWS "tableFormat.sampleRows"
+#define SHCORE_TABLE_MAX_SAMPLE_SIZE "tableFormat.maxSampleSize"
 
 #define SHCORE_SANDBOX_DIR "sandboxDir"
 #define SHCORE_DBA_GTID_WAIT_TIMEOUT "dba.gtidWaitTimeout"
@@ -134,6 +137,9 @@ class Shell_options : public shcore::Options {
     std::string pager;
     Quiet_start quiet_start = Quiet_start::NOT_SET;
     bool show_column_type_info = false;
+    int sql_batch_size = 0;
+    int table_sample_rows = 0;
+    int table_max_sample_size = 0;
     bool default_compress = false;
     std::string dbug_options;
 
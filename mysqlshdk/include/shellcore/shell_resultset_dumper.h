@@ -122,10 +122,22 @@ class Resultset_dumper_base {
   size_t format_vertical(bool has_header, bool align_right,
                          size_t min_label_width);
 
+  /**
+   * Checks if column widths of the table format are computed using only a
+   * sample of rows, instead of the whole (buffered) result.
+   */
+  bool is_table_sampled() const {
+    return m_table_sample_rows > 0 || m_table_max_sample_size > 0;
+  }
+
   mysqlshdk::db::IResult *m_result;
   std::string m_wrap_json;
   std::string m_format;
   bool m_cancelled = false;
+  // maximum number of rows used to compute column widths, 0 - all rows
+  size_t m_table_sample_rows = 0;
+  // maximum size in bytes of the sampled rows, 0 - no limit
+  size_t m_table_max_sample_size = 0;
   std::unique_ptr<Resultset_printer> m_printer;
 };
 
@@ -28,6 +28,7 @@
 #include <stack>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "mysqlshdk/libs/db/result.h"
 #include "mysqlshdk/libs/db/session.h"
@@ -116,6 +117,27 @@ class SHCORE_PUBLIC Shell_sql : public Shell_language {
                    std::shared_ptr<mysqlshdk::db::ISession> session,
                    mysqlshdk::utils::Sql_splitter *splitter);
 
+  /**
+   * Consecutive statements of a SQL script which are sent to the server in a
+   * single packet.
+   */
+  struct Sql_batch {
+    std::vector<std::string> statements;
+    // delimiter and line number of each statement
+    std::vector<std::pair<std::string, size_t>> context;
+    size_t bytes = 0;
+  };
+
+  /**
+   * Executes and clears the batch. Errors are reported using the line number
+   * of the failed statement, if --force is not set statements which follow
+   * it are discarded.
+   *
+   * @returns false if any of the statements failed.
+   */
+  bool process_batch(Sql_batch *batch,
+                     const std::shared_ptr<mysqlshdk::db::ISession> &session);
+
   std::pair<size_t, bool> handle_command(const char *p, size_t len, bool bol);
 
   void cmd_process_file(const std::vector<std::string> &params);
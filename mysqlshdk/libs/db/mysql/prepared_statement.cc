@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/db/mysql/prepared_statement.h"
+
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+#include "mysqlshdk/libs/db/mysql/result.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/dtoa.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/interrupt_handler.h"
+
+namespace mysqlshdk {
+namespace db {
+namespace mysql {
+
+#define FIELD_ERROR(index, msg) \
+  std::invalid_argument(        \
+      shcore::str_format("%s(%u): " msg, __FUNCTION__, index).c_str())
+
+#define FIELD_ERROR1(index, msg, arg) \
+  std::invalid_argument(              \
+      shcore::str_format("%s(%u): " msg, __FUNCTION__, index, arg).c_str())
+
+#define VALIDATE_INDEX(index)                          \
+  do {                                                 \
+    if (index >= num_fields())                         \
+      throw FIELD_ERROR(index, "index out of bounds"); \
+  } while (0)
+
+#define GET_VALIDATE_TYPE(index, TYPE_CHECK)                                  \
+  if (index >= num_fields()) throw FIELD_ERROR(index, "index out of bounds"); \
+  if (is_null(index)) throw FIELD_ERROR(index, "field is NULL");              \
+  ftype = get_type(index);                                                    \
+  if (!(TYPE_CHECK))                                                          \
+    throw FIELD_ERROR1(index, "field type is %s", to_string(ftype).c_str());
+
+namespace {
+
+// initial size of the buffer of a string column, grows if value is larger
+constexpr size_t k_initial_string_buffer = 256;
+
+// same as NOT_FIXED_DEC in the server
+constexpr int k_not_fixed_decimals = 31;
+
+}  // namespace
+
+//--------------------------- Prepared_statement -----------------------------
+
+Prepared_statement::Prepared_statement(MYSQL *mysql, const std::string &sql)
+    : m_mysql(mysql), m_stmt(mysql_stmt_init(mysql)), m_sql(sql) {
+  if (!m_stmt) {
+    throw Error(mysql_error(m_mysql), mysql_errno(m_mysql),
+                mysql_sqlstate(m_mysql));
+  }
+
+  if (mysql_stmt_prepare(m_stmt, m_sql.data(), m_sql.length()) != 0) {
+    const auto err = error();
+    mysql_stmt_close(m_stmt);
+    throw err;
+  }
+
+  m_params.resize(mysql_stmt_param_count(m_stmt));
+  m_param_values.resize(m_params.size());
+
+  try {
+    prepare_result();
+  } catch (...) {
+    mysql_stmt_close(m_stmt);
+    throw;
+  }
+}
+
+Prepared_statement::~Prepared_statement() {
+  // safe even if connection was already closed, statement is detached then
+  mysql_stmt_close(m_stmt);
+}
+
+Error Prepared_statement::error() const {
+  return Error(mysql_stmt_error(m_stmt), mysql_stmt_errno(m_stmt),
+               mysql_stmt_sqlstate(m_stmt));
+}
+
+void Prepared_statement::prepare_result() {
+  std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)> res(
+      mysql_stmt_result_metadata(m_stmt), &mysql_free_result);
+
+  // statements which do not return rows do not have the metadata
+  if (!res) return;
+
+  const auto num_fields = mysql_num_fields(res.get());
+  const auto fields = mysql_fetch_fields(res.get());
+
+  m_binds.resize(num_fields);
+  m_fields.resize(num_fields);
+
+  for (unsigned int i = 0; i < num_fields; ++i) {
+    m_metadata.emplace_back(Result::make_column(fields[i]));
+
+    auto &bind = m_binds[i];
+    auto &field = m_fields[i];
+
+    std::memset(&bind, 0, sizeof(MYSQL_BIND));
+    bind.is_null = &field.is_null;
+    bind.length = &field.length;
+
+    switch (m_metadata.back().get_type()) {
+      case Type::Null:
+        bind.buffer_type = MYSQL_TYPE_NULL;
+        break;
+
+      case Type::Integer:
+      case Type::UInteger:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        bind.buffer = &field.value.i;
+        bind.is_unsigned = m_metadata.back().is_unsigned();
+        break;
+
+      case Type::Float:
+        bind.buffer_type = MYSQL_TYPE_FLOAT;
+        bind.buffer = &field.value.f;
+        break;
+
+      case Type::Double:
+        bind.buffer_type = MYSQL_TYPE_DOUBLE;
+        bind.buffer = &field.value.d;
+        break;
+
+      default:
+        // decimals and temporal values are converted to the same text the
+        // server sends in the text protocol, strings and bits are copied
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        field.data.resize(k_initial_string_buffer);
+        bind.buffer = field.data.data();
+        bind.buffer_length = field.data.size();
+        break;
+    }
+  }
+}
+
+void Prepared_statement::bind_params(const std::vector<Statement_arg> &args) {
+  if (args.size() != m_params.size()) {
+    throw std::invalid_argument(shcore::str_format(
+        "Statement has %zu placeholders, %zu values given", m_params.size(),
+        args.size()));
+  }
+
+  if (m_params.empty()) return;
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto &arg = args[i];
+    auto &bind = m_params[i];
+    auto &value = m_param_values[i];
+
+    std::memset(&bind, 0, sizeof(MYSQL_BIND));
+
+    // values are sent by mysql_stmt_execute(), strings are not copied as args
+    // outlive that call
+    switch (arg.kind()) {
+      case Statement_arg::Kind::Null:
+        bind.buffer_type = MYSQL_TYPE_NULL;
+        break;
+
+      case Statement_arg::Kind::Integer:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        value.i = arg.as_int();
+        bind.buffer = &value.i;
+        break;
+
+      case Statement_arg::Kind::UInteger:
+        bind.buffer_type = MYSQL_TYPE_LONGLONG;
+        value.u = arg.as_uint();
+        bind.buffer = &value.u;
+        bind.is_unsigned = true;
+        break;
+
+      case Statement_arg::Kind::Double:
+        bind.buffer_type = MYSQL_TYPE_DOUBLE;
+        value.d = arg.as_double();
+        bind.buffer = &value.d;
+        break;
+
+      case Statement_arg::Kind::String:
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = const_cast<char *>(arg.as_string().data());
+        bind.buffer_length = arg.as_string().length();
+        bind.length = &bind.buffer_length;
+        break;
+    }
+  }
+
+  if (mysql_stmt_bind_param(m_stmt, m_params.data())) {
+    throw error();
+  }
+}
+
+void Prepared_statement::execute(const std::vector<Statement_arg> &args,
+                                 bool buffered) {
+  free_result();
+  bind_params(args);
+
+  if (mysql_stmt_execute(m_stmt) != 0) {
+    throw error();
+  }
+
+  m_affected_rows = mysql_stmt_affected_rows(m_stmt);
+  if (m_affected_rows == ~static_cast<my_ulonglong>(0)) m_affected_rows = 0;
+  m_insert_id = mysql_stmt_insert_id(m_stmt);
+  m_warning_count = mysql_warning_count(m_mysql);
+  const char *info = mysql_info(m_mysql);
+  m_info = info ? info : "";
+
+  // statement is transparently re-prepared by the server if tables it uses
+  // were altered
+  if (mysql_stmt_field_count(m_stmt) != m_metadata.size()) {
+    m_metadata.clear();
+    m_binds.clear();
+    m_fields.clear();
+    prepare_result();
+  }
+
+  if (has_resultset()) {
+    if (mysql_stmt_bind_result(m_stmt, m_binds.data())) {
+      throw error();
+    }
+
+    m_has_result = true;
+
+    if (buffered) {
+      if (mysql_stmt_store_result(m_stmt) != 0) {
+        const auto err = error();
+        free_result();
+        throw err;
+      }
+    } else {
+      m_reading = true;
+    }
+  }
+}
+
+bool Prepared_statement::fetch() {
+  if (!m_has_result) return false;
+
+  switch (mysql_stmt_fetch(m_stmt)) {
+    case 0:
+      return true;
+
+    case MYSQL_DATA_TRUNCATED:
+      fetch_truncated();
+      return true;
+
+    case MYSQL_NO_DATA:
+      m_reading = false;
+      return false;
+
+    default: {
+      const auto err = error();
+      free_result();
+      throw err;
+    }
+  }
+}
+
+void Prepared_statement::fetch_truncated() {
+  bool rebind = false;
+
+  for (unsigned int i = 0; i < m_fields.size(); ++i) {
+    auto &field = m_fields[i];
+    auto &bind = m_binds[i];
+
+    if (MYSQL_TYPE_STRING == bind.buffer_type && !field.is_null &&
+        field.length > field.data.size()) {
+      // buffer is kept for the subsequent rows
+      field.data.resize(field.length);
+      bind.buffer = field.data.data();
+      bind.buffer_length = field.data.size();
+      rebind = true;
+
+      if (mysql_stmt_fetch_column(m_stmt, &bind, i, 0) != 0) {
+        throw error();
+      }
+    }
+  }
+
+  if (rebind && mysql_stmt_bind_result(m_stmt, m_binds.data())) {
+    throw error();
+  }
+}
+
+void Prepared_statement::seek(uint64_t row) {
+  if (m_has_result) mysql_stmt_data_seek(m_stmt, row);
+}
+
+void Prepared_statement::free_result() {
+  if (!m_has_result) return;
+
+  mysql_stmt_free_result(m_stmt);
+
+  // discards the status of a CALL and any further result sets
+  while (mysql_stmt_next_result(m_stmt) == 0) {
+    mysql_stmt_free_result(m_stmt);
+  }
+
+  m_has_result = false;
+  m_reading = false;
+}
+
+//-------------------------------- Stmt_row ----------------------------------
+
+uint32_t Stmt_row::num_fields() const {
+  return static_cast<uint32_t>(m_stmt->metadata().size());
+}
+
+Type Stmt_row::get_type(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return column(index).get_type();
+}
+
+bool Stmt_row::is_null(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return Type::Null == column(index).get_type() || m_stmt->is_null(index);
+}
+
+std::string Stmt_row::get_as_string(uint32_t index) const {
+  VALIDATE_INDEX(index);
+
+  // same as mysql::Row, AdminAPI depends on this
+  if (is_null(index)) return "NULL";
+
+  const auto &col = column(index);
+  std::string result;
+
+  switch (col.get_type()) {
+    case Type::Integer:
+      result = std::to_string(m_stmt->int_value(index));
+      break;
+
+    case Type::UInteger:
+      result = std::to_string(m_stmt->uint_value(index));
+      break;
+
+    case Type::Float:
+    case Type::Double: {
+      const double value = Type::Float == col.get_type()
+                               ? m_stmt->float_value(index)
+                               : m_stmt->double_value(index);
+
+      if (col.get_fractional() < k_not_fixed_decimals) {
+        result = shcore::str_format("%.*f", col.get_fractional(), value);
+      } else {
+        char buffer[32];
+        const size_t len =
+            my_gcvt(value,
+                    Type::Float == col.get_type() ? MY_GCVT_ARG_FLOAT
+                                                  : MY_GCVT_ARG_DOUBLE,
+                    sizeof(buffer) - 1, buffer, nullptr);
+        result.assign(buffer, len);
+      }
+      break;
+    }
+
+    case Type::Bit:
+      return shcore::bits_to_string(get_bit(index), col.get_length());
+
+    default: {
+      const auto data = m_stmt->string_value(index);
+      return std::string(data.first, data.second);
+    }
+  }
+
+  // text protocol pads ZEROFILL columns
+  if (col.is_zerofill() && result.length() < col.get_length()) {
+    result.insert(0, col.get_length() - result.length(), '0');
+  }
+
+  return result;
+}
+
+int64_t Stmt_row::get_int(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(
+      index, (ftype == Type::Integer || ftype == Type::UInteger ||
+              (ftype == Type::Decimal &&
+               !memchr(m_stmt->string_value(index).first, '.',
+                       m_stmt->string_value(index).second))));
+
+  switch (ftype) {
+    case Type::UInteger: {
+      const uint64_t value = m_stmt->uint_value(index);
+      if (value > static_cast<uint64_t>(LLONG_MAX)) {
+        throw FIELD_ERROR(index, "field value exceeds allowed range");
+      }
+      return static_cast<int64_t>(value);
+    }
+
+    case Type::Decimal:
+      try {
+        return std::stoll(get_as_string(index));
+      } catch (const std::exception &) {
+        throw FIELD_ERROR(index, "field value out of the allowed range");
+      }
+
+    default:
+      return m_stmt->int_value(index);
+  }
+}
+
+uint64_t Stmt_row::get_uint(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(
+      index, (ftype == Type::Integer || ftype == Type::UInteger ||
+              (ftype == Type::Decimal &&
+               !memchr(m_stmt->string_value(index).first, '.',
+                       m_stmt->string_value(index).second))));
+
+  switch (ftype) {
+    case Type::Integer: {
+      const int64_t value = m_stmt->int_value(index);
+      if (value < 0) {
+        throw FIELD_ERROR(index, "field value out of the allowed range");
+      }
+      return static_cast<uint64_t>(value);
+    }
+
+    case Type::Decimal: {
+      const auto dec = get_as_string(index);
+      if (!dec.empty() && '-' == dec[0]) {
+        throw FIELD_ERROR(index, "field value out of the allowed range");
+      }
+      try {
+        return std::stoull(dec);
+      } catch (const std::exception &) {
+        throw FIELD_ERROR(index, "field value exceeds allowed range");
+      }
+    }
+
+    default:
+      return m_stmt->uint_value(index);
+  }
+}
+
+std::string Stmt_row::get_string(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (is_string_type(ftype)));
+  const auto data = m_stmt->string_value(index);
+  return std::string(data.first, data.second);
+}
+
+std::pair<const char *, size_t> Stmt_row::get_string_data(
+    uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (is_string_type(ftype)));
+  return m_stmt->string_value(index);
+}
+
+float Stmt_row::get_float(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Double ||
+                            ftype == Type::Decimal));
+
+  switch (ftype) {
+    case Type::Float:
+      return m_stmt->float_value(index);
+
+    case Type::Double:
+      return static_cast<float>(m_stmt->double_value(index));
+
+    default:
+      try {
+        return std::stof(get_as_string(index));
+      } catch (const std::exception &) {
+        throw FIELD_ERROR(index, "float value out of the allowed range");
+      }
+  }
+}
+
+double Stmt_row::get_double(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Double ||
+                            ftype == Type::Decimal));
+
+  switch (ftype) {
+    case Type::Float:
+      return static_cast<double>(m_stmt->float_value(index));
+
+    case Type::Double:
+      return m_stmt->double_value(index);
+
+    default:
+      try {
+        return std::stod(get_as_string(index));
+      } catch (const std::exception &) {
+        throw FIELD_ERROR(index, "double value out of the allowed range");
+      }
+  }
+}
+
+uint64_t Stmt_row::get_bit(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Bit));
+
+  // value is sent as a big-endian number
+  const auto data = m_stmt->string_value(index);
+  uint64_t value = 0;
+
+  for (size_t i = 0; i < data.second && i < sizeof(uint64_t); ++i) {
+    value = (value << 8) | static_cast<unsigned char>(data.first[i]);
+  }
+
+  return value;
+}
+
+//------------------------------- Stmt_result --------------------------------
+
+Stmt_result::Stmt_result(std::shared_ptr<Session_impl> owner,
+                         std::shared_ptr<Prepared_statement> stmt,
+                         bool buffered)
+    : m_session(owner),
+      m_stmt(std::move(stmt)),
+      m_row(m_stmt.get()),
+      m_buffered(buffered),
+      m_affected_rows(m_stmt->affected_rows()),
+      m_insert_id(m_stmt->insert_id()),
+      m_warning_count(m_stmt->warning_count()),
+      m_info(m_stmt->info()) {
+  if (owner) m_gtids = owner->get_last_gtids();
+}
+
+const IRow *Stmt_result::fetch_one() {
+  if (m_pre_fetched) {
+    if (m_fetched_row_count < m_pre_fetched_rows.size()) {
+      m_pre_fetched_row.reset(m_fetched_row_count++);
+      return &m_pre_fetched_row;
+    }
+
+    return nullptr;
+  }
+
+  if (m_stmt->fetch()) {
+    ++m_fetched_row_count;
+    return &m_row;
+  }
+
+  return nullptr;
+}
+
+std::unique_ptr<Warning> Stmt_result::fetch_one_warning() {
+  if (m_warning_count && !m_fetched_warnings) {
+    m_fetched_warnings = true;
+
+    if (auto s = m_session.lock()) {
+      auto result =
+          s->query("show warnings", sizeof("show warnings") - 1, true);
+
+      while (auto row = result->fetch_one()) {
+        std::unique_ptr<Warning> w(new Warning());
+        std::string level = row->get_string(0);
+        if (level == "Error") {
+          w->level = Warning::Level::Error;
+        } else if (level == "Warning") {
+          w->level = Warning::Level::Warn;
+        } else {
+          assert(level == "Note");
+          w->level = Warning::Level::Note;
+        }
+        w->code = row->get_int(1);
+        w->msg = row->get_string(2);
+        m_warnings.push_back(std::move(w));
+      }
+    }
+  }
+
+  if (!m_warnings.empty()) {
+    auto tmp = std::move(m_warnings.front());
+    m_warnings.pop_front();
+    return tmp;
+  }
+
+  return {};
+}
+
+std::shared_ptr<Field_names> Stmt_result::field_names() const {
+  if (!m_field_names) {
+    m_field_names = std::make_shared<Field_names>();
+    for (const auto &column : get_metadata())
+      m_field_names->add(column.get_column_label());
+  }
+  return m_field_names;
+}
+
+void Stmt_result::buffer() {
+  // buffered result is already held by the statement
+  if (m_buffered || m_pre_fetched) return;
+
+  bool stop = false;
+  shcore::Interrupt_handler intr([&stop]() {
+    stop = true;
+    return false;
+  });
+
+  // same as mysql::Result, rows which were already fetched are not buffered
+  while (const auto row = fetch_one()) {
+    if (stop) return;
+    m_pre_fetched_rows.append(*row);
+  }
+
+  m_fetched_row_count = 0;
+  m_pre_fetched = true;
+}
+
+void Stmt_result::rewind() {
+  m_fetched_row_count = 0;
+  if (m_buffered) m_stmt->seek(0);
+}
+
+}  // namespace mysql
+}  // namespace db
+}  // namespace mysqlshdk
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// Server-side prepared statements executed using the binary protocol
+
+#ifndef MYSQLSHDK_LIBS_DB_MYSQL_PREPARED_STATEMENT_H_
+#define MYSQLSHDK_LIBS_DB_MYSQL_PREPARED_STATEMENT_H_
+
+#include <mysql.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mysqlshdk/libs/db/result.h"
+#include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk/libs/db/row_batch.h"
+#include "mysqlshdk/libs/db/session.h"
+
+namespace mysqlshdk {
+namespace db {
+namespace mysql {
+
+class Session_impl;
+
+/**
+ * Statement prepared on the server. Buffers used to bind the parameters and
+ * the result are allocated once and reused by all the executions.
+ */
+class Prepared_statement {
+ public:
+  /**
+   * Prepares the statement.
+   *
+   * @throws Error if statement cannot be prepared.
+   */
+  Prepared_statement(MYSQL *mysql, const std::string &sql);
+
+  Prepared_statement(const Prepared_statement &) = delete;
+  Prepared_statement &operator=(const Prepared_statement &) = delete;
+
+  ~Prepared_statement();
+
+  const std::string &sql() const { return m_sql; }
+
+  /**
+   * Executes the statement, previous result is discarded.
+   *
+   * @param args values of the placeholders
+   * @param buffered if true, whole result is read by the client
+   *
+   * @throws std::invalid_argument if number of values is wrong.
+   * @throws Error if execution fails.
+   */
+  void execute(const std::vector<Statement_arg> &args, bool buffered);
+
+  /**
+   * Reads the next row into the result buffers.
+   *
+   * @returns false if there are no more rows.
+   */
+  bool fetch();
+
+  /**
+   * Positions the buffered result at the given row.
+   */
+  void seek(uint64_t row);
+
+  /**
+   * Discards the result of the last execution.
+   */
+  void free_result();
+
+  /**
+   * Whether rows of an unbuffered result are still waiting to be read,
+   * blocking the connection.
+   */
+  bool is_reading() const { return m_reading; }
+
+  bool has_resultset() const { return !m_metadata.empty(); }
+
+  const std::vector<Column> &metadata() const { return m_metadata; }
+
+  uint64_t affected_rows() const { return m_affected_rows; }
+
+  uint64_t insert_id() const { return m_insert_id; }
+
+  uint64_t warning_count() const { return m_warning_count; }
+
+  const std::string &info() const { return m_info; }
+
+  // values of the last fetched row
+  bool is_null(uint32_t index) const { return m_fields[index].is_null; }
+
+  int64_t int_value(uint32_t index) const { return m_fields[index].value.i; }
+
+  uint64_t uint_value(uint32_t index) const {
+    return m_fields[index].value.u;
+  }
+
+  float float_value(uint32_t index) const { return m_fields[index].value.f; }
+
+  double double_value(uint32_t index) const { return m_fields[index].value.d; }
+
+  std::pair<const char *, size_t> string_value(uint32_t index) const {
+    return {m_fields[index].data.data(), m_fields[index].length};
+  }
+
+ private:
+  union Number {
+    int64_t i;
+    uint64_t u;
+    float f;
+    double d;
+  };
+
+  struct Field {
+    Number value;
+    std::vector<char> data;
+    unsigned long length = 0;  // NOLINT(runtime/int)
+    bool is_null = false;
+  };
+
+  Error error() const;
+
+  void bind_params(const std::vector<Statement_arg> &args);
+
+  void prepare_result();
+
+  void fetch_truncated();
+
+  MYSQL *m_mysql;
+  MYSQL_STMT *m_stmt;
+  std::string m_sql;
+
+  std::vector<MYSQL_BIND> m_params;
+  std::vector<Number> m_param_values;
+
+  std::vector<Column> m_metadata;
+  std::vector<MYSQL_BIND> m_binds;
+  std::vector<Field> m_fields;
+
+  uint64_t m_affected_rows = 0;
+  uint64_t m_insert_id = 0;
+  uint64_t m_warning_count = 0;
+  std::string m_info;
+  bool m_has_result = false;
+  bool m_reading = false;
+};
+
+/**
+ * Row of a prepared statement result, values are read directly from the
+ * typed result buffers, numbers are not parsed.
+ *
+ * Values are the same as the ones returned by mysql::Row for the same query.
+ */
+class SHCORE_PUBLIC Stmt_row : public IRow {
+ public:
+  explicit Stmt_row(const Prepared_statement *stmt) : m_stmt(stmt) {}
+
+  uint32_t num_fields() const override;
+
+  Type get_type(uint32_t index) const override;
+  bool is_null(uint32_t index) const override;
+  std::string get_as_string(uint32_t index) const override;
+
+  std::string get_string(uint32_t index) const override;
+  int64_t get_int(uint32_t index) const override;
+  uint64_t get_uint(uint32_t index) const override;
+  float get_float(uint32_t index) const override;
+  double get_double(uint32_t index) const override;
+  std::pair<const char *, size_t> get_string_data(
+      uint32_t index) const override;
+  uint64_t get_bit(uint32_t index) const override;
+
+ private:
+  const Column &column(uint32_t index) const {
+    return m_stmt->metadata()[index];
+  }
+
+  const Prepared_statement *m_stmt;
+};
+
+/**
+ * Result of a prepared statement.
+ *
+ * Only the first result set is returned if statement is a CALL of a stored
+ * procedure.
+ */
+class SHCORE_PUBLIC Stmt_result : public IResult {
+ public:
+  Stmt_result(std::shared_ptr<Session_impl> owner,
+              std::shared_ptr<Prepared_statement> stmt, bool buffered);
+
+  Stmt_result(const Stmt_result &) = delete;
+  Stmt_result &operator=(const Stmt_result &) = delete;
+
+  ~Stmt_result() override = default;
+
+  // Data Retrieving
+  const IRow *fetch_one() override;
+  bool next_resultset() override { return false; }
+  std::unique_ptr<Warning> fetch_one_warning() override;
+
+  // Metadata retrieval
+  int64_t get_auto_increment_value() const override { return m_insert_id; }
+  bool has_resultset() override { return m_stmt->has_resultset(); }
+  uint64_t get_affected_row_count() const override { return m_affected_rows; }
+  uint64_t get_fetched_row_count() const override {
+    return m_fetched_row_count;
+  }
+  uint64_t get_warning_count() const override { return m_warning_count; }
+  std::string get_info() const override { return m_info; }
+  const std::vector<std::string> &get_gtids() const override { return m_gtids; }
+  const std::vector<Column> &get_metadata() const override {
+    return m_stmt->metadata();
+  }
+  std::shared_ptr<Field_names> field_names() const override;
+
+  void buffer() override;
+  void rewind() override;
+
+ private:
+  std::weak_ptr<Session_impl> m_session;
+  std::shared_ptr<Prepared_statement> m_stmt;
+  Stmt_row m_row;
+
+  // rows fetched from unbuffered result before buffer() was called
+  Row_batch m_pre_fetched_rows;
+  Batch_row m_pre_fetched_row{&m_pre_fetched_rows};
+  bool m_pre_fetched = false;
+
+  bool m_buffered;
+  bool m_fetched_warnings = false;
+  uint64_t m_fetched_row_count = 0;
+  uint64_t m_affected_rows;
+  uint64_t m_insert_id;
+  uint64_t m_warning_count;
+  std::string m_info;
+  std::vector<std::string> m_gtids;
+  std::list<std::unique_ptr<Warning>> m_warnings;
+  mutable std::shared_ptr<Field_names> m_field_names;
+};
+
+}  // namespace mysql
+}  // namespace db
+}  // namespace mysqlshdk
+#endif  // MYSQLSHDK_LIBS_DB_MYSQL_PREPARED_STATEMENT_H_
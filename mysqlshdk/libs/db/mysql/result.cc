@@ -160,40 +160,32 @@ void Result::fetch_metadata() {
     MYSQL_FIELD *fields = mysql_fetch_fields(res.get());
 
     for (int index = 0; index < num_fields; index++) {
-      _metadata.push_back(mysqlshdk::db::Column(
-          fields[index].catalog, fields[index].db, fields[index].org_table,
-          fields[index].table, fields[index].org_name, fields[index].name,
-          fields[index].length, fields[index].decimals,
-          map_data_type(fields[index].type, fields[index].flags),
-          fields[index].charsetnr,
-          static_cast<bool>(fields[index].flags & UNSIGNED_FLAG),
-          static_cast<bool>(fields[index].flags & ZEROFILL_FLAG),
-          static_cast<bool>(fields[index].flags & BINARY_FLAG),
-          fieldflags2str(fields[index].flags),
-          fieldtype2str(fields[index].type)));
+      _metadata.push_back(make_column(fields[index]));
     }
   }
 }
 
+Column Result::make_column(const MYSQL_FIELD &field) {
+  return mysqlshdk::db::Column(
+      field.catalog, field.db, field.org_table, field.table, field.org_name,
+      field.name, field.length, field.decimals,
+      map_data_type(field.type, field.flags), field.charsetnr,
+      static_cast<bool>(field.flags & UNSIGNED_FLAG),
+      static_cast<bool>(field.flags & ZEROFILL_FLAG),
+      static_cast<bool>(field.flags & BINARY_FLAG),
+      fieldflags2str(field.flags), fieldtype2str(field.type));
+}
+
 Result::~Result() {}
 
 const IRow *Result::fetch_one() {
   if (_pre_fetched) {
-    if (!_persistent_pre_fetch) {
-      if (!_pre_fetched_rows.empty()) {
-        if (_fetched_row_count > 0)  // free the previously fetched row
-          _pre_fetched_rows.pop_front();
-        if (!_pre_fetched_rows.empty()) {
-          // return the next row, but don't pop it yet otherwise it'll be freed
-          const IRow *row = &_pre_fetched_rows.front();
-          _fetched_row_count++;
-          return row;
-        }
-      }
-    } else {
-      if (_fetched_row_count < _pre_fetched_rows.size()) {
-        return &_pre_fetched_rows[_fetched_row_count++];
-      }
+    if (_fetched_row_count < _pre_fetched_rows.size()) {
+      _pre_fetched_row.reset(_fetched_row_count++);
+      return &_pre_fetched_row;
+    } else if (!_persistent_pre_fetch) {
+      // all rows were consumed, free them
+      _pre_fetched_rows.clear();
     }
   } else {
     _row.reset();
@@ -311,7 +303,7 @@ bool Result::pre_fetch_rows(bool persistent) {
     if (!has_resultset()) return false;
     while (auto row = fetch_one()) {
       if (_stop_pre_fetch) return true;
-      _pre_fetched_rows.emplace_back(*row);
+      _pre_fetched_rows.append(*row);
     }
     _fetched_row_count = 0;
 
@@ -28,6 +28,7 @@
 #define MYSQLSHDK_LIBS_DB_MYSQL_RESULT_H_
 
 #include "mysqlshdk/libs/db/result.h"
+#include "mysqlshdk/libs/db/row_batch.h"
 
 #include <deque>
 #include <list>
@@ -70,13 +71,19 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
 
   bool is_buffered() { return m_buffered; }
 
+  /**
+   * Converts the metadata received from the server.
+   */
+  static Column make_column(const MYSQL_FIELD &field);
+
  protected:
   Result(std::shared_ptr<mysqlshdk::db::mysql::Session_impl> owner,
          uint64_t affected_rows, unsigned int warning_count,
          uint64_t last_insert_id, const char *info, bool buffered);
   void reset(std::shared_ptr<MYSQL_RES> res);
 
-  std::deque<mysqlshdk::db::Row_copy> _pre_fetched_rows;
+  mysqlshdk::db::Row_batch _pre_fetched_rows;
+  mysqlshdk::db::Batch_row _pre_fetched_row{&_pre_fetched_rows};
   // size_t _fetched_row_count = 0;
   // size_t _fetched_warning_count = 0;
   bool _stop_pre_fetch = false;
@@ -87,7 +94,7 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
   void stop_pre_fetch();
 
   void fetch_metadata();
-  Type map_data_type(int raw_type, int flags);
+  static Type map_data_type(int raw_type, int flags);
 
   virtual std::shared_ptr<Field_names> field_names() const;
 
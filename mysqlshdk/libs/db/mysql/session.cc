@@ -284,6 +284,10 @@ void Session_impl::close() {
   // avoid having unneeded output on the script mode
   if (_prev_result) _prev_result.reset();
 
+  // statements still referenced by results are closed once they're released
+  m_statements_by_sql.clear();
+  m_statements.clear();
+
   if (_mysql) {
     DBUG_LOG("sql", get_thread_id() << ": DISCONNECT");
     mysql_close(_mysql);
@@ -305,18 +309,7 @@ std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
   if (_mysql == nullptr) throw std::runtime_error("Not connected");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("run_sql");
-  if (_prev_result) {
-    _prev_result.reset();
-  } else {
-    MYSQL_RES *unread_result = mysql_use_result(_mysql);
-    mysql_free_result(unread_result);
-  }
-
-  // Discards any pending result
-  while (mysql_next_result(_mysql) == 0) {
-    MYSQL_RES *trailing_result = mysql_use_result(_mysql);
-    mysql_free_result(trailing_result);
-  }
+  discard_pending_results();
 
   DBUG_LOG("sqlall", get_thread_id() << ": QUERY: " << std::string(sql, len));
 
@@ -345,6 +338,165 @@ std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
   return std::static_pointer_cast<IResult>(result);
 }
 
+void Session_impl::execute_batch(
+    const std::vector<std::string> &statements,
+    std::vector<std::shared_ptr<IResult>> *results) {
+  if (_mysql == nullptr) throw std::runtime_error("Not connected");
+  if (statements.empty()) return;
+  discard_pending_results();
+
+  std::string sql;
+
+  for (const auto &stmt : statements) {
+    // new line terminates a comment which may be at the end of the statement
+    if (!sql.empty()) sql.append("\n;");
+    sql.append(stmt);
+  }
+
+  DBUG_LOG("sqlall", get_thread_id() << ": BATCH: " << sql);
+
+  const auto error = [this]() {
+    return Error(mysql_error(_mysql), mysql_errno(_mysql),
+                 mysql_sqlstate(_mysql));
+  };
+
+  if (mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON) != 0)
+    throw error();
+
+  shcore::Scoped_callback restore([this]() {
+    discard_pending_results();
+    mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+  });
+
+  int status = mysql_real_query(_mysql, sql.data(), sql.length());
+
+  for (size_t i = 0; i < statements.size(); ++i) {
+    if (i > 0) status = mysql_next_result(_mysql);
+
+    // no more results
+    if (status < 0) break;
+
+    if (status > 0) {
+      auto err = error();
+      DBUG_LOG("sql", get_thread_id() << ": ERROR: " << err.format()
+                                      << "\n\twhile executing: "
+                                      << statements[i]);
+      throw err;
+    }
+
+    mysql_free_result(mysql_store_result(_mysql));
+
+    results->emplace_back(new Result(nullptr, mysql_affected_rows(_mysql),
+                                     mysql_warning_count(_mysql),
+                                     mysql_insert_id(_mysql),
+                                     mysql_info(_mysql), true));
+  }
+}
+
+void Session_impl::discard_pending_results() {
+  if (auto stmt = m_prev_statement.lock()) {
+    if (stmt->is_reading()) stmt->free_result();
+  }
+
+  m_prev_statement.reset();
+
+  if (_prev_result) {
+    _prev_result.reset();
+  } else {
+    MYSQL_RES *unread_result = mysql_use_result(_mysql);
+    mysql_free_result(unread_result);
+  }
+
+  // Discards any pending result
+  while (mysql_next_result(_mysql) == 0) {
+    MYSQL_RES *trailing_result = mysql_use_result(_mysql);
+    mysql_free_result(trailing_result);
+  }
+}
+
+std::shared_ptr<Prepared_statement> Session_impl::get_statement(
+    const std::string &sql) {
+  // unqualified names are resolved using the default schema in effect when
+  // statement is prepared, cached statements cannot be used once it changes
+  // (client library keeps track of it using the session state information)
+  const char *schema = _mysql->db ? _mysql->db : "";
+
+  if (m_statements_schema != schema) {
+    m_statements_by_sql.clear();
+    m_statements.clear();
+    m_statements_schema = schema;
+  }
+
+  const auto it = m_statements_by_sql.find(sql);
+
+  if (it != m_statements_by_sql.end()) {
+    // results of the previous execution still need the statement if it's
+    // referenced elsewhere, a new one is prepared in such case
+    if (it->second->use_count() == 1) {
+      m_statements.splice(m_statements.begin(), m_statements, it->second);
+      return m_statements.front();
+    }
+
+    forget_statement(sql);
+  }
+
+  DBUG_LOG("sqlall", get_thread_id() << ": PREPARE: " << sql);
+
+  auto stmt = std::make_shared<Prepared_statement>(_mysql, sql);
+
+  m_statements.emplace_front(stmt);
+  m_statements_by_sql.emplace(sql, m_statements.begin());
+
+  if (m_statements.size() > k_max_cached_statements) {
+    m_statements_by_sql.erase(m_statements.back()->sql());
+    m_statements.pop_back();
+  }
+
+  return stmt;
+}
+
+void Session_impl::forget_statement(const std::string &sql) {
+  const auto it = m_statements_by_sql.find(sql);
+
+  if (it != m_statements_by_sql.end()) {
+    m_statements.erase(it->second);
+    m_statements_by_sql.erase(it);
+  }
+}
+
+std::shared_ptr<IResult> Session_impl::query_prepared(
+    const std::string &sql, const std::vector<Statement_arg> &args,
+    bool buffered) {
+  if (_mysql == nullptr) throw std::runtime_error("Not connected");
+  mysqlshdk::utils::Profile_timer timer;
+  timer.stage_begin("query_prepared");
+  discard_pending_results();
+
+  DBUG_LOG("sqlall", get_thread_id() << ": EXECUTE: " << sql);
+
+  std::shared_ptr<Prepared_statement> stmt;
+
+  try {
+    stmt = get_statement(sql);
+    stmt->execute(args, buffered);
+  } catch (const Error &err) {
+    DBUG_LOG("sql", get_thread_id() << ": ERROR: " << err.format()
+                                    << "\n\twhile executing: " << sql);
+    // statement may no longer be valid, it's prepared again next time
+    if (stmt) forget_statement(sql);
+    throw;
+  }
+
+  if (stmt->is_reading()) m_prev_statement = stmt;
+
+  auto result = std::make_shared<Stmt_result>(shared_from_this(),
+                                              std::move(stmt), buffered);
+
+  timer.stage_end();
+  result->set_execution_time(timer.total_seconds_ellapsed());
+  return std::static_pointer_cast<IResult>(result);
+}
+
 template <class T>
 static void free_result(T *result) {
   mysql_free_result(result);
@@ -397,6 +549,8 @@ std::vector<std::string> Session_impl::get_last_gtids() const {
   return gtids;
 }
 
+constexpr size_t Session_impl::k_max_cached_statements;
+
 std::function<std::shared_ptr<Session>()> g_session_factory;
 
 std::function<std::shared_ptr<Session>()> Session::set_factory_function(
@@ -30,12 +30,15 @@
 #include <mysql.h>
 #include <mysqld_error.h>
 #include <functional>
+#include <list>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "mysqlshdk/libs/db/connection_options.h"
+#include "mysqlshdk/libs/db/mysql/prepared_statement.h"
 #include "mysqlshdk/libs/db/mysql/result.h"
 #include "mysqlshdk/libs/db/session.h"
 
@@ -53,6 +56,7 @@ namespace mysql {
 class Session_impl : public std::enable_shared_from_this<Session_impl> {
   friend class Session;  // The Session class instantiates this class
   friend class Result;   // The Result class uses some functions of this class
+  friend class Stmt_result;
  public:
   virtual ~Session_impl();
 
@@ -63,6 +67,13 @@ class Session_impl : public std::enable_shared_from_this<Session_impl> {
   std::shared_ptr<IResult> query(const char *sql, size_t len, bool buffered);
   void execute(const char *sql, size_t len);
 
+  std::shared_ptr<IResult> query_prepared(
+      const std::string &sql, const std::vector<Statement_arg> &args,
+      bool buffered);
+
+  void execute_batch(const std::vector<std::string> &statements,
+                     std::vector<std::shared_ptr<IResult>> *results);
+
   void start_transaction();
   void commit();
   void rollback();
@@ -150,11 +161,25 @@ class Session_impl : public std::enable_shared_from_this<Session_impl> {
 
   std::shared_ptr<IResult> run_sql(const char *sql, size_t len,
                                    bool lazy_fetch = true);
+  void discard_pending_results();
+  std::shared_ptr<Prepared_statement> get_statement(const std::string &sql);
+  void forget_statement(const std::string &sql);
   bool setup_ssl(const mysqlshdk::db::Ssl_options &ssl_options) const;
   void throw_on_connection_fail();
   std::string _uri;
   MYSQL *_mysql = nullptr;
   std::shared_ptr<MYSQL_RES> _prev_result;
+  // statement with an unbuffered result which is being read
+  std::weak_ptr<Prepared_statement> m_prev_statement;
+
+  // prepared statements keyed by the SQL text, most recently used first
+  static constexpr size_t k_max_cached_statements = 64;
+  std::list<std::shared_ptr<Prepared_statement>> m_statements;
+  std::unordered_map<std::string,
+                     std::list<std::shared_ptr<Prepared_statement>>::iterator>
+      m_statements_by_sql;
+  // default schema in effect when the cached statements were prepared
+  std::string m_statements_schema;
   mysqlshdk::db::Connection_options _connection_options;
   std::unique_ptr<Error> m_last_error;
 
@@ -195,6 +220,33 @@ class SHCORE_PUBLIC Session : public ISession,
     _impl->execute(sql, len);
   }
 
+  std::shared_ptr<IResult> query_prepared(
+      const std::string &sql, const std::vector<Statement_arg> &args,
+      bool buffered = false) override {
+    return _impl->query_prepared(sql, args, buffered);
+  }
+
+  /**
+   * Sends the given statements to the server in a single packet, statements
+   * are executed one after another. Multi-statement support is enabled only
+   * for the duration of this call.
+   *
+   * Statements must not return a result set. Warnings of the executed
+   * statements are not available, only their count.
+   *
+   * @param statements statements to execute, without the delimiter
+   * @param results receives result of each statement which was executed
+   *        successfully
+   *
+   * @throws Error if one of the statements fails, statements which follow it
+   *         are not executed. The failed statement is the one at the index
+   *         equal to the number of received results.
+   */
+  virtual void execute_batch(const std::vector<std::string> &statements,
+                             std::vector<std::shared_ptr<IResult>> *results) {
+    _impl->execute_batch(statements, results);
+  }
+
   void close() override { _impl->close(); }
   const char *get_ssl_cipher() const override {
     return _impl->get_ssl_cipher();
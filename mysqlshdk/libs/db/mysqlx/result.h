@@ -38,6 +38,7 @@
 
 #include "mysqlshdk/libs/db/mysqlx/mysqlxclient_clean.h"
 #include "mysqlshdk/libs/db/mysqlx/row.h"
+#include "mysqlshdk/libs/db/row_batch.h"
 #include "mysqlshdk/libs/db/row_copy.h"
 
 namespace mysqlshdk {
@@ -82,7 +83,8 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
 
   std::vector<Column> _metadata;
 
-  std::deque<mysqlshdk::db::Row_copy> _pre_fetched_rows;
+  mysqlshdk::db::Row_batch _pre_fetched_rows;
+  mysqlshdk::db::Batch_row _pre_fetched_row{&_pre_fetched_rows};
   std::unique_ptr<xcl::XQuery_result> _result;
   mutable std::shared_ptr<Field_names> _field_names;
 
@@ -107,6 +107,14 @@ void Recorder_mysql::executes(const char *sql, size_t length) {
   querys(sql, length, true);
 }
 
+void Recorder_mysql::execute_batch(
+    const std::vector<std::string> &statements,
+    std::vector<std::shared_ptr<IResult>> *results) {
+  for (const auto &stmt : statements) {
+    results->emplace_back(querys(stmt.data(), stmt.length(), true));
+  }
+}
+
 void Recorder_mysql::close() {
   try {
     if (_trace && !_closed) {
@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
@@ -59,6 +60,17 @@ class Recorder_mysql : public mysql::Session {
 
   void executes(const char *sql, size_t length) override;
 
+  // traces hold text queries, placeholders are substituted on the client side
+  std::shared_ptr<IResult> query_prepared(
+      const std::string &sql, const std::vector<Statement_arg> &args,
+      bool buffered) override {
+    return ISession::query_prepared(sql, args, buffered);
+  }
+
+  // traces hold single statements, batch is recorded one statement at a time
+  void execute_batch(const std::vector<std::string> &statements,
+                     std::vector<std::shared_ptr<IResult>> *results) override;
+
   void close() override;
 
  private:
@@ -182,6 +182,14 @@ void Replayer_mysql::executes(const char *sql, size_t length) {
   querys(sql, length, true);
 }
 
+void Replayer_mysql::execute_batch(
+    const std::vector<std::string> &statements,
+    std::vector<std::shared_ptr<IResult>> *results) {
+  for (const auto &stmt : statements) {
+    results->emplace_back(querys(stmt.data(), stmt.length(), true));
+  }
+}
+
 void Replayer_mysql::close() { _impl->close(); }
 
 bool Replayer_mysql::is_open() const { return _impl->is_open(); }
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/db/row_batch.h"
+
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlshdk {
+namespace db {
+
+#define FIELD_ERROR(index, msg) \
+  std::invalid_argument(        \
+      shcore::str_format("%s(%u): " msg, __FUNCTION__, index).c_str())
+
+#define FIELD_ERROR1(index, msg, arg) \
+  std::invalid_argument(              \
+      shcore::str_format("%s(%u): " msg, __FUNCTION__, index, arg).c_str())
+
+#define VALIDATE_INDEX(index)                          \
+  do {                                                 \
+    if (index >= num_fields())                         \
+      throw FIELD_ERROR(index, "index out of bounds"); \
+  } while (0)
+
+#define GET_VALIDATE_TYPE(index, TYPE_CHECK)                                  \
+  if (index >= num_fields()) throw FIELD_ERROR(index, "index out of bounds"); \
+  if (is_null(index)) throw FIELD_ERROR(index, "field is NULL");              \
+  ftype = get_type(index);                                                    \
+  if (!(TYPE_CHECK))                                                          \
+    throw FIELD_ERROR1(index, "field type is %s", to_string(ftype).c_str());
+
+namespace {
+
+// strings are copied to blocks of this size, larger values get their own
+// block
+constexpr size_t k_block_size = 64 * 1024;
+
+bool is_stored_as_string(Type type) {
+  switch (type) {
+    case Type::Integer:
+    case Type::UInteger:
+    case Type::Float:
+    case Type::Double:
+    case Type::Null:
+      return false;
+
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+constexpr uint32_t Row_batch::k_not_a_string;
+
+void Row_batch::append(const IRow &row) {
+  const auto field_count = row.num_fields();
+
+  if (m_types.empty()) {
+    for (uint32_t i = 0; i < field_count; ++i) {
+      const auto type = row.get_type(i);
+      m_types.push_back(type);
+      m_string_fields.push_back(is_stored_as_string(type)
+                                    ? m_string_field_count++
+                                    : k_not_a_string);
+    }
+  } else if (field_count != num_fields()) {
+    throw std::invalid_argument(
+        "The number of fields does not match the row batch");
+  }
+
+  m_values.resize(m_values.size() + field_count);
+  m_lengths.resize(m_lengths.size() + m_string_field_count);
+  m_nulls.resize(m_nulls.size() + field_count);
+
+  const size_t first = index(m_rows, 0);
+  uint32_t *lengths = m_lengths.data() + m_rows * m_string_field_count;
+
+  try {
+    for (uint32_t i = 0; i < field_count; ++i) {
+      const auto type = m_types[i];
+
+      if (row.is_null(i) || Type::Null == row.get_type(i)) {
+        m_nulls[first + i] = true;
+        continue;
+      }
+
+      if (row.get_type(i) != type) {
+        throw FIELD_ERROR1(i, "field type %s does not match the row batch",
+                           to_string(row.get_type(i)).c_str());
+      }
+
+      auto &value = m_values[first + i];
+
+      switch (type) {
+        case Type::Integer:
+          value.i = row.get_int(i);
+          break;
+
+        case Type::UInteger:
+          value.u = row.get_uint(i);
+          break;
+
+        case Type::Float:
+          value.f = row.get_float(i);
+          break;
+
+        case Type::Double:
+          value.d = row.get_double(i);
+          break;
+
+        case Type::String:
+        case Type::Bytes: {
+          // no need to create a temporary string
+          const auto data = row.get_string_data(i);
+          value.s = store(data.first, data.second);
+          lengths[m_string_fields[i]] = static_cast<uint32_t>(data.second);
+          break;
+        }
+
+        default: {
+          const auto data = Type::Decimal == type || Type::Bit == type
+                                ? row.get_as_string(i)
+                                : row.get_string(i);
+          value.s = store(data.data(), data.length());
+          lengths[m_string_fields[i]] = static_cast<uint32_t>(data.length());
+          break;
+        }
+      }
+    }
+  } catch (...) {
+    // removes the partially copied row
+    m_values.resize(first);
+    m_lengths.resize(m_rows * m_string_field_count);
+    m_nulls.resize(first);
+    throw;
+  }
+
+  ++m_rows;
+}
+
+void Row_batch::clear() {
+  m_types.clear();
+  m_string_fields.clear();
+  m_string_field_count = 0;
+  m_rows = 0;
+
+  // swap is used to actually release the memory
+  std::vector<Value>().swap(m_values);
+  std::vector<uint32_t>().swap(m_lengths);
+  std::vector<bool>().swap(m_nulls);
+  std::vector<std::unique_ptr<char[]>>().swap(m_blocks);
+
+  m_block_pos = nullptr;
+  m_block_free = 0;
+  m_blocks_size = 0;
+}
+
+size_t Row_batch::allocated_memory() const {
+  return m_values.capacity() * sizeof(Value) +
+         m_lengths.capacity() * sizeof(uint32_t) + m_nulls.capacity() / 8 +
+         m_blocks.capacity() * sizeof(std::unique_ptr<char[]>) + m_blocks_size;
+}
+
+const char *Row_batch::store(const char *data, size_t length) {
+  if (0 == length) return "";
+
+  if (length > m_block_free) {
+    if (length > k_block_size / 4) {
+      // large value, allocate a dedicated block, current one is still used
+      m_blocks.emplace_back(new char[length]);
+      m_blocks_size += length;
+      std::memcpy(m_blocks.back().get(), data, length);
+      return m_blocks.back().get();
+    }
+
+    m_blocks.emplace_back(new char[k_block_size]);
+    m_blocks_size += k_block_size;
+    m_block_pos = m_blocks.back().get();
+    m_block_free = k_block_size;
+  }
+
+  char *result = m_block_pos;
+  std::memcpy(result, data, length);
+  m_block_pos += length;
+  m_block_free -= length;
+
+  return result;
+}
+
+uint32_t Batch_row::num_fields() const { return m_batch->num_fields(); }
+
+Type Batch_row::get_type(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return m_batch->m_types[index];
+}
+
+bool Batch_row::is_null(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return m_batch->m_nulls[m_batch->index(m_row, index)];
+}
+
+std::string Batch_row::get_as_string(uint32_t index) const {
+  VALIDATE_INDEX(index);
+
+  if (is_null(index)) return "NULL";
+
+  switch (get_type(index)) {
+    case Type::Null:
+      return "NULL";
+
+    case Type::Integer:
+      return std::to_string(value(index).i);
+
+    case Type::UInteger:
+      return std::to_string(value(index).u);
+
+    case Type::Float:
+      return std::to_string(value(index).f);
+
+    case Type::Double:
+      return std::to_string(value(index).d);
+
+    default:
+      return string_value(index);
+  }
+}
+
+int64_t Batch_row::get_int(uint32_t index) const {
+  Type ftype;
+  std::string dec;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
+                            (ftype == Type::Decimal &&
+                             (dec = string_value(index)).find('.') ==
+                                 std::string::npos)));
+
+  if (ftype == Type::UInteger) {
+    uint64_t u = value(index).u;
+    if (u > LLONG_MAX) {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return static_cast<int64_t>(u);
+  } else if (ftype == Type::Decimal) {
+    return std::stoll(dec);
+  }
+  return value(index).i;
+}
+
+uint64_t Batch_row::get_uint(uint32_t index) const {
+  Type ftype;
+  std::string dec;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
+                            (ftype == Type::Decimal &&
+                             (dec = string_value(index)).find('.') ==
+                                 std::string::npos)));
+
+  if (ftype == Type::Integer) {
+    int64_t i = value(index).i;
+    if (i < 0) {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return static_cast<uint64_t>(i);
+  } else if (ftype == Type::Decimal) {
+    if (!dec.empty() && dec[0] == '-') {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return std::stoull(dec);
+  }
+  return value(index).u;
+}
+
+std::string Batch_row::get_string(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (is_string_type(ftype)));
+  return string_value(index);
+}
+
+std::pair<const char *, size_t> Batch_row::get_string_data(
+    uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::String || ftype == Type::Bytes));
+  return {value(index).s,
+          m_batch->m_lengths[m_row * m_batch->m_string_field_count +
+                             m_batch->m_string_fields[index]]};
+}
+
+float Batch_row::get_float(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Decimal ||
+                            ftype == Type::Double));
+  switch (ftype) {
+    case Type::Decimal:
+      try {
+        return std::stof(string_value(index));
+      } catch (...) {
+        throw FIELD_ERROR(index, "float value out of the allowed range");
+      }
+    case Type::Double:
+      return static_cast<float>(value(index).d);
+    case Type::Float:
+      return value(index).f;
+    default:
+      throw std::logic_error("internal error");
+  }
+}
+
+double Batch_row::get_double(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Double || ftype == Type::Float ||
+                            ftype == Type::Decimal));
+  switch (ftype) {
+    case Type::Decimal:
+      try {
+        return std::stod(string_value(index));
+      } catch (const std::exception &e) {
+        throw FIELD_ERROR(index, "double value out of the allowed range");
+      }
+    case Type::Float:
+      return static_cast<double>(value(index).f);
+    case Type::Double:
+      return value(index).d;
+    default:
+      throw std::logic_error("internal error");
+  }
+}
+
+uint64_t Batch_row::get_bit(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Bit));
+  return shcore::string_to_bits(string_value(index)).first;
+}
+
+std::string Batch_row::string_value(uint32_t index) const {
+  return std::string(
+      value(index).s,
+      m_batch->m_lengths[m_row * m_batch->m_string_field_count +
+                         m_batch->m_string_fields[index]]);
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// Compact storage for persistent copies of many Row objects
+
+#ifndef MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
+#define MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "mysqlshdk/include/mysqlshdk_export.h"
+#include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/row.h"
+
+namespace mysqlshdk {
+namespace db {
+
+/**
+ * Holds copies of rows with the same layout, i.e. rows of a buffered result.
+ *
+ * As opposed to Row_copy, which allocates each field separately, data is kept
+ * in a couple of contiguous areas:
+ *  - fixed width area, one 8 byte slot per field, holding either the numeric
+ *    value or a pointer to the string value,
+ *  - lengths of the string values,
+ *  - null bitmap,
+ *  - arena with the string values, allocated in large blocks.
+ *
+ * Rows are accessed using the Batch_row views.
+ */
+class SHCORE_PUBLIC Row_batch {
+ public:
+  Row_batch() = default;
+
+  Row_batch(const Row_batch &) = delete;
+  Row_batch &operator=(const Row_batch &) = delete;
+
+  Row_batch(Row_batch &&) = default;
+  Row_batch &operator=(Row_batch &&) = default;
+
+  ~Row_batch() = default;
+
+  /**
+   * Copies the given row. Layout of the batch is defined by the first row
+   * which is appended, all the subsequent rows need to have the same number
+   * of fields and types.
+   *
+   * @param row Row to be copied.
+   *
+   * @throws std::invalid_argument if row does not match the layout.
+   */
+  void append(const IRow &row);
+
+  /**
+   * Removes all the rows and releases the memory.
+   */
+  void clear();
+
+  size_t size() const { return m_rows; }
+
+  bool empty() const { return 0 == m_rows; }
+
+  uint32_t num_fields() const { return static_cast<uint32_t>(m_types.size()); }
+
+  /**
+   * Returns the approximate number of bytes allocated to store the rows.
+   */
+  size_t allocated_memory() const;
+
+ private:
+  friend class Batch_row;
+
+  union Value {
+    int64_t i;
+    uint64_t u;
+    float f;
+    double d;
+    const char *s;
+  };
+
+  static constexpr uint32_t k_not_a_string = static_cast<uint32_t>(-1);
+
+  const char *store(const char *data, size_t length);
+
+  size_t index(size_t row, uint32_t field) const {
+    return row * m_types.size() + field;
+  }
+
+  std::vector<Type> m_types;
+  // index of the string field in m_lengths, k_not_a_string if numeric
+  std::vector<uint32_t> m_string_fields;
+  uint32_t m_string_field_count = 0;
+  size_t m_rows = 0;
+
+  std::vector<Value> m_values;
+  std::vector<uint32_t> m_lengths;
+  std::vector<bool> m_nulls;
+
+  std::vector<std::unique_ptr<char[]>> m_blocks;
+  char *m_block_pos = nullptr;
+  size_t m_block_free = 0;
+  size_t m_blocks_size = 0;
+};
+
+/**
+ * Read only view of a row stored in a Row_batch, behaves the same way as
+ * Row_copy of that row. View can be repointed to other rows of the batch.
+ */
+class SHCORE_PUBLIC Batch_row : public IRow {
+ public:
+  explicit Batch_row(const Row_batch *batch, size_t row = 0)
+      : m_batch(batch), m_row(row) {}
+
+  void reset(size_t row) { m_row = row; }
+
+  size_t row() const { return m_row; }
+
+  uint32_t num_fields() const override;
+
+  Type get_type(uint32_t index) const override;
+  bool is_null(uint32_t index) const override;
+  std::string get_as_string(uint32_t index) const override;
+
+  std::string get_string(uint32_t index) const override;
+  int64_t get_int(uint32_t index) const override;
+  uint64_t get_uint(uint32_t index) const override;
+  float get_float(uint32_t index) const override;
+  double get_double(uint32_t index) const override;
+  std::pair<const char *, size_t> get_string_data(
+      uint32_t index) const override;
+  uint64_t get_bit(uint32_t index) const override;
+
+ private:
+  const Row_batch::Value &value(uint32_t index) const {
+    return m_batch->m_values[m_batch->index(m_row, index)];
+  }
+
+  std::string string_value(uint32_t index) const;
+
+  const Row_batch *m_batch;
+  size_t m_row;
+};
+
+}  // namespace db
+}  // namespace mysqlshdk
+#endif  // MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
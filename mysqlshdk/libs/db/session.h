@@ -32,6 +32,8 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "mysqlshdk/libs/db/connection_options.h"
 #include "mysqlshdk/libs/db/result.h"
@@ -76,6 +78,54 @@ class Error : public std::runtime_error {
   std::string sqlstate_;
 };
 
+/**
+ * Value of a placeholder of a prepared statement.
+ */
+class Statement_arg {
+ public:
+  enum class Kind { Null, Integer, UInteger, Double, String };
+
+  Statement_arg(std::nullptr_t) : m_kind(Kind::Null) {}  // NOLINT
+
+  template <typename T, typename std::enable_if<std::is_integral<T>::value &&
+                                                    std::is_signed<T>::value,
+                                                int>::type = 0>
+  Statement_arg(T value)  // NOLINT
+      : m_kind(Kind::Integer), m_int(value) {}
+
+  template <typename T, typename std::enable_if<std::is_integral<T>::value &&
+                                                    !std::is_signed<T>::value,
+                                                int>::type = 0>
+  Statement_arg(T value)  // NOLINT
+      : m_kind(Kind::UInteger), m_uint(value) {}
+
+  Statement_arg(double value)  // NOLINT
+      : m_kind(Kind::Double), m_double(value) {}
+
+  Statement_arg(const char *value)  // NOLINT
+      : m_kind(value ? Kind::String : Kind::Null), m_string(value ? value : "") {}
+
+  Statement_arg(const std::string &value)  // NOLINT
+      : m_kind(Kind::String), m_string(value) {}
+
+  Kind kind() const { return m_kind; }
+
+  int64_t as_int() const { return m_int; }
+
+  uint64_t as_uint() const { return m_uint; }
+
+  double as_double() const { return m_double; }
+
+  const std::string &as_string() const { return m_string; }
+
+ private:
+  Kind m_kind;
+  int64_t m_int = 0;
+  uint64_t m_uint = 0;
+  double m_double = 0.0;
+  std::string m_string;
+};
+
 class SHCORE_PUBLIC ISession {
  public:
   // Connection
@@ -129,6 +179,37 @@ class SHCORE_PUBLIC ISession {
     execute(shcore::sqlformat(sql, args...));
   }
 
+  /**
+   * Executes a statement with ? placeholders, values are sent separately from
+   * the SQL text.
+   *
+   * Sessions which support server-side prepared statements prepare the
+   * statement once and reuse it, the other ones substitute the placeholders
+   * on the client side.
+   *
+   * @param sql statement with ? placeholders, ! placeholders are not allowed
+   * @param args values for placeholders
+   * @param buffered whether result should be read right away
+   * @return query result
+   */
+  virtual std::shared_ptr<IResult> query_prepared(
+      const std::string &sql, const std::vector<Statement_arg> &args,
+      bool buffered = false) {
+    return query(format_statement(sql, args), buffered);
+  }
+
+  /**
+   * Convenience wrapper of query_prepared().
+   *
+   * @example
+   * auto result = session->queryp("SELECT * FROM tbl WHERE id = ?", my_id);
+   */
+  template <typename... Args>
+  inline std::shared_ptr<IResult> queryp(const std::string &sql,
+                                         const Args &... args) {
+    return query_prepared(sql, {Statement_arg(args)...});
+  }
+
   // Disconnection
   virtual void close() = 0;
 
@@ -156,6 +237,38 @@ class SHCORE_PUBLIC ISession {
     return m_ansi_quotes_enabled;
   }
 
+  static std::string format_statement(const std::string &sql,
+                                      const std::vector<Statement_arg> &args) {
+    shcore::sqlstring statement(sql.c_str(), 0);
+
+    for (const auto &arg : args) {
+      switch (arg.kind()) {
+        case Statement_arg::Kind::Null:
+          statement << static_cast<const char *>(nullptr);
+          break;
+
+        case Statement_arg::Kind::Integer:
+          statement << arg.as_int();
+          break;
+
+        case Statement_arg::Kind::UInteger:
+          statement << arg.as_uint();
+          break;
+
+        case Statement_arg::Kind::Double:
+          statement << arg.as_double();
+          break;
+
+        case Statement_arg::Kind::String:
+          statement << arg.as_string();
+          break;
+      }
+    }
+
+    statement.done();
+    return statement.str();
+  }
+
   void refresh_sql_mode() {
     assert(is_open());
     try {
@@ -60,6 +60,12 @@ Instance::Instance(std::shared_ptr<db::ISession> session) : _session(session) {}
 void Instance::refresh() {
   m_uuid.clear();
   m_group_name.clear();
+  m_sysvar_snapshots.clear();
+}
+
+void Instance::set_sysvar_snapshot(bool enabled) {
+  m_sysvar_snapshot = enabled;
+  m_sysvar_snapshots.clear();
 }
 
 std::string Instance::descr() const {
@@ -285,6 +291,28 @@ Instance::get_system_variables(const std::vector<std::string> &names,
                                const Var_qualifier scope) const {
   std::map<std::string, utils::nullable<std::string>> ret_val;
 
+  if (m_sysvar_snapshot && !names.empty() &&
+      (scope == Var_qualifier::GLOBAL || scope == Var_qualifier::SESSION)) {
+    auto snapshot = m_sysvar_snapshots.find(scope);
+
+    if (snapshot == m_sysvar_snapshots.end()) {
+      snapshot =
+          m_sysvar_snapshots.emplace(scope, get_system_variables({}, scope))
+              .first;
+    } else {
+      ++m_sysvar_queries_saved;
+    }
+
+    for (const auto &name : names) {
+      const auto value = snapshot->second.find(name);
+      ret_val[name] = value == snapshot->second.end()
+                          ? utils::nullable<std::string>()
+                          : value->second;
+    }
+
+    return ret_val;
+  }
+
   std::shared_ptr<db::IResult> result;
   if (!names.empty()) {
     std::string query_format;
@@ -771,6 +799,9 @@ std::shared_ptr<mysqlshdk::db::IResult> Instance::query(const std::string &sql,
 }
 
 void Instance::execute(const std::string &sql) const {
+  // statement may change the value of any variable
+  m_sysvar_snapshots.clear();
+
   try {
     get_session()->execute(sql);
   } catch (const mysqlshdk::db::Error &e) {
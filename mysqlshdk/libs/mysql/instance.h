@@ -314,6 +314,27 @@ class Instance : public IInstance {
 
   void suppress_binary_log(bool flag) override;
 
+  /**
+   * Enables or disables the system variable snapshot.
+   *
+   * While enabled, the first read of a GLOBAL or SESSION variable fetches all
+   * the variables with that scope using a single query, subsequent reads are
+   * served from the snapshot. Snapshot is discarded by refresh() and whenever
+   * a statement is executed using execute() (i.e. by set_sysvar()).
+   *
+   * Meant for operations which check many variables, changes made using
+   * other Instance objects or sessions are not visible while it's enabled.
+   */
+  void set_sysvar_snapshot(bool enabled);
+
+  bool is_sysvar_snapshot_enabled() const { return m_sysvar_snapshot; }
+
+  /**
+   * Number of queries which were not executed because the values were read
+   * from the system variable snapshot.
+   */
+  uint64_t get_sysvar_queries_saved() const { return m_sysvar_queries_saved; }
+
  public:
   std::shared_ptr<mysqlshdk::db::IResult> query(
       const std::string &sql, bool buffered = false) const override;
@@ -329,6 +350,11 @@ class Instance : public IInstance {
   mutable std::string m_hostname;
   mutable int m_port = 0;
   int m_sql_binlog_suppress_count = 0;
+  bool m_sysvar_snapshot = false;
+  mutable std::map<Var_qualifier,
+                   std::map<std::string, utils::nullable<std::string>>>
+      m_sysvar_snapshots;
+  mutable uint64_t m_sysvar_queries_saved = 0;
 
   const std::string &get_version_compile_os() const;
   std::string get_plugin_library_extension() const;
@@ -26,6 +26,7 @@
 
 #include "mysqlshdk/include/scripting/types.h"
 
+#include <cstddef>
 #include <string>
 
 #include "mysqlshdk/libs/rest/headers.h"
@@ -112,6 +113,62 @@ struct Response {
   shcore::Value body;
 };
 
+/**
+ * Caller-provided storage for the body of a response. If a request is executed
+ * with a buffer, body is written directly to it as it is being received and
+ * Response::body is left undefined.
+ */
+class Base_response_buffer {
+ public:
+  Base_response_buffer() = default;
+
+  Base_response_buffer(const Base_response_buffer &) = delete;
+  Base_response_buffer(Base_response_buffer &&) = delete;
+
+  Base_response_buffer &operator=(const Base_response_buffer &) = delete;
+  Base_response_buffer &operator=(Base_response_buffer &&) = delete;
+
+  virtual ~Base_response_buffer() = default;
+
+  /**
+   * Appends the next part of the body.
+   *
+   * @param data Received data.
+   * @param size Number of bytes received.
+   *
+   * @returns false if data cannot be stored, request is aborted in such case.
+   */
+  virtual bool append_data(const char *data, size_t size) = 0;
+};
+
+/**
+ * Stores the body of a response in an existing string.
+ */
+class String_buffer : public Base_response_buffer {
+ public:
+  /**
+   * Creates the buffer.
+   *
+   * @param target String which receives the body, it is cleared and must
+   *        outlive the request.
+   * @param expected_size If known, number of bytes which are going to be
+   *        received, memory is reserved upfront.
+   */
+  explicit String_buffer(std::string *target, size_t expected_size = 0)
+      : m_target(target) {
+    m_target->clear();
+    m_target->reserve(expected_size);
+  }
+
+  bool append_data(const char *data, size_t size) override {
+    m_target->append(data, size);
+    return true;
+  }
+
+ private:
+  std::string *m_target;
+};
+
 }  // namespace rest
 }  // namespace mysqlshdk
 
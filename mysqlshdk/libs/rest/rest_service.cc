@@ -24,7 +24,13 @@
 #include "mysqlshdk/libs/rest/rest_service.h"
 
 #include <curl/curl.h>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
@@ -60,6 +66,19 @@ size_t response_callback(char *ptr, size_t size, size_t nmemb, void *userdata) {
   return bytes;
 }
 
+size_t buffer_callback(char *ptr, size_t size, size_t nmemb, void *userdata) {
+  const auto buffer = static_cast<Base_response_buffer *>(userdata);
+  const auto bytes = size * nmemb;
+
+  // returning a different number of bytes aborts the transfer
+  return buffer->append_data(ptr, bytes) ? bytes : 0;
+}
+
+std::string error_message(const char *error_buffer, CURLcode code) {
+  // error buffer is not always filled in
+  return '\0' == error_buffer[0] ? curl_easy_strerror(code) : error_buffer;
+}
+
 Headers parse_headers(const std::string &s) {
   Headers headers;
 
@@ -123,85 +142,72 @@ class Rest_service::Impl {
   enum class Type { GET, HEAD, POST, PUT, PATCH, DELETE };
 
   Impl(const std::string &base_url, bool verify)
-      : m_handle(curl_easy_init(), &curl_easy_cleanup), m_base_url{base_url} {
-    // Disable signal handlers used by libcurl, we're potentially going to use
-    // timeouts and background threads.
-    curl_easy_setopt(m_handle.get(), CURLOPT_NOSIGNAL, 1L);
-    // we're going to automatically follow redirections
-    curl_easy_setopt(m_handle.get(), CURLOPT_FOLLOWLOCATION, 1L);
-    // most modern browsers allow for more or less 20 redirections
-    curl_easy_setopt(m_handle.get(), CURLOPT_MAXREDIRS, 20L);
-    // introduce ourselves to the server
-    curl_easy_setopt(m_handle.get(), CURLOPT_USERAGENT,
-                     get_user_agent().c_str());
-
-#if LIBCURL_VERSION_NUM >= 0x071900
-    // CURLOPT_TCP_KEEPALIVE was added in libcurl 7.25.0
-    curl_easy_setopt(m_handle.get(), CURLOPT_TCP_KEEPALIVE, 1L);
-#endif
-
-    // error buffer, once set, must be available until curl_easy_cleanup() is
-    // called
-    curl_easy_setopt(m_handle.get(), CURLOPT_ERRORBUFFER, m_error_buffer);
-
-    verify_ssl(verify);
-    // set timeout to 2 seconds
-    set_timeout(2000);
-
-    // set the callbacks
-    curl_easy_setopt(m_handle.get(), CURLOPT_READDATA, nullptr);
-    curl_easy_setopt(m_handle.get(), CURLOPT_READFUNCTION, request_callback);
-    curl_easy_setopt(m_handle.get(), CURLOPT_WRITEFUNCTION, response_callback);
-
-#ifdef _WIN32
-    curl_easy_setopt(m_handle.get(), CURLOPT_CAINFO, nullptr);
-    curl_easy_setopt(m_handle.get(), CURLOPT_CAPATH, nullptr);
-    curl_easy_setopt(m_handle.get(), CURLOPT_SSL_CTX_FUNCTION,
-                     *sslctx_function);
-#endif  // _WIN32
+      : m_handle(curl_easy_init(), &curl_easy_cleanup),
+        m_base_url{base_url},
+        m_verify_ssl(verify) {
+    m_error_buffer[0] = '\0';
+    configure(m_handle.get(), m_error_buffer);
   }
 
   ~Impl() = default;
 
   Response execute(Type type, const std::string &path,
-                   const shcore::Value &body, const Headers &headers) {
-    set_url(path);
-    // body needs to be set before the type, because it implicitly sets type to
-    // POST
-    set_body(body);
-    set_type(type);
+                   const shcore::Value &body, const Headers &headers,
+                   Base_response_buffer *buffer = nullptr) {
+    if (m_pool) {
+      return execute_async(type, path, body, headers, buffer).get();
+    }
+
     const auto headers_deleter =
-        set_headers(headers, body.type != shcore::Value_type::Undefined);
+        prepare(m_handle.get(), type, path, body, headers);
 
     // set callbacks which will receive the response
     std::string response_headers;
     std::string response_body;
 
     curl_easy_setopt(m_handle.get(), CURLOPT_HEADERDATA, &response_headers);
-    curl_easy_setopt(m_handle.get(), CURLOPT_WRITEDATA, &response_body);
+    set_response_body(m_handle.get(), &response_body, buffer);
 
     // execute the request
-    if (curl_easy_perform(m_handle.get()) != CURLE_OK) {
-      throw Connection_error{m_error_buffer};
+    const auto result = curl_easy_perform(m_handle.get());
+
+    if (CURLE_OK != result) {
+      throw Connection_error{error_message(m_error_buffer, result)};
     }
 
-    return get_raw_response(response_headers, std::move(response_body));
+    return get_raw_response(m_handle.get(), response_headers,
+                            std::move(response_body), nullptr == buffer);
   }
 
   std::future<Response> execute_async(Type type, const std::string &path,
                                       const shcore::Value &body,
-                                      const Headers &headers) {
-    return std::async(std::launch::async, [this, type, path, body, headers]() {
-      return execute(type, path, body, headers);
-    });
+                                      const Headers &headers,
+                                      Base_response_buffer *buffer = nullptr) {
+    if (m_pool) {
+      auto transfer = shcore::make_unique<Transfer>();
+      const auto handle = transfer->handle.get();
+
+      configure(handle, transfer->error_buffer);
+      transfer->headers = prepare(handle, type, path, body, headers);
+      transfer->buffer = buffer;
+      curl_easy_setopt(handle, CURLOPT_HEADERDATA,
+                       &transfer->response_headers);
+      set_response_body(handle, &transfer->response_body, buffer);
+
+      return m_pool->submit(std::move(transfer));
+    }
+
+    return std::async(std::launch::async,
+                      [this, type, path, body, headers, buffer]() {
+                        return execute(type, path, body, headers, buffer);
+                      });
   }
 
   void set(const Basic_authentication &basic) {
-    curl_easy_setopt(m_handle.get(), CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-    curl_easy_setopt(m_handle.get(), CURLOPT_USERNAME,
-                     basic.username().c_str());
-    curl_easy_setopt(m_handle.get(), CURLOPT_PASSWORD,
-                     basic.password().c_str());
+    m_username = basic.username();
+    m_password = basic.password();
+    m_has_basic_authentication = true;
+    set_basic_authentication(m_handle.get());
   }
 
   void set_default_headers(const Headers &headers) {
@@ -209,76 +215,330 @@ class Rest_service::Impl {
   }
 
   void set_timeout(uint32_t timeout) {
-    curl_easy_setopt(m_handle.get(), CURLOPT_TIMEOUT_MS,
-                     static_cast<long>(timeout));
+    m_timeout = timeout;
+    apply_timeout(m_handle.get());
+  }
+
+  void set_connection_pool(size_t max_connections) {
+    assert(max_connections > 0);
+    m_pool = shcore::make_unique<Transfer_loop>(max_connections);
   }
 
  private:
-  void verify_ssl(bool verify) {
-    curl_easy_setopt(m_handle.get(), CURLOPT_SSL_VERIFYHOST, verify ? 2L : 0L);
-    curl_easy_setopt(m_handle.get(), CURLOPT_SSL_VERIFYPEER, verify ? 1L : 0L);
+  /**
+   * A request executed by the transfer loop.
+   */
+  struct Transfer {
+    Transfer()
+        : handle(curl_easy_init(), &curl_easy_cleanup),
+          headers(nullptr, &curl_slist_free_all) {
+      error_buffer[0] = '\0';
+    }
+
+    std::unique_ptr<CURL, void (*)(CURL *)> handle;
+    std::unique_ptr<curl_slist, void (*)(curl_slist *)> headers;
+    char error_buffer[CURL_ERROR_SIZE];
+    std::string response_headers;
+    std::string response_body;
+    Base_response_buffer *buffer = nullptr;
+    std::promise<Response> promise;
+  };
+
+  /**
+   * Executes the transfers concurrently using the CURL multi interface, in a
+   * background thread. Multi handle holds the connection cache, so connections
+   * are reused between the transfers.
+   */
+  class Transfer_loop {
+   public:
+    explicit Transfer_loop(size_t max_connections)
+        : m_multi(curl_multi_init(), &curl_multi_cleanup) {
+      const auto connections = static_cast<long>(max_connections);
+
+#if LIBCURL_VERSION_NUM >= 0x071e00
+      // CURLMOPT_MAX_HOST_CONNECTIONS was added in libcurl 7.30.0, transfers
+      // over the limit are queued by CURL
+      curl_multi_setopt(m_multi.get(), CURLMOPT_MAX_HOST_CONNECTIONS,
+                        connections);
+      curl_multi_setopt(m_multi.get(), CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                        connections);
+#endif
+
+      // number of idle connections which are kept alive
+      curl_multi_setopt(m_multi.get(), CURLMOPT_MAXCONNECTS, connections);
+
+      m_thread = std::thread(&Transfer_loop::run, this);
+    }
+
+    Transfer_loop(const Transfer_loop &) = delete;
+    Transfer_loop(Transfer_loop &&) = delete;
+
+    Transfer_loop &operator=(const Transfer_loop &) = delete;
+    Transfer_loop &operator=(Transfer_loop &&) = delete;
+
+    ~Transfer_loop() {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+
+      wake_up();
+      m_thread.join();
+    }
+
+    std::future<Response> submit(std::unique_ptr<Transfer> transfer) {
+      auto result = transfer->promise.get_future();
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.emplace_back(std::move(transfer));
+      }
+
+      wake_up();
+
+      return result;
+    }
+
+   private:
+    void run() {
+      std::unordered_map<CURL *, std::unique_ptr<Transfer>> active;
+
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(m_mutex);
+
+          if (active.empty()) {
+            // nothing to do, sleep until new transfer arrives
+            m_condition.wait(
+                lock, [this]() { return m_stop || !m_pending.empty(); });
+          }
+
+          if (m_stop) {
+            for (auto &transfer : m_pending) {
+              active.emplace(transfer->handle.get(), std::move(transfer));
+            }
+
+            m_pending.clear();
+            break;
+          }
+
+          for (auto &transfer : m_pending) {
+            const auto handle = transfer->handle.get();
+            curl_multi_add_handle(m_multi.get(), handle);
+            active.emplace(handle, std::move(transfer));
+          }
+
+          m_pending.clear();
+        }
+
+        int running = 0;
+        curl_multi_perform(m_multi.get(), &running);
+
+        int queued = 0;
+        CURLMsg *msg = nullptr;
+
+        while ((msg = curl_multi_info_read(m_multi.get(), &queued))) {
+          if (CURLMSG_DONE == msg->msg) {
+            const auto it = active.find(msg->easy_handle);
+
+            curl_multi_remove_handle(m_multi.get(), msg->easy_handle);
+            finish(it->second.get(), msg->data.result);
+            active.erase(it);
+          }
+        }
+
+        if (!active.empty()) {
+          wait();
+        }
+      }
+
+      // loop is being stopped, cancel all outstanding transfers
+      for (const auto &transfer : active) {
+        curl_multi_remove_handle(m_multi.get(), transfer.first);
+        transfer.second->promise.set_exception(
+            std::make_exception_ptr(Connection_error{"Request was cancelled"}));
+      }
+    }
+
+    void finish(Transfer *transfer, CURLcode result) {
+      if (CURLE_OK == result) {
+        transfer->promise.set_value(get_raw_response(
+            transfer->handle.get(), transfer->response_headers,
+            std::move(transfer->response_body), nullptr == transfer->buffer));
+      } else {
+        transfer->promise.set_exception(std::make_exception_ptr(
+            Connection_error{error_message(transfer->error_buffer, result)}));
+      }
+    }
+
+    void wait() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+      // curl_multi_poll() was added in libcurl 7.68.0, it can be interrupted
+      // by curl_multi_wakeup()
+      curl_multi_poll(m_multi.get(), nullptr, 0, 1000, nullptr);
+#else
+      // new transfers are picked up with a slight delay
+      curl_multi_wait(m_multi.get(), nullptr, 0, 10, nullptr);
+#endif
+    }
+
+    void wake_up() {
+      m_condition.notify_one();
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+      curl_multi_wakeup(m_multi.get());
+#endif
+    }
+
+    std::unique_ptr<CURLM, CURLMcode (*)(CURLM *)> m_multi;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_condition;
+
+    std::vector<std::unique_ptr<Transfer>> m_pending;
+
+    bool m_stop = false;
+
+    std::thread m_thread;
+  };
+
+  void configure(CURL *handle, char *error_buffer) const {
+    // Disable signal handlers used by libcurl, we're potentially going to use
+    // timeouts and background threads.
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    // we're going to automatically follow redirections
+    curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+    // most modern browsers allow for more or less 20 redirections
+    curl_easy_setopt(handle, CURLOPT_MAXREDIRS, 20L);
+    // introduce ourselves to the server
+    curl_easy_setopt(handle, CURLOPT_USERAGENT, get_user_agent().c_str());
+
+#if LIBCURL_VERSION_NUM >= 0x071900
+    // CURLOPT_TCP_KEEPALIVE was added in libcurl 7.25.0
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+#endif
+
+    // error buffer, once set, must be available until curl_easy_cleanup() is
+    // called
+    curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, error_buffer);
+
+    verify_ssl(handle);
+    apply_timeout(handle);
+
+    if (m_has_basic_authentication) {
+      set_basic_authentication(handle);
+    }
+
+    // set the callbacks
+    curl_easy_setopt(handle, CURLOPT_READDATA, nullptr);
+    curl_easy_setopt(handle, CURLOPT_READFUNCTION, request_callback);
+    // headers are always stored in a string, body can go to a custom buffer
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, response_callback);
+
+#ifdef _WIN32
+    curl_easy_setopt(handle, CURLOPT_CAINFO, nullptr);
+    curl_easy_setopt(handle, CURLOPT_CAPATH, nullptr);
+    curl_easy_setopt(handle, CURLOPT_SSL_CTX_FUNCTION, *sslctx_function);
+#endif  // _WIN32
+  }
+
+  std::unique_ptr<curl_slist, void (*)(curl_slist *)> prepare(
+      CURL *handle, Type type, const std::string &path,
+      const shcore::Value &body, const Headers &headers) const {
+    set_url(handle, path);
+    // body needs to be set before the type, because it implicitly sets type to
+    // POST
+    set_body(handle, body);
+    set_type(handle, type);
+    return set_headers(handle, headers,
+                       body.type != shcore::Value_type::Undefined);
+  }
+
+  void verify_ssl(CURL *handle) const {
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, m_verify_ssl ? 2L : 0L);
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, m_verify_ssl ? 1L : 0L);
+  }
+
+  void apply_timeout(CURL *handle) const {
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, static_cast<long>(m_timeout));
+  }
+
+  void set_basic_authentication(CURL *handle) const {
+    curl_easy_setopt(handle, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
+    curl_easy_setopt(handle, CURLOPT_USERNAME, m_username.c_str());
+    curl_easy_setopt(handle, CURLOPT_PASSWORD, m_password.c_str());
+  }
+
+  static void set_response_body(CURL *handle, std::string *body,
+                                Base_response_buffer *buffer) {
+    if (buffer) {
+      curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, buffer_callback);
+      curl_easy_setopt(handle, CURLOPT_WRITEDATA, buffer);
+    } else {
+      curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, response_callback);
+      curl_easy_setopt(handle, CURLOPT_WRITEDATA, body);
+    }
   }
 
-  void set_type(Type type) {
+  static void set_type(CURL *handle, Type type) {
     // custom request overwrites any other option, make sure it's set to default
-    curl_easy_setopt(m_handle.get(), CURLOPT_CUSTOMREQUEST, nullptr);
+    curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, nullptr);
 
     switch (type) {
       case Type::GET:
-        curl_easy_setopt(m_handle.get(), CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
         break;
 
       case Type::HEAD:
-        curl_easy_setopt(m_handle.get(), CURLOPT_HTTPGET, 1L);
-        curl_easy_setopt(m_handle.get(), CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(handle, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
         break;
 
       case Type::POST:
-        curl_easy_setopt(m_handle.get(), CURLOPT_NOBODY, 0L);
-        curl_easy_setopt(m_handle.get(), CURLOPT_POST, 1L);
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+        curl_easy_setopt(handle, CURLOPT_POST, 1L);
         break;
 
       case Type::PUT:
-        curl_easy_setopt(m_handle.get(), CURLOPT_NOBODY, 0L);
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
         // We could use CURLOPT_UPLOAD here, but that would mean we have to
         // provide request data using CURLOPT_READDATA. Using custom request
         // allows to always use CURLOPT_COPYPOSTFIELDS.
-        curl_easy_setopt(m_handle.get(), CURLOPT_CUSTOMREQUEST, "PUT");
+        curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "PUT");
         break;
 
       case Type::PATCH:
-        curl_easy_setopt(m_handle.get(), CURLOPT_NOBODY, 0L);
-        curl_easy_setopt(m_handle.get(), CURLOPT_CUSTOMREQUEST, "PATCH");
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+        curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "PATCH");
         break;
 
       case Type::DELETE:
-        curl_easy_setopt(m_handle.get(), CURLOPT_NOBODY, 0L);
-        curl_easy_setopt(m_handle.get(), CURLOPT_CUSTOMREQUEST, "DELETE");
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+        curl_easy_setopt(handle, CURLOPT_CUSTOMREQUEST, "DELETE");
         break;
     }
   }
 
-  void set_url(const std::string &path) {
-    curl_easy_setopt(m_handle.get(), CURLOPT_URL, (m_base_url + path).c_str());
+  void set_url(CURL *handle, const std::string &path) const {
+    curl_easy_setopt(handle, CURLOPT_URL, (m_base_url + path).c_str());
   }
 
-  void set_body(const shcore::Value &body) {
+  static void set_body(CURL *handle, const shcore::Value &body) {
     if (body.type != shcore::Value_type::Undefined) {
       // set the body
       const auto request_body = body.repr();
-      curl_easy_setopt(m_handle.get(), CURLOPT_POSTFIELDSIZE,
-                       request_body.length());
-      curl_easy_setopt(m_handle.get(), CURLOPT_COPYPOSTFIELDS,
-                       request_body.c_str());
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, request_body.length());
+      curl_easy_setopt(handle, CURLOPT_COPYPOSTFIELDS, request_body.c_str());
     } else {
       // no body, remove post data (if present)
-      curl_easy_setopt(m_handle.get(), CURLOPT_POSTFIELDSIZE, -1L);
-      curl_easy_setopt(m_handle.get(), CURLOPT_COPYPOSTFIELDS, nullptr);
+      curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE, -1L);
+      curl_easy_setopt(handle, CURLOPT_COPYPOSTFIELDS, nullptr);
     }
   }
 
   std::unique_ptr<curl_slist, void (*)(curl_slist *)> set_headers(
-      const Headers &headers, bool has_body) {
+      CURL *handle, const Headers &headers, bool has_body) const {
     // create the headers list
     curl_slist *header_list = nullptr;
 
@@ -311,24 +571,28 @@ class Rest_service::Impl {
     }
 
     // set the headers
-    curl_easy_setopt(m_handle.get(), CURLOPT_HTTPHEADER, header_list);
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, header_list);
     // automatically delete the headers when leaving the scope
     return std::unique_ptr<curl_slist, void (*)(curl_slist *)>{
         header_list, &curl_slist_free_all};
   }
 
-  Response get_raw_response(const std::string &headers, std::string &&body) {
+  static Response get_raw_response(CURL *handle, const std::string &headers,
+                                   std::string &&body, bool store_body) {
     // fill in the response object
     Response response;
 
     {
       long response_code = 0;
-      curl_easy_getinfo(m_handle.get(), CURLINFO_RESPONSE_CODE, &response_code);
+      curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
       response.status = static_cast<Response::Status_code>(response_code);
     }
 
     response.headers = parse_headers(headers);
-    response.body = shcore::Value(std::move(body));
+
+    if (store_body) {
+      response.body = shcore::Value(std::move(body));
+    }
 
     return response;
   }
@@ -340,6 +604,19 @@ class Rest_service::Impl {
   std::string m_base_url;
 
   Headers m_default_headers;
+
+  bool m_verify_ssl;
+
+  // set timeout to 2 seconds
+  uint32_t m_timeout = 2000;
+
+  bool m_has_basic_authentication = false;
+
+  std::string m_username;
+
+  std::string m_password;
+
+  std::unique_ptr<Transfer_loop> m_pool;
 };
 
 Rest_service::Rest_service(const std::string &base_url, bool verify_ssl)
@@ -366,10 +643,20 @@ Rest_service &Rest_service::set_timeout(uint32_t timeout) {
   return *this;
 }
 
+Rest_service &Rest_service::set_connection_pool(size_t max_connections) {
+  m_impl->set_connection_pool(max_connections);
+  return *this;
+}
+
 Response Rest_service::get(const std::string &path, const Headers &headers) {
   return m_impl->execute(Impl::Type::GET, path, {}, headers);
 }
 
+Response Rest_service::get(const std::string &path, const Headers &headers,
+                           Base_response_buffer *buffer) {
+  return m_impl->execute(Impl::Type::GET, path, {}, headers, buffer);
+}
+
 Response Rest_service::head(const std::string &path, const Headers &headers) {
   return m_impl->execute(Impl::Type::HEAD, path, {}, headers);
 }
@@ -400,6 +687,12 @@ std::future<Response> Rest_service::async_get(const std::string &path,
   return m_impl->execute_async(Impl::Type::GET, path, {}, headers);
 }
 
+std::future<Response> Rest_service::async_get(const std::string &path,
+                                              const Headers &headers,
+                                              Base_response_buffer *buffer) {
+  return m_impl->execute_async(Impl::Type::GET, path, {}, headers, buffer);
+}
+
 std::future<Response> Rest_service::async_head(const std::string &path,
                                                const Headers &headers) {
   return m_impl->execute_async(Impl::Type::HEAD, path, {}, headers);
@@ -42,6 +42,11 @@ namespace rest {
  * A REST service. By default, requests will follow redirections and
  * keep the connections alive.
  *
+ * By default, all requests are executed using a single connection, and
+ * asynchronous requests must not overlap. Once the connection pool is enabled
+ * (see set_connection_pool()), requests are instead executed concurrently by
+ * a background event loop, and can be issued from multiple threads.
+ *
  * This is a move-only type.
  */
 class Rest_service {
@@ -92,6 +97,22 @@ class Rest_service {
    */
   Rest_service &set_timeout(uint32_t timeout);
 
+  /**
+   * Enables the connection pool: all subsequent requests are handed over to a
+   * background event loop which executes them concurrently, using at most the
+   * given number of connections to the host. Connections are kept alive and
+   * reused by the following requests. Requests which exceed the limit are
+   * queued until a connection becomes available.
+   *
+   * Settings (authentication, headers, timeout) should be set before the
+   * pool is enabled.
+   *
+   * @param max_connections Maximum number of connections, must be positive.
+   *
+   * @returns Reference to self.
+   */
+  Rest_service &set_connection_pool(size_t max_connections);
+
   /**
    * Executes a GET request, blocks until response is available.
    *
@@ -107,6 +128,22 @@ class Rest_service {
    */
   Response get(const std::string &path, const Headers &headers = {});
 
+  /**
+   * Executes a GET request, blocks until response is available. Body of the
+   * response is written to the given buffer.
+   *
+   * @param path Path to the request, it is going to be appended to the base
+   *        URL.
+   * @param headers Request-specific headers.
+   * @param buffer Receives the body of the response.
+   *
+   * @returns Received response, its body is undefined.
+   *
+   * @throws Connection_error In case of any connection-related problems.
+   */
+  Response get(const std::string &path, const Headers &headers,
+               Base_response_buffer *buffer);
+
   /**
    * Executes a HEAD request, blocks until response is available.
    *
@@ -217,6 +254,25 @@ class Rest_service {
   std::future<Response> async_get(const std::string &path,
                                   const Headers &headers = {});
 
+  /**
+   * Asynchronously executes a GET request. Body of the response is written to
+   * the given buffer, which must not be accessed until response is received.
+   *
+   * @param path Path to the request, it is going to be appended to the base
+   *        URL.
+   * @param headers Request-specific headers.
+   * @param buffer Receives the body of the response.
+   *
+   * @returns Received response, its body is undefined.
+   *
+   * @throws Connection_error In case of any connection-related problems. This
+   *         method does not throw on its own, exception could be thrown from
+   *         future object.
+   */
+  std::future<Response> async_get(const std::string &path,
+                                  const Headers &headers,
+                                  Base_response_buffer *buffer);
+
   /**
    * Asynchronously executes a HEAD request. This object must not be modified
    * nor any other request can be executed again until response is received.
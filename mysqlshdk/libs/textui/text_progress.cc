@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -92,8 +92,18 @@ void Text_progress::clear_status() {
 void Text_progress::shutdown() { write(fileno(stderr), "\n", 1); }
 
 void Text_progress::render_status() {
-  // 100% (1024.00 MB / 1024.00 MB), 1024.00 MB/s
   m_status.clear();
+
+  if (!m_items.empty()) {
+    // 100% (1024 / 1024 tables), 16 tables/s
+    m_status += "\r" + std::to_string(percent()) + "% (" +
+                std::to_string(m_current) + " / " + std::to_string(m_total) +
+                " " + m_items + "), " + std::to_string(m_throughput.rate()) +
+                " " + m_items + "/s";
+    return;
+  }
+
+  // 100% (1024.00 MB / 1024.00 MB), 1024.00 MB/s
   m_status +=
       "\r" + std::to_string(percent()) + "% (" +
       mysqlshdk::utils::format_bytes(m_current) + " / " +
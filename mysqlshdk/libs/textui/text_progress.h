@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -112,6 +112,14 @@ class Text_progress final : public IProgress {
  public:
   Text_progress() : m_status(80, ' ') {}
 
+  /**
+   * Progress of work measured in items rather than bytes.
+   *
+   * @param items Name of the items displayed next to the values, i.e. "tables".
+   */
+  explicit Text_progress(const std::string &items)
+      : m_items(items), m_status(80, ' ') {}
+
   Text_progress(const Text_progress &other) = default;
   Text_progress(Text_progress &&other) = default;
 
@@ -160,6 +168,7 @@ class Text_progress final : public IProgress {
   unsigned long long m_total = 0;
   bool m_changed = true;
   Throughput m_throughput;
+  std::string m_items;                  //< Items name, empty if bytes
   unsigned int m_last_status_size = 0;  //< Last displayed status length
   std::string m_status;
   std::chrono::steady_clock::time_point
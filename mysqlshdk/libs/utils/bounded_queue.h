@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_UTILS_BOUNDED_QUEUE_H_
+#define MYSQLSHDK_LIBS_UTILS_BOUNDED_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace shcore {
+
+/**
+ * Multiple producer, multiple consumer FIFO queue with a fixed capacity.
+ *
+ * Elements are stored in a lock-free ring buffer, each slot holds a sequence
+ * number which tells producers and consumers whether it can be written or
+ * read. Positions of producers and consumers are kept in separate cache lines.
+ *
+ * push() blocks while the queue is full, which throttles producers which are
+ * faster than consumers. pop() blocks while the queue is empty. Both spin for
+ * a short while before falling back to a condition variable, the mutex is
+ * used only by threads which are about to sleep and by threads which wake
+ * them up.
+ *
+ * Can be used in place of Synchronized_queue, as long as a bounded capacity
+ * cannot lead to a deadlock (i.e. consumers run concurrently with producers).
+ */
+template <class T>
+class Bounded_queue final {
+ public:
+  /**
+   * Creates the queue.
+   *
+   * @param capacity maximum number of elements, rounded up to a power of two.
+   */
+  explicit Bounded_queue(size_t capacity) {
+    size_t size = 2;
+
+    while (size < capacity) {
+      size <<= 1;
+    }
+
+    m_mask = size - 1;
+    m_cells.reset(new Cell[size]);
+
+    for (size_t i = 0; i < size; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_head.position.store(0, std::memory_order_relaxed);
+    m_tail.position.store(0, std::memory_order_relaxed);
+  }
+
+  Bounded_queue(const Bounded_queue &other) = delete;
+  Bounded_queue(Bounded_queue &&other) = delete;
+
+  Bounded_queue &operator=(const Bounded_queue &other) = delete;
+  Bounded_queue &operator=(Bounded_queue &&other) = delete;
+
+  ~Bounded_queue() = default;
+
+  size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * Adds an element to the queue, waits while the queue is full.
+   */
+  void push(const T &r) {
+    T copy = r;
+    push(std::move(copy));
+  }
+
+  void push(T &&r) {
+    if (!spin([this, &r]() { return try_push(std::move(r)); })) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      ++m_push_waiters;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_not_full.wait(lock, [this, &r]() { return try_push(std::move(r)); });
+      --m_push_waiters;
+    }
+
+    notify(m_pop_waiters, &m_not_empty);
+  }
+
+  /**
+   * Adds an element to the queue if it is not full.
+   *
+   * @returns false if queue is full, r is not modified.
+   */
+  bool try_push(T &&r) {
+    auto pos = m_head.position.load(std::memory_order_relaxed);
+
+    while (true) {
+      auto &cell = m_cells[pos & m_mask];
+      const auto seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+      if (0 == diff) {
+        if (m_head.position.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed)) {
+          cell.data = std::move(r);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // slot still holds an element from the previous lap
+        return false;
+      } else {
+        pos = m_head.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Removes the oldest element from the queue, waits while the queue is
+   * empty. Once the queue is drained after shutdown(), returns default
+   * constructed guard objects.
+   */
+  T pop() {
+    T r;
+
+    if (!spin([this, &r]() { return try_pop_or_guard(&r); })) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      ++m_pop_waiters;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_not_empty.wait(lock, [this, &r]() { return try_pop_or_guard(&r); });
+      --m_pop_waiters;
+    }
+
+    notify(m_push_waiters, &m_not_full);
+
+    return r;
+  }
+
+  /**
+   * Removes the oldest element from the queue if it is not empty. Guard
+   * objects are not returned by this method.
+   *
+   * @returns false if queue is empty.
+   */
+  bool try_pop(T *r) {
+    auto pos = m_tail.position.load(std::memory_order_relaxed);
+
+    while (true) {
+      auto &cell = m_cells[pos & m_mask];
+      const auto seq = cell.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+      if (0 == diff) {
+        if (m_tail.position.compare_exchange_weak(pos, pos + 1,
+                                                  std::memory_order_relaxed)) {
+          *r = std::move(cell.data);
+          // release resources held by the element
+          cell.data = T();
+          cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // slot was not written yet
+        return false;
+      } else {
+        pos = m_tail.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Signals to consumer threads to complete operation: once all elements are
+   * consumed, n calls to pop() return guard objects (T()). Guards do not
+   * occupy space in the queue, this method never blocks. Elements must not be
+   * pushed after this call.
+   *
+   * @param n number of consumer threads.
+   */
+  void shutdown(int64_t n) {
+    m_guards.fetch_add(n);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+
+    m_not_empty.notify_all();
+  }
+
+ private:
+  static constexpr size_t k_cache_line = 64;
+
+  static constexpr int k_spin_count = 128;
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  template <typename F>
+  static bool spin(F f) {
+    for (int i = 0; i < k_spin_count; ++i) {
+      if (f()) {
+        return true;
+      }
+
+      if (i >= k_spin_count / 2) {
+        std::this_thread::yield();
+      }
+    }
+
+    return false;
+  }
+
+  bool try_pop_or_guard(T *r) {
+    if (try_pop(r)) {
+      return true;
+    }
+
+    if (m_guards.load() > 0) {
+      // shutdown() was called after all elements were pushed, make sure that
+      // none of them is skipped
+      if (try_pop(r)) {
+        return true;
+      }
+
+      auto guards = m_guards.load();
+
+      while (guards > 0) {
+        if (m_guards.compare_exchange_weak(guards, guards - 1)) {
+          *r = T();
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void notify(const std::atomic<int> &waiters, std::condition_variable *cv) {
+    // pairs with the fence executed by the waiting thread before it checks
+    // the queue for the last time
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+      }
+
+      cv->notify_one();
+    }
+  }
+
+  std::unique_ptr<Cell[]> m_cells;
+  size_t m_mask;
+
+  // producers and consumers do not share cache lines
+  char m_padding[k_cache_line];
+
+  struct {
+    std::atomic<size_t> position;
+    char padding[k_cache_line];
+  } m_head;
+
+  struct {
+    std::atomic<size_t> position;
+    char padding[k_cache_line];
+  } m_tail;
+
+  std::atomic<int64_t> m_guards{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_not_empty;
+  std::condition_variable m_not_full;
+  std::atomic<int> m_push_waiters{0};
+  std::atomic<int> m_pop_waiters{0};
+};
+
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_LIBS_UTILS_BOUNDED_QUEUE_H_
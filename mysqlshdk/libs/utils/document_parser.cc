@@ -68,12 +68,11 @@ bool Document_reader_options::ignore_type(Bson_type type) const {
   return true;
 }
 
-std::string Json_reader::next() {
-  std::deque<char> context;
+void Json_reader::next(std::string *document) {
   m_source->skip_whitespaces();
 
   Json_document_parser parser(m_source, m_options);
-  return parser.parse();
+  parser.parse(document);
 }
 
 void Json_document_parser::throw_premature_end() {
@@ -659,6 +658,17 @@ void Json_document_parser::parse_bson_binary() {
                 "processing extended JSON for $binary");
 }
 
+template <typename Stop>
+void Json_document_parser::get_chars_until(std::string *target, Stop stop) {
+  if (target) {
+    m_source->get_until(stop, [target](const char *data, size_t length) {
+      target->append(data, length);
+    });
+  } else {
+    m_source->get_until(stop, [](const char *, size_t) {});
+  }
+}
+
 void Json_document_parser::get_char(std::string *target) {
   if (target)
     (*target) += m_source->get();
@@ -679,10 +689,15 @@ void Json_document_parser::get_string(std::string *target,
 
   get_char(target);
 
-  // Count holds the count of the characters read between the quotes
-  int count = 0;
   bool done = false;
   while (!m_source->eof() && !done) {
+    // characters which do not need special handling are copied in bulk
+    get_chars_until(target, [](unsigned char c) {
+      return c == '\\' || c == '"';
+    });
+
+    if (m_source->eof()) break;
+
     switch (m_source->peek()) {
       case '\\':
         get_char(target);
@@ -693,18 +708,14 @@ void Json_document_parser::get_string(std::string *target,
         get_char(target);
         done = true;
         break;
-
-      default:
-        get_char(target);
     }
-    if (!done) count++;
   }
 
   if (!done) throw_premature_end();
 }
 
 void Json_document_parser::get_whitespaces(std::string *target) {
-  while (!m_source->eof() && ::isspace(m_source->peek())) get_char(target);
+  get_chars_until(target, [](unsigned char c) { return !::isspace(c); });
 }
 
 void Json_document_parser::get_value(std::string *target) {
@@ -740,9 +751,10 @@ void Json_document_parser::get_value(std::string *target) {
       throw invalid_json("Unexpected ']'", m_source->offset());
       break;
     default: {
-      while (m_source->peek() != ',' &&
-             m_source->peek() != (m_as_array ? ']' : '}'))
-        get_char(target);
+      const char closing = m_as_array ? ']' : '}';
+      get_chars_until(target, [closing](unsigned char c) {
+        return c == ',' || c == closing;
+      });
     }
   }
 }
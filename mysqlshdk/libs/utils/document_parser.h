@@ -83,7 +83,18 @@ class Document_reader {
                   const shcore::Document_reader_options &options)
       : m_source(input), m_options(options){};
 
-  virtual std::string next() = 0;
+  /**
+   * Appends the next document to the given buffer. Reusing the buffer allows
+   * to read documents without allocating memory for each one of them.
+   */
+  virtual void next(std::string *document) = 0;
+
+  std::string next() {
+    std::string document;
+    next(&document);
+    return document;
+  }
+
   bool eof() { return m_source->eof(); }
 
  protected:
@@ -100,7 +111,9 @@ class Json_reader : public Document_reader {
   Json_reader(Buffered_input *input,
               const shcore::Document_reader_options &options)
       : Document_reader(input, options) {}
-  std::string next() override;
+
+  using Document_reader::next;
+  void next(std::string *document) override;
 };
 
 /**
@@ -153,6 +166,12 @@ class Json_document_parser : public Document_parser {
    */
   std::string parse() override;
 
+  /**
+   * Parses a single JSON document from the Buffered_input, appending it to
+   * the given document.
+   */
+  void parse(std::string *document);
+
   struct Bson_token {
     Bson_token(char atype, const std::string &astring = "",
                std::string *string_ptr = nullptr, double *number = nullptr,
@@ -178,9 +197,9 @@ class Json_document_parser : public Document_parser {
   size_t m_last_attribute_start = 0;
   size_t m_last_attribute_end = 0;
 
-  void parse(std::string *document);
-
   void get_char(std::string *target = nullptr);
+  template <typename Stop>
+  void get_chars_until(std::string *target, Stop stop);
   void get_string(std::string *target, const std::string &context = "");
   void get_value(std::string *target);
   void get_whitespaces(std::string *target);
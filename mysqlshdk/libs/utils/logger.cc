@@ -35,9 +35,13 @@
 #endif  // !_WIN32
 
 #include <algorithm>
+#include <condition_variable>
 #include <map>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include "mysqlshdk/libs/utils/bounded_queue.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 
 namespace shcore {
@@ -90,6 +94,117 @@ Logger::LOG_LEVEL get_level_by_name(const std::string &name) {
 
 }  // namespace
 
+/**
+ * Writes the log entries in a background thread.
+ *
+ * Entries are passed through a bounded queue, producers wait only if it is
+ * full. The single consumer drains all the available entries and writes them
+ * to the file at once.
+ */
+class Logger::Async_writer final {
+ public:
+  explicit Async_writer(std::ofstream *file)
+      : m_file(file), m_queue(k_capacity) {
+    m_thread = std::thread(&Async_writer::run, this);
+  }
+
+  Async_writer(const Async_writer &) = delete;
+  Async_writer(Async_writer &&) = delete;
+
+  Async_writer &operator=(const Async_writer &) = delete;
+  Async_writer &operator=(Async_writer &&) = delete;
+
+  /**
+   * Writes all the queued entries and stops the thread.
+   */
+  ~Async_writer() {
+    m_queue.shutdown(1);
+    m_thread.join();
+  }
+
+  /**
+   * Queues the entry, waits if the queue is full.
+   *
+   * @param entry entry to be written
+   * @param flush if true, waits until the entry is written
+   */
+  void write(std::string &&entry, bool flush) {
+    if (!flush) {
+      m_queue.push(Entry{std::move(entry), nullptr});
+      return;
+    }
+
+    bool written = false;
+    m_queue.push(Entry{std::move(entry), &written});
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [&written]() { return written; });
+  }
+
+  /**
+   * Waits until all the entries queued so far are written.
+   */
+  void flush() { write(std::string(), true); }
+
+ private:
+  struct Entry {
+    std::string data;
+    /// Set once the entry is written, if someone waits for it
+    bool *written;
+  };
+
+  static constexpr size_t k_capacity = 4096;
+  static constexpr size_t k_max_batch_size = 64 * 1024;
+
+  void run() {
+    std::string batch;
+    std::vector<bool *> waiters;
+
+    for (;;) {
+      auto entry = m_queue.pop();
+      // guard returned after shutdown, all the entries were consumed
+      const bool stop = entry.data.empty() && !entry.written;
+
+      batch.clear();
+      waiters.clear();
+
+      do {
+        batch.append(entry.data);
+        if (entry.written) waiters.emplace_back(entry.written);
+      } while (batch.length() < k_max_batch_size && m_queue.try_pop(&entry));
+
+      if (!batch.empty()) {
+        m_file->write(batch.c_str(), batch.length());
+        m_file->flush();
+      }
+
+      if (!waiters.empty()) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+
+          for (const auto written : waiters) {
+            *written = true;
+          }
+        }
+
+        m_written.notify_all();
+      }
+
+      if (stop) break;
+    }
+  }
+
+  std::ofstream *m_file;
+  Bounded_queue<Entry> m_queue;
+
+  std::mutex m_mutex;
+  std::condition_variable m_written;
+  std::thread m_thread;
+};
+
+constexpr size_t Logger::Async_writer::k_capacity;
+constexpr size_t Logger::Async_writer::k_max_batch_size;
+
 std::unique_ptr<Logger> Logger::s_instance;
 std::string Logger::s_output_format;
 
@@ -105,7 +220,8 @@ Logger::Log_entry::Log_entry(const char *domain, const char *message,
 
 void Logger::attach_log_hook(Log_hook hook, void *user_data, bool catch_all) {
   if (hook) {
-    m_hook_list.emplace_back(hook, user_data, catch_all);
+    m_hook_list.emplace_back(Hook{hook, user_data, catch_all, LOG_MAX_LEVEL});
+    update_max_level();
   } else {
     throw std::invalid_argument("Logger::attach_log_hook: Null hook pointer");
   }
@@ -113,15 +229,78 @@ void Logger::attach_log_hook(Log_hook hook, void *user_data, bool catch_all) {
 
 void Logger::detach_log_hook(Log_hook hook) {
   if (hook) {
-    m_hook_list.remove_if([hook](const std::tuple<Log_hook, void *, bool> &i) {
-      return std::get<0>(i) == hook;
-    });
+    m_hook_list.remove_if([hook](const Hook &h) { return h.hook == hook; });
+    update_max_level();
   } else {
     throw std::invalid_argument("Logger::detach_log_hook: Null hook pointer");
   }
 }
 
-void Logger::set_log_level(LOG_LEVEL log_level) { m_log_level = log_level; }
+void Logger::set_log_hook_level(Log_hook hook, LOG_LEVEL level) {
+  for (auto &h : m_hook_list) {
+    if (h.hook == hook) h.max_level = level;
+  }
+
+  update_max_level();
+}
+
+void Logger::set_log_level(LOG_LEVEL log_level) {
+  m_log_level = log_level;
+  update_max_level();
+}
+
+void Logger::update_max_level() {
+  LOG_LEVEL level = m_log_level;
+
+  for (const auto &h : m_hook_list) {
+    if (h.catch_all) level = std::max(level, h.max_level);
+  }
+
+  m_max_level = level;
+}
+
+void Logger::set_async(bool async) {
+  m_async = async;
+
+  if (!async) {
+    m_writer.reset();
+  } else if (!m_writer && m_log_file.is_open()) {
+    m_writer.reset(new Async_writer(&m_log_file));
+  }
+}
+
+void Logger::flush() {
+  if (m_writer) m_writer->flush();
+}
+
+void Logger::write_to_file(std::string &&entry, bool flush) {
+  if (m_writer) {
+    m_writer->write(std::move(entry), flush);
+  } else {
+    std::lock_guard<std::mutex> lock(m_log_file_mutex);
+    m_log_file.write(entry.c_str(), entry.length());
+    m_log_file.flush();
+  }
+}
+
+void Logger::open_log_file(const char *filename) {
+  m_log_file_name = filename;
+  m_log_file.open(filename, std::ios_base::app);
+
+  if (m_log_file.fail())
+    throw std::logic_error(
+        std::string("Error in Logger::Logger when opening file '") + filename +
+        "' for writing");
+
+  if (m_async) m_writer.reset(new Async_writer(&m_log_file));
+}
+
+void Logger::close_log_file() {
+  // queued entries are written before the file is closed
+  m_writer.reset();
+
+  if (m_log_file.is_open()) m_log_file.close();
+}
 
 void Logger::assert_logger_initialized() {
   if (s_instance.get() == nullptr) {
@@ -159,7 +338,7 @@ std::string Logger::format(const char *formats, va_list args) {
 void Logger::log(LOG_LEVEL level, const char *formats, ...) {
   assert_logger_initialized();
 
-  if (s_instance.get() != nullptr) {
+  if (s_instance.get() != nullptr && s_instance->is_enabled(level)) {
     va_list args;
     va_start(args, formats);
     const auto msg = format(formats, args);
@@ -170,16 +349,16 @@ void Logger::log(LOG_LEVEL level, const char *formats, ...) {
 }
 
 void Logger::do_log(const Log_entry &entry) {
-  if (s_instance->m_log_file.is_open() &&
-      entry.level <= s_instance->m_log_level) {
-    const auto s = format_message(entry);
-    s_instance->m_log_file.write(s.c_str(), s.length());
-    s_instance->m_log_file.flush();
+  const LOG_LEVEL log_level = s_instance->m_log_level;
+
+  if (s_instance->m_log_file.is_open() && entry.level <= log_level) {
+    s_instance->write_to_file(format_message(entry),
+                              entry.level <= LOG_ERROR);
   }
 
-  for (const auto &f : s_instance->m_hook_list) {
-    if (std::get<2>(f) || entry.level <= s_instance->m_log_level)
-      std::get<0>(f)(entry, std::get<1>(f));
+  for (const auto &h : s_instance->m_hook_list) {
+    if (entry.level <= (h.catch_all ? h.max_level : log_level))
+      h.hook(entry, h.data);
   }
 }
 
@@ -278,17 +457,11 @@ void Logger::setup_instance(const char *filename, bool use_stderr,
   if (s_instance) {
     if (filename) {
       if (filename != s_instance->m_log_file_name) {
-        if (s_instance->m_log_file.is_open()) s_instance->m_log_file.close();
-        s_instance->m_log_file_name = filename;
-
-        s_instance->m_log_file.open(filename, std::ios_base::app);
-        if (s_instance->m_log_file.fail())
-          throw std::logic_error(
-              std::string("Error in Logger::Logger when opening file '") +
-              filename + "' for writing");
+        s_instance->close_log_file();
+        s_instance->open_log_file(filename);
       }
     } else {
-      if (s_instance->m_log_file.is_open()) s_instance->m_log_file.close();
+      s_instance->close_log_file();
       s_instance->m_log_file_name.clear();
     }
 
@@ -306,12 +479,7 @@ void Logger::setup_instance(const char *filename, bool use_stderr,
 
 Logger::Logger(const char *filename, bool use_stderr) {
   if (filename != nullptr) {
-    m_log_file_name = filename;
-    m_log_file.open(filename, std::ios_base::app);
-    if (m_log_file.fail())
-      throw std::logic_error(
-          std::string("Error in Logger::Logger when opening file '") +
-          filename + "' for writing");
+    open_log_file(filename);
   }
 
   if (use_stderr) {
@@ -319,9 +487,7 @@ Logger::Logger(const char *filename, bool use_stderr) {
   }
 }
 
-Logger::~Logger() {
-  if (m_log_file.is_open()) m_log_file.close();
-}
+Logger::~Logger() { close_log_file(); }
 
 Logger::LOG_LEVEL Logger::parse_log_level(const std::string &tag) {
   try {
@@ -354,8 +520,8 @@ std::string Logger::stderr_output_format() { return s_output_format; }
 bool Logger::use_stderr() const {
   return m_hook_list.end() !=
          std::find_if(m_hook_list.begin(), m_hook_list.end(),
-                      [](const std::tuple<Log_hook, void *, bool> &h) {
-                        return std::get<0>(h) == &Logger::out_to_stderr;
+                      [](const Hook &h) {
+                        return h.hook == &Logger::out_to_stderr;
                       });
 }
 
@@ -24,13 +24,14 @@
 #ifndef MYSQLSHDK_LIBS_UTILS_LOGGER_H_
 #define MYSQLSHDK_LIBS_UTILS_LOGGER_H_
 
+#include <atomic>
 #include <cstdarg>
 #include <fstream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
-#include <tuple>
 
 #ifdef _MSC_VER
 #include <sal.h>
@@ -78,9 +79,38 @@ class SHCORE_PUBLIC Logger final {
                        bool catch_all = false);
   void detach_log_hook(Log_hook hook);
 
+  /**
+   * Sets the maximum level of entries passed to a catch-all hook, by default
+   * such hook receives entries of all levels.
+   */
+  void set_log_hook_level(Log_hook hook, LOG_LEVEL level);
+
   void set_log_level(LOG_LEVEL log_level);
   LOG_LEVEL get_log_level() const { return m_log_level; }
 
+  /**
+   * Checks if entries of the given level are going to be written to the log
+   * file or passed to any of the hooks. Messages of other entries are not
+   * formatted.
+   */
+  bool is_enabled(LOG_LEVEL level) const { return level <= m_max_level; }
+
+  /**
+   * Enables writing to the log file in a background thread. Entries are
+   * queued and written in batches, entries of LOG_ERROR and lower levels are
+   * written before the log() call returns.
+   *
+   * Log file may not contain all the queued entries until flush() is called.
+   */
+  void set_async(bool async);
+
+  bool is_async() const { return m_async; }
+
+  /**
+   * Waits until all the queued entries are written to the log file.
+   */
+  void flush();
+
 #if __GNUC__ > 2 || (__GNUC__ == 2 && __GNUC_MINOR__ > 4)
   static void log(LOG_LEVEL level, const char *format, ...)
       __attribute__((__format__(__printf__, 2, 3)));
@@ -132,14 +162,37 @@ class SHCORE_PUBLIC Logger final {
 
   static void do_log(const Log_entry &entry);
 
+  void update_max_level();
+
+  void write_to_file(std::string &&entry, bool flush);
+
+  void open_log_file(const char *filename);
+
+  void close_log_file();
+
+  struct Hook {
+    Log_hook hook;
+    void *data;
+    bool catch_all;
+    // maximum level of entries passed to a catch-all hook
+    LOG_LEVEL max_level;
+  };
+
+  class Async_writer;
+
   static std::unique_ptr<Logger> s_instance;
   static std::string s_output_format;
 
-  LOG_LEVEL m_log_level = LOG_NONE;
+  std::atomic<LOG_LEVEL> m_log_level{LOG_NONE};
+  // maximum level of entries which are written or passed to a hook
+  std::atomic<LOG_LEVEL> m_max_level{LOG_NONE};
 
   std::ofstream m_log_file;
   std::string m_log_file_name;
-  std::list<std::tuple<Log_hook, void *, bool>> m_hook_list;
+  std::mutex m_log_file_mutex;
+  bool m_async = false;
+  std::unique_ptr<Async_writer> m_writer;
+  std::list<Hook> m_hook_list;
 
   std::list<std::string> m_log_context;
 };
@@ -633,7 +633,9 @@ void Process::do_start() {
       fprintf(stderr, "Exception while preparing the child process: %s\n",
               e.what());
       fflush(stderr);
-      exit(128);
+      // child must not run the exit handlers of the parent, i.e. static
+      // destructors stopping threads which only exist in the parent
+      _exit(128);
     }
 
     for (const auto &str : new_environment) shcore::setenv(str);
@@ -650,7 +652,7 @@ void Process::do_start() {
     // subprocess
     if (my_errno == 2) my_errno = 128;
 
-    exit(my_errno);
+    _exit(my_errno);
   } else {
     ::close(fd_out[1]);
     ::close(fd_in[0]);
@@ -24,7 +24,11 @@
 #ifndef MYSQLSHDK_LIBS_UTILS_THREADS_H_
 #define MYSQLSHDK_LIBS_UTILS_THREADS_H_
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -72,6 +76,69 @@ OutputT map_reduce(InputIter begin, InputIter end, MapF map, ReduceF reduce) {
   return result;
 }
 
+/**
+ * Thread guard which does nothing, see parallel_for().
+ */
+struct No_thread_guard {};
+
+/**
+ * Calls f(i) for each i in [0, count), using at most max_threads worker
+ * threads. Returns once all calls are finished. If just one thread would be
+ * used, calls are made in the callers thread.
+ *
+ * An instance of Thread_guard lives in each worker thread for as long as the
+ * thread is running, i.e. mysqlsh::Mysql_thread if f connects to the server.
+ *
+ * If any call throws, remaining indexes are not processed and the first
+ * exception is rethrown in the callers thread.
+ */
+template <class Thread_guard = No_thread_guard, class F>
+void parallel_for(size_t count, size_t max_threads, F f) {
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  const auto process = [&]() {
+    try {
+      for (size_t i = next++; i < count; i = next++) {
+        f(i);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+      next = count;
+    }
+  };
+
+  const size_t threads = std::min(count, std::max<size_t>(max_threads, 1));
+
+  if (threads <= 1) {
+    process();
+  } else {
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back([&]() {
+        try {
+          Thread_guard guard;
+          (void)guard;
+          process();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) error = std::current_exception();
+          next = count;
+        }
+      });
+    }
+
+    for (auto &w : workers) {
+      w.join();
+    }
+  }
+
+  if (error) std::rethrow_exception(error);
+}
+
 }  // namespace utils
 }  // namespace mysqlshdk
 
@@ -73,12 +73,47 @@ class Buffered_input {
   byte *pos() const { return m_pos; }
   byte *end() const { return m_end; }
 
-  void skip_whitespaces() {
-    while (::isspace(peek())) {
-      get();
+  /**
+   * Consumes count bytes of the buffered data, count cannot be greater than
+   * end() - pos().
+   */
+  void skip(size_t count) {
+    m_pos += count;
+    m_bytes_processed += count;
+  }
+
+  /**
+   * Consumes bytes until stop(byte) returns true or input ends. Bytes are
+   * consumed in spans of the buffered data, callback is called for each span.
+   *
+   * @param stop Predicate which marks the first byte which is not consumed.
+   * @param append Called with each consumed span (pointer, length).
+   */
+  template <typename Stop, typename Append>
+  void get_until(Stop stop, Append append) {
+    while (!eof()) {
+      peek();
+
+      byte *last = m_pos;
+      while (last != m_end && !stop(*last)) {
+        ++last;
+      }
+
+      const size_t length = last - m_pos;
+      append(reinterpret_cast<const char *>(m_pos), length);
+      skip(length);
+
+      if (last != m_end) {
+        break;
+      }
     }
   }
 
+  void skip_whitespaces() {
+    get_until([](byte c) { return !::isspace(c); },
+              [](const char *, size_t) {});
+  }
+
   std::string get_double_quoted_string();
 
  private:
@@ -33,6 +33,7 @@
 #include "scripting/types_jscript.h"
 
 #include "scripting/obj_date.h"
+#include "scripting/obj_typed_array.h"
 
 #include <cerrno>
 #include <fstream>
@@ -115,10 +116,61 @@ v8::Local<v8::Value> JScript_type_bridger::native_object_to_js(
     return result.ToLocalChecked();
   }
 
+  if (object && object->class_name() == "TypedArray") {
+    return typed_array_to_js(*std::static_pointer_cast<Typed_array>(object));
+  }
+
   return object->is_indexed() ? indexed_object_wrapper->wrap(object)
                               : object_wrapper->wrap(object);
 }
 
+v8::Local<v8::Value> JScript_type_bridger::typed_array_to_js(
+    const Typed_array &array) {
+  const auto size = array.size();
+
+  if (Typed_array::Type::Uint8 == array.type()) {
+    const auto buffer = v8::ArrayBuffer::New(owner->isolate(), size);
+
+    if (size > 0) {
+      memcpy(buffer->GetContents().Data(), array.data(), size);
+    }
+
+    return v8::Uint8Array::New(buffer, 0, size);
+  }
+
+  // JavaScript numbers are doubles, 64-bit integers are converted the same
+  // way as single values are
+  const auto buffer =
+      v8::ArrayBuffer::New(owner->isolate(), size * sizeof(double));
+  const auto data = static_cast<double *>(buffer->GetContents().Data());
+
+  switch (array.type()) {
+    case Typed_array::Type::Double:
+      if (size > 0) {
+        memcpy(data, array.data(), size * sizeof(double));
+      }
+      break;
+
+    case Typed_array::Type::Text_offset: {
+      // strings are indexed using UTF-16 code units
+      const auto offsets = array.offsets(Typed_array::String_unit::Utf16);
+
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<double>(offsets[i]);
+      }
+      break;
+    }
+
+    default:
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = array.at_double(i);
+      }
+      break;
+  }
+
+  return v8::Float64Array::New(buffer, 0, size);
+}
+
 Object_bridge_ref JScript_type_bridger::js_object_to_native(
     v8::Local<v8::Object> object) {
   const auto ctorname =
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "scripting/obj_typed_array.h"
+
+#include <utility>
+
+#include "utils/utils_json.h"
+
+namespace shcore {
+
+Typed_array::Typed_array(Type type) : m_type(type) {
+  if (Type::Text_offset == m_type) {
+    push_back_text(nullptr, 0);
+  }
+}
+
+Typed_array::Typed_array(Type type, std::string &&data)
+    : m_type(type), m_data(std::move(data)) {
+  assert(Type::Text_offset != m_type);
+  assert(0 == m_data.size() % element_size());
+}
+
+std::string &Typed_array::append_descr(std::string &s_out, int /*indent*/,
+                                       int /*quote_strings*/) const {
+  s_out += "[";
+
+  for (size_t i = 0, s = size(); i < s; ++i) {
+    if (i > 0) s_out += ", ";
+    get_member(i).append_descr(s_out);
+  }
+
+  s_out += "]";
+
+  return s_out;
+}
+
+std::string &Typed_array::append_repr(std::string &s_out) const {
+  return append_descr(s_out);
+}
+
+void Typed_array::append_json(shcore::JSON_dumper &dumper) const {
+  dumper.start_array();
+
+  for (size_t i = 0, s = size(); i < s; ++i) {
+    dumper.append_value(get_member(i));
+  }
+
+  dumper.end_array();
+}
+
+bool Typed_array::operator==(const Object_bridge &other) const {
+  if (other.class_name() == class_name()) {
+    const auto &array = static_cast<const Typed_array &>(other);
+    return m_type == array.m_type && m_data == array.m_data;
+  }
+
+  return false;
+}
+
+Value Typed_array::get_member(size_t index) const {
+  if (index >= size()) {
+    throw Exception::argument_error("Index " + std::to_string(index) +
+                                    " is out of range");
+  }
+
+  switch (m_type) {
+    case Type::Uint8:
+      return Value(static_cast<uint64_t>(at<uint8_t>(index)));
+
+    case Type::Int64:
+      return Value(at<int64_t>(index));
+
+    case Type::Uint64:
+    case Type::Text_offset:
+      return Value(at<uint64_t>(index));
+
+    case Type::Double:
+      return Value(at<double>(index));
+  }
+
+  return Value();
+}
+
+double Typed_array::at_double(size_t index) const {
+  switch (m_type) {
+    case Type::Uint8:
+      return at<uint8_t>(index);
+
+    case Type::Int64:
+      return static_cast<double>(at<int64_t>(index));
+
+    case Type::Uint64:
+    case Type::Text_offset:
+      return static_cast<double>(at<uint64_t>(index));
+
+    case Type::Double:
+      return at<double>(index);
+  }
+
+  return 0.0;
+}
+
+void Typed_array::push_back_text(const char *value, size_t length) {
+  assert(Type::Text_offset == m_type);
+
+  uint64_t bytes = 0;
+  uint64_t code_points = 0;
+  uint64_t utf16 = 0;
+
+  if (!m_code_point_offsets.empty()) {
+    bytes = at<uint64_t>(size() - 1);
+    code_points = m_code_point_offsets.back();
+    utf16 = m_utf16_offsets.back();
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    const auto c = static_cast<unsigned char>(value[i]);
+
+    // continuation bytes do not start a new code point
+    if (0x80 != (c & 0xC0)) {
+      ++code_points;
+      ++utf16;
+
+      // code points encoded using four bytes need a surrogate pair
+      if (c >= 0xF0) {
+        ++utf16;
+      }
+    }
+  }
+
+  bytes += length;
+
+  m_data.append(reinterpret_cast<const char *>(&bytes), sizeof(bytes));
+  m_code_point_offsets.emplace_back(code_points);
+  m_utf16_offsets.emplace_back(utf16);
+}
+
+std::vector<uint64_t> Typed_array::offsets(String_unit unit) const {
+  assert(Type::Text_offset == m_type);
+
+  switch (unit) {
+    case String_unit::Code_point:
+      return m_code_point_offsets;
+
+    case String_unit::Utf16:
+      return m_utf16_offsets;
+
+    case String_unit::Byte:
+      break;
+  }
+
+  std::vector<uint64_t> bytes(size());
+
+  if (!bytes.empty()) {
+    memcpy(bytes.data(), m_data.data(), m_data.size());
+  }
+
+  return bytes;
+}
+
+}  // namespace shcore
@@ -22,6 +22,10 @@
  */
 
 #include "scripting/python_type_conversion.h"
+
+#include <vector>
+
+#include "scripting/obj_typed_array.h"
 #include "scripting/python_array_wrapper.h"
 #include "scripting/python_function_wrapper.h"
 #include "scripting/python_map_wrapper.h"
@@ -37,11 +41,112 @@ Python_type_bridger::~Python_type_bridger() {}
 
 void Python_type_bridger::init() {}
 
-/* TODO:
-PyObject *Python_type_bridger::native_object_to_py(Object_bridge_ref object)
-{
+namespace {
+
+/**
+ * Creates an array.array object which holds a copy of the given elements.
+ *
+ * @param type_code type of the elements
+ * @param data elements in native byte order
+ * @param size size of the data in bytes
+ *
+ * @returns new reference or nullptr if Python error was set.
+ */
+PyObject *new_py_array(const char *type_code, const char *data, size_t size) {
+  PyObject *module = PyImport_ImportModule("array");
+
+  if (!module) return nullptr;
+
+  PyObject *array = PyObject_CallMethod(module, const_cast<char *>("array"),
+                                        const_cast<char *>("s"), type_code);
+  Py_DECREF(module);
+
+  if (!array || 0 == size) return array;
+
+  PyObject *bytes =
+      PyBytes_FromStringAndSize(data, static_cast<Py_ssize_t>(size));
+
+  if (!bytes) {
+    Py_DECREF(array);
+    return nullptr;
+  }
+
+#ifdef IS_PY3K
+  const auto method = "frombytes";
+#else
+  const auto method = "fromstring";
+#endif  // IS_PY3K
+
+  PyObject *result = PyObject_CallMethod(array, const_cast<char *>(method),
+                                         const_cast<char *>("O"), bytes);
+  Py_DECREF(bytes);
+
+  if (!result) {
+    Py_DECREF(array);
+    return nullptr;
+  }
+
+  Py_DECREF(result);
+
+  return array;
+}
+
+template <typename T>
+PyObject *new_py_array(const char *type_code, const std::vector<T> &data) {
+  return new_py_array(type_code, reinterpret_cast<const char *>(data.data()),
+                      data.size() * sizeof(T));
+}
+
+PyObject *typed_array_to_py(const Typed_array &array) {
+  using Type = Typed_array::Type;
+
+  switch (array.type()) {
+    case Type::Uint8:
+      return new_py_array("B", array.data(), array.size());
+
+    case Type::Double:
+      return new_py_array("d", array.data(), array.size() * sizeof(double));
+
+#ifdef IS_PY3K
+    case Type::Int64:
+      return new_py_array("q", array.data(), array.size() * sizeof(int64_t));
+
+    case Type::Uint64:
+      return new_py_array("Q", array.data(), array.size() * sizeof(uint64_t));
+
+    case Type::Text_offset:
+      return new_py_array(
+          "Q", array.offsets(Typed_array::String_unit::Code_point));
+#else
+    case Type::Int64:
+    case Type::Uint64:
+    case Type::Text_offset: {
+      // array module in Python 2 does not support 64-bit integers on all
+      // platforms, str objects are indexed using bytes
+      std::vector<double> values;
+      values.reserve(array.size());
+
+      for (size_t i = 0, s = array.size(); i < s; ++i) {
+        values.emplace_back(array.at_double(i));
+      }
+
+      return new_py_array("d", values);
+    }
+#endif  // IS_PY3K
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+PyObject *Python_type_bridger::native_object_to_py(Object_bridge_ref object) {
+  if (object && object->class_name() == "TypedArray") {
+    return typed_array_to_py(*std::static_pointer_cast<Typed_array>(object));
+  }
+
+  return wrap(object);
 }
-*/
 
 Value Python_type_bridger::pyobj_to_shcore_value(PyObject *py) const {
   // Some numeric conversions yield errors, in that case the string
@@ -220,7 +325,7 @@ PyObject *Python_type_bridger::shcore_value_to_pyobj(const Value &value) {
       r = PyFloat_FromDouble(value.value.d);
       break;
     case Object:
-      r = wrap(*value.value.o);
+      r = native_object_to_py(*value.value.o);
       break;
     case Array:
       r = wrap(*value.value.array);
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/shellcore/name_cache.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif  // _WIN32
+
+#include <openssl/sha.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+
+namespace shcore {
+namespace completer {
+
+namespace {
+
+constexpr const int k_version = 1;
+
+/**
+ * Converts a name into a valid file name. Only lowercase letters, digits, '_'
+ * and '-' are used as is, so that names which differ only in case do not
+ * clash on case-insensitive file systems.
+ */
+std::string encode(const std::string &name) {
+  static constexpr const char k_hex[] = "0123456789ABCDEF";
+  std::string result;
+
+  for (const auto c : name) {
+    if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || '_' == c ||
+        '-' == c) {
+      result += c;
+    } else {
+      const auto byte = static_cast<uint8_t>(c);
+      result += '%';
+      result += k_hex[byte >> 4];
+      result += k_hex[byte & 0xF];
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Converts a name of arbitrary length into a valid file name of a fixed
+ * length, using hex-encoded SHA-256 of the name.
+ */
+std::string hash(const std::string &name) {
+  static constexpr const char k_hex[] = "0123456789abcdef";
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+
+  SHA256(reinterpret_cast<const unsigned char *>(name.data()), name.length(),
+         digest);
+
+  std::string result;
+  result.reserve(2 * SHA256_DIGEST_LENGTH);
+
+  for (const auto byte : digest) {
+    result += k_hex[byte >> 4];
+    result += k_hex[byte & 0xF];
+  }
+
+  return result;
+}
+
+/**
+ * Reads the given file, returns an array stored in the given member.
+ */
+bool load_array(const std::string &path, const char *name,
+                rapidjson::Document *doc, const rapidjson::Value **array) {
+  std::string contents;
+
+  if (!shcore::is_file(path) || !shcore::load_text_file(path, contents)) {
+    return false;
+  }
+
+  doc->Parse(contents.c_str());
+
+  if (doc->HasParseError() || !doc->IsObject()) {
+    return false;
+  }
+
+  const auto version = doc->FindMember("version");
+
+  if (doc->MemberEnd() == version || !version->value.IsInt() ||
+      k_version != version->value.GetInt()) {
+    return false;
+  }
+
+  const auto member = doc->FindMember(name);
+
+  if (doc->MemberEnd() == member || !member->value.IsArray()) {
+    return false;
+  }
+
+  *array = &member->value;
+  return true;
+}
+
+bool get_strings(const rapidjson::Value &array,
+                 std::vector<std::string> *strings) {
+  strings->reserve(array.Size());
+
+  for (const auto &value : array.GetArray()) {
+    if (!value.IsString()) {
+      return false;
+    }
+
+    strings->emplace_back(value.GetString(), value.GetStringLength());
+  }
+
+  return true;
+}
+
+bool get_string(const rapidjson::Value &object, const char *name,
+                std::string *s) {
+  const auto member = object.FindMember(name);
+
+  if (object.MemberEnd() == member || !member->value.IsString()) {
+    return false;
+  }
+
+  s->assign(member->value.GetString(), member->value.GetStringLength());
+  return true;
+}
+
+class Json_writer final {
+ public:
+  Json_writer() : m_writer(m_buffer) {
+    m_writer.StartObject();
+    m_writer.Key("version");
+    m_writer.Int(k_version);
+  }
+
+  rapidjson::Writer<rapidjson::StringBuffer> *operator->() {
+    return &m_writer;
+  }
+
+  void string(const std::string &s) {
+    m_writer.String(s.c_str(), static_cast<rapidjson::SizeType>(s.length()));
+  }
+
+  void strings(const std::vector<std::string> &strings) {
+    m_writer.StartArray();
+
+    for (const auto &s : strings) {
+      string(s);
+    }
+
+    m_writer.EndArray();
+  }
+
+  /**
+   * Starts the array which holds the names, it needs to be the last member.
+   */
+  void start_array(const char *name) {
+    m_writer.Key(name);
+    m_writer.StartArray();
+  }
+
+  std::string finish() {
+    m_writer.EndArray();
+    m_writer.EndObject();
+    return std::string(m_buffer.GetString(), m_buffer.GetSize());
+  }
+
+ private:
+  rapidjson::StringBuffer m_buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> m_writer;
+};
+
+}  // namespace
+
+Name_cache::Name_cache(const std::string &directory,
+                       const std::string &server_uuid)
+    : m_path(shcore::path::join_path(directory, encode(server_uuid))) {}
+
+std::string Name_cache::default_directory() {
+  return shcore::path::join_path(shcore::get_user_config_path(),
+                                 "completion_cache");
+}
+
+bool Name_cache::load_schemas(std::vector<std::string> *schemas) const {
+  rapidjson::Document doc;
+  const rapidjson::Value *array = nullptr;
+
+  if (!load_array(schemas_path(), "schemas", &doc, &array)) {
+    return false;
+  }
+
+  std::vector<std::string> result;
+
+  if (!get_strings(*array, &result)) {
+    return false;
+  }
+
+  *schemas = std::move(result);
+  return true;
+}
+
+void Name_cache::save_schemas(const std::vector<std::string> &schemas) const {
+  Json_writer writer;
+  writer.start_array("schemas");
+
+  for (const auto &schema : schemas) {
+    writer.string(schema);
+  }
+
+  write(schemas_path(), writer.finish());
+}
+
+bool Name_cache::load_tables(const std::string &schema, Tables *tables) const {
+  rapidjson::Document doc;
+  const rapidjson::Value *array = nullptr;
+
+  if (!load_array(tables_path(schema), "tables", &doc, &array)) {
+    return false;
+  }
+
+  std::string name;
+
+  // file names are hashed, make sure the file holds the requested schema
+  if (!get_string(doc, "schema", &name) || name != schema) {
+    return false;
+  }
+
+  Tables result;
+
+  for (const auto &value : array->GetArray()) {
+    if (!value.IsObject()) {
+      return false;
+    }
+
+    std::string name;
+    Table table;
+
+    if (!get_string(value, "name", &name) ||
+        !get_string(value, "created", &table.create_time) ||
+        !get_string(value, "updated", &table.update_time)) {
+      return false;
+    }
+
+    const auto columns = value.FindMember("columns");
+
+    if (value.MemberEnd() == columns || !columns->value.IsArray() ||
+        !get_strings(columns->value, &table.columns)) {
+      return false;
+    }
+
+    result.emplace(std::move(name), std::move(table));
+  }
+
+  *tables = std::move(result);
+  return true;
+}
+
+void Name_cache::save_tables(const std::string &schema,
+                             const Tables &tables) const {
+  Json_writer writer;
+  writer->Key("schema");
+  writer.string(schema);
+  writer.start_array("tables");
+
+  for (const auto &table : tables) {
+    writer->StartObject();
+    writer->Key("name");
+    writer.string(table.first);
+    writer->Key("created");
+    writer.string(table.second.create_time);
+    writer->Key("updated");
+    writer.string(table.second.update_time);
+    writer->Key("columns");
+    writer.strings(table.second.columns);
+    writer->EndObject();
+  }
+
+  write(tables_path(schema), writer.finish());
+}
+
+std::string Name_cache::schemas_path() const {
+  return shcore::path::join_path(m_path, "schemas.json");
+}
+
+std::string Name_cache::tables_path(const std::string &schema) const {
+  // schema names can be longer than the file name limit once encoded, a hash
+  // has a fixed length, the name itself is stored in the file
+  return shcore::path::join_path(m_path, "tables." + hash(schema) + ".json");
+}
+
+void Name_cache::write(const std::string &path,
+                       const std::string &contents) const {
+  shcore::create_directory(m_path);
+
+  const auto tmp_path = path + ".tmp";
+
+  {
+    std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+
+    if (!f.is_open()) {
+      throw std::runtime_error("Unable to open cache file '" + tmp_path +
+                               "' for writing: " + strerror(errno));
+    }
+
+    f.write(contents.data(), contents.size());
+    f.flush();
+
+    if (f.fail()) {
+      throw std::runtime_error("Error '" + std::string{strerror(errno)} +
+                               "' while writing cache file '" + tmp_path +
+                               "'");
+    }
+  }
+
+  // cache is replaced in one step, it's never left incomplete
+#ifdef _WIN32
+  if (!MoveFileExA(tmp_path.c_str(), path.c_str(),
+                   MOVEFILE_REPLACE_EXISTING)) {
+    throw std::runtime_error("Could not rename '" + tmp_path + "' to '" +
+                             path + "'");
+  }
+#else
+  shcore::rename_file(tmp_path, path);
+#endif
+}
+
+}  // namespace completer
+}  // namespace shcore
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_SHELLCORE_NAME_CACHE_H_
+#define MYSQLSHDK_SHELLCORE_NAME_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace shcore {
+namespace completer {
+
+/**
+ * Auto-completion names of a single server, persisted between the sessions.
+ *
+ * Each server has its own directory, named after its UUID. Schema names are
+ * stored in one file, names of the tables and their columns are stored in a
+ * separate file for each schema, named after a hash of the schema name.
+ * Creation and update times of the tables are stored as well, so that only
+ * the tables which have changed need to be fetched again.
+ */
+class Name_cache final {
+ public:
+  struct Table {
+    // CREATE_TIME, empty if not known
+    std::string create_time;
+    // UPDATE_TIME, empty if not known
+    std::string update_time;
+    std::vector<std::string> columns;
+  };
+
+  // table name -> table
+  using Tables = std::map<std::string, Table>;
+
+  Name_cache() = delete;
+
+  /**
+   * @param directory Directory which holds caches of all servers.
+   * @param server_uuid UUID of the server.
+   */
+  Name_cache(const std::string &directory, const std::string &server_uuid);
+
+  Name_cache(const Name_cache &) = default;
+  Name_cache(Name_cache &&) = default;
+
+  Name_cache &operator=(const Name_cache &) = default;
+  Name_cache &operator=(Name_cache &&) = default;
+
+  ~Name_cache() = default;
+
+  /**
+   * Default location of the caches, within the user's configuration
+   * directory.
+   */
+  static std::string default_directory();
+
+  /**
+   * Reads the cached schema names.
+   *
+   * @returns false if names are not cached or the file is malformed.
+   */
+  bool load_schemas(std::vector<std::string> *schemas) const;
+
+  /**
+   * Writes the schema names.
+   *
+   * @throws std::runtime_error if file cannot be written
+   */
+  void save_schemas(const std::vector<std::string> &schemas) const;
+
+  /**
+   * Reads the cached tables of the given schema.
+   *
+   * @returns false if tables are not cached or the file is malformed.
+   */
+  bool load_tables(const std::string &schema, Tables *tables) const;
+
+  /**
+   * Writes the tables of the given schema.
+   *
+   * @throws std::runtime_error if file cannot be written
+   */
+  void save_tables(const std::string &schema, const Tables &tables) const;
+
+  const std::string &path() const { return m_path; }
+
+ private:
+  std::string schemas_path() const;
+
+  std::string tables_path(const std::string &schema) const;
+
+  void write(const std::string &path, const std::string &contents) const;
+
+  std::string m_path;
+
+#ifdef FRIEND_TEST
+  FRIEND_TEST(Name_cache_test, long_schema_name);
+#endif
+};
+
+}  // namespace completer
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_SHELLCORE_NAME_CACHE_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -23,13 +23,22 @@
 
 #include "mysqlshdk/shellcore/provider_sql.h"
 #include <algorithm>
-#include <iostream>
+#include <cctype>
+#include <functional>
 #include <iterator>
-#include <set>
+#include <list>
+#include <map>
+#include <thread>
+#include <utility>
 
-#include "modules/devapi/base_resultset.h"  // TODO(alfredo) remove when ISession
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/mysqlx/session.h"
+#include "mysqlshdk/libs/db/replay/setup.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_sqlstring.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/shell_init.h"
 
 namespace shcore {
 namespace completer {
@@ -37,8 +46,59 @@ namespace completer {
 namespace {
 
 extern std::vector<std::string> k_sorted_keywords;
+
+inline unsigned char lower(char c) {
+  return static_cast<unsigned char>(
+      std::tolower(static_cast<unsigned char>(c)));
+}
+
+/**
+ * Case-insensitive comparison, consistent with shcore::str_casecmp().
+ */
+int compare_ci(const char *a, size_t a_length, const char *b,
+               size_t b_length) {
+  const auto length = std::min(a_length, b_length);
+
+  for (size_t i = 0; i < length; ++i) {
+    const int diff = lower(a[i]) - lower(b[i]);
+
+    if (diff) {
+      return diff;
+    }
+  }
+
+  return a_length < b_length ? -1 : (a_length > b_length ? 1 : 0);
+}
+
+std::shared_ptr<mysqlshdk::db::ISession> create_session(
+    mysqlsh::SessionType type) {
+  if (mysqlsh::SessionType::X == type) {
+    return mysqlshdk::db::mysqlx::Session::create();
+  } else {
+    return mysqlshdk::db::mysql::Session::create();
+  }
 }
 
+/**
+ * Kills the connection with the given ID, using a new one.
+ */
+void kill_connection(mysqlsh::SessionType type,
+                     const mysqlshdk::db::Connection_options &options,
+                     uint64_t id) {
+  mysqlsh::Mysql_thread mysql_thread;
+
+  try {
+    const auto session = create_session(type);
+    session->connect(options);
+    session->execute("KILL " + std::to_string(id));
+    session->close();
+  } catch (const std::exception &e) {
+    log_info("Unable to kill the auto-completion connection: %s", e.what());
+  }
+}
+
+}  // namespace
+
 void add_matches_ci(const std::vector<std::string> &options,
                     Completion_list *out_list, const std::string &prefix,
                     bool back_quote = false) {
@@ -60,9 +120,115 @@ void add_matches_ci(const std::vector<std::string> &options,
   }
 }
 
+Sorted_names::Sorted_names(std::vector<std::string> &&names) {
+  std::sort(names.begin(), names.end(),
+            [](const std::string &a, const std::string &b) {
+              const auto result =
+                  compare_ci(a.data(), a.length(), b.data(), b.length());
+              // names which differ only in case are sorted as well, so that
+              // duplicates are next to each other
+              return result < 0 || (0 == result && a < b);
+            });
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  size_t total = 0;
+
+  for (const auto &n : names) {
+    total += n.length();
+  }
+
+  names_.reserve(total);
+  offsets_.reserve(names.size() + 1);
+
+  for (const auto &n : names) {
+    offsets_.emplace_back(static_cast<uint32_t>(names_.length()));
+    names_.append(n);
+  }
+
+  offsets_.emplace_back(static_cast<uint32_t>(names_.length()));
+
+  index_.resize(257);
+
+  const auto count = size();
+  size_t pos = 0;
+
+  for (size_t c = 0; c < 256; ++c) {
+    // empty name can only be the first one
+    while (pos < count && (0 == length(pos) || lower(*name(pos)) < c)) {
+      ++pos;
+    }
+
+    index_[c] = static_cast<uint32_t>(pos);
+  }
+
+  index_[256] = static_cast<uint32_t>(count);
+}
+
+void Sorted_names::add_matches(const std::string &prefix, bool back_quote,
+                               Completion_list *out_list) const {
+  if (empty()) {
+    return;
+  }
+
+  size_t begin = 0;
+  size_t end = size();
+
+  if (!prefix.empty()) {
+    const auto c = lower(prefix[0]);
+    begin = index_[c];
+    end = index_[c + 1];
+  }
+
+  // find the first name which is not less than the prefix
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+
+    if (compare_ci(name(middle), length(middle), prefix.data(),
+                   prefix.length()) < 0) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+
+  // names which start with the prefix follow it
+  for (auto i = begin, s = size(); i < s; ++i) {
+    if (length(i) < prefix.length() ||
+        0 != compare_ci(name(i), prefix.length(), prefix.data(),
+                        prefix.length())) {
+      break;
+    }
+
+    std::string n{name(i), length(i)};
+    out_list->emplace_back(back_quote ? shcore::quote_identifier(n)
+                                      : std::move(n));
+  }
+}
+
+Provider_sql::Provider_sql() {
+  try {
+    cache_directory_ = Name_cache::default_directory();
+  } catch (const std::exception &e) {
+    log_warning("Auto-completion names are not going to be cached: %s",
+                e.what());
+  }
+}
+
+Provider_sql::~Provider_sql() {
+  interrupt_rehash();
+  names_->join();
+}
+
 Completion_list Provider_sql::complete_schema(const std::string &prefix) {
   Completion_list list;
-  add_matches_ci(schema_names_, &list, prefix);
+  std::shared_ptr<const Sorted_names> schemas;
+
+  {
+    std::lock_guard<std::mutex> lock(names_->mutex);
+    schemas = names_->schemas;
+  }
+
+  schemas->add_matches(prefix, false, &list);
   return list;
 }
 
@@ -117,100 +283,454 @@ Completion_list Provider_sql::complete(const std::string &text,
     add_matches_ci(k_sorted_keywords, &options, prefix);
   }
 
+  // names can be replaced by the background thread, take a snapshot
+  std::shared_ptr<const Sorted_names> schemas;
+  std::shared_ptr<const Sorted_names> objects;
+  std::shared_ptr<const Sorted_names> object_dots;
+
+  {
+    std::lock_guard<std::mutex> lock(names_->mutex);
+    schemas = names_->schemas;
+    objects = names_->objects;
+    object_dots = names_->object_dots;
+  }
+
   // add DB objects
-  add_matches_ci(schema_names_, &options, prefix, back_quote);
+  schemas->add_matches(prefix, back_quote, &options);
 
   if (dot_pos != std::string::npos) {
-    add_matches_ci(object_dot_names_, &options, prefix, back_quote);
+    object_dots->add_matches(prefix, back_quote, &options);
   }
-  add_matches_ci(object_names_, &options, prefix, back_quote);
+  objects->add_matches(prefix, back_quote, &options);
   return options;
 }
 
-void Provider_sql::interrupt_rehash() { cancelled_ = true; }
+void Provider_sql::interrupt_rehash() { names_->cancel(); }
+
+void Provider_sql::wait_for_rehash() { names_->wait(); }
 
 void Provider_sql::refresh_schema_cache(
-    std::shared_ptr<mysqlsh::ShellBaseSession> session) {
-  schema_names_.clear();
-  schema_names_.reserve(100);
-
-  auto res = session->raw_execute_sql("show schemas");
-  auto row = res->call("fetchOne", shcore::Argument_list());
-  while (row && !cancelled_) {
-    std::string column =
-        row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-    schema_names_.push_back(column);
-    row = res->call("fetchOne", shcore::Argument_list());
-  }
-  std::sort(schema_names_.begin(), schema_names_.end(),
-            [](const std::string &a, const std::string &b) -> bool {
-              return shcore::str_casecmp(a, b) < 0;
-            });
+    std::shared_ptr<mysqlsh::ShellBaseSession> session, bool force) {
+  start_rehash(session, names_->start(false), true, "", force);
 }
 
 void Provider_sql::refresh_name_cache(
     std::shared_ptr<mysqlsh::ShellBaseSession> session,
-    const std::string &current_schema,
-    const std::vector<std::string> *table_names, bool rehash_all) {
-  cancelled_ = false;
+    const std::string &current_schema, bool rehash_all, bool force) {
+  bool schemas = rehash_all;
+
+  {
+    std::lock_guard<std::mutex> lock(names_->mutex);
+    // cache schema names if not done yet
+    schemas = schemas || names_->schemas->empty();
+  }
+
   default_schema_ = current_schema;
+  // names of the previous schema must not be used, they are discarded after
+  // the previous refresh is cancelled, so that it cannot publish them again
+  start_rehash(session, names_->start(true), schemas, current_schema, force);
+}
+
+void Provider_sql::start_rehash(
+    std::shared_ptr<mysqlsh::ShellBaseSession> session, uint64_t generation,
+    bool schemas, const std::string &schema, bool force) {
+  const auto names = names_;
+  bool detached = false;
+  // otherwise the background thread marks the refresh as finished
+  shcore::on_leave_scope finish([names, generation, &detached]() {
+    if (!detached) names->finish(generation);
+  });
+
+  if (!schemas && schema.empty()) {
+    return;
+  }
+
+  const auto core_session = session->get_core_session();
+
+  if (mysqlshdk::db::replay::g_replay_mode !=
+      mysqlshdk::db::replay::Mode::Direct) {
+    // sessions which are recorded or replayed need to be created in a
+    // deterministic order, use the current one, names are not cached, as
+    // this would add queries which depend on contents of the cache
+    fetch_names(core_session.get(), schemas, schema, nullptr, names.get(),
+                generation);
+    return;
+  }
+
+  const auto cached =
+      load_cache(core_session.get(), generation, schemas, schema, force);
+  const auto type = session->session_type();
+  const auto options = core_session->get_connection_options();
 
-  object_names_.clear();
-  object_dot_names_.clear();
-
-  // cache schema names if not done yet
-  if (schema_names_.empty() || rehash_all) {
-    refresh_schema_cache(session);
-  }
-
-  if (!current_schema.empty() && !cancelled_) {
-    // fetch table names, if one was not provided
-    std::vector<std::string> schema_tables;
-    if (table_names == nullptr) {
-      table_names = &schema_tables;
-
-      auto res = session->raw_execute_sql(
-          shcore::sqlstring("show tables from !", 0) << current_schema);
-      auto row = res->call("fetchOne", shcore::Argument_list());
-      while (row && !cancelled_) {
-        std::string table =
-            row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-        object_names_.push_back(table);
-        schema_tables.push_back(table);
-        row = res->call("fetchOne", shcore::Argument_list());
+  // thread is not waited for, connecting or a slow query could block the
+  // shell, if refresh is cancelled its connection is killed and its results
+  // are discarded
+  names->run([names, generation, type, options, schemas, schema, cached]() {
+    mysqlsh::Mysql_thread mysql_thread;
+
+    try {
+      const auto background = create_session(type);
+      background->connect(options);
+
+      const auto id = background->get_connection_id();
+
+      if (names->add_connection(generation, [type, options, id]() {
+            kill_connection(type, options, id);
+          })) {
+        shcore::on_leave_scope remove(
+            [names, generation]() { names->remove_connection(generation); });
+
+        fetch_names(background.get(), schemas, schema, cached.get(),
+                    names.get(), generation);
       }
+
+      background->close();
+    } catch (const std::exception &e) {
+      // outdated refresh fails once its connection is killed
+      if (names->is_current(generation)) {
+        log_warning("Error during auto-completion cache update: %s", e.what());
+      }
+    }
+
+    names->finish(generation);
+  });
+
+  detached = true;
+}
+
+std::shared_ptr<Provider_sql::Cached_names> Provider_sql::load_cache(
+    mysqlshdk::db::ISession *session, uint64_t generation, bool schemas,
+    const std::string &schema, bool force) {
+  if (cache_directory_.empty()) {
+    return nullptr;
+  }
+
+  std::string server_uuid;
+
+  try {
+    const auto result = session->query("SELECT @@server_uuid");
+    const auto row = result->fetch_one();
+
+    if (row && !row->is_null(0)) {
+      server_uuid = row->get_string(0);
     }
+  } catch (const std::exception &e) {
+    log_info("Unable to get the server UUID, names are not cached: %s",
+             e.what());
+  }
 
-    // fetch column names for each table
-    for (const std::string &t : *table_names) {
-      if (cancelled_) break;
-      std::vector<std::string> column_names;
-      auto res = session->raw_execute_sql(
-          shcore::sqlstring("show columns from !.!", 0) << current_schema << t);
-      auto row = res->call("fetchOne", shcore::Argument_list());
-      while (row && !cancelled_) {
-        std::string column =
-            row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-        // FIXME add quoting
-        object_names_.push_back(column);
-        object_dot_names_.push_back(t + "." + column);
-        row = res->call("fetchOne", shcore::Argument_list());
+  if (server_uuid.empty()) {
+    return nullptr;
+  }
+
+  const auto cached = std::make_shared<Cached_names>(
+      Name_cache(cache_directory_, server_uuid));
+
+  // cached names are used right away, until they are verified
+  if (schemas && cached->cache.load_schemas(&cached->schemas)) {
+    names_->set_schemas(generation, std::vector<std::string>(cached->schemas));
+  }
+
+  if (!schema.empty() && cached->cache.load_tables(schema, &cached->tables)) {
+    names_->set_objects(generation, cached->tables);
+
+    if (force) {
+      // nothing is reused, all tables are going to be fetched
+      cached->tables.clear();
+    }
+  }
+
+  return cached;
+}
+
+void Provider_sql::fetch_names(mysqlshdk::db::ISession *session, bool schemas,
+                               const std::string &schema, Cached_names *cached,
+                               Names *names, uint64_t generation) {
+  const auto save = [](const std::function<void()> &f) {
+    try {
+      f();
+    } catch (const std::exception &e) {
+      log_warning("Unable to cache auto-completion names: %s", e.what());
+    }
+  };
+
+  if (schemas) {
+    std::vector<std::string> schema_names;
+    const auto result =
+        session->query("SELECT SCHEMA_NAME FROM information_schema.schemata");
+
+    while (const auto row = result->fetch_one()) {
+      if (!names->is_current(generation)) return;
+      schema_names.emplace_back(row->get_string(0));
+    }
+
+    if (cached && cached->schemas != schema_names) {
+      save([cached, &schema_names]() {
+        cached->cache.save_schemas(schema_names);
+      });
+    }
+
+    if (!names->set_schemas(generation, std::move(schema_names))) return;
+  }
+
+  if (!schema.empty()) {
+    Name_cache::Tables tables;
+    // tables which are new or were modified since they were cached
+    std::vector<std::string> changed;
+
+    {
+      const auto result = session->query(
+          shcore::sqlstring("SELECT TABLE_NAME, CREATE_TIME, UPDATE_TIME "
+                            "FROM information_schema.tables "
+                            "WHERE TABLE_SCHEMA = ?",
+                            0)
+          << schema);
+
+      while (const auto row = result->fetch_one()) {
+        if (!names->is_current(generation)) return;
+
+        auto name = row->get_string(0);
+        Name_cache::Table table;
+        table.create_time = row->get_as_string(1, "");
+        table.update_time = row->get_as_string(2, "");
+
+        Name_cache::Table *old = nullptr;
+
+        if (cached) {
+          const auto it = cached->tables.find(name);
+
+          if (cached->tables.end() != it) {
+            old = &it->second;
+          }
+        }
+
+        // views may not have the creation time, they are always fetched
+        if (old && !table.create_time.empty() &&
+            old->create_time == table.create_time &&
+            old->update_time == table.update_time) {
+          table.columns = std::move(old->columns);
+        } else {
+          changed.emplace_back(name);
+        }
+
+        tables.emplace(std::move(name), std::move(table));
+      }
+    }
+
+    // table names (and unchanged columns) can be used while columns are being
+    // fetched
+    if (!names->set_objects(generation, tables)) return;
+
+    const bool modified =
+        !changed.empty() ||
+        (cached && cached->tables.size() != tables.size());
+
+    if (!changed.empty()) {
+      shcore::sqlstring query(
+          "SELECT TABLE_NAME, COLUMN_NAME FROM information_schema.columns "
+          "WHERE TABLE_SCHEMA = ?",
+          0);
+      query << schema;
+      std::string sql = query.str();
+
+      if (changed.size() < tables.size()) {
+        sql += " AND TABLE_NAME IN (";
+
+        for (const auto &table : changed) {
+          sql += (shcore::sqlstring("?", 0) << table).str();
+          sql += ',';
+        }
+
+        sql.back() = ')';
       }
+
+      const auto result = session->query(sql);
+
+      while (const auto row = result->fetch_one()) {
+        if (!names->is_current(generation)) return;
+
+        const auto table = tables.find(row->get_string(0));
+
+        // table could have been created after the list was fetched
+        if (tables.end() != table) {
+          table->second.columns.emplace_back(row->get_string(1));
+        }
+      }
+
+      if (!names->set_objects(generation, tables)) return;
+    }
+
+    if (cached && modified) {
+      save([cached, &schema, &tables]() {
+        cached->cache.save_tables(schema, tables);
+      });
+    }
+  }
+}
+
+uint64_t Provider_sql::Names::start(bool clear_objects) {
+  std::map<uint64_t, std::function<void()>> outdated;
+  uint64_t gen;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (clear_objects) {
+      objects = std::make_shared<const Sorted_names>();
+      object_dots = std::make_shared<const Sorted_names>();
     }
-    std::sort(object_names_.begin(), object_names_.end(),
-              [](const std::string &a, const std::string &b) -> bool {
-                return shcore::str_casecmp(a, b) < 0;
-              });
-    auto last = std::unique(object_names_.begin(), object_names_.end());
-    object_names_.erase(last, object_names_.end());
-
-    std::sort(object_dot_names_.begin(), object_dot_names_.end(),
-              [](const std::string &a, const std::string &b) -> bool {
-                return shcore::str_casecmp(a, b) < 0;
-              });
-    last = std::unique(object_dot_names_.begin(), object_dot_names_.end());
-    object_dot_names_.erase(last, object_dot_names_.end());
+
+    gen = ++generation;
+    outdated.swap(connections_);
   }
+
+  kill_connections(std::move(outdated));
+
+  return gen;
+}
+
+void Provider_sql::Names::cancel() {
+  std::map<uint64_t, std::function<void()>> outdated;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = ++generation;
+    outdated.swap(connections_);
+  }
+
+  finished_cv.notify_all();
+  kill_connections(std::move(outdated));
+}
+
+void Provider_sql::Names::finish(uint64_t gen) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = std::max(finished, gen);
+  }
+
+  finished_cv.notify_all();
+}
+
+void Provider_sql::Names::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  finished_cv.wait(lock, [this]() { return finished >= generation; });
+}
+
+void Provider_sql::Names::run(std::function<void()> f) {
+  std::list<Worker> done;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto it = workers_.begin(); it != workers_.end();) {
+      const auto current = it++;
+
+      if (current->finished) {
+        done.splice(done.end(), workers_, current);
+      }
+    }
+
+    // worker is added before the thread is started, so that it can be marked
+    // as finished
+    const auto worker = workers_.emplace(workers_.end());
+    worker->thread = std::thread([this, worker, f]() {
+      f();
+
+      std::lock_guard<std::mutex> l(mutex);
+      worker->finished = true;
+    });
+  }
+
+  for (auto &worker : done) {
+    worker.thread.join();
+  }
+}
+
+void Provider_sql::Names::join() {
+  while (true) {
+    std::list<Worker> running;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running.swap(workers_);
+    }
+
+    if (running.empty()) {
+      break;
+    }
+
+    for (auto &worker : running) {
+      worker.thread.join();
+    }
+  }
+}
+
+bool Provider_sql::Names::add_connection(uint64_t gen,
+                                         std::function<void()> kill) {
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!is_current(gen)) {
+    return false;
+  }
+
+  connections_[gen] = std::move(kill);
+  return true;
+}
+
+void Provider_sql::Names::remove_connection(uint64_t gen) {
+  std::lock_guard<std::mutex> lock(mutex);
+  connections_.erase(gen);
+}
+
+void Provider_sql::Names::kill_connections(
+    std::map<uint64_t, std::function<void()>> &&kill) {
+  for (auto &connection : kill) {
+    run(std::move(connection.second));
+  }
+}
+
+bool Provider_sql::Names::set_schemas(uint64_t gen,
+                                      std::vector<std::string> &&names) {
+  // names are sorted before the lock is acquired
+  auto sorted = std::make_shared<const Sorted_names>(std::move(names));
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!is_current(gen)) {
+    return false;
+  }
+
+  schemas = std::move(sorted);
+  return true;
+}
+
+bool Provider_sql::Names::set_objects(uint64_t gen,
+                                      const Name_cache::Tables &tables) {
+  std::vector<std::string> names;
+  std::vector<std::string> dot_names;
+
+  for (const auto &table : tables) {
+    names.emplace_back(table.first);
+
+    for (const auto &column : table.second.columns) {
+      // FIXME add quoting
+      dot_names.emplace_back(table.first + "." + column);
+      names.emplace_back(column);
+    }
+  }
+
+  auto sorted = std::make_shared<const Sorted_names>(std::move(names));
+  auto sorted_dots = std::make_shared<const Sorted_names>(std::move(dot_names));
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!is_current(gen)) {
+    return false;
+  }
+
+  objects = std::move(sorted);
+  object_dots = std::move(sorted_dots);
+  return true;
 }
 
 namespace {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2017, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,44 +24,267 @@
 #ifndef MYSQLSHDK_SHELLCORE_PROVIDER_SQL_H_
 #define MYSQLSHDK_SHELLCORE_PROVIDER_SQL_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "mysqlshdk/libs/db/session.h"
+#include "mysqlshdk/shellcore/name_cache.h"
 #include "shellcore/base_session.h"
 #include "shellcore/completer.h"
 
 namespace shcore {
 namespace completer {
 
+/**
+ * Immutable list of names, sorted case-insensitively. Names are stored in a
+ * single buffer, lookups are narrowed down using an index of their first
+ * characters.
+ */
+class Sorted_names final {
+ public:
+  Sorted_names() = default;
+
+  explicit Sorted_names(std::vector<std::string> &&names);
+
+  size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+  bool empty() const { return 0 == size(); }
+
+  /**
+   * Appends all names which start with the given prefix, comparison is
+   * case-insensitive.
+   *
+   * @param prefix Prefix to look for.
+   * @param back_quote If true, names are quoted.
+   * @param out_list Receives the matching names.
+   */
+  void add_matches(const std::string &prefix, bool back_quote,
+                   Completion_list *out_list) const;
+
+ private:
+  const char *name(size_t i) const { return names_.data() + offsets_[i]; }
+
+  size_t length(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+  // all names, one after another
+  std::string names_;
+  // offsets of the names, followed by size of the buffer
+  std::vector<uint32_t> offsets_;
+  // index_[c] is the position of the first name whose lowercase first
+  // character is not less than c
+  std::vector<uint32_t> index_;
+};
+
 class Provider_sql : public Provider {
  public:
+  Provider_sql();
+
+  Provider_sql(const Provider_sql &) = delete;
+  Provider_sql(Provider_sql &&) = delete;
+
+  Provider_sql &operator=(const Provider_sql &) = delete;
+  Provider_sql &operator=(Provider_sql &&) = delete;
+
+  ~Provider_sql() override;
+
   Completion_list complete(const std::string &text,
                            size_t *compl_offset) override;
 
+  /**
+   * Starts fetching the schema names in the background, using a separate
+   * connection. Completion uses the old names until new ones are available.
+   *
+   * Names cached on disk are used right away, unless force is set.
+   */
   virtual void refresh_schema_cache(
-      std::shared_ptr<mysqlsh::ShellBaseSession> session);
+      std::shared_ptr<mysqlsh::ShellBaseSession> session, bool force = false);
 
-  // void refresh_name_cache(std::shared_ptr<mysqlshdk::db::ISession> session,
-  //                         const std::string &current_schema,
-  //                         const std::vector<std::string> *table_names,
-  //                         bool rehash_all);
+  /**
+   * Starts fetching the table and column names of the given schema in the
+   * background, using a separate connection. Names of the previous schema are
+   * discarded right away, table names become available before the column
+   * names.
+   *
+   * Names cached on disk are used right away, then columns are fetched only
+   * for the tables whose creation or update time has changed. If force is
+   * set, all names are fetched again.
+   */
   virtual void refresh_name_cache(
       std::shared_ptr<mysqlsh::ShellBaseSession> session,
-      const std::string &current_schema,
-      const std::vector<std::string> *table_names, bool rehash_all);
+      const std::string &current_schema, bool rehash_all, bool force = false);
+
+  /**
+   * Sets the directory where names are cached between the sessions, an empty
+   * string disables the cache.
+   */
+  void set_cache_directory(const std::string &directory) {
+    cache_directory_ = directory;
+  }
 
+  /**
+   * Stops the background refresh, names which were not fetched yet are not
+   * going to be available. Does not wait for the background thread, its
+   * results are discarded and its connection is killed.
+   */
   void interrupt_rehash();
 
+  /**
+   * Blocks until the background refresh is finished.
+   */
+  void wait_for_rehash();
+
   Completion_list complete_schema(const std::string &prefix);
 
  private:
+  /**
+   * Names read from the disk cache, used to find out what has changed.
+   */
+  struct Cached_names {
+    explicit Cached_names(Name_cache &&c) : cache(std::move(c)) {}
+
+    Name_cache cache;
+    std::vector<std::string> schemas;
+    Name_cache::Tables tables;
+  };
+
+  /**
+   * Names used by the completion. They are shared with the background
+   * threads, which are not waited for when the refresh is cancelled, they are
+   * joined when the provider is destroyed.
+   */
+  struct Names {
+    /**
+     * Starts a new refresh, names fetched by the previous ones are not going
+     * to be published anymore and their connections are killed.
+     *
+     * @param clear_objects If true, table and column names are discarded.
+     *
+     * @returns generation of the new refresh
+     */
+    uint64_t start(bool clear_objects);
+
+    /**
+     * Cancels the current refresh, its connection is killed in a background
+     * thread.
+     */
+    void cancel();
+
+    /**
+     * Marks the refresh with the given generation as finished.
+     */
+    void finish(uint64_t gen);
+
+    /**
+     * Blocks until the current refresh is finished.
+     */
+    void wait();
+
+    bool is_current(uint64_t gen) const { return gen == generation; }
+
+    /**
+     * Runs the function in a background thread. Threads which have already
+     * finished are joined right away, the remaining ones are joined by
+     * join().
+     */
+    void run(std::function<void()> f);
+
+    /**
+     * Joins all the background threads, has to be called before the names
+     * are destroyed.
+     */
+    void join();
+
+    /**
+     * Registers the connection used by the refresh, it's killed using the
+     * given function once the refresh is cancelled or outdated.
+     *
+     * @returns false if the refresh is already outdated
+     */
+    bool add_connection(uint64_t gen, std::function<void()> kill);
+
+    /**
+     * Unregisters the connection used by the refresh.
+     */
+    void remove_connection(uint64_t gen);
+
+    /**
+     * Publishes the schema names, unless a newer refresh has been started.
+     *
+     * @returns false if the names were discarded
+     */
+    bool set_schemas(uint64_t gen, std::vector<std::string> &&names);
+
+    /**
+     * Publishes the table and column names, unless a newer refresh has been
+     * started.
+     *
+     * @returns false if the names were discarded
+     */
+    bool set_objects(uint64_t gen, const Name_cache::Tables &tables);
+
+    // guards the names, the generations, the workers and the connections
+    std::mutex mutex;
+    std::condition_variable finished_cv;
+    // generation of the current refresh, it's also read without the lock to
+    // stop the outdated refresh early
+    std::atomic<uint64_t> generation{0};
+    // the most recent generation which is finished
+    uint64_t finished = 0;
+    std::shared_ptr<const Sorted_names> schemas =
+        std::make_shared<const Sorted_names>();
+    std::shared_ptr<const Sorted_names> objects =
+        std::make_shared<const Sorted_names>();
+    std::shared_ptr<const Sorted_names> object_dots =
+        std::make_shared<const Sorted_names>();
+
+   private:
+    struct Worker {
+      std::thread thread;
+      bool finished = false;
+    };
+
+    void kill_connections(std::map<uint64_t, std::function<void()>> &&kill);
+
+    std::list<Worker> workers_;
+    // connections of the refreshes which are running, by generation
+    std::map<uint64_t, std::function<void()>> connections_;
+  };
+
+  void start_rehash(std::shared_ptr<mysqlsh::ShellBaseSession> session,
+                    uint64_t generation, bool schemas,
+                    const std::string &schema, bool force);
+
+  std::shared_ptr<Cached_names> load_cache(mysqlshdk::db::ISession *session,
+                                           uint64_t generation, bool schemas,
+                                           const std::string &schema,
+                                           bool force);
+
+  static void fetch_names(mysqlshdk::db::ISession *session, bool schemas,
+                          const std::string &schema, Cached_names *cached,
+                          Names *names, uint64_t generation);
+
   std::string default_schema_;
-  std::vector<std::string> schema_names_;
-  std::vector<std::string> object_names_;
-  std::vector<std::string> object_dot_names_;
-  bool cancelled_;
+  std::string cache_directory_;
+
+  std::shared_ptr<Names> names_ = std::make_shared<Names>();
+
+#ifdef FRIEND_TEST
+  FRIEND_TEST(Provider_sql_test, outdated_names);
+  FRIEND_TEST(Provider_sql_test, join_threads);
+  FRIEND_TEST(Provider_sql_test, fetch_names_changed_tables);
+  FRIEND_TEST(Provider_sql_test, fetch_names_unchanged_tables);
+  FRIEND_TEST(Provider_sql_test, fetch_names_not_cached);
+#endif
 };
 
 }  // namespace completer
@@ -184,6 +184,21 @@ void log_hook(const shcore::Logger::Log_entry &log, void *data) {
     }
   }
 }
+
+shcore::Logger::LOG_LEVEL verbose_log_level(int verbose) {
+  switch (verbose) {
+    case 0:
+      return shcore::Logger::LOG_NONE;
+    case 1:
+      return shcore::Logger::LOG_INFO;
+    case 2:
+      return shcore::Logger::LOG_DEBUG;
+    case 3:
+      return shcore::Logger::LOG_DEBUG2;
+    default:
+      return shcore::Logger::LOG_DEBUG3;
+  }
+}
 }  // namespace
 
 Shell_console::Shell_console(shcore::Interpreter_delegate *deleg)
@@ -191,12 +206,21 @@ Shell_console::Shell_console(shcore::Interpreter_delegate *deleg)
   m_print_handlers.emplace_back(deleg);
   // Capture logging output and if verbose is enabled, show them in the console
   shcore::Logger::singleton()->attach_log_hook(log_hook, this, true);
+  shcore::Logger::singleton()->set_log_hook_level(log_hook,
+                                                  verbose_log_level(m_verbose));
 }
 
 Shell_console::~Shell_console() {
   shcore::Logger::singleton()->detach_log_hook(log_hook);
 }
 
+void Shell_console::set_verbose(int level) {
+  IConsole::set_verbose(level);
+  // entries which are not going to be displayed are not formatted
+  shcore::Logger::singleton()->set_log_hook_level(log_hook,
+                                                  verbose_log_level(level));
+}
+
 void Shell_console::dump_json(const char *tag, const std::string &s) const {
   delegate_print(json_obj(tag, s).c_str());
 }
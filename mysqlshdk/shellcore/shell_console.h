@@ -146,6 +146,8 @@ class Shell_console : public IConsole {
 
   void remove_print_handler(shcore::Interpreter_print_handler *) override;
 
+  void set_verbose(int level) override;
+
  private:
   void dump_json(const char *tag, const std::string &s) const;
 
@@ -380,6 +380,21 @@ Shell_options::Shell_options(int argc, char **argv,
         "Display column type information in SQL mode. Please be aware that "
         "output may depend on the protocol you are using to connect to the "
         "server, e.g. DbType field is approximated when using X protocol.")
+    (&storage.sql_batch_size, 0, SHCORE_SQL_BATCH_SIZE,
+        "Maximum number of consecutive INSERT, REPLACE, UPDATE and DELETE "
+        "statements sent to the server in a single packet when executing a "
+        "SQL script using a classic session. Values lower than 2 disable "
+        "batching.",
+        shcore::opts::Range<int>(0, std::numeric_limits<int>::max()))
+    (&storage.table_sample_rows, 0, SHCORE_TABLE_SAMPLE_ROWS,
+        "Number of rows used to compute column widths of the table output "
+        "format, remaining rows are streamed without being buffered. 0 means "
+        "all rows are buffered.",
+        shcore::opts::Range<int>(0, std::numeric_limits<int>::max()))
+    (&storage.table_max_sample_size, 0, SHCORE_TABLE_MAX_SAMPLE_SIZE,
+        "Maximum size in bytes of the rows used to compute column widths of "
+        "the table output format. 0 means no limit.",
+        shcore::opts::Range<int>(0, std::numeric_limits<int>::max()))
     (&storage.history_max_size, 1000, SHCORE_HISTORY_MAX_SIZE,
         "Shell's history maximum size",
         shcore::opts::Range<int>(0, std::numeric_limits<int>::max()))
@@ -32,6 +32,7 @@
 #include "mysqlshdk/include/shellcore/base_shell.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/row_copy.h"
 #include "mysqlshdk/libs/utils/dtoa.h"
 #include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_json.h"
@@ -381,6 +382,7 @@ class Field_formatter {
   const char *c_str() const { return m_buffer.get(); }
   size_t get_max_display_length() const { return m_max_display_length; }
   size_t get_max_buffer_length() const { return m_max_buffer_length; }
+  size_t get_last_buffer_length() const { return m_buffer_lengths.back(); }
 
  private:
   std::unique_ptr<char[]> m_buffer;
@@ -402,18 +404,20 @@ class Field_formatter {
   bool m_is_numeric;
 
   void reset() {
-    // sets the buffer only once
-    if (!m_buffer) {
-      if (m_format == ResultFormat::TABLE) {
-        m_allocated = std::max<size_t>(m_max_display_length,
-                                       m_max_buffer_length + m_max_mb_holes) +
-                      1;
-
-        if (m_allocated > MAX_DISPLAY_LENGTH) m_allocated = MAX_DISPLAY_LENGTH;
-      } else {
-        m_allocated = MAX_DISPLAY_LENGTH;
-      }
+    size_t required = MAX_DISPLAY_LENGTH;
+
+    if (m_format == ResultFormat::TABLE) {
+      required = std::max<size_t>(m_max_display_length,
+                                  m_max_buffer_length + m_max_mb_holes) +
+                 1;
+
+      if (required > MAX_DISPLAY_LENGTH) required = MAX_DISPLAY_LENGTH;
+    }
 
+    // sets the buffer only once, unless column got wider since then, which
+    // happens when table rows are streamed
+    if (!m_buffer || required > m_allocated) {
+      m_allocated = required;
       m_buffer.reset(new char[m_allocated]);
     }
 
@@ -546,7 +550,11 @@ Resultset_dumper::Resultset_dumper(mysqlshdk::db::IResult *target,
                             wrap_json, format),
       m_show_warnings(show_warnings),
       m_show_stats(show_stats),
-      m_buffer_data(buffer_data) {}
+      m_buffer_data(buffer_data) {
+  const auto &options = mysqlsh::current_shell_options()->get();
+  m_table_sample_rows = options.table_sample_rows;
+  m_table_max_sample_size = options.table_max_sample_size;
+}
 
 size_t Resultset_dumper::dump(const std::string &item_label, bool is_query,
                               bool is_doc_result) {
@@ -572,8 +580,10 @@ size_t Resultset_dumper::dump(const std::string &item_label, bool is_query,
 
       if (m_result->has_resultset()) {
         // Data requires to be buffered on table format because it will be
-        // traversed once for proper formatting and once for printing it
-        if (m_buffer_data || m_format == "table") m_result->buffer();
+        // traversed once for proper formatting and once for printing it,
+        // unless column widths are computed using just a sample of rows
+        if (m_buffer_data || (m_format == "table" && !is_table_sampled()))
+          m_result->buffer();
 
         if (is_doc_result || m_format.find("json") != std::string::npos)
           count = dump_documents(is_doc_result);
@@ -919,68 +929,127 @@ size_t Resultset_dumper_base::dump_table() {
     fmt.emplace_back(ResultFormat::TABLE, column);
   }
 
-  std::vector<const mysqlshdk::db::IRow *> records;
+  // If sampling is enabled, column widths are computed using only the first
+  // rows, these are copied and the remaining ones are printed as soon as they
+  // are fetched, otherwise all rows are traversed twice
+  const bool sampled = is_table_sampled();
+  std::vector<mysqlshdk::db::Row_copy> sample;
+  size_t sample_size = 0;
+  size_t row_count = 0;
+
   auto row = m_result->fetch_one();
   while (row && !m_cancelled) {
-    records.push_back(row);
     for (size_t field_index = 0; field_index < field_count; field_index++) {
       fmt[field_index].process(row, field_index);
+      sample_size += fmt[field_index].get_last_buffer_length();
+    }
+
+    ++row_count;
+
+    if (sampled) {
+      sample.emplace_back(*row);
+
+      if ((m_table_sample_rows > 0 && row_count >= m_table_sample_rows) ||
+          (m_table_max_sample_size > 0 &&
+           sample_size >= m_table_max_sample_size)) {
+        break;
+      }
     }
+
     row = m_result->fetch_one();
   }
 
-  m_result->rewind();
+  if (!sampled) m_result->rewind();
 
-  if (m_cancelled || records.empty()) return 0;
+  if (m_cancelled || row_count == 0) return 0;
 
   //-----------
 
-  size_t index = 0;
+  std::string separator;
 
-  std::string separator("+");
-  for (index = 0; index < field_count; index++) {
-    std::string field_separator(fmt[index].get_max_display_length() + 2, '-');
-    field_separator.append("+");
-    separator.append(field_separator);
-  }
-  separator.append("\n");
+  const auto print_header = [&]() {
+    // closes the rows printed using the previous column widths
+    if (!separator.empty()) m_printer->print(separator);
 
-  // Prints the initial separator line and the column headers
-  m_printer->print(separator);
-  m_printer->print("| ");
-  for (index = 0; index < field_count; index++) {
-    std::string format = "%-";
-    format.append(std::to_string(fmt[index].get_max_display_length()));
-    format.append((index == field_count - 1) ? "s |\n" : "s | ");
-    auto column = metadata[index];
-    m_printer->print(
-        shcore::str_format(format.c_str(), column.get_column_label().c_str()));
-  }
-  m_printer->print(separator);
+    separator = "+";
+    for (size_t index = 0; index < field_count; index++) {
+      separator.append(fmt[index].get_max_display_length() + 2, '-');
+      separator.append("+");
+    }
+    separator.append("\n");
 
-  // Now prints the records
-  row = m_result->fetch_one();
-  while (row && !m_cancelled) {
+    // Prints the initial separator line and the column headers
+    m_printer->print(separator);
+    m_printer->print("| ");
+    for (size_t index = 0; index < field_count; index++) {
+      std::string format = "%-";
+      format.append(std::to_string(fmt[index].get_max_display_length()));
+      format.append((index == field_count - 1) ? "s |\n" : "s | ");
+      auto column = metadata[index];
+      m_printer->print(shcore::str_format(format.c_str(),
+                                          column.get_column_label().c_str()));
+    }
+    m_printer->print(separator);
+  };
+
+  const auto print_row = [&](const mysqlshdk::db::IRow *record) {
     m_printer->print("| ");
 
     for (size_t field_index = 0; field_index < field_count; field_index++) {
-      if (fmt[field_index].put(row, field_index)) {
+      if (fmt[field_index].put(record, field_index)) {
         m_printer->print(fmt[field_index].c_str());
       } else {
         assert(mysqlshdk::db::is_string_type(metadata[field_index].get_type()));
-        m_printer->print(row->get_as_string(field_index));
+        m_printer->print(record->get_as_string(field_index));
       }
       if (field_index < field_count - 1) m_printer->print(" | ");
     }
     m_printer->print(" |\n");
+  };
+
+  print_header();
+
+  if (sampled) {
+    for (const auto &record : sample) {
+      if (m_cancelled) break;
+      print_row(&record);
+    }
+
+    sample.clear();
+    sample.shrink_to_fit();
+
+    // Now streams the remaining records, if a value does not fit into its
+    // column, header is printed again using the new widths
+    row = m_cancelled ? nullptr : m_result->fetch_one();
+    while (row && !m_cancelled) {
+      bool widened = false;
+
+      for (size_t field_index = 0; field_index < field_count; field_index++) {
+        const auto width = fmt[field_index].get_max_display_length();
+        fmt[field_index].process(row, field_index);
+        widened |= width != fmt[field_index].get_max_display_length();
+      }
+
+      if (widened) print_header();
+
+      print_row(row);
+      ++row_count;
+      row = m_result->fetch_one();
+    }
+  } else {
+    // Now prints the records
     row = m_result->fetch_one();
-  }
+    while (row && !m_cancelled) {
+      print_row(row);
+      row = m_result->fetch_one();
+    }
 
-  m_result->rewind();
+    m_result->rewind();
+  }
 
   m_printer->print(separator.c_str());
 
-  return records.size();
+  return row_count;
 }
 
 std::string Resultset_dumper::get_affected_stats(
@@ -28,6 +28,7 @@
 #include <functional>
 #include "modules/devapi/mod_mysqlx_session.h"
 #include "modules/mod_mysql_session.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/include/shellcore/utils_help.h"
 #include "mysqlshdk/libs/utils/profiling.h"
@@ -62,6 +63,10 @@ namespace shcore {
 // How many bytes at a time to process when executing large SQL scripts
 static constexpr auto k_sql_chunk_size = 64 * 1024;
 
+// Maximum size of the statements sent in a single packet, needs to be lower
+// than the default value of max_allowed_packet
+static constexpr size_t k_max_sql_batch_size = 1024 * 1024;
+
 Shell_sql::Context::Context(Shell_sql *parent)
     : splitter(
           [parent](const char *s, size_t len, bool bol, size_t /*lnum*/) {
@@ -197,6 +202,94 @@ bool Shell_sql::process_sql(const char *query_str, size_t query_len,
   return ret_val;
 }
 
+namespace {
+
+/**
+ * Statements which can be sent to the server together with other statements:
+ * they don't return a result set and don't modify the session state which is
+ * tracked by the shell.
+ */
+bool is_batchable(const std::string &sql) {
+  mysqlshdk::utils::SQL_string_iterator it(sql);
+  const auto keyword = shcore::str_upper(it.get_next_sql_token());
+
+  return keyword == "INSERT" || keyword == "REPLACE" || keyword == "UPDATE" ||
+         keyword == "DELETE";
+}
+
+}  // namespace
+
+bool Shell_sql::process_batch(
+    Sql_batch *batch, const std::shared_ptr<mysqlshdk::db::ISession> &session) {
+  const auto classic =
+      std::static_pointer_cast<mysqlshdk::db::mysql::Session>(session);
+  bool ret_val = true;
+
+  while (!batch->statements.empty()) {
+    std::vector<std::shared_ptr<mysqlshdk::db::IResult>> results;
+    std::unique_ptr<shcore::Exception> error;
+    mysqlshdk::utils::Profile_timer timer;
+    timer.stage_begin("batch");
+
+    // Install kill query as ^C handler
+    uint64_t conn_id = session->get_connection_id();
+    const auto &conn_opts = session->get_connection_options();
+    Interrupts::push_handler([this, conn_id, conn_opts]() {
+      kill_query(conn_id, conn_opts);
+      return true;
+    });
+
+    try {
+      classic->execute_batch(batch->statements, &results);
+    } catch (const mysqlshdk::db::Error &e) {
+      error = shcore::make_unique<shcore::Exception>(
+          shcore::Exception::mysql_error_with_code_and_state(
+              e.what(), e.code(), e.sqlstate()));
+      error->set_file_context("", batch->context[results.size()].second);
+    } catch (...) {
+      Interrupts::pop_handler();
+      *batch = Sql_batch();
+      throw;
+    }
+
+    Interrupts::pop_handler();
+    timer.stage_end();
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      Sql_result_info info;
+      // execution time of the whole batch is reported by its last statement
+      if (!error && i + 1 == results.size())
+        info.ellapsed_seconds = timer.total_seconds_ellapsed();
+
+      _result_processor(results[i], info);
+    }
+
+    size_t processed = results.size();
+
+    if (error) {
+      print_exception(*error);
+      ret_val = false;
+      ++processed;
+    }
+
+    for (size_t i = 0; i < processed; ++i) {
+      _last_handled.append(batch->statements[i])
+          .append(batch->context[i].first);
+    }
+
+    if (error && !mysqlsh::current_shell_options()->get().force) break;
+
+    batch->statements.erase(batch->statements.begin(),
+                            batch->statements.begin() + processed);
+    batch->context.erase(batch->context.begin(),
+                         batch->context.begin() + processed);
+  }
+
+  *batch = Sql_batch();
+
+  return ret_val;
+}
+
 bool Shell_sql::handle_input_stream(std::istream *istream) {
   std::shared_ptr<mysqlshdk::db::ISession> session;
   {
@@ -207,21 +300,73 @@ bool Shell_sql::handle_input_stream(std::istream *istream) {
       session = s->get_core_session();
   }
 
+  // Statements are batched only if their warnings are not going to be
+  // displayed, as these are not available for the batched statements.
+  size_t batch_size = 0;
+
+  if (std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(session)) {
+    const auto &options = mysqlsh::current_shell_options()->get();
+
+    if (options.sql_batch_size > 1 && options.wrap_json == "off" &&
+        !(options.interactive && options.show_warnings)) {
+      batch_size = options.sql_batch_size;
+    }
+  }
+
+  Sql_batch batch;
   mysqlshdk::utils::Sql_splitter *splitter = nullptr;
-  if (!mysqlshdk::utils::iterate_sql_stream(
-          istream, k_sql_chunk_size,
-          [&](const char *s, size_t len, const std::string &delim,
-              size_t lnum) {
-            if (len > 0 &&
-                !process_sql(s, len, delim, lnum, session, splitter)) {
-              if (!mysqlsh::current_shell_options()->get().force) return false;
+  bool ret_val = mysqlshdk::utils::iterate_sql_stream(
+      istream, k_sql_chunk_size,
+      [&](const char *s, size_t len, const std::string &delim, size_t lnum) {
+        if (len == 0) return true;
+
+        bool ok = true;
+
+        if (batch_size > 0) {
+          std::string sql(s, len);
+
+          // batch is sent as a multi-statement, statements terminated by a
+          // custom delimiter may contain ';', \\G needs its own output
+          if (delim == ";" && is_batchable(sql)) {
+            batch.bytes += len;
+            batch.statements.emplace_back(std::move(sql));
+            batch.context.emplace_back(delim, lnum);
+
+            if (batch.statements.size() < batch_size &&
+                batch.bytes < k_max_sql_batch_size) {
+              return true;
             }
-            return true;
-          },
-          [](const std::string &err) {
-            mysqlsh::current_console()->print_error(err);
-          },
-          ansi_quotes_enabled(session), nullptr, &splitter)) {
+
+            ok = process_batch(&batch, session);
+          } else {
+            // statements are executed in order
+            ok = process_batch(&batch, session);
+
+            if (ok || mysqlsh::current_shell_options()->get().force) {
+              ok = process_sql(s, len, delim, lnum, session, splitter);
+            }
+          }
+        } else {
+          ok = process_sql(s, len, delim, lnum, session, splitter);
+        }
+
+        if (!ok) {
+          if (!mysqlsh::current_shell_options()->get().force) return false;
+        }
+        return true;
+      },
+      [](const std::string &err) {
+        mysqlsh::current_console()->print_error(err);
+      },
+      ansi_quotes_enabled(session), nullptr, &splitter);
+
+  // execute the remaining statements
+  if (!process_batch(&batch, session) &&
+      !mysqlsh::current_shell_options()->get().force) {
+    ret_val = false;
+  }
+
+  if (!ret_val) {
     // signal error during input processing
     _result_processor(nullptr, {});
     return false;
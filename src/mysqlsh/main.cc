@@ -672,6 +672,8 @@ int main(int argc, char **argv) {
         shcore::path::join_path(shcore::get_user_config_path(), "mysqlsh.log");
     shcore::Logger::setup_instance(log_path.c_str(), options.log_to_stderr,
                                    options.log_level);
+    // log file is written in background, errors are written immediately
+    shcore::Logger::singleton()->set_async(true);
   }
 
   std::shared_ptr<mysqlsh::Command_line_shell> shell;
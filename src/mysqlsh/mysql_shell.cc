@@ -964,10 +964,7 @@ std::shared_ptr<mysqlsh::ShellBaseSession> Mysql_shell::set_active_session(
   if (options().interactive && !get_options()->get_shell_cli_operation()) {
     // Always refresh schema name completion cache because it can be used in
     // \use in any mode
-    refresh_schema_completion();
-    if (_shell->interactive_mode() == shcore::Shell_core::Mode::SQL) {
-      refresh_completion();
-    }
+    refresh_completion(false, true);
   }
 
   return new_session;
@@ -1388,8 +1385,7 @@ bool Mysql_shell::cmd_use(const std::vector<std::string> &args) {
 
 bool Mysql_shell::cmd_rehash(const std::vector<std::string> &args) {
   if (_shell->get_dev_session()) {
-    refresh_schema_completion(true);
-    refresh_completion(true);
+    refresh_completion(true, true);
 
     shcore::Value vdb(_shell->get_global("db"));
     if (vdb) {
@@ -1404,27 +1400,7 @@ bool Mysql_shell::cmd_rehash(const std::vector<std::string> &args) {
   return true;
 }
 
-void Mysql_shell::refresh_schema_completion(bool force) {
-  if (options().db_name_cache || force) {
-    std::shared_ptr<mysqlsh::ShellBaseSession> session(
-        _shell->get_dev_session());
-    if (session && _provider_sql) {
-      println(
-          "Fetching schema names for autocompletion... "
-          "Press ^C to stop.");
-      try {
-        _provider_sql->refresh_schema_cache(session);
-      } catch (const std::exception &e) {
-        print_diag(
-            shcore::str_format(
-                "Error during auto-completion cache update: %s\n", e.what())
-                .c_str());
-      }
-    }
-  }
-}
-
-void Mysql_shell::refresh_completion(bool force) {
+void Mysql_shell::refresh_completion(bool force, bool schemas) {
   if (options().db_name_cache || force) {
     std::shared_ptr<mysqlsh::ShellBaseSession> session(
         _shell->get_dev_session());
@@ -1434,28 +1410,32 @@ void Mysql_shell::refresh_completion(bool force) {
           "Error during auto-completion cache update: %s\n", e.what()));
     };
 
-    if (session) {
+    if (!session || !_provider_sql) return;
+
+    // Only refresh the full DB name cache if we're in SQL mode
+    if (_shell->interactive_mode() == shcore::IShell_core::Mode::SQL) {
       try {
         current_schema = session->get_current_schema();
       } catch (const std::exception &e) {
         handle_error(e);
-        return;
+        if (!schemas) return;
       }
     }
 
-    if (session && _provider_sql && !current_schema.empty()) {
-      // Only refresh the full DB name cache if we're in SQL mode
-      if (_shell->interactive_mode() == shcore::IShell_core::Mode::SQL) {
+    if (schemas) println("Fetching schema names for autocompletion...");
+
+    try {
+      if (!current_schema.empty()) {
         println("Fetching table and column names from `" + current_schema +
-                "` for auto-completion... Press ^C to stop.");
-        try {
-          _provider_sql->refresh_name_cache(session, current_schema,
-                                            nullptr,  // &table_names,
-                                            true);
-        } catch (const std::exception &e) {
-          handle_error(e);
-        }
+                "` for auto-completion...");
+        // schema names are fetched by the same request
+        _provider_sql->refresh_name_cache(session, current_schema, true,
+                                          force);
+      } else if (schemas) {
+        _provider_sql->refresh_schema_cache(session, force);
       }
+    } catch (const std::exception &e) {
+      handle_error(e);
     }
   }
 }
@@ -109,8 +109,7 @@ class Mysql_shell : public mysqlsh::Base_shell {
 
   virtual bool do_shell_command(const std::string &command);
 
-  void refresh_completion(bool force = false);
-  void refresh_schema_completion(bool force = false);
+  void refresh_completion(bool force = false, bool schemas = false);
   void add_devapi_completions();
 
   void print_connection_message(mysqlsh::SessionType type,
@@ -29,6 +29,11 @@ try:
 except:
     from BaseHTTPServer import BaseHTTPRequestHandler, HTTPServer
 
+try:
+    from socketserver import ThreadingMixIn
+except:
+    from SocketServer import ThreadingMixIn
+
 import base64
 import json
 import os
@@ -44,6 +49,13 @@ except:
     from urlparse import parse_qsl, urlparse
 
 
+BYTES_PATTERN = bytes(bytearray(range(251)))
+
+
+class ThreadingHTTPServer(ThreadingMixIn, HTTPServer):
+    daemon_threads = True
+
+
 class TestRequestHandler(BaseHTTPRequestHandler):
     protocol_version = "HTTP/1.1"
 
@@ -52,7 +64,8 @@ class TestRequestHandler(BaseHTTPRequestHandler):
             r'^/timeout/([0-9]*\.?[0-9]*)$': self.handle_timeout,
             r'^/redirect/([1-9][0-9]*)$': self.handle_redirect,
             r'^/basic/([^/]+)/(.+)$': self.handle_basic,
-            r'^/headers?.+$': self.handle_headers
+            r'^/headers?.+$': self.handle_headers,
+            r'^/bytes/([0-9]+)$': self.handle_bytes
         }
 
         try:
@@ -108,6 +121,40 @@ class TestRequestHandler(BaseHTTPRequestHandler):
         self.reply(extra_headers=parse_qsl(urlparse(self.path).query))
         return True
 
+    def handle_bytes(self, args):
+        # serves a file of the given size, supports single range requests
+        size = int(args[0])
+        first = 0
+        last = size - 1
+        status = 200
+        m = re.match(r'^bytes=([0-9]+)-([0-9]+)$', self.getheader('Range', ''))
+
+        if m:
+            first = int(m.group(1))
+            last = min(int(m.group(2)), size - 1)
+            status = 206
+
+        if first > last:
+            self.send_response(416)
+            self.send_header('Content-Length', '0')
+            self.end_headers()
+            return True
+
+        length = last - first + 1
+        self.send_response(status)
+        self.send_header('Accept-Ranges', 'bytes')
+        self.send_header('Content-Type', 'application/octet-stream')
+        self.send_header('Content-Length', '%d' % length)
+        self.end_headers()
+
+        if self.command != 'HEAD':
+            # byte at offset i has value i % 251
+            start = first % 251
+            repeat = (start + length) // 251 + 1
+            self.wfile.write((BYTES_PATTERN * repeat)[start:start + length])
+
+        return True
+
     def invoke_handler(self):
         for path, handler in self._handlers.items():
             m = re.match(path, self.path)
@@ -178,7 +225,7 @@ def usage():
 
 
 def test_server(port):
-    server = HTTPServer(('127.0.0.1', port), TestRequestHandler)
+    server = ThreadingHTTPServer(('127.0.0.1', port), TestRequestHandler)
     ssl_dir = os.path.join(os.path.dirname(os.path.realpath(__file__)), 'ssl')
     server.socket = ssl.wrap_socket(
         server.socket,
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unittest/gtest_clean.h"
+
+#include "modules/devapi/base_resultset.h"
+#include "mysqlshdk/libs/db/mutable_result.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+
+namespace mysqlsh {
+
+using mysqlshdk::db::Mutable_result;
+using mysqlshdk::db::Type;
+
+namespace {
+
+class Test_result : public ShellBaseResult {
+ public:
+  explicit Test_result(const std::vector<std::string> &names)
+      : m_names(std::make_shared<std::vector<std::string>>(names)) {
+    std::vector<mysqlshdk::db::Column> columns;
+
+    for (const auto &name : names) {
+      columns.emplace_back(Mutable_result::make_column(name, Type::String));
+    }
+
+    m_result = shcore::make_unique<Mutable_result>(columns);
+  }
+
+  std::string class_name() const override { return "Test_result"; }
+
+  mysqlshdk::db::IResult *get_result() const override {
+    return m_result.get();
+  }
+
+  std::shared_ptr<std::vector<std::string>> get_column_names() const override {
+    return m_names;
+  }
+
+  Mutable_result *result() { return m_result.get(); }
+
+ private:
+  std::shared_ptr<std::vector<std::string>> m_names;
+  std::unique_ptr<Mutable_result> m_result;
+};
+
+size_t npos() { return Row_members::npos; }
+
+shcore::Argument_list args(const std::string &field) {
+  shcore::Argument_list list;
+  list.push_back(shcore::Value(field));
+  return list;
+}
+
+}  // namespace
+
+TEST(Row_members, columns) {
+  const Row_members members{std::make_shared<std::vector<std::string>>(
+      std::vector<std::string>{"id", "first name", "firstName", "id",
+                               "length", "getField", "get_field", "1st",
+                               "lastName", "last_name"})};
+
+  EXPECT_EQ(0u, members.column("id"));
+  EXPECT_EQ(1u, members.column("first name"));
+  EXPECT_EQ(4u, members.column("length"));
+  EXPECT_EQ(npos(), members.column("ID"));
+  EXPECT_EQ(npos(), members.column("missing"));
+
+  // not valid identifiers
+  EXPECT_EQ(npos(), members.property("first name", shcore::LowerCamelCase));
+  EXPECT_EQ(npos(), members.property("1st", shcore::LowerCamelCase));
+  // members of the Row object
+  EXPECT_EQ(npos(), members.property("length", shcore::LowerCamelCase));
+  EXPECT_EQ(npos(), members.property("getField", shcore::LowerCamelCase));
+  EXPECT_EQ(npos(),
+            members.property("get_field", shcore::LowerCaseUnderscores));
+
+  EXPECT_EQ(0u, members.property("id", shcore::LowerCamelCase));
+  EXPECT_EQ(2u, members.property("firstName", shcore::LowerCamelCase));
+  EXPECT_EQ(2u, members.property("first_name", shcore::LowerCaseUnderscores));
+  EXPECT_EQ(6u, members.property("get_field", shcore::LowerCamelCase));
+  // first property wins if names clash
+  EXPECT_EQ(8u, members.property("last_name", shcore::LowerCaseUnderscores));
+  EXPECT_EQ(9u, members.property("last_name", shcore::LowerCamelCase));
+
+  std::vector<std::string> properties;
+  members.append_properties(shcore::LowerCaseUnderscores, &properties);
+  EXPECT_EQ((std::vector<std::string>{"id", "first_name", "get_field",
+                                      "last_name", "last_name"}),
+            properties);
+}
+
+TEST(Row_members, no_columns) {
+  const Row_members members{std::make_shared<std::vector<std::string>>()};
+
+  EXPECT_EQ(npos(), members.column(""));
+  EXPECT_EQ(npos(), members.property("id", shcore::LowerCamelCase));
+}
+
+TEST(Row_members, rows) {
+  Test_result result{{"id", "firstName", "length", "get_field"}};
+  result.result()->append("1", "John", "3", "x");
+  result.result()->append("2", "Jane", "4", "y");
+
+  const auto row = result.fetch_one_row();
+  ASSERT_NE(nullptr, row);
+
+  EXPECT_EQ("1", row->get_member("id").get_string());
+  EXPECT_EQ("John", row->get_member("firstName").get_string());
+  EXPECT_EQ(4, row->get_member("length").as_int());
+  EXPECT_EQ("3", row->get_field_("length").get_string());
+  EXPECT_THROW(row->get_field_("lastName"), shcore::Exception);
+
+  EXPECT_TRUE(row->has_member("firstName"));
+  EXPECT_TRUE(row->has_member("length"));
+  EXPECT_TRUE(row->has_member("getField"));
+  EXPECT_FALSE(row->has_member("lastName"));
+  EXPECT_FALSE(row->has_method("firstName"));
+  EXPECT_TRUE(row->has_method("getField"));
+
+  EXPECT_EQ("Jane", result.fetch_one_row()
+                        ->call("getField", args("firstName"))
+                        .get_string());
+
+  EXPECT_EQ((std::vector<std::string>{"length", "id", "firstName",
+                                      "get_field", "getField", "getLength",
+                                      "help"}),
+            row->get_members());
+
+  {
+    shcore::Scoped_naming_style style(shcore::LowerCaseUnderscores);
+
+    EXPECT_EQ("John", row->get_member_advanced("first_name").get_string());
+    EXPECT_EQ(4, row->get_member_advanced("length").as_int());
+    EXPECT_TRUE(row->has_member_advanced("first_name"));
+    EXPECT_FALSE(row->has_member_advanced("firstName"));
+    // methods take precedence over the properties
+    EXPECT_TRUE(row->has_method_advanced("get_field"));
+    EXPECT_FALSE(row->has_method_advanced("first_name"));
+    EXPECT_EQ("x",
+              row->call_advanced("get_field", args("get_field")).get_string());
+    EXPECT_THROW(row->set_member_advanced("first_name", shcore::Value("A")),
+                 shcore::Exception);
+  }
+
+  EXPECT_EQ(nullptr, result.fetch_one_row());
+}
+
+TEST(Row_members, add_item) {
+  Row row;
+
+  EXPECT_FALSE(row.has_member("code"));
+
+  row.add_item("level", shcore::Value("Warning"));
+  row.add_item("code", shcore::Value(1234));
+  row.add_item("message", shcore::Value("text"));
+
+  EXPECT_EQ(3u, row.get_length());
+  EXPECT_TRUE(row.has_member("code"));
+  EXPECT_EQ(1234, row.get_member("code").as_int());
+  EXPECT_EQ("text", row.get_field_("message").get_string());
+}
+
+TEST(Row_members, DISABLED_benchmark) {
+  const int64_t rows = 1000000;
+  std::vector<std::string> names;
+
+  for (int i = 0; i < 10; ++i) {
+    names.emplace_back("column_" + std::to_string(i));
+  }
+
+  Test_result result{names};
+
+  for (int i = 0; i < 1000; ++i) {
+    const auto value = std::to_string(i);
+    result.result()->append(value, value, value, value, value, value, value,
+                            value, value, value);
+  }
+
+  size_t length = 0;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int64_t i = 0; i < rows; ++i) {
+    auto row = result.fetch_one_row();
+
+    if (!row) {
+      result.result()->reset();
+      row = result.fetch_one_row();
+    }
+
+    length += row->get_member("column_9").get_string().length();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+
+  std::cout << "fetch_one_row(): "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " ms, " << length << " bytes" << std::endl;
+}
+
+}  // namespace mysqlsh
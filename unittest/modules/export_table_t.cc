@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest_clean.h"
+
+#include "modules/util/export_table/dialect_writer.h"
+#include "modules/util/import_table/dialect.h"
+
+namespace mysqlsh {
+namespace export_table {
+
+namespace {
+
+using Field = Dialect_writer::Field;
+
+Field value(const std::string &s, bool quoted = true) {
+  return Field{s.data(), s.length(), quoted};
+}
+
+Field null() { return Field{nullptr, 0, false}; }
+
+std::string write(Dialect dialect, const std::vector<Field> &fields) {
+  dialect.validate();
+  std::string out;
+  Dialect_writer(dialect).write_row(fields, &out);
+  return out;
+}
+
+}  // namespace
+
+TEST(export_table, dialect_writer_default) {
+  const std::string number = "1";
+  const std::string text = "a\tb\nc\\d";
+  const std::string nul{"e\0f", 3};
+
+  EXPECT_EQ("1\ta\\\tb\\\nc\\\\d\t\\N\te\\0f\n",
+            write(Dialect::default_(), {value(number, false), value(text),
+                                        null(), value(nul)}));
+}
+
+TEST(export_table, dialect_writer_csv) {
+  const std::string number = "-12.5000";
+  const std::string text = "baz said: \"Where is my \t char?\"";
+
+  // only strings are enclosed, terminators within enclosed values are not
+  // escaped
+  EXPECT_EQ("-12.5000,\"baz said: \\\"Where is my \t char?\\\"\",\\N\r\n",
+            write(Dialect::csv(), {value(number, false), value(text), null()}));
+}
+
+TEST(export_table, dialect_writer_csv_unix) {
+  const std::string number = "2";
+  const std::string text = "a,b";
+
+  // all values are enclosed, except for NULL
+  EXPECT_EQ("\"2\",\"a,b\",\\N\n",
+            write(Dialect::csv_unix(),
+                  {value(number, false), value(text), null()}));
+}
+
+TEST(export_table, dialect_writer_json) {
+  const std::string document = "{\"a\": \"b\\\"c\"}";
+
+  // nothing is escaped if escape character is empty
+  EXPECT_EQ("{\"a\": \"b\\\"c\"}\n",
+            write(Dialect::json(), {value(document)}));
+  EXPECT_EQ("NULL\n", write(Dialect::json(), {null()}));
+}
+
+TEST(export_table, dialect_writer_lines_starting_by) {
+  Dialect dialect;
+  dialect.lines_starting_by = ">>";
+  dialect.fields_terminated_by = "|";
+  const std::string a = "x|y";
+  const std::string b = "z";
+
+  EXPECT_EQ(">>x\\|y|z\n", write(dialect, {value(a), value(b)}));
+}
+
+}  // namespace export_table
+}  // namespace mysqlsh
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+/* Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
 
  This program is free software; you can redistribute it and/or modify
  it under the terms of the GNU General Public License, version 2.0,
@@ -19,15 +19,39 @@
  along with this program; if not, write to the Free Software Foundation, Inc.,
  51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <queue>
 #include <random>
+#include <thread>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 
 #include "gtest_clean.h"
 
 #include "modules/util/import_table/chunk_file.h"
+#include "modules/util/import_table/dialect.h"
+#include "modules/util/import_table/file_backends/compressed_file.h"
+#include "modules/util/import_table/file_backends/file.h"
+#include "modules/util/import_table/file_backends/mmap_file.h"
+#include "modules/util/import_table/file_backends/range_reader.h"
 #include "modules/util/import_table/import_table.h"
+#include "modules/util/import_table/journal.h"
+#include "modules/util/import_table/scanner.h"
+#include "mysqlshdk/libs/utils/bounded_queue.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 
 namespace mysqlsh {
@@ -1008,5 +1032,900 @@ TEST(import_table, twochar_aa_line_terminator_same_as_row_data) {
   shcore::delete_file(path, true);
 }
 
+TEST(import_table, scanner_find_byte) {
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> data(4 * kBufferSize + 77);
+  for (auto &b : data) {
+    b = static_cast<uint8_t>(byte(gen));
+  }
+
+  for (auto impl :
+       {Scanner_impl::Scalar, Scanner_impl::Sse2, Scanner_impl::Avx2}) {
+    SCOPED_TRACE(scanner_name(impl));
+    const auto find_byte_impl = scanner_find_byte(impl);
+    if (!find_byte_impl) {
+      EXPECT_FALSE(scanner_supported(impl));
+      continue;
+    }
+
+    // every alignment and length which hits the vector loop tails
+    for (size_t offset = 0; offset < 70; offset++) {
+      for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 129,
+                            kBufferSize}) {
+        const uint8_t *first = data.data() + offset;
+        const uint8_t *last = first + length;
+        for (int needle : {0, 10, 92, 200, 255}) {
+          EXPECT_EQ(std::find(first, last, static_cast<uint8_t>(needle)),
+                    find_byte_impl(first, last, static_cast<uint8_t>(needle)));
+        }
+      }
+    }
+  }
+}
+
+TEST(import_table, parallel_chunking) {
+  const std::string path{"import_table_parallel_chunking.dump"};
+  const Dialect dialect = Dialect::default_();
+  const std::string &terminator = dialect.lines_terminated_by;
+
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> row_length(1, 3000);
+  std::string test_string;
+  std::vector<size_t> row_ends;
+  while (test_string.size() < 40 * kBufferSize) {
+    // escaped terminators inside of rows must not become chunk boundaries
+    std::string row(row_length(gen), 'x');
+    row[row.size() / 2] = '\\';
+    row.insert(row.size() / 2 + 1, terminator);
+    test_string += row + terminator;
+    row_ends.emplace_back(test_string.size());
+  }
+  shcore::create_file(path, test_string, true);
+
+  for (int64_t threads : {1, 2, 3, 8}) {
+    SCOPED_TRACE("threads: " + std::to_string(threads));
+    shcore::Synchronized_queue<Range> queue;
+    Chunk_file chunk;
+    chunk.set_chunk_size(0);
+    chunk.set_file_path(path);
+    chunk.set_dialect(dialect);
+    chunk.set_rows_to_skip(1);
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(threads);
+    chunk.start();
+    queue.shutdown(1);
+
+    // ranges are ordered, contiguous and end on row boundaries
+    size_t expected_begin = row_ends[0];
+    for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+      EXPECT_EQ(expected_begin, r.begin);
+      EXPECT_LT(r.begin, r.end);
+      EXPECT_TRUE(std::binary_search(row_ends.begin(), row_ends.end(), r.end))
+          << r.end;
+      expected_begin = r.end;
+    }
+    EXPECT_EQ(test_string.size(), expected_begin);
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, parallel_chunking_bounded_queue) {
+  const std::string path{"import_table_parallel_chunking_bounded.dump"};
+  const Dialect dialect = Dialect::default_();
+  std::string test_string;
+  for (int i = 0; test_string.size() < 20 * kBufferSize; i++) {
+    test_string += std::to_string(i) + dialect.lines_terminated_by;
+  }
+  shcore::create_file(path, test_string, true);
+
+  for (int64_t threads : {1, 4}) {
+    SCOPED_TRACE("threads: " + std::to_string(threads));
+    // queue is much smaller than number of ranges, chunking has to wait for
+    // the consumer
+    shcore::Bounded_queue<Range> queue(2);
+    size_t expected_begin = 0;
+    size_t ranges = 0;
+
+    std::thread consumer([&]() {
+      for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+        EXPECT_EQ(expected_begin, r.begin);
+        EXPECT_LT(r.begin, r.end);
+        expected_begin = r.end;
+        ++ranges;
+      }
+    });
+
+    Chunk_file chunk;
+    chunk.set_chunk_size(0);
+    chunk.set_file_path(path);
+    chunk.set_dialect(dialect);
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(threads);
+    chunk.start();
+    queue.shutdown(1);
+    consumer.join();
+
+    EXPECT_LT(queue.capacity(), ranges);
+    EXPECT_EQ(test_string.size(), expected_begin);
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, adaptive_chunk_size) {
+  // rates are not known yet
+  EXPECT_EQ(std::numeric_limits<size_t>::max(),
+            adaptive_chunk_size({}, 1000));
+  EXPECT_EQ(std::numeric_limits<size_t>::max(),
+            adaptive_chunk_size({0.0, 0.0}, 1000));
+
+  // equal rates, each worker gets half of its share of the remaining bytes
+  EXPECT_EQ(250u, adaptive_chunk_size({100.0, 100.0}, 1000));
+
+  // unknown rates are assumed to be average
+  EXPECT_EQ(250u, adaptive_chunk_size({100.0, 0.0}, 1000));
+
+  // slowest worker should finish its chunk in half of the remaining time
+  EXPECT_EQ(125u, adaptive_chunk_size({300.0, 100.0}, 1000));
+
+  // chunks shrink as the end of the file approaches
+  EXPECT_GT(adaptive_chunk_size({100.0, 100.0}, 1000),
+            adaptive_chunk_size({100.0, 100.0}, 100));
+  EXPECT_EQ(0u, adaptive_chunk_size({100.0, 100.0}, 0));
+}
+
+TEST(import_table, adaptive_chunking) {
+  const std::string path{"import_table_adaptive_chunking.dump"};
+  const Dialect dialect = Dialect::default_();
+  std::string test_string;
+  std::vector<size_t> row_ends;
+  for (int i = 0; test_string.size() < 200 * kBufferSize; i++) {
+    test_string += std::string(i % 1000 + 1, 'a' + i % 26) + "\n";
+    row_ends.emplace_back(test_string.size());
+  }
+  shcore::create_file(path, test_string, true);
+
+  const size_t max_chunk_size = 32 * kBufferSize;
+
+  for (int64_t threads : {1, 4}) {
+    SCOPED_TRACE("threads: " + std::to_string(threads));
+    shcore::Synchronized_queue<Range> queue;
+    std::vector<size_t> bytes_left;
+    Chunk_file chunk;
+    chunk.set_chunk_size(max_chunk_size);
+    chunk.set_file_path(path);
+    chunk.set_dialect(dialect);
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(threads);
+    chunk.set_chunk_size_policy([&bytes_left](size_t left) {
+      bytes_left.emplace_back(left);
+      return left / 2;
+    });
+    chunk.start();
+    queue.shutdown(1);
+
+    std::vector<Range> ranges;
+    for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+      ranges.emplace_back(r);
+    }
+
+    // ranges are ordered, contiguous and end on row boundaries
+    size_t expected_begin = 0;
+    for (const auto &r : ranges) {
+      EXPECT_EQ(expected_begin, r.begin);
+      EXPECT_LT(r.begin, r.end);
+      EXPECT_TRUE(std::binary_search(row_ends.begin(), row_ends.end(), r.end))
+          << r.end;
+      expected_begin = r.end;
+    }
+    EXPECT_EQ(test_string.size(), expected_begin);
+
+    // policy is consulted with decreasing number of bytes left
+    ASSERT_FALSE(bytes_left.empty());
+    EXPECT_EQ(test_string.size(), bytes_left.front());
+    EXPECT_TRUE(std::is_sorted(bytes_left.rbegin(), bytes_left.rend()));
+
+    // large chunks at the beginning, small ones at the end
+    ASSERT_LT(2u, ranges.size());
+    const auto size = [](const Range &r) { return r.end - r.begin; };
+    EXPECT_LE(max_chunk_size, size(ranges.front()));
+    EXPECT_GT(size(ranges.front()), size(ranges[ranges.size() - 2]));
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, file_index) {
+  const std::string path{"import_table_file_index.dump"};
+  std::string test_string;
+  for (int i = 0; test_string.size() < 40 * kBufferSize; i++) {
+    test_string += std::string(i % 100 + 1, 'a' + i % 26) + "\n";
+  }
+  shcore::create_file(path, test_string, true);
+
+  for (int64_t threads : {1, 4}) {
+    SCOPED_TRACE("threads: " + std::to_string(threads));
+    shcore::Synchronized_queue<Range> queue;
+    Chunk_file chunk;
+    chunk.set_chunk_size(2 * kBufferSize);
+    chunk.set_file_path(path);
+    chunk.set_file_index(7);
+    chunk.set_dialect(Dialect::default_());
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(threads);
+    chunk.set_chunk_size_policy([](size_t left) { return left / 2; });
+    chunk.start();
+    queue.shutdown(1);
+
+    // ranges of all files are sent to the same queue, each one is marked with
+    // index of its file
+    size_t ranges = 0;
+    size_t bytes = 0;
+    for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+      EXPECT_EQ(7u, r.file);
+      bytes += r.end - r.begin;
+      ++ranges;
+    }
+    EXPECT_LT(1u, ranges);
+    EXPECT_EQ(test_string.size(), bytes);
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, journal) {
+  const std::string path{"import_table_journal.json"};
+  shcore::delete_file(path, true);
+
+  const auto range = [](size_t begin, size_t end) {
+    return Range{begin, end, nullptr, 1};
+  };
+  const auto bounds = [](const std::vector<Range> &ranges) {
+    std::vector<std::pair<size_t, size_t>> result;
+    for (const auto &r : ranges) {
+      EXPECT_EQ(1u, r.file);
+      result.emplace_back(r.begin, r.end);
+    }
+    return result;
+  };
+  using Bounds = std::vector<std::pair<size_t, size_t>>;
+
+  {
+    Import_journal journal{path};
+    journal.set_target("schema", "table", {"a", "b"});
+    journal.set_dialect(Dialect::csv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 1000);
+
+    EXPECT_FALSE(journal.load());
+    journal.save();
+    EXPECT_TRUE(shcore::is_file(path));
+
+    EXPECT_EQ((Bounds{{0, 1000}}), bounds(journal.pending(range(0, 1000))));
+
+    journal.complete(range(100, 200));
+    journal.complete(range(300, 400));
+    // adjacent ranges are merged
+    journal.complete(range(200, 250));
+
+    EXPECT_EQ((Bounds{{0, 100}, {250, 300}, {400, 1000}}),
+              bounds(journal.pending(range(0, 1000))));
+    EXPECT_EQ((Bounds{{250, 300}}), bounds(journal.pending(range(150, 350))));
+    EXPECT_EQ((Bounds{}), bounds(journal.pending(range(100, 250))));
+    EXPECT_EQ((Bounds{{50, 100}}), bounds(journal.pending(range(50, 120))));
+  }
+
+  {
+    // journal is read back by the resumed import
+    Import_journal journal{path};
+    journal.set_target("schema", "table", {"a", "b"});
+    journal.set_dialect(Dialect::csv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 1000);
+
+    ASSERT_TRUE(journal.load());
+    EXPECT_EQ((Bounds{{0, 100}, {250, 300}, {400, 1000}}),
+              bounds(journal.pending(range(0, 1000))));
+
+    // in-memory data is split between the parts
+    const auto data = std::make_shared<const std::string>("0123456789");
+    const auto parts = journal.pending(Range{245, 255, data, 1});
+    ASSERT_EQ(1u, parts.size());
+    EXPECT_EQ(250u, parts[0].begin);
+    EXPECT_EQ(255u, parts[0].end);
+    ASSERT_TRUE(parts[0].data);
+    EXPECT_EQ("56789", *parts[0].data);
+  }
+
+  {
+    // journal written for a different import cannot be used
+    Import_journal journal{path};
+    journal.set_target("schema", "table", {"a", "b"});
+    journal.set_dialect(Dialect::tsv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 1000);
+
+    EXPECT_THROW(journal.load(), std::runtime_error);
+  }
+
+  for (const auto &columns :
+       {std::vector<std::string>{"a"}, std::vector<std::string>{"b", "a"}}) {
+    Import_journal journal{path};
+    journal.set_target("schema", "table", columns);
+    journal.set_dialect(Dialect::csv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 1000);
+
+    EXPECT_THROW(journal.load(), std::runtime_error);
+  }
+
+  {
+    Import_journal journal{path};
+    journal.set_target("schema", "other", {"a", "b"});
+    journal.set_dialect(Dialect::csv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 1000);
+
+    EXPECT_THROW(journal.load(), std::runtime_error);
+  }
+
+  {
+    Import_journal journal{path};
+    journal.set_target("schema", "table", {"a", "b"});
+    journal.set_dialect(Dialect::csv());
+    journal.set_rows_to_skip(1);
+    journal.add_file("first.csv", 100);
+    journal.add_file("second.csv", 2000);
+
+    EXPECT_THROW(journal.load(), std::runtime_error);
+
+    journal.remove();
+    EXPECT_FALSE(shcore::is_file(path));
+  }
+}
+
+TEST(import_table, mmap_file) {
+  const std::string path{"import_table_mmap_file.dump"};
+  std::string test_string;
+  for (int i = 0; test_string.size() < 3 * kBufferSize; i++) {
+    test_string += std::to_string(i) + "\n";
+  }
+  shcore::create_file(path, test_string, true);
+
+  {
+    Mmap_file mmap_file{path};
+    File file{path};
+    mmap_file.open();
+    file.open();
+    ASSERT_TRUE(mmap_file.is_open());
+    ASSERT_NE(nullptr, mmap_file.mapping());
+    EXPECT_EQ(0, memcmp(test_string.data(), mmap_file.mapping(),
+                        test_string.size()));
+
+    for (size_t offset : {0, 1, 1000, kBufferSize - 1, 2 * kBufferSize + 3}) {
+      EXPECT_EQ(static_cast<off64_t>(offset), mmap_file.seek(offset));
+      EXPECT_EQ(static_cast<off64_t>(offset), file.seek(offset));
+
+      char mmap_buffer[kBufferSize];
+      char file_buffer[kBufferSize];
+      ssize_t mmap_bytes = 0;
+      ssize_t file_bytes = 0;
+      do {
+        mmap_bytes = mmap_file.read(mmap_buffer, sizeof(mmap_buffer));
+        file_bytes = file.read(file_buffer, sizeof(file_buffer));
+        ASSERT_EQ(file_bytes, mmap_bytes);
+        EXPECT_EQ(0, memcmp(file_buffer, mmap_buffer, file_bytes));
+      } while (mmap_bytes > 0);
+    }
+
+    mmap_file.close();
+    file.close();
+    EXPECT_EQ(nullptr, mmap_file.mapping());
+  }
+
+  {
+    // empty files are not mapped, but can be read
+    shcore::create_file(path, "", true);
+    Mmap_file mmap_file{path};
+    mmap_file.open();
+    ASSERT_TRUE(mmap_file.is_open());
+    EXPECT_EQ(nullptr, mmap_file.mapping());
+    char buffer[16];
+    EXPECT_EQ(0, mmap_file.read(buffer, sizeof(buffer)));
+    mmap_file.close();
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, range_reader) {
+  constexpr size_t k_buffer_size = 4096;
+  constexpr size_t k_read_ahead = 256 * 1024;
+  // each of the read ahead threads fetches a quarter of the limit at once
+  constexpr size_t k_block_size = k_read_ahead / 4;
+
+  std::string file(1000003, '\0');
+  for (size_t i = 0; i < file.size(); ++i) {
+    file[i] = static_cast<char>(i % 251);
+  }
+
+  std::mutex mutex;
+  size_t requests = 0;
+  size_t fetched_end = 0;
+  size_t fail_at = file.size();
+
+  const Range_reader::Fetch fetch = [&](size_t begin, size_t end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++requests;
+    fetched_end = std::max(fetched_end, end);
+
+    if (end > fail_at) {
+      throw std::runtime_error("Fetch failed.");
+    }
+
+    return file.substr(begin, end - begin);
+  };
+
+  const auto reset = [&]() {
+    requests = 0;
+    fetched_end = 0;
+  };
+
+  std::string buffer(k_buffer_size, '\0');
+
+  const auto read_to = [&](Range_reader *reader, size_t offset, size_t end) {
+    std::string data;
+
+    while (offset < end) {
+      const auto bytes =
+          reader->read(&buffer[0], std::min(k_buffer_size, end - offset));
+      ASSERT_LT(0, bytes);
+      data.append(buffer.data(), bytes);
+      offset += bytes;
+
+      {
+        // data fetched ahead of the reader does not exceed the limit
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_GE(offset + k_read_ahead, fetched_end);
+      }
+    }
+
+    EXPECT_EQ(file.substr(end - data.size(), data.size()), data);
+  };
+
+  {
+    SCOPED_TRACE("no read ahead, each read is a request");
+    reset();
+    Range_reader reader(file.size(), fetch, 0);
+    read_to(&reader, 0, file.size());
+    EXPECT_EQ(0, reader.read(&buffer[0], k_buffer_size));
+    EXPECT_EQ((file.size() + k_buffer_size - 1) / k_buffer_size, requests);
+  }
+
+  {
+    SCOPED_TRACE("sequential reads start reading ahead");
+    reset();
+    Range_reader reader(file.size(), fetch, k_read_ahead);
+    read_to(&reader, 0, file.size());
+    EXPECT_EQ(0, reader.read(&buffer[0], k_buffer_size));
+    // first read is a request, the rest is fetched in blocks
+    EXPECT_EQ(1 + (file.size() - k_buffer_size + k_block_size - 1) /
+                      k_block_size,
+              requests);
+  }
+
+  {
+    SCOPED_TRACE("advised range is read ahead, nothing past it is fetched");
+    reset();
+    Range_reader reader(file.size(), fetch, k_read_ahead);
+    EXPECT_EQ(100000, reader.seek(100000));
+    reader.advise_read_end(300000);
+    read_to(&reader, 100000, 300000);
+    EXPECT_EQ((200000 + k_block_size - 1) / k_block_size, requests);
+    EXPECT_EQ(300000, fetched_end);
+
+    // reading continues past the advised range
+    read_to(&reader, 300000, 310000);
+  }
+
+  {
+    SCOPED_TRACE("seek stops reading ahead");
+    reset();
+    Range_reader reader(file.size(), fetch, k_read_ahead);
+    reader.advise_read_end(file.size());
+    read_to(&reader, 0, 10000);
+    EXPECT_EQ(500000, reader.seek(500000));
+    read_to(&reader, 500000, 600000);
+    reader.reset();
+  }
+
+  {
+    SCOPED_TRACE("errors are reported by the reader");
+    reset();
+    fail_at = 500000;
+    Range_reader reader(file.size(), fetch, k_read_ahead);
+    reader.advise_read_end(file.size());
+    EXPECT_THROW(read_to(&reader, 0, file.size()), std::runtime_error);
+    fail_at = file.size();
+  }
+}
+
+TEST(import_table, compression_from_path) {
+  EXPECT_EQ(Compression::None, compression_from_path("data.tsv"));
+  EXPECT_EQ(Compression::Gzip, compression_from_path("data.tsv.gz"));
+  EXPECT_EQ(Compression::Gzip, compression_from_path("DATA.TSV.GZ"));
+  EXPECT_EQ(Compression::Zstd, compression_from_path("/tmp/data.csv.zst"));
+  EXPECT_EQ(Compression::None, compression_from_path("data.gzip"));
+
+  EXPECT_EQ("data.tsv", strip_compression_extension("data.tsv"));
+  EXPECT_EQ("data.tsv", strip_compression_extension("data.tsv.gz"));
+  EXPECT_EQ("/tmp/data.csv", strip_compression_extension("/tmp/data.csv.zst"));
+}
+
+namespace {
+
+std::vector<Compression> supported_compressions() {
+  std::vector<Compression> result;
+#ifdef HAVE_ZLIB
+  result.emplace_back(Compression::Gzip);
+#endif
+#ifdef HAVE_ZSTD
+  result.emplace_back(Compression::Zstd);
+#endif
+  return result;
+}
+
+std::string compressed_path(const std::string &path, Compression compression) {
+  return path + (compression == Compression::Gzip ? ".gz" : ".zst");
+}
+
+void create_compressed_file(const std::string &path, const std::string &data,
+                            Compression compression) {
+  std::string compressed;
+
+  switch (compression) {
+    case Compression::Gzip: {
+#ifdef HAVE_ZLIB
+      // two members, readers have to handle concatenated gzip files
+      const size_t half = data.size() / 2;
+      for (const auto &part : {data.substr(0, half), data.substr(half)}) {
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        ASSERT_EQ(Z_OK, deflateInit2(&stream, Z_DEFAULT_COMPRESSION,
+                                     Z_DEFLATED, 15 + 16, 8,
+                                     Z_DEFAULT_STRATEGY));
+        std::string out(deflateBound(&stream, part.size()), '\0');
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(
+            part.data()));
+        stream.avail_in = part.size();
+        stream.next_out = reinterpret_cast<Bytef *>(&out[0]);
+        stream.avail_out = out.size();
+        ASSERT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        compressed += out;
+      }
+#endif
+      break;
+    }
+
+    case Compression::Zstd: {
+#ifdef HAVE_ZSTD
+      compressed.resize(ZSTD_compressBound(data.size()));
+      const auto size = ZSTD_compress(&compressed[0], compressed.size(),
+                                      data.data(), data.size(), 3);
+      ASSERT_FALSE(ZSTD_isError(size));
+      compressed.resize(size);
+#endif
+      break;
+    }
+
+    case Compression::None:
+      compressed = data;
+      break;
+  }
+
+  shcore::create_file(path, compressed, true);
+}
+
+}  // namespace
+
+TEST(import_table, compressed_file) {
+  std::string test_string;
+  for (int i = 0; test_string.size() < 5 * kBufferSize; i++) {
+    test_string += std::to_string(i * i) + "\n";
+  }
+
+  for (const auto compression : supported_compressions()) {
+    const auto path =
+        compressed_path("import_table_compressed_file.dump", compression);
+    SCOPED_TRACE(path);
+    create_compressed_file(path, test_string, compression);
+
+    Compressed_file file{shcore::make_unique<File>(path), compression};
+    file.open();
+    ASSERT_TRUE(file.is_open());
+
+    // forward and backward seeks
+    for (size_t offset :
+         {0, 1, 1000, kBufferSize - 1, 3 * kBufferSize + 3, 7, 0}) {
+      EXPECT_EQ(static_cast<off64_t>(offset), file.seek(offset));
+
+      std::string data;
+      char buffer[1000];
+      ssize_t bytes = 0;
+      while ((bytes = file.read(buffer, sizeof(buffer))) > 0) {
+        data.append(buffer, bytes);
+      }
+      ASSERT_EQ(0, bytes);
+      EXPECT_EQ(test_string.substr(offset), data);
+      EXPECT_EQ(file.file_size(), file.compressed_offset());
+    }
+
+    file.close();
+    shcore::delete_file(path, true);
+  }
+}
+
+TEST(import_table, compressed_chunking) {
+  std::string test_string;
+  std::vector<size_t> row_ends;
+  for (int i = 0; test_string.size() < 20 * kBufferSize; i++) {
+    test_string += std::string(i % 1000 + 1, 'a' + i % 26) + "\n";
+    row_ends.emplace_back(test_string.size());
+  }
+
+  for (const auto compression : supported_compressions()) {
+    const auto path =
+        compressed_path("import_table_compressed_chunking.dump", compression);
+    SCOPED_TRACE(path);
+    create_compressed_file(path, test_string, compression);
+
+    shcore::Synchronized_queue<Range> queue;
+    std::atomic<size_t> progress{0};
+    Chunk_file chunk;
+    chunk.set_chunk_size(kBufferSize);
+    chunk.set_file_path(path);
+    chunk.set_dialect(Dialect::default_());
+    chunk.set_rows_to_skip(1);
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(4);
+    chunk.set_max_pending_chunks(2);
+    chunk.set_progress(&progress);
+
+    // chunker waits for the chunks to be consumed
+    std::thread chunker([&]() {
+      chunk.start();
+      queue.shutdown(1);
+    });
+
+    size_t expected_begin = row_ends[0];
+    for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+      EXPECT_EQ(expected_begin, r.begin);
+      EXPECT_LT(r.begin, r.end);
+      EXPECT_TRUE(std::binary_search(row_ends.begin(), row_ends.end(), r.end))
+          << r.end;
+      ASSERT_NE(nullptr, r.data);
+      EXPECT_EQ(test_string.substr(r.begin, r.end - r.begin), *r.data);
+      expected_begin = r.end;
+    }
+    chunker.join();
+
+    EXPECT_EQ(test_string.size(), expected_begin);
+    EXPECT_EQ(shcore::file_size(path), progress);
+    shcore::delete_file(path, true);
+  }
+}
+
+TEST(import_table, compressed_chunking_truncated) {
+  std::string test_string;
+  for (int i = 0; test_string.size() < 20 * kBufferSize; i++) {
+    test_string += std::to_string(i * i) + "\n";
+  }
+
+  for (const auto compression : supported_compressions()) {
+    const auto path = compressed_path(
+        "import_table_compressed_chunking_truncated.dump", compression);
+    SCOPED_TRACE(path);
+    create_compressed_file(path, test_string, compression);
+    {
+      // drop the end of the second member
+      std::ifstream in(path, std::ios::binary);
+      const std::string data{std::istreambuf_iterator<char>(in),
+                             std::istreambuf_iterator<char>()};
+      in.close();
+      shcore::create_file(path, data.substr(0, data.size() - 16), true);
+    }
+
+    shcore::Synchronized_queue<Range> queue;
+    Chunk_file chunk;
+    chunk.set_chunk_size(kBufferSize);
+    chunk.set_file_path(path);
+    chunk.set_dialect(Dialect::default_());
+    chunk.set_output_queue(&queue);
+    chunk.set_threads(4);
+    chunk.set_max_pending_chunks(2);
+
+    std::exception_ptr exception;
+    std::thread chunker([&]() {
+      try {
+        chunk.start();
+      } catch (...) {
+        exception = std::current_exception();
+      }
+
+      queue.shutdown(1);
+    });
+
+    size_t bytes = 0;
+    for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+      bytes += r.end - r.begin;
+    }
+    chunker.join();
+
+    EXPECT_LT(bytes, test_string.size());
+    ASSERT_NE(nullptr, exception);
+    EXPECT_THROW(std::rethrow_exception(exception), std::runtime_error);
+    shcore::delete_file(path, true);
+  }
+}
+
+TEST(import_table, compressed_journal) {
+  std::string test_string;
+  for (int i = 0; test_string.size() < 20 * kBufferSize; i++) {
+    test_string += std::string(100, 'a' + i % 26) + "\n";
+  }
+
+  const std::string journal_path{"import_table_compressed_journal.json"};
+
+  for (const auto compression : supported_compressions()) {
+    const auto path =
+        compressed_path("import_table_compressed_journal.dump", compression);
+    SCOPED_TRACE(path);
+    create_compressed_file(path, test_string, compression);
+    const auto size = shcore::file_size(path);
+
+    std::vector<Range> ranges;
+    {
+      shcore::Synchronized_queue<Range> queue;
+      Chunk_file chunk;
+      chunk.set_chunk_size(kBufferSize);
+      chunk.set_file_path(path);
+      chunk.set_dialect(Dialect::default_());
+      chunk.set_output_queue(&queue);
+      chunk.set_threads(4);
+      // all chunks are kept until the import is resumed
+      chunk.set_max_pending_chunks(100);
+
+      std::thread chunker([&]() {
+        chunk.start();
+        queue.shutdown(1);
+      });
+
+      for (auto r = queue.pop(); r.begin != 0 || r.end != 0; r = queue.pop()) {
+        ranges.emplace_back(std::move(r));
+      }
+      chunker.join();
+    }
+
+    ASSERT_LT(2u, ranges.size());
+    const auto half = ranges.size() / 2;
+    // ranges are offsets in the decompressed data
+    ASSERT_LT(size, ranges[half - 1].end);
+
+    const auto create_journal = [&](bool compressed) {
+      auto journal = shcore::make_unique<Import_journal>(journal_path);
+      journal->set_target("schema", "table", {});
+      journal->set_dialect(Dialect::default_());
+      journal->add_file(path, size, compressed);
+      return journal;
+    };
+
+    {
+      // import is interrupted after half of the chunks is loaded
+      const auto journal = create_journal(true);
+      journal->save();
+
+      for (size_t i = 0; i < half; ++i) {
+        journal->complete(ranges[i]);
+      }
+    }
+
+    {
+      // resumed import loads only the remaining data
+      const auto journal = create_journal(true);
+      ASSERT_TRUE(journal->load());
+
+      std::string loaded = test_string.substr(0, ranges[half].begin);
+
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        for (const auto &part : journal->pending(ranges[i])) {
+          EXPECT_LE(half, i);
+          ASSERT_NE(nullptr, part.data);
+          loaded += *part.data;
+        }
+      }
+
+      EXPECT_EQ(test_string, loaded);
+    }
+
+    {
+      // file was recorded as compressed
+      const auto journal = create_journal(false);
+      EXPECT_THROW(journal->load(), std::runtime_error);
+      journal->remove();
+    }
+
+    shcore::delete_file(path, true);
+  }
+}
+
+TEST(import_table, DISABLED_chunking_throughput) {
+  using mysqlshdk::utils::format_throughput_bytes;
+  constexpr size_t k_file_size = 256 * 1024 * 1024;
+  const std::string path{"import_table_chunking_throughput.dump"};
+
+  std::cout << "Best scanner: " << scanner_name(scanner_best_impl())
+            << std::endl;
+
+  const std::vector<std::pair<std::string, Dialect>> dialects{
+      {"default", Dialect::default_()},
+      {"json", Dialect::json()},
+      {"csv", Dialect::csv()},
+      {"tsv", Dialect::tsv()},
+      {"csv-unix", Dialect::csv_unix()}};
+
+  for (const auto &d : dialects) {
+    const auto &dialect = d.second;
+    const auto &terminator = dialect.lines_terminated_by;
+    std::string row;
+    for (int i = 0; i < 12; i++) {
+      if (i > 0) row += dialect.fields_terminated_by;
+      row += dialect.fields_enclosed_by + "field value " + std::to_string(i) +
+             dialect.fields_enclosed_by;
+    }
+    row += terminator;
+
+    std::string test_string;
+    test_string.reserve(k_file_size + row.size());
+    while (test_string.size() < k_file_size) {
+      test_string += row;
+    }
+    shcore::create_file(path, test_string, true);
+
+    {
+      File_handler fh{path};
+      mysqlshdk::utils::Profile_timer timer;
+      timer.stage_begin("skip_rows");
+      auto first = fh.begin(terminator.size());
+      auto last = fh.end(terminator.size());
+      if (dialect.fields_escaped_by.empty()) {
+        first = skip_rows(first, last, terminator,
+                          std::numeric_limits<uint64_t>::max());
+      } else {
+        first = skip_rows(first, last, terminator,
+                          std::numeric_limits<uint64_t>::max(),
+                          dialect.fields_escaped_by[0]);
+      }
+      timer.stage_end();
+      EXPECT_EQ(last, first);
+
+      std::cout << d.first << ": "
+                << format_throughput_bytes(test_string.size(),
+                                           timer.total_seconds_ellapsed())
+                << std::endl;
+    }
+
+    shcore::delete_file(path, true);
+  }
+}
+
 }  // namespace import_table
 }  // namespace mysqlsh
@@ -861,6 +861,50 @@ TEST_F(MySQL_upgrade_check_test, check_table_command) {
   EXPECT_TRUE(issues.empty());
 }
 
+TEST_F(MySQL_upgrade_check_test, check_table_command_sessions) {
+  PrepareTestDatabase("mysql_check_table_sessions_test");
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_NO_THROW(session->execute("create table t" + std::to_string(i) +
+                                     "(i integer) engine=innodb;"));
+  }
+
+  Check_table_command serial;
+  std::vector<Upgrade_issue> expected;
+  ASSERT_NO_THROW(expected = serial.run(session, opts));
+
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions;
+  for (int i = 0; i < 3; ++i) {
+    sessions.emplace_back(mysqlshdk::db::mysql::Session::create());
+    sessions.back()->connect(shcore::get_connection_options(_mysql_uri));
+  }
+
+  Check_table_command parallel;
+  parallel.set_sessions(sessions);
+
+  size_t last_checked = 0;
+  size_t total_tables = 0;
+  parallel.set_progress([&](size_t checked, size_t total) {
+    EXPECT_EQ(last_checked + 1, checked);
+    last_checked = checked;
+    total_tables = total;
+  });
+
+  std::vector<Upgrade_issue> issues;
+  ASSERT_NO_THROW(issues = parallel.run(session, opts));
+
+  EXPECT_LE(10, total_tables);
+  EXPECT_EQ(total_tables, last_checked);
+
+  // issues are reported in the same order
+  ASSERT_EQ(expected.size(), issues.size());
+  for (size_t i = 0; i < issues.size(); ++i) {
+    EXPECT_EQ(to_string(expected[i]), to_string(issues[i]));
+  }
+
+  for (const auto &s : sessions) s->close();
+}
+
 TEST_F(MySQL_upgrade_check_test, manual_checks) {
   auto manual = Upgrade_check::create_checklist(
       Upgrade_check_options{Version("5.7.0"), Version("8.0.11"), "", ""});
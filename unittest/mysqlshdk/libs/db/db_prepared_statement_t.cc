@@ -0,0 +1,341 @@
+/* Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License, version 2.0,
+ as published by the Free Software Foundation.
+
+ This program is also distributed with certain software (including
+ but not limited to OpenSSL) that is licensed under separate terms, as
+ designated in a particular file or component or in included license
+ documentation.  The authors of MySQL hereby grant you an additional
+ permission to link the program and your derivative works with the
+ separately licensed software that they have included with MySQL.
+ This program is distributed in the hope that it will be useful,  but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ the GNU General Public License, version 2.0, for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/mysqlx/session.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "unittest/mysqlshdk/libs/db/db_common.h"
+
+namespace mysqlshdk {
+namespace db {
+
+namespace {
+
+template <typename T>
+void expect_same(T (IRow::*getter)(uint32_t) const, const IRow &expected,
+                 const IRow &actual, uint32_t index) {
+  bool throws = false;
+  T value{};
+
+  try {
+    value = (expected.*getter)(index);
+  } catch (const std::exception &) {
+    throws = true;
+  }
+
+  if (throws) {
+    EXPECT_ANY_THROW((actual.*getter)(index));
+  } else {
+    EXPECT_EQ(value, (actual.*getter)(index));
+  }
+}
+
+void expect_same(const IRow &expected, const IRow &actual) {
+  ASSERT_EQ(expected.num_fields(), actual.num_fields());
+
+  for (uint32_t i = 0; i < expected.num_fields(); ++i) {
+    SCOPED_TRACE("field " + std::to_string(i));
+
+    const auto type = expected.get_type(i);
+    EXPECT_EQ(type, actual.get_type(i));
+    EXPECT_EQ(expected.is_null(i), actual.is_null(i));
+
+    // text representation of floating point numbers is generated by the
+    // server, it may differ in the last digit
+    if (Type::Float != type && Type::Double != type) {
+      expect_same(&IRow::get_as_string, expected, actual, i);
+    }
+
+    expect_same(&IRow::get_string, expected, actual, i);
+    expect_same(&IRow::get_int, expected, actual, i);
+    expect_same(&IRow::get_uint, expected, actual, i);
+    expect_same(&IRow::get_float, expected, actual, i);
+    expect_same(&IRow::get_double, expected, actual, i);
+    expect_same(&IRow::get_bit, expected, actual, i);
+  }
+}
+
+}  // namespace
+
+TEST_F(Db_tests, prepared_same_as_text) {
+  session->connect(Connection_options(uri()));
+
+  // each query invalidates the previous result, text queries are executed
+  // using another session
+  auto text_session = mysql::Session::create();
+  text_session->connect(Connection_options(uri()));
+
+  std::vector<std::string> tables;
+  {
+    auto result = session->query(
+        "SELECT table_name FROM information_schema.tables WHERE "
+        "table_schema = 'xtest' ORDER BY table_name");
+    while (auto row = result->fetch_one()) {
+      tables.emplace_back(row->get_string(0));
+    }
+  }
+
+  ASSERT_FALSE(tables.empty());
+
+  for (const auto &table : tables) {
+    SCOPED_TRACE(table);
+
+    const std::string sql = "SELECT * FROM xtest." + table;
+
+    for (const bool buffered : {false, true}) {
+      SCOPED_TRACE(buffered ? "buffered" : "unbuffered");
+
+      auto text = text_session->query(sql, true);
+      auto binary = session->query_prepared(sql, {}, buffered);
+
+      ASSERT_EQ(text->get_metadata().size(), binary->get_metadata().size());
+
+      for (size_t i = 0; i < text->get_metadata().size(); ++i) {
+        EXPECT_EQ(text->get_metadata()[i].get_column_label(),
+                  binary->get_metadata()[i].get_column_label());
+        EXPECT_EQ(text->get_metadata()[i].get_type(),
+                  binary->get_metadata()[i].get_type());
+      }
+
+      while (auto expected = text->fetch_one()) {
+        auto actual = binary->fetch_one();
+        ASSERT_NE(nullptr, actual);
+        expect_same(*expected, *actual);
+      }
+
+      EXPECT_EQ(nullptr, binary->fetch_one());
+      EXPECT_EQ(text->get_fetched_row_count(),
+                binary->get_fetched_row_count());
+    }
+  }
+
+  text_session->close();
+  session->close();
+}
+
+TEST_F(Db_tests, prepared_placeholders) {
+  const std::string large(100000, 'x');
+
+  do {
+    SCOPED_TRACE(is_classic ? "mysql" : "mysqlx");
+    session->connect(Connection_options(uri()));
+
+    session->execute("DROP TABLE IF EXISTS xtest.prepared");
+    session->execute(
+        "CREATE TABLE xtest.prepared (id INT PRIMARY KEY AUTO_INCREMENT, i "
+        "BIGINT, u BIGINT UNSIGNED, d DOUBLE, s LONGTEXT)");
+
+    auto result = session->queryp(
+        "INSERT INTO xtest.prepared (i, u, d, s) VALUES (?, ?, ?, ?)",
+        std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<uint64_t>::max(), 1.5, "it's \"quoted\"");
+    EXPECT_EQ(1, result->get_affected_row_count());
+    EXPECT_LT(0, result->get_auto_increment_value());
+
+    session->queryp(
+        "INSERT INTO xtest.prepared (i, u, d, s) VALUES (?, ?, ?, ?)", -1,
+        1u, nullptr, large);
+
+    result = session->queryp(
+        "SELECT i, u, d, s FROM xtest.prepared WHERE i < ? ORDER BY id", 0);
+
+    auto row = result->fetch_one();
+    ASSERT_NE(nullptr, row);
+    EXPECT_EQ(std::numeric_limits<int64_t>::min(), row->get_int(0));
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), row->get_uint(1));
+    EXPECT_EQ(1.5, row->get_double(2));
+    EXPECT_EQ("it's \"quoted\"", row->get_string(3));
+
+    row = result->fetch_one();
+    ASSERT_NE(nullptr, row);
+    EXPECT_EQ(-1, row->get_int(0));
+    EXPECT_EQ(1, row->get_uint(1));
+    EXPECT_TRUE(row->is_null(2));
+    EXPECT_EQ("NULL", row->get_as_string(2));
+    EXPECT_EQ(large, row->get_string(3));
+
+    EXPECT_EQ(nullptr, result->fetch_one());
+
+    // wrong number of values
+    EXPECT_ANY_THROW(session->queryp("SELECT * FROM xtest.prepared WHERE i = ?",
+                                     1, 2));
+
+    EXPECT_THROW(session->queryp("SELECT * FROM xtest.missing WHERE i = ?", 1),
+                 std::exception);
+
+    session->execute("DROP TABLE xtest.prepared");
+    session->close();
+  } while (switch_proto());
+}
+
+TEST_F(Db_tests, prepared_statement_reuse) {
+  session->connect(Connection_options(uri()));
+
+  const std::string sql =
+      "SELECT c1 FROM xtest.t_tinyint WHERE c1 IS NOT NULL AND c1 > ? ORDER BY "
+      "c1";
+
+  // result of the first execution is still used, new statement is prepared
+  auto first = session->query_prepared(sql, {-1000}, true);
+  auto second = session->query_prepared(sql, {0}, true);
+
+  Row_copy first_row{*first->fetch_one()};
+  Row_copy second_row{*second->fetch_one()};
+  EXPECT_GT(second_row.get_int(0), 0);
+  EXPECT_LT(first_row.get_int(0), second_row.get_int(0));
+
+  first->rewind();
+  EXPECT_EQ(first_row.get_int(0), first->fetch_one()->get_int(0));
+
+  // unbuffered result is discarded when another query is executed
+  auto unbuffered = session->query_prepared(sql, {-1000});
+  ASSERT_NE(nullptr, unbuffered->fetch_one());
+
+  EXPECT_EQ(1, session->query("SELECT 1")->fetch_one()->get_int(0));
+  EXPECT_EQ(nullptr, unbuffered->fetch_one());
+
+  // buffer() keeps the remaining rows
+  unbuffered = session->query_prepared(sql, {-1000});
+  unbuffered->buffer();
+  EXPECT_LT(0, session
+                  ->queryp("SELECT COUNT(*) FROM xtest.t_tinyint WHERE c1 > ?",
+                           -1000)
+                  ->fetch_one()
+                  ->get_int(0));
+  EXPECT_EQ(first_row.get_int(0), unbuffered->fetch_one()->get_int(0));
+
+  session->close();
+}
+
+TEST_F(Db_tests, prepared_schema_change) {
+  do {
+    SCOPED_TRACE(is_classic ? "mysql" : "mysqlx");
+    session->connect(Connection_options(uri()));
+
+    for (const auto &schema : {"prepared_a", "prepared_b"}) {
+      session->executef("DROP SCHEMA IF EXISTS !", schema);
+      session->executef("CREATE SCHEMA !", schema);
+      session->executef("CREATE TABLE !.t (s VARCHAR(32))", schema);
+      session->executef("INSERT INTO !.t VALUES (?)", schema, schema);
+    }
+
+    const std::string sql = "SELECT s FROM t WHERE s LIKE ?";
+
+    // unqualified name is resolved using the current default schema
+    session->execute("USE prepared_a");
+    EXPECT_EQ("prepared_a",
+              session->queryp(sql, "prepared%")->fetch_one()->get_string(0));
+
+    session->execute("USE prepared_b");
+    EXPECT_EQ("prepared_b",
+              session->queryp(sql, "prepared%")->fetch_one()->get_string(0));
+
+    // failed statement is prepared again once the error is fixed
+    session->execute("DROP TABLE prepared_b.t");
+    EXPECT_THROW(session->queryp(sql, "prepared%"), std::exception);
+    session->execute("CREATE TABLE prepared_b.t (id INT, s VARCHAR(32))");
+    session->execute("INSERT INTO prepared_b.t VALUES (1, 'again')");
+    EXPECT_EQ("again", session->queryp(sql, "%")->fetch_one()->get_string(0));
+
+    session->execute("USE prepared_a");
+    EXPECT_EQ("prepared_a",
+              session->queryp(sql, "prepared%")->fetch_one()->get_string(0));
+
+    session->execute("DROP SCHEMA prepared_a");
+    session->execute("DROP SCHEMA prepared_b");
+    session->close();
+  } while (switch_proto());
+}
+
+TEST_F(Db_tests, DISABLED_prepared_benchmark) {
+  session->connect(Connection_options(uri()));
+
+  session->execute("DROP TABLE IF EXISTS xtest.prepared_bench");
+  session->execute(
+      "CREATE TABLE xtest.prepared_bench (id INT PRIMARY KEY, i BIGINT, d "
+      "DOUBLE, s VARCHAR(64))");
+
+  const int rows = 10000;
+
+  for (int i = 0; i < rows; i += 1000) {
+    std::string sql = "INSERT INTO xtest.prepared_bench VALUES ";
+    for (int j = i; j < i + 1000; ++j) {
+      sql += shcore::sqlformat("(?, ?, ?, ?),", j, j * 1000, j / 3.0,
+                               std::to_string(j));
+    }
+    sql.pop_back();
+    session->execute(sql);
+  }
+
+  const std::string sql =
+      "SELECT id, i, d, s FROM xtest.prepared_bench WHERE id >= ? LIMIT 10";
+  const auto consume = [](const std::shared_ptr<IResult> &result) {
+    int64_t sum = 0;
+    while (auto row = result->fetch_one()) {
+      sum += row->get_int(0) + row->get_int(1) +
+             static_cast<int64_t>(row->get_double(2)) +
+             row->get_string(3).length();
+    }
+    return sum;
+  };
+
+  int64_t text_sum = 0;
+  int64_t binary_sum = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < rows; ++i) {
+    text_sum += consume(session->queryf(sql, i));
+  }
+
+  const auto text = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < rows; ++i) {
+    binary_sum += consume(session->queryp(sql, i));
+  }
+
+  const auto binary = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(text_sum, binary_sum);
+
+  std::cout << "text protocol: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(text -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+  std::cout << "prepared statements: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(binary -
+                                                                     text)
+                   .count()
+            << " ms" << std::endl;
+
+  session->execute("DROP TABLE xtest.prepared_bench");
+  session->close();
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/db/row_batch.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "unittest/gtest_clean.h"
+
+namespace mysqlshdk {
+namespace db {
+
+namespace {
+
+const std::vector<Type> k_types = {
+    Type::Integer, Type::UInteger, Type::Float,   Type::Double,
+    Type::String,  Type::Bytes,    Type::Decimal, Type::Date,
+    Type::Json,    Type::Bit,      Type::Decimal};
+
+Mutable_row make_row(int64_t i) {
+  Mutable_row row(k_types);
+
+  row.set_field(0, static_cast<int64_t>(i));
+  row.set_field(1, static_cast<uint64_t>(i * 2));
+  row.set_field(2, 1.5f * i);
+  row.set_field(3, 2.5 * i);
+  row.set_field(4, std::string(i % 7, 'a' + i % 26));
+  row.set_field(5, std::string("\0bytes\0", 7));
+  row.set_field(6, std::to_string(-i) + ".25");
+  row.set_field(7, "2019-01-01");
+  row.set_field(8, "{\"a\": " + std::to_string(i) + "}");
+  row.set_field(9, std::string("\x01\x02", 2));
+  row.set_field(10, std::to_string(i));
+
+  return row;
+}
+
+template <typename T>
+void expect_same(T (IRow::*getter)(uint32_t) const, const IRow &expected,
+                 const IRow &actual, uint32_t index) {
+  bool throws = false;
+  T value{};
+
+  try {
+    value = (expected.*getter)(index);
+  } catch (const std::exception &) {
+    throws = true;
+  }
+
+  if (throws) {
+    EXPECT_ANY_THROW((actual.*getter)(index));
+  } else {
+    EXPECT_EQ(value, (actual.*getter)(index));
+  }
+}
+
+void expect_same(const IRow &expected, const IRow &actual) {
+  ASSERT_EQ(expected.num_fields(), actual.num_fields());
+
+  for (uint32_t i = 0; i < expected.num_fields(); ++i) {
+    SCOPED_TRACE("field " + std::to_string(i));
+
+    EXPECT_EQ(expected.get_type(i), actual.get_type(i));
+    EXPECT_EQ(expected.is_null(i), actual.is_null(i));
+
+    expect_same(&IRow::get_as_string, expected, actual, i);
+    expect_same(&IRow::get_string, expected, actual, i);
+    expect_same(&IRow::get_int, expected, actual, i);
+    expect_same(&IRow::get_uint, expected, actual, i);
+    expect_same(&IRow::get_float, expected, actual, i);
+    expect_same(&IRow::get_double, expected, actual, i);
+    expect_same(&IRow::get_bit, expected, actual, i);
+
+    if (!expected.is_null(i) && (Type::String == expected.get_type(i) ||
+                                 Type::Bytes == expected.get_type(i))) {
+      // pointers differ, compare the data
+      const auto e = expected.get_string_data(i);
+      const auto a = actual.get_string_data(i);
+      EXPECT_EQ(std::string(e.first, e.second), std::string(a.first, a.second));
+    } else {
+      EXPECT_ANY_THROW(actual.get_string_data(i));
+    }
+  }
+
+  EXPECT_THROW(actual.is_null(expected.num_fields()), std::invalid_argument);
+}
+
+}  // namespace
+
+TEST(Row_batch, same_as_row_copy) {
+  Row_batch batch;
+  std::deque<Row_copy> copies;
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    auto row = make_row(i);
+
+    // every field is null in some of the rows
+    if (i % 5 == 0) row.set_field(i % k_types.size(), nullptr);
+
+    batch.append(row);
+    copies.emplace_back(row);
+  }
+
+  ASSERT_EQ(copies.size(), batch.size());
+
+  Batch_row view{&batch};
+
+  for (size_t i = 0; i < copies.size(); ++i) {
+    SCOPED_TRACE("row " + std::to_string(i));
+    view.reset(i);
+
+    expect_same(copies[i], view);
+  }
+}
+
+TEST(Row_batch, large_values) {
+  Row_batch batch;
+  std::vector<std::string> values;
+
+  for (size_t size : {0, 1, 100, 16 * 1024, 17 * 1024, 100 * 1024, 3}) {
+    values.emplace_back(size, 'x');
+
+    if (size > 1) {
+      values.back().front() = '<';
+      values.back().back() = '>';
+    }
+
+    Mutable_row row({Type::String});
+    row.set_field(0, values.back());
+    batch.append(row);
+  }
+
+  Batch_row view{&batch};
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    view.reset(i);
+    EXPECT_EQ(values[i], view.get_string(0));
+  }
+}
+
+TEST(Row_batch, layout_mismatch) {
+  Row_batch batch;
+  batch.append(make_row(1));
+
+  {
+    Mutable_row row({Type::Integer});
+    row.set_field(0, 1);
+    EXPECT_THROW(batch.append(row), std::invalid_argument);
+  }
+
+  {
+    auto types = k_types;
+    types.back() = Type::String;
+    Mutable_row row(types);
+    row.set_field(0, 1);
+    row.set_field(10, "1");
+    EXPECT_THROW(batch.append(row), std::invalid_argument);
+  }
+
+  // batch is not affected by the failures
+  batch.append(make_row(2));
+  ASSERT_EQ(2, batch.size());
+
+  Batch_row view{&batch, 1};
+  Row_copy expected{make_row(2)};
+  EXPECT_EQ(expected.get_as_string(4), view.get_as_string(4));
+  EXPECT_FALSE(view.is_null(9));
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.allocated_memory());
+
+  Mutable_row row({Type::String});
+  row.set_field(0, "new layout");
+  batch.append(row);
+  EXPECT_EQ("new layout", Batch_row(&batch).get_string(0));
+}
+
+TEST(Row_batch, DISABLED_benchmark) {
+  const int64_t rows = 1000000;
+  std::vector<Mutable_row> source;
+
+  for (int64_t i = 0; i < 1000; ++i) {
+    source.emplace_back(make_row(i));
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  {
+    std::deque<Row_copy> copies;
+    for (int64_t i = 0; i < rows; ++i) {
+      copies.emplace_back(source[i % source.size()]);
+    }
+  }
+
+  const auto copied = std::chrono::steady_clock::now();
+  size_t memory = 0;
+
+  {
+    Row_batch batch;
+    for (int64_t i = 0; i < rows; ++i) {
+      batch.append(source[i % source.size()]);
+    }
+    memory = batch.allocated_memory();
+  }
+
+  const auto batched = std::chrono::steady_clock::now();
+
+  std::cout << "Row_copy: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(copied -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+  std::cout << "Row_batch: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(batched -
+                                                                     copied)
+                   .count()
+            << " ms, " << memory / (1024 * 1024) << " MB" << std::endl;
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
@@ -1370,4 +1370,71 @@ TEST_F(Instance_test, get_fence_sysvars) {
   EXPECT_THROW(instance.get_fence_sysvars(), std::logic_error);
 }
 
+TEST_F(Instance_test, sysvar_snapshot) {
+  EXPECT_CALL(session, connect(_connection_options));
+  _session->connect(_connection_options);
+  mysqlshdk::mysql::Instance instance(_session);
+
+  instance.set_sysvar_snapshot(true);
+  EXPECT_TRUE(instance.is_sysvar_snapshot_enabled());
+
+  const auto expect_global_variables = [this](const std::string &lc_messages) {
+    session.expect_query("SHOW GLOBAL VARIABLES")
+        .then_return({{"SHOW GLOBAL VARIABLES",
+                       {"Variable_name", "Value"},
+                       {Type::String, Type::String},
+                       {{"lc_messages", lc_messages},
+                        {"server_id", "1"},
+                        {"sql_warnings", "OFF"}}}});
+  };
+
+  // all the variables are fetched by the first read
+  expect_global_variables("en_US");
+  EXPECT_EQ("en_US", *instance.get_sysvar_string("lc_messages"));
+  EXPECT_EQ(1, *instance.get_sysvar_int("server_id"));
+  EXPECT_FALSE(*instance.get_sysvar_bool("sql_warnings"));
+  EXPECT_TRUE(instance.get_sysvar_string("unexisting_variable").is_null());
+  EXPECT_EQ(3, instance.get_sysvar_queries_saved());
+
+  // each scope has its own snapshot
+  session.expect_query("SHOW SESSION VARIABLES")
+      .then_return({{"SHOW SESSION VARIABLES",
+                     {"Variable_name", "Value"},
+                     {Type::String, Type::String},
+                     {{"lc_messages", "es_MX"}}}});
+  EXPECT_EQ("es_MX",
+            *instance.get_sysvar_string(
+                "lc_messages", mysqlshdk::mysql::Var_qualifier::SESSION));
+  EXPECT_EQ("en_US", *instance.get_sysvar_string("lc_messages"));
+  EXPECT_EQ(4, instance.get_sysvar_queries_saved());
+
+  // snapshot is discarded when variable is set
+  EXPECT_CALL(session, execute("SET GLOBAL `lc_messages` = 'fr_FR'"));
+  instance.set_sysvar("lc_messages", (std::string) "fr_FR");
+  expect_global_variables("fr_FR");
+  EXPECT_EQ("fr_FR", *instance.get_sysvar_string("lc_messages"));
+
+  // and by refresh()
+  instance.refresh();
+  expect_global_variables("pt_PT");
+  EXPECT_EQ("pt_PT", *instance.get_sysvar_string("lc_messages"));
+  EXPECT_EQ(4, instance.get_sysvar_queries_saved());
+
+  // variables are queried one by one when disabled
+  instance.set_sysvar_snapshot(false);
+  session
+      .expect_query(
+          "show GLOBAL variables where `variable_name` in ('lc_messages')")
+      .then_return({{"show GLOBAL variables "
+                     "where `variable_name` in ('lc_messages')",
+                     {"Variable_name", "Value"},
+                     {Type::String, Type::String},
+                     {{"lc_messages", "en_US"}}}});
+  EXPECT_EQ("en_US", *instance.get_sysvar_string("lc_messages"));
+  EXPECT_EQ(4, instance.get_sysvar_queries_saved());
+
+  EXPECT_CALL(session, close());
+  _session->close();
+}
+
 }  // namespace testing
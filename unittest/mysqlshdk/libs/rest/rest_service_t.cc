@@ -21,6 +21,8 @@
  * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -487,6 +489,75 @@ TEST_F(Rest_service_test, timeout) {
   EXPECT_EQ(Response::Status_code::OK, m_service.get("/timeout/2.1").status);
 }
 
+TEST_F(Rest_service_test, response_buffer) {
+  FAIL_IF_NO_SERVER
+
+  std::string expected(100000, '\0');
+  for (size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = static_cast<char>(i % 251);
+  }
+
+  std::string data;
+  String_buffer buffer{&data};
+
+  auto response = m_service.get("/bytes/100000", {}, &buffer);
+  EXPECT_EQ(Response::Status_code::OK, response.status);
+  EXPECT_EQ(shcore::Value_type::Undefined, response.body.type);
+  EXPECT_EQ(expected, data);
+
+  String_buffer range{&data};
+
+  response = m_service.async_get("/bytes/100000", {{"Range", "bytes=10-19"}},
+                                 &range)
+                 .get();
+  EXPECT_EQ(Response::Status_code::PARTIAL_CONTENT, response.status);
+  EXPECT_EQ(expected.substr(10, 10), data);
+}
+
+TEST_F(Rest_service_test, connection_pool) {
+  FAIL_IF_NO_SERVER
+
+  m_service.set_timeout(10000);
+  m_service.set_default_headers({{"one", "1"}});
+  m_service.set_connection_pool(4);
+
+  // synchronous requests are executed by the pool as well
+  auto response = m_service.get("/get", {{"two", "2"}});
+  EXPECT_EQ(Response::Status_code::OK, response.status);
+  EXPECT_EQ("1",
+            response.json().as_map()->get_map("headers")->get_string("one"));
+  EXPECT_EQ("2",
+            response.json().as_map()->get_map("headers")->get_string("two"));
+
+  response = m_service.post("/post", shcore::Value::parse("{'id' : 10}"));
+  EXPECT_EQ(Response::Status_code::OK, response.status);
+  EXPECT_EQ(10, response.json().as_map()->get_map("json")->get_int("id"));
+
+  // four requests are executed concurrently, the remaining ones are queued
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::future<Response>> responses;
+
+  for (int i = 0; i < 8; ++i) {
+    responses.emplace_back(m_service.async_get("/timeout/1"));
+  }
+
+  for (auto &r : responses) {
+    EXPECT_EQ(Response::Status_code::OK, r.get().status);
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  EXPECT_GE(elapsed, 2000);
+  EXPECT_LT(elapsed, 4000);
+
+  // connection errors are reported through the future
+  Rest_service invalid{"https://127.0.0.1:1", false};
+  invalid.set_connection_pool(1);
+
+  EXPECT_THROW(invalid.async_get("/get").get(), Connection_error);
+}
+
 }  // namespace test
 }  // namespace rest
 }  // namespace mysqlshdk
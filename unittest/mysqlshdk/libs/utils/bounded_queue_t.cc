@@ -0,0 +1,234 @@
+/* Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License, version 2.0,
+ as published by the Free Software Foundation.
+
+ This program is also distributed with certain software (including
+ but not limited to OpenSSL) that is licensed under separate terms, as
+ designated in a particular file or component or in included license
+ documentation.  The authors of MySQL hereby grant you an additional
+ permission to link the program and your derivative works with the
+ separately licensed software that they have included with MySQL.
+ This program is distributed in the hope that it will be useful,  but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ the GNU General Public License, version 2.0, for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest_clean.h"
+#include "mysqlshdk/libs/utils/bounded_queue.h"
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
+
+namespace shcore {
+
+namespace {
+
+/**
+ * Runs the given number of producers and consumers, each producer pushes
+ * values [1, count], consumers stop when they receive a guard.
+ *
+ * @returns sum of all values received by consumers.
+ */
+template <class Queue>
+uint64_t produce_consume(Queue *queue, int producers, int consumers,
+                         uint64_t count) {
+  std::atomic<uint64_t> sum{0};
+  std::vector<std::thread> producer_threads;
+  std::vector<std::thread> consumer_threads;
+
+  for (int i = 0; i < consumers; ++i) {
+    consumer_threads.emplace_back([&]() {
+      uint64_t local = 0;
+
+      for (auto v = queue->pop(); v != 0; v = queue->pop()) {
+        local += v;
+      }
+
+      sum += local;
+    });
+  }
+
+  for (int i = 0; i < producers; ++i) {
+    producer_threads.emplace_back([&]() {
+      for (uint64_t v = 1; v <= count; ++v) {
+        queue->push(v);
+      }
+    });
+  }
+
+  for (auto &t : producer_threads) {
+    t.join();
+  }
+
+  queue->shutdown(consumers);
+
+  for (auto &t : consumer_threads) {
+    t.join();
+  }
+
+  return sum;
+}
+
+}  // namespace
+
+TEST(Bounded_queue, capacity) {
+  EXPECT_EQ(2u, Bounded_queue<int>(0).capacity());
+  EXPECT_EQ(2u, Bounded_queue<int>(2).capacity());
+  EXPECT_EQ(4u, Bounded_queue<int>(3).capacity());
+  EXPECT_EQ(64u, Bounded_queue<int>(64).capacity());
+
+  Bounded_queue<int> queue(4);
+
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.try_push(int{i}));
+  }
+
+  EXPECT_FALSE(queue.try_push(5));
+
+  int value = 0;
+
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.try_pop(&value));
+    EXPECT_EQ(i, value);
+  }
+
+  EXPECT_FALSE(queue.try_pop(&value));
+
+  // ring wraps around
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(queue.try_push(int{i}));
+    EXPECT_TRUE(queue.try_pop(&value));
+    EXPECT_EQ(i, value);
+  }
+}
+
+TEST(Bounded_queue, shutdown) {
+  Bounded_queue<std::shared_ptr<std::string>> queue(8);
+  auto data = std::make_shared<std::string>("data");
+
+  queue.push(data);
+  queue.push(data);
+  queue.shutdown(2);
+
+  // elements pushed before shutdown() are received first
+  EXPECT_EQ(data, queue.pop());
+  EXPECT_EQ(data, queue.pop());
+  EXPECT_EQ(nullptr, queue.pop());
+  EXPECT_EQ(nullptr, queue.pop());
+
+  // queue does not hold references to the consumed elements
+  EXPECT_EQ(1, data.use_count());
+
+  // guards are not returned by try_pop()
+  std::shared_ptr<std::string> value;
+  queue.shutdown(1);
+  EXPECT_FALSE(queue.try_pop(&value));
+  EXPECT_EQ(nullptr, queue.pop());
+}
+
+TEST(Bounded_queue, shutdown_wakes_consumers) {
+  Bounded_queue<int> queue(2);
+  std::atomic<int> guards{0};
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      if (0 == queue.pop()) ++guards;
+    });
+  }
+
+  // let the consumers fall asleep
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.shutdown(4);
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(4, guards);
+}
+
+TEST(Bounded_queue, back_pressure) {
+  Bounded_queue<int> queue(2);
+  std::atomic<int> pushed{0};
+
+  std::thread producer([&]() {
+    for (int i = 1; i <= 10; ++i) {
+      queue.push(i);
+      ++pushed;
+    }
+  });
+
+  // producer waits for free space
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(2, pushed);
+
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_EQ(i, queue.pop());
+  }
+
+  producer.join();
+  EXPECT_EQ(10, pushed);
+}
+
+TEST(Bounded_queue, multiple_producers_consumers) {
+  const uint64_t count = 10000;
+
+  for (const int threads : {1, 2, 8}) {
+    for (const size_t capacity : {2, 16, 1024}) {
+      SCOPED_TRACE(std::to_string(threads) + " threads, capacity " +
+                   std::to_string(capacity));
+
+      Bounded_queue<uint64_t> queue(capacity);
+      EXPECT_EQ(threads * count * (count + 1) / 2,
+                produce_consume(&queue, threads, threads, count));
+    }
+  }
+}
+
+TEST(Bounded_queue, DISABLED_benchmark) {
+  const uint64_t total = 1000000;
+
+  for (const int threads : {1, 2, 4, 8, 16, 32, 64}) {
+    const uint64_t count = total / threads;
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+      Synchronized_queue<uint64_t> queue;
+      produce_consume(&queue, threads, threads, count);
+    }
+
+    const auto synchronized = std::chrono::steady_clock::now();
+
+    {
+      Bounded_queue<uint64_t> queue(1024);
+      produce_consume(&queue, threads, threads, count);
+    }
+
+    const auto bounded = std::chrono::steady_clock::now();
+
+    std::cout << threads << " producers/consumers, Synchronized_queue: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     synchronized - start)
+                     .count()
+              << " ms, Bounded_queue: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                     bounded - synchronized)
+                     .count()
+              << " ms" << std::endl;
+  }
+}
+
+}  // namespace shcore
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/document_parser.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "unittest/gtest_clean.h"
+
+namespace shcore {
+
+namespace {
+
+std::vector<std::string> read_documents(const std::string &data) {
+  const std::string path = "document_parser_test.json";
+  shcore::create_file(path, data, true);
+
+  std::vector<std::string> documents;
+
+  {
+    Buffered_input input{path};
+    Document_reader_options options;
+    Json_reader reader(&input, options);
+    std::string document;
+
+    while (!reader.eof()) {
+      document.clear();
+      reader.next(&document);
+
+      if (!document.empty()) {
+        // whitespace following the document is a part of it
+        documents.emplace_back(shcore::str_rstrip(document));
+      }
+    }
+  }
+
+  shcore::delete_file(path, true);
+  return documents;
+}
+
+}  // namespace
+
+TEST(Document_parser, json_documents) {
+  const std::vector<std::string> expected = {
+      "{}",
+      "{\"a\": 1, \"b\" : [1, 2.5, true, null, \"x\"]}",
+      "{\"str\": \"quoted \\\" and escaped \\\\ chars\\n\", \"\": \"\"}",
+      "{\"nested\": {\"array\": [[], [{}], {\"c\": [\"}\", \"]\", \",\"]}]}}",
+      "{\n  \"pretty\": {\n    \"value\": -1.5e10\n  }\n}",
+  };
+
+  std::string data;
+  for (const auto &doc : expected) {
+    data += "  " + doc + "\n\n";
+  }
+
+  EXPECT_EQ(expected, read_documents(data));
+}
+
+TEST(Document_parser, json_documents_across_buffers) {
+  // documents are larger than the input buffer, values are split between
+  // consecutive reads
+  std::vector<std::string> expected;
+  std::string data;
+
+  for (int i = 0; i < 20; i++) {
+    std::string doc = "{\"id\": " + std::to_string(i) + ", \"value\": \"";
+    doc += std::string(i * 9973, 'a' + i % 26);
+    doc += "\\\"\", \"number\": " + std::string(i * 997 + 1, '1') + "}";
+    expected.emplace_back(doc);
+    data += doc + "\n";
+  }
+
+  EXPECT_EQ(expected, read_documents(data));
+}
+
+TEST(Document_parser, json_document_appended) {
+  const std::string path = "document_parser_test.json";
+  shcore::create_file(path, "{\"a\": 1}{\"b\": 2}", true);
+
+  {
+    Buffered_input input{path};
+    Document_reader_options options;
+    Json_reader reader(&input, options);
+    std::string documents;
+
+    reader.next(&documents);
+    reader.next(&documents);
+    EXPECT_EQ("{\"a\": 1}{\"b\": 2}", documents);
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(Document_parser, json_document_premature_end) {
+  for (const auto &data :
+       {"{\"a\": 1", "{\"a\": \"value", "{\"a\": \"value\\", "{\"a\": [1, 2"}) {
+    SCOPED_TRACE(data);
+    EXPECT_THROW(read_documents(data), invalid_json);
+  }
+}
+
+}  // namespace shcore
@@ -20,10 +20,15 @@
    51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <deque>
 #include <fstream>
+#include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "unittest/gtest_clean.h"
 #include "unittest/test_utils/mocks/gmock_clean.h"
@@ -84,6 +89,8 @@ class Logger_test : public ::testing::Test {
   }
 
   void TearDown() override {
+    Logger::singleton()->set_async(false);
+
     const auto current_log_file = Logger::singleton()->logfile_name();
 
     if (current_log_file != m_previous_log_file) {
@@ -238,6 +245,149 @@ TEST_F(Logger_test, log_format) {
   EXPECT_TRUE(tests.empty());
 }
 
+TEST_F(Logger_test, level_filter) {
+  Logger::setup_instance(get_log_file("mylog.txt").c_str(), false,
+                         Logger::LOG_WARNING);
+
+  const auto l = Logger::singleton();
+
+  EXPECT_TRUE(l->is_enabled(Logger::LOG_ERROR));
+  EXPECT_TRUE(l->is_enabled(Logger::LOG_WARNING));
+  EXPECT_FALSE(l->is_enabled(Logger::LOG_INFO));
+
+  // catch-all hook receives entries of all levels
+  l->attach_log_hook(log_all_hook, nullptr, true);
+  EXPECT_TRUE(l->is_enabled(Logger::LOG_DEBUG3));
+
+  l->set_log_hook_level(log_all_hook, Logger::LOG_INFO);
+  EXPECT_TRUE(l->is_enabled(Logger::LOG_INFO));
+  EXPECT_FALSE(l->is_enabled(Logger::LOG_DEBUG));
+
+  l->log(Logger::LOG_WARNING, "Warning");
+  l->log(Logger::LOG_INFO, "Info");
+  l->log(Logger::LOG_DEBUG, "Debug");
+  EXPECT_EQ(2, all_hook_executed());
+
+  l->set_log_level(Logger::LOG_DEBUG2);
+  EXPECT_TRUE(l->is_enabled(Logger::LOG_DEBUG2));
+  EXPECT_FALSE(l->is_enabled(Logger::LOG_DEBUG3));
+
+  l->detach_log_hook(log_all_hook);
+  l->set_log_level(Logger::LOG_ERROR);
+  EXPECT_FALSE(l->is_enabled(Logger::LOG_WARNING));
+}
+
+TEST_F(Logger_test, async_writes) {
+  const auto name = get_log_file("async_log.txt");
+  shcore::delete_file(name);
+
+  Logger::setup_instance(name.c_str(), false, Logger::LOG_DEBUG);
+
+  const auto l = Logger::singleton();
+  l->set_async(true);
+  EXPECT_TRUE(l->is_async());
+
+  // more entries than the capacity of the queue
+  const int threads = 8;
+  const int entries = 2000;
+  std::vector<std::thread> workers;
+
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([t]() {
+      for (int i = 0; i < entries; ++i) {
+        log_debug("thread %d entry %d", t, i);
+      }
+    });
+  }
+
+  for (auto &w : workers) w.join();
+
+  l->flush();
+
+  std::string contents;
+  EXPECT_TRUE(get_log_file_contents("async_log.txt", &contents));
+
+  std::vector<int> next(threads, 0);
+  int count = 0;
+
+  for (const auto &line : shcore::str_split(contents, "\n")) {
+    if (line.empty()) continue;
+
+    ASSERT_TRUE(is_timestamp(line.c_str()));
+
+    int t = 0;
+    int i = 0;
+    ASSERT_EQ(2, sscanf(line.c_str() + 19, ": Debug: thread %d entry %d", &t,
+                        &i))
+        << line;
+
+    // entries of a thread are written in order
+    EXPECT_EQ(next[t], i);
+    next[t] = i + 1;
+    ++count;
+  }
+
+  EXPECT_EQ(threads * entries, count);
+
+  // errors are written before log() returns
+  log_error("Error entry");
+  EXPECT_TRUE(get_log_file_contents("async_log.txt", &contents));
+  EXPECT_THAT(contents, ::testing::HasSubstr(": Error: Error entry\n"));
+
+  // queued entries are written when logger stops writing in background
+  log_info("Last entry");
+  l->set_async(false);
+  EXPECT_FALSE(l->is_async());
+  EXPECT_TRUE(get_log_file_contents("async_log.txt", &contents));
+  EXPECT_THAT(contents, ::testing::HasSubstr(": Info: Last entry\n"));
+}
+
+TEST_F(Logger_test, DISABLED_benchmark) {
+  const auto name = get_log_file("benchmark_log.txt");
+  const auto l = Logger::singleton();
+  const int threads = 8;
+  const int entries = 100000;
+
+  for (const bool async : {false, true}) {
+    for (const auto level :
+         {Logger::LOG_NONE, Logger::LOG_INFO, Logger::LOG_DEBUG3}) {
+      shcore::delete_file(name);
+      Logger::setup_instance(name.c_str(), false, level);
+      l->set_async(async);
+
+      std::vector<std::thread> workers;
+      const auto start = std::chrono::steady_clock::now();
+
+      for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t]() {
+          for (int i = 0; i < entries; ++i) {
+            log_debug3("thread %d entry %d: %s", t, i,
+                       "some text to make the entry longer");
+          }
+        });
+      }
+
+      for (auto &w : workers) w.join();
+
+      l->flush();
+
+      const auto end = std::chrono::steady_clock::now();
+
+      std::cout << (async ? "async" : "sync") << ", log level " << level
+                << ": "
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       end - start)
+                           .count() *
+                       1000 / (threads * entries)
+                << " ns per entry" << std::endl;
+
+      l->set_async(false);
+    }
+  }
+
+  shcore::delete_file(name);
+}
+
 #ifndef _WIN32
 // on Windows Logger is using OutputDebugString() instead of stderr
 
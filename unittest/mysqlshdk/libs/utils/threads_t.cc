@@ -0,0 +1,123 @@
+/* Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License, version 2.0,
+ as published by the Free Software Foundation.
+
+ This program is also distributed with certain software (including
+ but not limited to OpenSSL) that is licensed under separate terms, as
+ designated in a particular file or component or in included license
+ documentation.  The authors of MySQL hereby grant you an additional
+ permission to link the program and your derivative works with the
+ separately licensed software that they have included with MySQL.
+ This program is distributed in the hope that it will be useful,  but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ the GNU General Public License, version 2.0, for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest_clean.h"
+#include "mysqlshdk/libs/utils/threads.h"
+
+namespace mysqlshdk {
+namespace utils {
+
+namespace {
+
+std::atomic<int> g_guards{0};
+
+struct Counting_guard {
+  Counting_guard() { ++g_guards; }
+  ~Counting_guard() { --g_guards; }
+};
+
+}  // namespace
+
+TEST(Threads, parallel_for) {
+  for (const size_t count : {0, 1, 2, 7, 100}) {
+    for (const size_t threads : {0, 1, 3, 8}) {
+      SCOPED_TRACE(std::to_string(count) + " items, " +
+                   std::to_string(threads) + " threads");
+
+      std::vector<std::atomic<int>> calls(count);
+      std::atomic<size_t> running{0};
+      std::atomic<size_t> max_running{0};
+
+      for (auto &c : calls) c = 0;
+
+      parallel_for(count, threads, [&](size_t i) {
+        const auto r = ++running;
+        size_t m = max_running;
+        while (r > m && !max_running.compare_exchange_weak(m, r)) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++calls[i];
+        --running;
+      });
+
+      for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(1, calls[i]);
+      }
+
+      EXPECT_LE(max_running.load(), std::max<size_t>(threads, 1));
+    }
+  }
+}
+
+TEST(Threads, parallel_for_caller_thread) {
+  const auto caller = std::this_thread::get_id();
+
+  parallel_for<Counting_guard>(1, 4, [&](size_t) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    EXPECT_EQ(0, g_guards);
+  });
+
+  parallel_for<Counting_guard>(10, 1, [&](size_t) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    EXPECT_EQ(0, g_guards);
+  });
+}
+
+TEST(Threads, parallel_for_guard) {
+  const auto caller = std::this_thread::get_id();
+
+  parallel_for<Counting_guard>(20, 4, [&](size_t) {
+    EXPECT_NE(caller, std::this_thread::get_id());
+    EXPECT_LT(0, g_guards);
+    EXPECT_GE(4, g_guards);
+  });
+
+  EXPECT_EQ(0, g_guards);
+}
+
+TEST(Threads, parallel_for_exception) {
+  for (const size_t threads : {1, 4}) {
+    std::atomic<size_t> calls{0};
+
+    EXPECT_THROW(parallel_for(1000, threads,
+                              [&](size_t i) {
+                                ++calls;
+                                if (i == 0) throw std::runtime_error("fail");
+                                std::this_thread::sleep_for(
+                                    std::chrono::milliseconds(1));
+                              }),
+                 std::runtime_error);
+
+    // remaining items are not processed
+    EXPECT_GT(1000u, calls.load());
+  }
+}
+
+}  // namespace utils
+}  // namespace mysqlshdk
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "unittest/gtest_clean.h"
+
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/shellcore/name_cache.h"
+
+namespace shcore {
+namespace completer {
+
+class Name_cache_test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto tmpdir = getenv("TMPDIR");
+    m_directory = shcore::path::join_path(tmpdir ? tmpdir : ".",
+                                          "name_cache_test");
+  }
+
+  void TearDown() override {
+    if (shcore::is_folder(m_directory)) {
+      shcore::remove_directory(m_directory);
+    }
+  }
+
+  std::string m_directory;
+};
+
+TEST_F(Name_cache_test, missing) {
+  Name_cache cache{m_directory, "uuid"};
+  std::vector<std::string> schemas;
+  Name_cache::Tables tables;
+
+  EXPECT_FALSE(cache.load_schemas(&schemas));
+  EXPECT_FALSE(cache.load_tables("schema", &tables));
+}
+
+TEST_F(Name_cache_test, schemas) {
+  const std::vector<std::string> schemas = {"mysql", "sakila", "a/b", "A.b"};
+
+  Name_cache{m_directory, "uuid"}.save_schemas(schemas);
+
+  std::vector<std::string> loaded;
+  EXPECT_TRUE(Name_cache(m_directory, "uuid").load_schemas(&loaded));
+  EXPECT_EQ(schemas, loaded);
+
+  // other servers have their own cache
+  EXPECT_FALSE(Name_cache(m_directory, "other").load_schemas(&loaded));
+}
+
+TEST_F(Name_cache_test, tables) {
+  Name_cache::Tables tables;
+  tables["actor"].create_time = "2019-07-01 10:00:00";
+  tables["actor"].update_time = "2019-07-02 11:00:00";
+  tables["actor"].columns = {"actor_id", "first_name", "last_name"};
+  tables["view"].columns = {"a"};
+  tables["empty"].create_time = "2019-07-01 10:00:00";
+
+  Name_cache cache{m_directory, "uuid"};
+  cache.save_tables("sakila", tables);
+  cache.save_tables("Sakila", {});
+
+  Name_cache::Tables loaded;
+  ASSERT_TRUE(cache.load_tables("sakila", &loaded));
+  ASSERT_EQ(3u, loaded.size());
+
+  for (const auto &table : tables) {
+    SCOPED_TRACE(table.first);
+    const auto &t = loaded[table.first];
+    EXPECT_EQ(table.second.create_time, t.create_time);
+    EXPECT_EQ(table.second.update_time, t.update_time);
+    EXPECT_EQ(table.second.columns, t.columns);
+  }
+
+  // names which differ only in case do not overwrite each other
+  ASSERT_TRUE(cache.load_tables("Sakila", &loaded));
+  EXPECT_TRUE(loaded.empty());
+
+  EXPECT_FALSE(cache.load_tables("world", &loaded));
+}
+
+TEST_F(Name_cache_test, long_schema_name) {
+  // 64 characters, three bytes each, too long for a file name if encoded
+  std::string schema;
+
+  for (int i = 0; i < 64; ++i) {
+    schema += "\xe2\x82\xac";
+  }
+
+  Name_cache::Tables tables;
+  tables["table"].columns = {"column"};
+
+  Name_cache cache{m_directory, "uuid"};
+  cache.save_tables(schema, tables);
+
+  Name_cache::Tables loaded;
+  ASSERT_TRUE(cache.load_tables(schema, &loaded));
+  ASSERT_EQ(1u, loaded.size());
+  EXPECT_EQ(std::vector<std::string>{"column"}, loaded["table"].columns);
+
+  // file which holds a different schema is not used
+  shcore::copy_file(cache.tables_path(schema), cache.tables_path("other"));
+  EXPECT_FALSE(cache.load_tables("other", &loaded));
+}
+
+TEST_F(Name_cache_test, malformed) {
+  Name_cache cache{m_directory, "uuid"};
+  cache.save_schemas({"sakila"});
+
+  const auto path = shcore::path::join_path(cache.path(), "schemas.json");
+  ASSERT_TRUE(shcore::is_file(path));
+
+  std::vector<std::string> schemas;
+
+  for (const auto &contents :
+       {"", "[]", "{\"schemas\":[\"a\"]}", "{\"version\":2,\"schemas\":[]}",
+        "{\"version\":1,\"schemas\":[1]}", "{\"version\":1,\"schemas\":["}) {
+    SCOPED_TRACE(contents);
+    shcore::create_file(path, contents);
+    EXPECT_FALSE(cache.load_schemas(&schemas));
+  }
+
+  shcore::create_file(path, "{\"version\":1,\"schemas\":[\"a\"]}");
+  EXPECT_TRUE(cache.load_schemas(&schemas));
+  EXPECT_EQ(std::vector<std::string>{"a"}, schemas);
+}
+
+}  // namespace completer
+}  // namespace shcore
@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2019, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/mocks/mysqlshdk/libs/db/mock_session.h"
+
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/shellcore/provider_sql.h"
+
+namespace shcore {
+namespace completer {
+
+namespace {
+
+Completion_list matches(const Sorted_names &names, const std::string &prefix,
+                        bool back_quote = false) {
+  Completion_list list;
+  names.add_matches(prefix, back_quote, &list);
+  return list;
+}
+
+using mysqlshdk::db::Type;
+
+constexpr auto k_null = "___NULL___";
+
+constexpr auto k_tables_query =
+    "SELECT TABLE_NAME, CREATE_TIME, UPDATE_TIME "
+    "FROM information_schema.tables WHERE TABLE_SCHEMA = 'db'";
+
+constexpr auto k_columns_query =
+    "SELECT TABLE_NAME, COLUMN_NAME FROM information_schema.columns "
+    "WHERE TABLE_SCHEMA = 'db'";
+
+std::string cache_directory() {
+  const auto tmpdir = getenv("TMPDIR");
+  const auto directory =
+      shcore::path::join_path(tmpdir ? tmpdir : ".", "provider_sql_test");
+
+  if (shcore::is_folder(directory)) {
+    shcore::remove_directory(directory);
+  }
+
+  return directory;
+}
+
+void expect_tables(testing::Mock_session *session,
+                   const std::vector<std::vector<std::string>> &rows) {
+  session->expect_query(k_tables_query)
+      .then_return({{"",
+                     {"TABLE_NAME", "CREATE_TIME", "UPDATE_TIME"},
+                     {Type::String, Type::DateTime, Type::DateTime},
+                     rows}});
+}
+
+void expect_columns(testing::Mock_session *session, const std::string &query,
+                    const std::vector<std::vector<std::string>> &rows) {
+  session->expect_query(query).then_return(
+      {{"", {"TABLE_NAME", "COLUMN_NAME"}, {Type::String, Type::String}, rows}});
+}
+
+}  // namespace
+
+TEST(Provider_sql_test, sorted_names_empty) {
+  Sorted_names names;
+
+  EXPECT_TRUE(names.empty());
+  EXPECT_TRUE(matches(names, "").empty());
+  EXPECT_TRUE(matches(names, "a").empty());
+
+  Sorted_names no_names{std::vector<std::string>{}};
+
+  EXPECT_TRUE(no_names.empty());
+  EXPECT_TRUE(matches(no_names, "a").empty());
+}
+
+TEST(Provider_sql_test, sorted_names_prefix) {
+  Sorted_names names{{"zoo", "Zebra", "actor", "Actors", "act", "b", "zoo",
+                      "ZOO", "_id", "\xc3\xa9t\xc3\xa9", "a b"}};
+
+  // exact duplicates are removed, names differing in case are kept
+  EXPECT_EQ(10u, names.size());
+
+  EXPECT_EQ((Completion_list{"_id", "a b", "act", "actor", "Actors", "b",
+                             "Zebra", "ZOO", "zoo", "\xc3\xa9t\xc3\xa9"}),
+            matches(names, ""));
+  EXPECT_EQ((Completion_list{"a b", "act", "actor", "Actors"}),
+            matches(names, "a"));
+  EXPECT_EQ((Completion_list{"act", "actor", "Actors"}), matches(names, "ACT"));
+  EXPECT_EQ((Completion_list{"actor", "Actors"}), matches(names, "acto"));
+  EXPECT_EQ((Completion_list{"Actors"}), matches(names, "actors"));
+  EXPECT_EQ((Completion_list{}), matches(names, "actress"));
+  EXPECT_EQ((Completion_list{"ZOO", "zoo"}), matches(names, "zo"));
+  EXPECT_EQ((Completion_list{"Zebra", "ZOO", "zoo"}), matches(names, "z"));
+  EXPECT_EQ((Completion_list{"_id"}), matches(names, "_"));
+  EXPECT_EQ((Completion_list{"\xc3\xa9t\xc3\xa9"}), matches(names, "\xc3"));
+  EXPECT_EQ((Completion_list{}), matches(names, "c"));
+  EXPECT_EQ((Completion_list{}), matches(names, "zoos"));
+
+  EXPECT_EQ((Completion_list{"`a b`", "`act`", "`actor`", "`Actors`"}),
+            matches(names, "a", true));
+}
+
+TEST(Provider_sql_test, sorted_names_many) {
+  std::vector<std::string> input;
+
+  for (int i = 0; i < 20000; ++i) {
+    input.emplace_back("table_" + std::to_string(i));
+  }
+
+  Sorted_names names{std::vector<std::string>(input)};
+
+  EXPECT_EQ(input.size(), names.size());
+  EXPECT_EQ(input.size(), matches(names, "TABLE_").size());
+  EXPECT_EQ(11111u, matches(names, "table_1").size());
+  EXPECT_EQ((Completion_list{"table_1999", "table_19990", "table_19991",
+                             "table_19992", "table_19993", "table_19994",
+                             "table_19995", "table_19996", "table_19997",
+                             "table_19998", "table_19999"}),
+            matches(names, "table_1999"));
+}
+
+TEST(Provider_sql_test, outdated_names) {
+  Provider_sql provider;
+  const auto names = provider.names_;
+  Name_cache::Tables tables;
+  tables["zz_table"].columns = {"zz_column"};
+  size_t offset = 0;
+
+  const auto first = names->start(false);
+  EXPECT_TRUE(names->set_schemas(first, {"first"}));
+  EXPECT_EQ((Completion_list{"first"}), provider.complete_schema(""));
+
+  // names of the previous refresh are discarded
+  const auto second = names->start(false);
+  EXPECT_FALSE(names->set_schemas(first, {"old"}));
+  EXPECT_FALSE(names->set_objects(first, tables));
+  EXPECT_EQ((Completion_list{"first"}), provider.complete_schema(""));
+  EXPECT_TRUE(provider.complete("zz", &offset).empty());
+
+  EXPECT_TRUE(names->set_objects(second, tables));
+  EXPECT_EQ((Completion_list{"zz_column", "zz_table"}),
+            provider.complete("zz", &offset));
+
+  // names of the previous schema are discarded right away
+  const auto third = names->start(true);
+  EXPECT_TRUE(provider.complete("zz", &offset).empty());
+
+  // cancelled refresh is not waited for and cannot publish anything
+  provider.interrupt_rehash();
+  provider.wait_for_rehash();
+  EXPECT_FALSE(names->set_objects(third, tables));
+  EXPECT_TRUE(provider.complete("zz", &offset).empty());
+  EXPECT_EQ((Completion_list{"first"}), provider.complete_schema(""));
+
+  // waiting for the refresh which is finished by another thread
+  const auto fourth = names->start(false);
+  std::thread thread([names, fourth]() {
+    names->set_schemas(fourth, {"fourth"});
+    names->finish(fourth);
+  });
+  provider.wait_for_rehash();
+  EXPECT_EQ((Completion_list{"fourth"}), provider.complete_schema(""));
+  thread.join();
+}
+
+TEST(Provider_sql_test, join_threads) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  int killed = 0;
+  bool finished = false;
+
+  const auto kill = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      ++killed;
+    }
+    cv.notify_all();
+  };
+
+  {
+    Provider_sql provider;
+    const auto names = provider.names_;
+
+    // connection of the outdated refresh is killed
+    const auto first = names->start(false);
+    EXPECT_TRUE(names->add_connection(first, kill));
+    const auto second = names->start(false);
+    EXPECT_FALSE(names->add_connection(first, kill));
+
+    // refresh blocks until its connection is killed
+    EXPECT_TRUE(names->add_connection(second, kill));
+    names->run([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return killed > 1; });
+      finished = true;
+    });
+
+    // cancelled refresh is not waited for
+    provider.interrupt_rehash();
+    provider.wait_for_rehash();
+    EXPECT_FALSE(names->add_connection(second, kill));
+  }
+
+  // threads are joined when the provider is destroyed
+  EXPECT_EQ(2, killed);
+  EXPECT_TRUE(finished);
+}
+
+TEST(Provider_sql_test, fetch_names_changed_tables) {
+  const auto directory = cache_directory();
+  Provider_sql::Cached_names cached{Name_cache(directory, "uuid")};
+  cached.tables["same"] = {"2019-01-01 10:00:00", "2019-01-02 10:00:00", {"a"}};
+  cached.tables["updated"] = {"2019-01-01 10:00:00", "2019-01-02 10:00:00",
+                              {"old_column"}};
+  cached.tables["view"] = {"", "", {"old_view_column"}};
+  cached.tables["dropped"] = {"2019-01-01 10:00:00", "", {"d"}};
+
+  testing::Mock_session session;
+  expect_tables(&session,
+                {{"created", "2019-03-01 10:00:00", k_null},
+                 {"same", "2019-01-01 10:00:00", "2019-01-02 10:00:00"},
+                 {"updated", "2019-01-01 10:00:00", "2019-02-01 10:00:00"},
+                 {"view", k_null, k_null}});
+  // columns of unchanged tables are reused, views are always fetched
+  expect_columns(&session,
+                 std::string(k_columns_query) +
+                     " AND TABLE_NAME IN ('created','updated','view')",
+                 {{"created", "c"},
+                  {"updated", "new_column"},
+                  {"view", "view_column"}});
+
+  Provider_sql::Names names;
+  Provider_sql::fetch_names(&session, false, "db", &cached, &names,
+                            names.start(false));
+
+  EXPECT_EQ((Completion_list{"a", "c", "created", "new_column", "same",
+                             "updated", "view", "view_column"}),
+            matches(*names.objects, ""));
+  EXPECT_EQ((Completion_list{"created.c", "same.a", "updated.new_column",
+                             "view.view_column"}),
+            matches(*names.object_dots, ""));
+
+  // modified names are written to the cache
+  Name_cache::Tables saved;
+  ASSERT_TRUE(Name_cache(directory, "uuid").load_tables("db", &saved));
+  EXPECT_EQ(4u, saved.size());
+  EXPECT_EQ(0u, saved.count("dropped"));
+  EXPECT_EQ("2019-03-01 10:00:00", saved["created"].create_time);
+  EXPECT_EQ("", saved["created"].update_time);
+  EXPECT_EQ(std::vector<std::string>{"a"}, saved["same"].columns);
+  EXPECT_EQ("2019-02-01 10:00:00", saved["updated"].update_time);
+  EXPECT_EQ(std::vector<std::string>{"new_column"}, saved["updated"].columns);
+  EXPECT_EQ(std::vector<std::string>{"view_column"}, saved["view"].columns);
+
+  shcore::remove_directory(directory);
+}
+
+TEST(Provider_sql_test, fetch_names_unchanged_tables) {
+  const auto directory = cache_directory();
+  Provider_sql::Names names;
+
+  {
+    Provider_sql::Cached_names cached{Name_cache(directory, "uuid")};
+    cached.tables["same"] = {"2019-01-01 10:00:00", "", {"a", "b"}};
+    cached.tables["other"] = {"2019-01-01 10:00:00", "2019-01-02 10:00:00",
+                              {"c"}};
+
+    // nothing has changed, columns are not fetched
+    testing::Mock_session session;
+    expect_tables(&session,
+                  {{"other", "2019-01-01 10:00:00", "2019-01-02 10:00:00"},
+                   {"same", "2019-01-01 10:00:00", k_null}});
+
+    Provider_sql::fetch_names(&session, false, "db", &cached, &names,
+                              names.start(false));
+
+    EXPECT_EQ((Completion_list{"a", "b", "c", "other", "same"}),
+              matches(*names.objects, ""));
+
+    // cache is not written if nothing has changed
+    Name_cache::Tables saved;
+    EXPECT_FALSE(Name_cache(directory, "uuid").load_tables("db", &saved));
+  }
+
+  {
+    Provider_sql::Cached_names cached{Name_cache(directory, "uuid")};
+    cached.tables["same"] = {"2019-01-01 10:00:00", "", {"a", "b"}};
+    cached.tables["dropped"] = {"2019-01-01 10:00:00", "", {"c"}};
+
+    // table was dropped, columns are not fetched, but cache is written
+    testing::Mock_session session;
+    expect_tables(&session, {{"same", "2019-01-01 10:00:00", k_null}});
+
+    Provider_sql::fetch_names(&session, false, "db", &cached, &names,
+                              names.start(false));
+
+    EXPECT_EQ((Completion_list{"a", "b", "same"}),
+              matches(*names.objects, ""));
+
+    Name_cache::Tables saved;
+    ASSERT_TRUE(Name_cache(directory, "uuid").load_tables("db", &saved));
+    EXPECT_EQ(1u, saved.size());
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), saved["same"].columns);
+  }
+
+  shcore::remove_directory(directory);
+}
+
+TEST(Provider_sql_test, fetch_names_not_cached) {
+  testing::Mock_session session;
+  session.expect_query("SELECT SCHEMA_NAME FROM information_schema.schemata")
+      .then_return({{"", {"SCHEMA_NAME"}, {Type::String}, {{"db"}, {"s"}}}});
+  expect_tables(&session, {{"t1", "2019-01-01 10:00:00", k_null},
+                           {"t2", "2019-01-01 10:00:00", k_null}});
+  // all tables are fetched, no need to list them
+  expect_columns(&session, k_columns_query, {{"t1", "a"}, {"t2", "b"}});
+
+  Provider_sql::Names names;
+  Provider_sql::fetch_names(&session, true, "db", nullptr, &names,
+                            names.start(false));
+
+  EXPECT_EQ((Completion_list{"db", "s"}), matches(*names.schemas, ""));
+  EXPECT_EQ((Completion_list{"a", "b", "t1", "t2"}),
+            matches(*names.objects, ""));
+}
+
+}  // namespace completer
+}  // namespace shcore
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -21,8 +21,18 @@
  * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #include <gtest_clean.h>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "mysqlshdk/include/shellcore/shell_resultset_dumper.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
 
 using Print_flags = mysqlsh::Print_flags;
 using Print_flag = mysqlsh::Print_flag;
@@ -67,3 +77,214 @@ TEST(Resultset_dumper, get_data_sizes) {
   // Multibyte character 3 bytes represented in 2 spaces
   TEST_DATA_SIZES("I 爱 MySQL Shell\0", 17, Print_flags(), 16, 17);
 }
+
+namespace {
+
+/**
+ * Result which generates its rows on the fly, the value in the second column
+ * of the row with the given index is replaced with a long one.
+ */
+class Generated_result : public mysqlshdk::db::IResult {
+ public:
+  Generated_result(size_t rows, size_t long_row = 0)
+      : m_rows(rows),
+        m_long_row(long_row),
+        m_row({mysqlshdk::db::Type::Integer, mysqlshdk::db::Type::String}) {
+    for (const auto &name : {"id", "name"}) {
+      m_metadata.emplace_back("catalog", "schema", "table", "table", name,
+                              name, 1, 0,
+                              name == std::string("id")
+                                  ? mysqlshdk::db::Type::Integer
+                                  : mysqlshdk::db::Type::String,
+                              1, false, false, false);
+    }
+  }
+
+  const mysqlshdk::db::IRow *fetch_one() override {
+    if (m_fetched == m_rows) return nullptr;
+
+    ++m_fetched;
+    m_row.set_field(0, static_cast<int64_t>(m_fetched));
+    m_row.set_field(1, m_fetched == m_long_row
+                           ? std::string("long value")
+                           : "v" + std::to_string(m_fetched % 10));
+    return &m_row;
+  }
+
+  bool next_resultset() override { return false; }
+
+  std::unique_ptr<mysqlshdk::db::Warning> fetch_one_warning() override {
+    return {};
+  }
+
+  int64_t get_auto_increment_value() const override { return 0; }
+  bool has_resultset() override { return true; }
+  uint64_t get_affected_row_count() const override { return 0; }
+  uint64_t get_fetched_row_count() const override { return m_fetched; }
+  uint64_t get_warning_count() const override { return 0; }
+  std::string get_info() const override { return ""; }
+
+  const std::vector<std::string> &get_gtids() const override {
+    return m_gtids;
+  }
+
+  const std::vector<mysqlshdk::db::Column> &get_metadata() const override {
+    return m_metadata;
+  }
+
+  std::shared_ptr<mysqlshdk::db::Field_names> field_names() const override {
+    return {};
+  }
+
+  void buffer() override { m_buffered = true; }
+
+  void rewind() override { m_fetched = 0; }
+
+  bool buffered() const { return m_buffered; }
+
+ private:
+  size_t m_rows;
+  size_t m_long_row;
+  size_t m_fetched = 0;
+  bool m_buffered = false;
+  mysqlshdk::db::Mutable_row m_row;
+  std::vector<mysqlshdk::db::Column> m_metadata;
+  std::vector<std::string> m_gtids;
+};
+
+class Test_printer : public mysqlsh::Resultset_printer {
+ public:
+  explicit Test_printer(std::string *output) : m_output(output) {}
+
+  void print(const std::string &s) override { raw_print(s); }
+
+  void println(const std::string &s) override { raw_print(s + "\n"); }
+
+  void raw_print(const std::string &s) override {
+    if (m_output) m_output->append(s);
+  }
+
+ private:
+  std::string *m_output;
+};
+
+class Table_dumper : public mysqlsh::Resultset_dumper_base {
+ public:
+  Table_dumper(mysqlshdk::db::IResult *result, size_t sample_rows,
+               size_t max_sample_size, std::string *output = nullptr)
+      : Resultset_dumper_base(result,
+                              shcore::make_unique<Test_printer>(output), "off",
+                              "table") {
+    m_table_sample_rows = sample_rows;
+    m_table_max_sample_size = max_sample_size;
+  }
+
+  size_t dump() { return dump_table(); }
+};
+
+}  // namespace
+
+TEST(Resultset_dumper, table_sampled) {
+  {
+    // all rows fit into column widths computed from the sample
+    Generated_result result{4};
+    std::string output;
+    EXPECT_EQ(4, Table_dumper(&result, 2, 0, &output).dump());
+    EXPECT_EQ(
+        "+----+------+\n"
+        "| id | name |\n"
+        "+----+------+\n"
+        "|  1 | v1   |\n"
+        "|  2 | v2   |\n"
+        "|  3 | v3   |\n"
+        "|  4 | v4   |\n"
+        "+----+------+\n",
+        output);
+  }
+
+  {
+    // value which does not fit causes the header to be printed again
+    Generated_result result{4, 3};
+    std::string output;
+    EXPECT_EQ(4, Table_dumper(&result, 2, 0, &output).dump());
+    EXPECT_EQ(
+        "+----+------+\n"
+        "| id | name |\n"
+        "+----+------+\n"
+        "|  1 | v1   |\n"
+        "|  2 | v2   |\n"
+        "+----+------+\n"
+        "+----+------------+\n"
+        "| id | name       |\n"
+        "+----+------------+\n"
+        "|  3 | long value |\n"
+        "|  4 | v4         |\n"
+        "+----+------------+\n",
+        output);
+  }
+
+  {
+    // sample is limited by its size: each row takes 3 bytes
+    Generated_result result{4, 3};
+    std::string output;
+    EXPECT_EQ(4, Table_dumper(&result, 0, 7, &output).dump());
+    EXPECT_EQ(
+        "+----+------------+\n"
+        "| id | name       |\n"
+        "+----+------------+\n"
+        "|  1 | v1         |\n"
+        "|  2 | v2         |\n"
+        "|  3 | long value |\n"
+        "|  4 | v4         |\n"
+        "+----+------------+\n",
+        output);
+  }
+
+  {
+    // without sampling, output is the same as if the whole result was used
+    Generated_result result{4, 3};
+    std::string output;
+    EXPECT_EQ(4, Table_dumper(&result, 0, 0, &output).dump());
+    EXPECT_EQ(
+        "+----+------------+\n"
+        "| id | name       |\n"
+        "+----+------------+\n"
+        "|  1 | v1         |\n"
+        "|  2 | v2         |\n"
+        "|  3 | long value |\n"
+        "|  4 | v4         |\n"
+        "+----+------------+\n",
+        output);
+  }
+}
+
+#ifndef _WIN32
+TEST(Resultset_dumper, table_sampled_constant_memory) {
+  const auto max_rss = []() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<size_t>(usage.ru_maxrss);
+#endif
+  };
+
+  {
+    Generated_result result{10000};
+    EXPECT_EQ(10000, Table_dumper(&result, 1000, 0).dump());
+    EXPECT_FALSE(result.buffered());
+  }
+
+  // peak RSS (in KB) must not grow with the number of rows, fully processed
+  // result would need at least 32 bytes per row to hold the lengths of values
+  const auto rss = max_rss();
+
+  {
+    Generated_result result{2000000};
+    EXPECT_EQ(2000000, Table_dumper(&result, 1000, 0).dump());
+  }
+
+  EXPECT_GT(rss + 8 * 1024, max_rss());
+}
+#endif  // !_WIN32
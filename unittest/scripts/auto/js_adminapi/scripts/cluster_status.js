@@ -27,6 +27,18 @@ cluster = dba.getCluster();
 var stat = cluster.status();
 println(stat);
 
+//@<> Status cluster while the member sessions are recorded or replayed
+// members are connected to and probed in a deterministic order, every call
+// needs to match the trace
+var ports = [__mysql_sandbox_port1, __mysql_sandbox_port2, __mysql_sandbox_port3];
+for (var i = 0; i < 3; ++i) {
+  var topology = cluster.status({extended: 1})["defaultReplicaSet"]["topology"];
+
+  for (var p in ports) {
+    EXPECT_EQ("ONLINE", topology[hostname + ":" + ports[p]]["status"]);
+  }
+}
+
 //@<> WL#13084 - TSF4_5: extended: 0 is the default (same as with no options).
 var ext_0_status = cluster.status({extended: 0});
 EXPECT_EQ(ext_0_status, stat);
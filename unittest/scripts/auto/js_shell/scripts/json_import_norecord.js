@@ -549,6 +549,34 @@ EXPECT_STDOUT_CONTAINS(
     '" to collection `wl10606`.`2MB_less________` in MySQL Server at');
 EXPECT_STDOUT_CONTAINS("Total successfully imported documents 1 ");
 
+//@<> Import documents using multiple threads
+util.importJson(__import_data_path + '/sample.json', {
+  schema : target_schema,
+  collection: "multiple_threads",
+  threads: 4
+});
+EXPECT_STDOUT_CONTAINS("Worker 4: ");
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 18 ");
+EXPECT_EQ(18, session.getSchema(target_schema).getCollection("multiple_threads").count());
+
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample.json', {
+    schema : target_schema,
+    collection: "multiple_threads",
+    threads: 0
+  });
+}, "Util.importJson: Option 'threads' must be greater than 0.");
+
+//@<> Failed import using multiple threads is rolled back
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample_invalid.json', {
+    schema : target_schema,
+    collection: "multiple_threads_invalid",
+    threads: 4
+  });
+}, "Util.importJson: Unexpected character, expected field/value separator ':' at offset 1783");
+EXPECT_EQ(0, session.getSchema(target_schema).getCollection("multiple_threads_invalid").count());
+
 //@<> Import document using invalid options
 EXPECT_THROWS(function() {
   util.importJson(__import_data_path + '/2MB_doc.json', {
@@ -80,6 +80,12 @@ result.help('fetchAll')
 //@ Help on fetchAll, \? [USE:Help on fetchAll]
 \? classicresult.fetchAll
 
+//@ Help on fetchAllColumnar
+result.help('fetchAllColumnar')
+
+//@ Help on fetchAllColumnar, \? [USE:Help on fetchAllColumnar]
+\? classicresult.fetchAllColumnar
+
 //@ Help on fetchOne
 result.help('fetchOne')
 
@@ -30,3 +30,9 @@ util.help('importTable');
 
 //@ util importTable help, \? [USE:util importTable help]
 \? importTable
+
+//@ util exportTable help
+util.help('exportTable');
+
+//@ util exportTable help, \? [USE:util exportTable help]
+\? exportTable
@@ -142,6 +142,119 @@ EXPECT_STDOUT_CONTAINS("File '" + __import_data_path + "/world_x_cities.csv' (25
 EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 4079  Deleted: 0  Skipped: 0  Warnings: 0");
 
 
+//@<> Import multiple files using a single pool of threads
+util.importTable([__import_data_path + '/world_x_cities.dump', __import_data_path + '/world_x_cities.dump'], {
+    schema: target_schema, table: 'cities'
+});
+EXPECT_STDOUT_CONTAINS("Importing from 2 files to table `" + target_schema + "`.`cities` in MySQL Server at ");
+EXPECT_STDOUT_CONTAINS("2 files (");
+EXPECT_STDOUT_CONTAINS(") were imported in ");
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 8158  Deleted: 0  Skipped: 8158  Warnings: 8158");
+
+//@<> Import files matching the pattern, header row is skipped in each file
+util.importTable(__import_data_path + '/world_x_cities*.csv', {
+    schema: target_schema, table: 'cities',
+    fieldsTerminatedBy: ',', fieldsEnclosedBy: '"', fieldsOptionallyEnclosed: true, linesTerminatedBy: '\n', skipRows: 1
+});
+EXPECT_STDOUT_CONTAINS("Importing from 2 files to table `" + target_schema + "`.`cities` in MySQL Server at ");
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 8157  Deleted: 0  Skipped: 8157  Warnings: 8157");
+
+//@<> Throw if pattern does not match any file
+EXPECT_THROWS(function () {
+    util.importTable(__import_data_path + '/no_such_file*.csv', { schema: target_schema, table: 'cities' });
+}, "No files match the pattern '" + __import_data_path + "/no_such_file*.csv'");
+
+//@<> Throw if list of files is invalid
+EXPECT_THROWS(function () {
+    util.importTable([__import_data_path + '/world_x_cities.dump', 1], { schema: target_schema, table: 'cities' });
+}, "Argument #1 is expected to be a string or an array of strings");
+EXPECT_THROWS(function () {
+    util.importTable([], { schema: target_schema, table: 'cities' });
+}, "At least one file to import must be given.");
+
+//@<> Throw if compressed file is corrupted, workers are stopped
+var corrupted_path = __tmp_dir + '/import_table_corrupted.tsv.gz';
+testutil.createFile(corrupted_path, 'this is not gzip data\n');
+EXPECT_THROWS(function () {
+    util.importTable(corrupted_path, { schema: target_schema, table: 'cities' });
+}, "gzip decompression failed");
+testutil.rmfile(corrupted_path);
+util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities' });
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 4079  Deleted: 0  Skipped: 4079  Warnings: 4079");
+
+//@<> Import with a journal, which is removed once all data is loaded
+var journal_path = __tmp_dir + '/import_table_journal.json';
+util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', journal: journal_path });
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 4079  Deleted: 0  Skipped: 4079  Warnings: 4079");
+EXPECT_FALSE(os.file_exists(journal_path));
+
+//@<> Resume using a journal which records all data as loaded
+testutil.createFile(journal_path, '{"schema": "' + target_schema + '", "table": "cities", "columns": [], "dialect": {"linesTerminatedBy": "\\n", "fieldsEscapedBy": "\\\\", "fieldsTerminatedBy": "\\t", "fieldsEnclosedBy": "", "fieldsOptionallyEnclosed": false, "linesStartingBy": ""}, "skipRows": 0, "files": [{"path": "' + __import_data_path + '/world_x_cities.dump", "size": 209745, "compressed": false, "completed": [[0, 209745]]}]}');
+util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', journal: journal_path, resume: true });
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 0  Deleted: 0  Skipped: 0  Warnings: 0");
+EXPECT_FALSE(os.file_exists(journal_path));
+
+//@<> Throw if journal already exists and import is not resumed
+testutil.createFile(journal_path, '{}');
+EXPECT_THROWS(function () {
+    util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', journal: journal_path });
+}, "Journal file '" + journal_path + "' already exists, set the 'resume' option to continue the import or remove the file.");
+
+//@<> Throw if journal is not valid
+EXPECT_THROWS(function () {
+    util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', journal: journal_path, resume: true });
+}, "Journal file '" + journal_path + "' is not valid: missing member 'schema'");
+testutil.rmfile(journal_path);
+
+//@<> Throw if journal was written for a different table
+testutil.createFile(journal_path, '{"schema": "' + target_schema + '", "table": "document_store", "columns": [], "dialect": {}, "skipRows": 0, "files": []}');
+EXPECT_THROWS(function () {
+    util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', journal: journal_path, resume: true });
+}, "Journal file '" + journal_path + "' was written for a different table, it cannot be used to resume this import.");
+testutil.rmfile(journal_path);
+
+//@<> Throw if resume is set without the journal
+EXPECT_THROWS(function () {
+    util.importTable(__import_data_path + '/world_x_cities.dump', { schema: target_schema, table: 'cities', resume: true });
+}, "The 'resume' option requires the 'journal' option to be set.");
+
+//@<> Export table and import it back using the same dialect
+var export_path = __tmp_dir + '/export_table_cities.csv';
+util.exportTable('cities', export_path, { schema: target_schema, dialect: 'csv', threads: 4 });
+EXPECT_STDOUT_CONTAINS("Exporting table `" + target_schema + "`.`cities` from MySQL Server at ");
+EXPECT_STDOUT_CONTAINS("Total rows exported from " + target_schema + ".cities: 4079");
+session.runSql('CREATE TABLE ' + target_schema + '.cities_copy LIKE ' + target_schema + '.cities');
+util.importTable(export_path, { schema: target_schema, table: 'cities_copy', dialect: 'csv' });
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities_copy: Records: 4079  Deleted: 0  Skipped: 0  Warnings: 0");
+var checksums = session.runSql('CHECKSUM TABLE ' + target_schema + '.cities, ' + target_schema + '.cities_copy').fetchAll();
+EXPECT_EQ(checksums[0][1], checksums[1][1]);
+session.runSql('DROP TABLE ' + target_schema + '.cities_copy');
+testutil.rmfile(export_path);
+
+//@<> Export table with chunks larger than a single write block
+session.runSql('CREATE TABLE ' + target_schema + '.wide (id INT PRIMARY KEY, data VARCHAR(1000))');
+session.runSql('SET SESSION cte_max_recursion_depth = 20000');
+session.runSql('INSERT INTO ' + target_schema + '.wide WITH RECURSIVE seq (n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 16000) SELECT n, REPEAT(CHAR(97 + n % 26), 500) FROM seq');
+util.exportTable('wide', export_path, { schema: target_schema, threads: 4, bytesPerChunk: '4M' });
+EXPECT_STDOUT_CONTAINS("Total rows exported from " + target_schema + ".wide: 16000");
+EXPECT_FALSE(os.file_exists(export_path + '.part0'));
+session.runSql('CREATE TABLE ' + target_schema + '.wide_copy LIKE ' + target_schema + '.wide');
+util.importTable(export_path, { schema: target_schema, table: 'wide_copy' });
+var checksums = session.runSql('CHECKSUM TABLE ' + target_schema + '.wide, ' + target_schema + '.wide_copy').fetchAll();
+EXPECT_EQ(checksums[0][1], checksums[1][1]);
+session.runSql('DROP TABLE ' + target_schema + '.wide, ' + target_schema + '.wide_copy');
+testutil.rmfile(export_path);
+
+//@<> Throw if output of the export is not a local file
+EXPECT_THROWS(function () {
+    util.exportTable('cities', 'http://example.com/cities.csv', { schema: target_schema });
+}, "Only local files are supported as the output of the export operation.");
+
+//@<> Throw if exported table does not exist
+EXPECT_THROWS(function () {
+    util.exportTable('missing', export_path, { schema: target_schema });
+}, "Table `" + target_schema + "`.`missing` does not exist.");
+
 //@<> fieldsEnclosedBy must be empty or a char.
 EXPECT_THROWS(function () {
     util.importTable(__import_data_path + '/world_x_cities.csv', {
@@ -283,6 +283,9 @@
  sandboxDir                      <<<_defaultSandboxDir>>>
  showColumnTypeInfo              false
  showWarnings                    true
+ sqlBatchSize                    0
+ tableFormat.maxSampleSize       0
+ tableFormat.sampleRows          0
  useWizards                      true
  verbose                         0
 
@@ -311,6 +314,9 @@
  sandboxDir                      <<<_defaultSandboxDir>>> (Compiled default)
  showColumnTypeInfo              false (Compiled default)
  showWarnings                    true (Compiled default)
+ sqlBatchSize                    0 (Compiled default)
+ tableFormat.maxSampleSize       0 (Compiled default)
+ tableFormat.sampleRows          0 (Compiled default)
  useWizards                      true (Compiled default)
  verbose                         0 (Compiled default)
 
@@ -388,6 +394,9 @@
  sandboxDir                      <<<_defaultSandboxDir>>>
  showColumnTypeInfo              false
  showWarnings                    true
+ sqlBatchSize                    0
+ tableFormat.maxSampleSize       0
+ tableFormat.sampleRows          0
  useWizards                      true
  verbose                         0
 
@@ -417,5 +426,8 @@ Switching to SQL mode... Commands end with ;
  sandboxDir                      <<<_defaultSandboxDir>>> (Compiled default)
  showColumnTypeInfo              false (Compiled default)
  showWarnings                    true (Compiled default)
+ sqlBatchSize                    0 (Compiled default)
+ tableFormat.maxSampleSize       0 (Compiled default)
+ tableFormat.sampleRows          0 (Compiled default)
  useWizards                      true (Compiled default)
  verbose                         0 (Compiled default)
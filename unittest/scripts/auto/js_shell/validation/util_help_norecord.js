@@ -17,6 +17,10 @@ FUNCTIONS
             Wizard to create a valid configuration for the OCI SDK.
 
 ?{}
+      exportTable(table, outputUrl[, options])
+            Export table to a file using SELECT statements in parallel
+            connections.
+
       help([member])
             Provides help about this object and it's members
 
@@ -52,6 +56,8 @@ DESCRIPTION
       - targetVersion - version to which upgrade will be checked
         (default=<<<__mysh_version>>>)
       - password - password for connection.
+      - threads - number of sessions used to run the checks and the 'check
+        table x for upgrade' command concurrently (default=1).
 
       The connection data may be specified in the following formats:
 
@@ -149,6 +155,9 @@ DESCRIPTION
       - table: string - name of table where the data will be imported.
       - tableColumn: string (default: "doc") - name of column in target table
         where the imported JSON documents will be stored.
+      - threads: int (default: 1) - number of threads inserting the documents,
+        each one uses its own X Protocol session. When greater than 1,
+        documents are not inserted in the order they appear in the file.
       - convertBsonTypes: bool (default: false) - enables the BSON data type
         conversion.
       - convertBsonOid: bool (default: the value of convertBsonTypes) - enables
@@ -298,7 +307,7 @@ SYNTAX
       util.importTable(filename[, options])
 
 WHERE
-      filename: Path to file with user data
+      filename: Path to file with user data, or list of such paths
       options: Dictionary with import options
 
 DESCRIPTION
@@ -320,12 +329,20 @@ DESCRIPTION
         and ociConfigFile options will override, respectively, oci.profile and
         oci.configFile shell options.
 
+      Files with .gz (gzip) and .zst (zstd) extensions are decompressed while
+      they are imported.
+
+      If a list of files is given, all of them are imported to the same table
+      by a shared pool of threads. Wildcards (* and ?) in the file name part of
+      a local path are expanded to all matching files. Files not larger than
+      bytesPerChunk are loaded whole, larger ones are split into chunks.
+
       Options dictionary:
 
       - schema: string (default: current shell active schema) - Name of target
         schema
       - table: string (default: filename without extension) - Name of target
-        table
+        table, the first file is used if multiple files are given
       - columns: string array (default: empty array) - This option takes a
         array of column names as its value. The order of the column names
         indicates how to match data file columns with table columns.
@@ -354,17 +371,30 @@ DESCRIPTION
         Unit suffixes, k - for Kilobytes (n * 1'000 bytes), M - for Megabytes
         (n * 1'000'000 bytes), G - for Gigabytes (n * 1'000'000'000 bytes),
         bytesPerChunk="2k" - ~2 kilobyte data chunk will send to the MySQL
-        Server.
+        Server. Chunks become smaller as the end of the file approaches, so
+        that all threads finish at the same time.
       - maxRate: string (default: "0") - Limit data send throughput to maxRate
         in bytes per second per thread. maxRate="0" - no limit. Unit suffixes,
         k - for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
         bytes), G - for Gigabytes (n * 1'000'000'000 bytes), maxRate="2k" -
         limit to 2 kilobytes per second.
+      - readAhead: string (default: "32M") - Maximum amount of data fetched
+        ahead of the import by each thread which reads a remote file
+        (http[s]://, oci+os://), using up to 4 concurrent range requests.
+        readAhead="0" - fetch only the data which is requested. Unit suffixes
+        are the same as in case of maxRate.
       - showProgress: bool (default: true if stdout is a tty, false otherwise)
         - Enable or disable import progress information.
       - skipRows: int (default: 0) - Skip first n rows of the data in the file.
         You can use this option to skip an initial header line containing
-        column names.
+        column names. Rows are skipped in each of the imported files.
+      - journal: string (default: not set) - Path to a file which records the
+        data loaded so far, so that an interrupted import can be resumed. The
+        file is replaced each time a chunk is loaded and it is removed when the
+        import finishes successfully.
+      - resume: bool (default: false) - Skip the data which is recorded as
+        loaded in the journal file. The journal has to be written for the same
+        files, dialect and skipRows value.
       - dialect: enum (default: "default") - Setup fields and lines options
         that matches specific data file format. Can be used as base dialect and
         customized with fieldsTerminatedBy, fieldsEnclosedBy,
@@ -429,3 +459,69 @@ DESCRIPTION
       - SET foreign_key_checks = 0
       - SET SESSION TRANSACTION ISOLATION LEVEL READ UNCOMMITTED
 
+//@<OUT> util exportTable help
+NAME
+      exportTable - Export table to a file using SELECT statements in parallel
+                    connections.
+
+SYNTAX
+      util.exportTable(table, outputUrl[, options])
+
+WHERE
+      table: Name of the table to be exported
+      outputUrl: Path to the file where the data is written
+      options: Dictionary with export options
+
+DESCRIPTION
+      Scheme part of outputUrl can be omitted or set to file://, only local
+      files are supported.
+
+      Table is split into ranges of the first column of its primary key, if it
+      is an integer column, each range is read by one of the parallel
+      connections. Data is written to the file in the order of the primary key.
+      Table which does not have such a key is read by a single connection.
+
+      The output file uses the same format as SELECT ... INTO OUTFILE with the
+      same field and line options, so it can be loaded back by
+      util.importTable() called with the same dialect, fields and lines
+      options.
+
+      Options dictionary:
+
+      - schema: string (default: current shell active schema) - Name of source
+        schema
+      - fieldsTerminatedBy: string (default: "\t"), fieldsEnclosedBy: char
+        (default: ''), fieldsEscapedBy: char (default: '\') - These options
+        have the same meaning as the corresponding clauses for SELECT ... INTO
+        OUTFILE.
+      - fieldsOptionallyEnclosed: bool (default: false) - Set to true if only
+        values of string columns should be enclosed within quotation marks
+        specified by fieldsEnclosedBy option. Set to false if all fields should
+        be quoted.
+      - linesTerminatedBy: string (default: "\n") - This option has the same
+        meaning as the corresponding clause for SELECT ... INTO OUTFILE.
+      - threads: int (default: 8) - Use N threads to read the table.
+      - bytesPerChunk: string (minimum: "131072", default: "50M") - Estimated
+        size of the data read by a single SELECT statement. Unit suffixes, k -
+        for Kilobytes (n * 1'000 bytes), M - for Megabytes (n * 1'000'000
+        bytes), G - for Gigabytes (n * 1'000'000'000 bytes).
+      - maxRate: string (default: "0") - Limit data read throughput to maxRate
+        in bytes per second per thread. maxRate="0" - no limit. Unit suffixes
+        are the same as in case of bytesPerChunk.
+      - showProgress: bool (default: true if stdout is a tty, false otherwise)
+        - Enable or disable export progress information.
+      - dialect: enum (default: "default") - Setup fields and lines options
+        that matches specific data file format. Can be used as base dialect and
+        customized with fieldsTerminatedBy, fieldsEnclosedBy,
+        fieldsOptionallyEnclosed, fieldsEscapedBy and linesTerminatedBy
+        options. Must be one of the following values: csv, tsv, json or
+        csv-unix.
+
+      If the schema is not provided, an active schema on the global session, if
+      set, will be used.
+
+      Connection options set in the global session, such as compression,
+      ssl-mode, etc. are used in parallel connections.
+
+      Each range is read in a separate transaction, table should not be
+      modified while it is exported.
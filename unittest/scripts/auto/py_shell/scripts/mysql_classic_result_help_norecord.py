@@ -83,6 +83,15 @@ classicresult.help('fetch_all')
 #@ global help for fetch_all[USE:classicresult.fetch_all]
 \help ClassicResult.fetch_all
 
+#@ classicresult.fetch_all_columnar
+classicresult.help('fetch_all_columnar')
+
+#@ global ? for fetch_all_columnar[USE:classicresult.fetch_all_columnar]
+\? ClassicResult.fetch_all_columnar
+
+#@ global help for fetch_all_columnar[USE:classicresult.fetch_all_columnar]
+\help ClassicResult.fetch_all_columnar
+
 #@ classicresult.fetch_one
 classicresult.help('fetch_one')
 
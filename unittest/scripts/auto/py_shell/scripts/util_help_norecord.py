@@ -30,3 +30,9 @@ util.help('import_table')
 
 #@ util import_table help, \? [USE:util import_table help]
 \? import_table
+
+#@ util export_table help
+util.help('export_table')
+
+#@ util export_table help, \? [USE:util export_table help]
+\? export_table
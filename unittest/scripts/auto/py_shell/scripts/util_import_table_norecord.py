@@ -1,4 +1,6 @@
 # This is unit test file for WL12193 Parallel data import
+import os
+
 target_port = __mysql_port
 target_xport = __port
 target_schema = 'wl12193'
@@ -121,6 +123,84 @@ EXPECT_STDOUT_CONTAINS("File '" + __import_data_path + "/world_x_cities.csv' (25
 EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 4079  Deleted: 0  Skipped: 0  Warnings: 0")
 
 
+#@<> Import multiple files using a single pool of threads
+util.import_table([__import_data_path + '/world_x_cities.dump', __import_data_path + '/world_x_cities.dump'], {
+    "schema": target_schema, "table": 'cities'
+})
+EXPECT_STDOUT_CONTAINS("Importing from 2 files to table `" + target_schema + "`.`cities` in MySQL Server at ")
+EXPECT_STDOUT_CONTAINS("2 files (")
+EXPECT_STDOUT_CONTAINS(") were imported in ")
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 8158  Deleted: 0  Skipped: 8158  Warnings: 8158")
+
+#@<> Import files matching the pattern, header row is skipped in each file
+util.import_table(__import_data_path + '/world_x_cities*.csv', {
+    "schema": target_schema, "table": 'cities',
+    "fieldsTerminatedBy": ',', "fieldsEnclosedBy": '"', "fieldsOptionallyEnclosed": True, "linesTerminatedBy": '\n', "skipRows": 1
+})
+EXPECT_STDOUT_CONTAINS("Importing from 2 files to table `" + target_schema + "`.`cities` in MySQL Server at ")
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 8157  Deleted: 0  Skipped: 8157  Warnings: 8157")
+
+#@<> Throw if pattern does not match any file
+EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/no_such_file*.csv', { "schema": target_schema, "table": 'cities' }),
+    "No files match the pattern '" + __import_data_path + "/no_such_file*.csv'")
+
+#@<> Throw if list of files is invalid
+EXPECT_THROWS(lambda: util.import_table([__import_data_path + '/world_x_cities.dump', 1], { "schema": target_schema, "table": 'cities' }),
+    "Argument #1 is expected to be a string or an array of strings")
+EXPECT_THROWS(lambda: util.import_table([], { "schema": target_schema, "table": 'cities' }),
+    "At least one file to import must be given.")
+
+#@<> Import with a journal, which is removed once all data is loaded
+journal_path = os.path.join(__tmp_dir, 'import_table_journal.json')
+util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "journal": journal_path })
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 4079  Deleted: 0  Skipped: 4079  Warnings: 4079")
+EXPECT_FALSE(os.path.exists(journal_path))
+
+#@<> Resume using a journal which records all data as loaded
+testutil.create_file(journal_path, '{"schema": "' + target_schema + '", "table": "cities", "columns": [], "dialect": {"linesTerminatedBy": "\\n", "fieldsEscapedBy": "\\\\", "fieldsTerminatedBy": "\\t", "fieldsEnclosedBy": "", "fieldsOptionallyEnclosed": false, "linesStartingBy": ""}, "skipRows": 0, "files": [{"path": "' + __import_data_path + '/world_x_cities.dump", "size": 209745, "compressed": false, "completed": [[0, 209745]]}]}')
+util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "journal": journal_path, "resume": True })
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities: Records: 0  Deleted: 0  Skipped: 0  Warnings: 0")
+EXPECT_FALSE(os.path.exists(journal_path))
+
+#@<> Throw if journal already exists and import is not resumed
+testutil.create_file(journal_path, '{}')
+EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "journal": journal_path }),
+    "Journal file '" + journal_path + "' already exists, set the 'resume' option to continue the import or remove the file.")
+
+#@<> Throw if journal is not valid
+EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "journal": journal_path, "resume": True }),
+    "Journal file '" + journal_path + "' is not valid: missing member 'schema'")
+testutil.rmfile(journal_path)
+
+#@<> Throw if journal was written for a different table
+testutil.create_file(journal_path, '{"schema": "' + target_schema + '", "table": "document_store", "columns": [], "dialect": {}, "skipRows": 0, "files": []}')
+EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "journal": journal_path, "resume": True }),
+    "Journal file '" + journal_path + "' was written for a different table, it cannot be used to resume this import.")
+testutil.rmfile(journal_path)
+
+#@<> Throw if resume is set without the journal
+EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/world_x_cities.dump', { "schema": target_schema, "table": 'cities', "resume": True }),
+    "The 'resume' option requires the 'journal' option to be set.")
+
+#@<> Export table and import it back using the same dialect
+export_path = os.path.join(__tmp_dir, 'export_table_cities.csv')
+util.export_table('cities', export_path, { "schema": target_schema, "dialect": 'csv', "threads": 4 })
+EXPECT_STDOUT_CONTAINS("Exporting table `" + target_schema + "`.`cities` from MySQL Server at ")
+EXPECT_STDOUT_CONTAINS("Total rows exported from " + target_schema + ".cities: 4079")
+session.run_sql('CREATE TABLE ' + target_schema + '.cities_copy LIKE ' + target_schema + '.cities')
+util.import_table(export_path, { "schema": target_schema, "table": 'cities_copy', "dialect": 'csv' })
+EXPECT_STDOUT_CONTAINS("Total rows affected in " + target_schema + ".cities_copy: Records: 4079  Deleted: 0  Skipped: 0  Warnings: 0")
+checksums = session.run_sql('CHECKSUM TABLE ' + target_schema + '.cities, ' + target_schema + '.cities_copy').fetch_all()
+EXPECT_EQ(checksums[0][1], checksums[1][1])
+session.run_sql('DROP TABLE ' + target_schema + '.cities_copy')
+testutil.rmfile(export_path)
+
+#@<> Throw if output of the export is not a local file
+EXPECT_THROWS(lambda: util.export_table('cities', 'http://example.com/cities.csv', { "schema": target_schema }), "Only local files are supported as the output of the export operation.")
+
+#@<> Throw if exported table does not exist
+EXPECT_THROWS(lambda: util.export_table('missing', export_path, { "schema": target_schema }), "Table `" + target_schema + "`.`missing` does not exist.")
+
 #@<> fieldsEnclosedBy must be empty or a char.
 EXPECT_THROWS(lambda: util.import_table(__import_data_path + '/world_x_cities.csv', {
         "schema": target_schema, "table": 'cities',
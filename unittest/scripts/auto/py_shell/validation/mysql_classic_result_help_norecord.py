@@ -59,6 +59,9 @@ FUNCTIONS
             Returns a list of Row objects which contains an element for every
             record left on the result.
 
+      fetch_all_columnar()
+            Returns the records left on the result, stored column by column.
+
       fetch_one()
             Retrieves the next Row on the ClassicResult.
 
@@ -197,6 +200,39 @@ DESCRIPTION
       If fetchOne is called before this function, when this function is called
       it will return a Row for each of the remaining records on the resultset.
 
+#@<OUT> classicresult.fetch_all_columnar
+NAME
+      fetch_all_columnar - Returns the records left on the result, stored
+                           column by column.
+
+SYNTAX
+      <ClassicResult>.fetch_all_columnar()
+
+RETURNS
+       A list with a dictionary for each column.
+
+DESCRIPTION
+      Values of each column are stored contiguously, which is much faster than
+      creating a Row object for every record when processing large results. The
+      dictionary describing a column has the following keys:
+
+      - name: the column label.
+      - type: one of int64, uint64, double, string or bytes.
+      - nulls: typed array which holds 1 for each NULL value, 0 otherwise.
+      - values: typed array with the numeric values, NULL is stored as 0.
+      - data: string and binary values concatenated, binary values are returned
+        as a typed array of bytes.
+      - offsets: typed array with the offsets of string and binary values in
+        data, value i spans from offsets[i] to offsets[i + 1].
+
+      Typed arrays are returned as Float64Array or Uint8Array objects in
+      JavaScript and as array.array objects in Python. Offsets of string values
+      are expressed in the units used to index strings in the given language.
+      Decimal, date and time values are returned as strings.
+
+      If fetch_one is called before this function, only the remaining records
+      are returned.
+
 #@<OUT> classicresult.fetch_one
 NAME
       fetch_one - Retrieves the next Row on the ClassicResult.
@@ -33,6 +33,7 @@ validateMembers(result, [
 'fetchOne',
 'fetchOneObject',
 'fetchAll',
+'fetchAllColumnar',
 'hasData',
 'nextDataSet',
 'nextResult',
@@ -110,4 +111,21 @@ println("Age as item: " +  object['age']);
 println()
 println(object)
 
+//@<> Resultset columnar fetch
+var result = mySession.runSql('select name, age, age / 2e0 as half, null as missing from buffer_table where name in ("adam", "alma") order by name');
+var columns = result.fetchAllColumnar();
+EXPECT_EQ(4, columns.length);
+EXPECT_EQ("name", columns[0].name);
+EXPECT_EQ("string", columns[0].type);
+EXPECT_EQ("adamalma", columns[0].data);
+EXPECT_EQ([0, 4, 8], Array.from(columns[0].offsets));
+EXPECT_EQ([0, 0], Array.from(columns[0].nulls));
+EXPECT_EQ("int64", columns[1].type);
+EXPECT_EQ([15, 13], Array.from(columns[1].values));
+EXPECT_EQ("double", columns[2].type);
+EXPECT_EQ([7.5, 6.5], Array.from(columns[2].values));
+EXPECT_EQ("missing", columns[3].name);
+EXPECT_EQ([1, 1], Array.from(columns[3].nulls));
+EXPECT_EQ([0, 0, 0], Array.from(columns[3].offsets));
+
 mySession.close()
@@ -34,6 +34,7 @@ validate_members(result, [
   'fetch_one',
   'fetch_one_object',
   'fetch_all',
+  'fetch_all_columnar',
   'has_data',
   'next_data_set',
   'next_result',
@@ -113,4 +114,20 @@ print("Name with property: %s" % object.alias)
 print("Age with property: %s" % object["age"])
 print(object)
 
+#@<> Resultset columnar fetch
+result = mySession.run_sql('select name, age, age / 2e0 as half, null as missing from buffer_table where name in ("adam", "alma") order by name')
+columns = result.fetch_all_columnar()
+EXPECT_EQ("4", str(len(columns)))
+EXPECT_EQ("name", columns[0]["name"])
+EXPECT_EQ("string", columns[0]["type"])
+EXPECT_EQ("adamalma", columns[0]["data"])
+EXPECT_EQ("[0, 4, 8]", str([int(v) for v in columns[0]["offsets"]]))
+EXPECT_EQ("[0, 0]", str(list(columns[0]["nulls"])))
+EXPECT_EQ("int64", columns[1]["type"])
+EXPECT_EQ("[15, 13]", str([int(v) for v in columns[1]["values"]]))
+EXPECT_EQ("double", columns[2]["type"])
+EXPECT_EQ("[7.5, 6.5]", str(list(columns[2]["values"])))
+EXPECT_EQ("missing", columns[3]["name"])
+EXPECT_EQ("[1, 1]", str(list(columns[3]["nulls"])))
+
 mySession.close()
@@ -397,6 +397,80 @@ TEST_F(ShellRunScript, sql_stream) {
   }
 }
 
+TEST_F(ShellRunScript, sql_batch) {
+  shcore::create_file("batch.sql",
+                      "DROP SCHEMA IF EXISTS sql_batch;\n"
+                      "CREATE SCHEMA sql_batch;\n"
+                      "CREATE TABLE sql_batch.t (id INT PRIMARY KEY);\n"
+                      "INSERT INTO sql_batch.t VALUES (1);\n"
+                      "INSERT INTO sql_batch.t VALUES (2);\n"
+                      "INSERT INTO sql_batch.t VALUES (1);\n"
+                      "INSERT INTO sql_batch.t VALUES (3); -- comment\n"
+                      "UPDATE sql_batch.t SET id = id + 10 WHERE id = 3;\n"
+                      "SELECT GROUP_CONCAT(id ORDER BY id) FROM sql_batch.t;\n"
+                      "SELECT 'end';\n");
+
+  // results do not depend on the batch size, errors are reported at the line
+  // of the failed statement
+  for (const int batch_size : {0, 3, 1000}) {
+    SCOPED_TRACE("batch size " + std::to_string(batch_size));
+    _options->sql_batch_size = batch_size;
+
+    {
+      RESET_BATCH("sql");
+      RUNFILE_ABORTS("batch.sql");
+      MY_EXPECT_STDERR_CONTAINS(
+          "ERROR: 1062 at line 6: Duplicate entry '1' for key");
+
+      wipe_all();
+      execute("SELECT GROUP_CONCAT(id ORDER BY id) FROM sql_batch.t;");
+      MY_EXPECT_STDOUT_CONTAINS("1,2");
+      MY_EXPECT_STDOUT_NOT_CONTAINS("1,2,");
+    }
+    {
+      RESET_FORCE_BATCH("sql");
+      RUNFILE_TIL_END("batch.sql");
+      MY_EXPECT_STDERR_CONTAINS(
+          "ERROR: 1062 at line 6: Duplicate entry '1' for key");
+      MY_EXPECT_STDOUT_CONTAINS("1,2,13");
+    }
+  }
+
+  _options->sql_batch_size = 0;
+  execute("DROP SCHEMA sql_batch;");
+  shcore::delete_file("batch.sql");
+}
+
+TEST_F(ShellRunScript, sql_batch_delimiter) {
+  shcore::create_file(
+      "batch.sql",
+      "DROP SCHEMA IF EXISTS sql_batch;\n"
+      "CREATE SCHEMA sql_batch;\n"
+      "CREATE TABLE sql_batch.t (id INT PRIMARY KEY);\n"
+      "DELIMITER $$\n"
+      "INSERT INTO sql_batch.t VALUES (1); "
+      "INSERT INTO sql_batch.t VALUES (2)$$\n"
+      "DELIMITER ;\n"
+      "INSERT INTO sql_batch.t VALUES (3);\n"
+      "SELECT CONCAT('ids: ', GROUP_CONCAT(id)) FROM sql_batch.t;\n");
+
+  // statement with a custom delimiter is not batched, it's a single statement
+  // even if it contains ';'
+  for (const int batch_size : {0, 1000}) {
+    SCOPED_TRACE("batch size " + std::to_string(batch_size));
+    _options->sql_batch_size = batch_size;
+
+    RESET_FORCE_BATCH("sql");
+    RUNFILE_TIL_END("batch.sql");
+    MY_EXPECT_STDERR_CONTAINS("ERROR: 1064 at line 5:");
+    MY_EXPECT_STDOUT_CONTAINS("ids: 3");
+  }
+
+  _options->sql_batch_size = 0;
+  execute("DROP SCHEMA sql_batch;");
+  shcore::delete_file("batch.sql");
+}
+
 #ifdef HAVE_V8
 TEST_F(ShellRunScript, js_file) {
   {